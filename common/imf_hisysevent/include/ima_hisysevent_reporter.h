@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "global.h"
+#include "imf_hisysevent_histogram.h"
 #include "imf_hisysevent_reporter.h"
 
 namespace OHOS {
@@ -88,10 +89,13 @@ public:
     static ImaHiSysEventReporter &GetInstance();
 
 private:
-    ImaHiSysEventReporter();
-    ~ImaHiSysEventReporter();
     static const std::vector<std::pair<int32_t, int32_t>> BASE_TEXT_OPERATION_TIME_INTERVAL;
     static const std::vector<std::pair<int32_t, int32_t>> IME_CB_TIME_INTERVAL;
+    // the intervals are the buckets of the time consume histograms, at most MAX_BUCKET_NUM of them
+    explicit ImaHiSysEventReporter(
+        const std::vector<std::pair<int32_t, int32_t>> &baseTextOperationIntervals = BASE_TEXT_OPERATION_TIME_INTERVAL,
+        const std::vector<std::pair<int32_t, int32_t>> &imeCbIntervals = IME_CB_TIME_INTERVAL);
+    ~ImaHiSysEventReporter();
     bool IsValidErrCode(int32_t errCode) override;
     bool IsFault(int32_t errCode) override;
     void RecordStatisticsEvent(ImfStatisticsEvent event, const HiSysOriginalInfo &info) override;
@@ -100,9 +104,16 @@ private:
     void ModImeCbTimeConsumeInfo(int32_t imeCbTime);
     void RecordBaseTextOperationStatistics(const HiSysOriginalInfo &info);
     uint32_t GetBaseTextOperationSucceedIntervalIndex(int32_t baseTextOperationTime);
+    // merges the counts recorded since the last call, runs only when the statistics are reported
+    void CollectStatistics(ImeStartInputAllInfo &imeStartInputInfo, BaseTextOperationAllInfo &baseTextOperationInfo);
     std::mutex statisticsEventLock_;
-    ImeStartInputAllInfo imeStartInputAllInfo_;
-    BaseTextOperationAllInfo baseTextOperationAllInfo_;
+    const std::vector<std::pair<int32_t, int32_t>> baseTextOperationIntervals_;
+    const std::vector<std::pair<int32_t, int32_t>> imeCbIntervals_;
+    ImfHiSysEventHistogram imeStartInputSucceed_;
+    ImfHiSysEventHistogram imeStartInputFailed_;
+    ImfHiSysEventHistogram imeCbTimeConsume_;
+    ImfHiSysEventHistogram baseTextOperationSucceed_;
+    ImfHiSysEventHistogram baseTextOperationFailed_;
 };
 } // namespace MiscServices
 } // namespace OHOS
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IMF_HISYSEVENT_HISTOGRAM_H
+#define IMF_HISYSEVENT_HISTOGRAM_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace OHOS {
+namespace MiscServices {
+/*
+ * Counts events by a packed key and a bucket without a lock.
+ * A key takes a slot of a fixed table the first time it is recorded and keeps it, so recording is a short probe
+ * and one atomic increment. The counts are moved out only when the statistics are reported.
+ */
+class ImfHiSysEventHistogram {
+public:
+    static constexpr uint32_t MAX_BUCKET_NUM = 10;
+    static constexpr uint32_t DEFAULT_SLOT_NUM = 64;
+    static constexpr uint64_t MAX_KEY = (1ULL << 63) - 1;
+    using Visitor = std::function<void(uint64_t key, uint32_t bucket, uint32_t count)>;
+
+    explicit ImfHiSysEventHistogram(uint32_t bucketNum, uint32_t slotNum = DEFAULT_SLOT_NUM);
+    // the bucket is clamped to the last one, returns false if the key is invalid or the table is full
+    bool Record(uint64_t key, uint32_t bucket);
+    // visits and resets the counts recorded since the last collection, returns the number of dropped records
+    uint64_t Collect(const Visitor &visitor);
+    uint32_t GetBucketNum() const;
+    // intervals are closed ranges in ms, a value beyond all of them falls into the last one
+    static uint32_t GetIntervalIndex(const std::vector<std::pair<int32_t, int32_t>> &intervals, int32_t value);
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> key{ 0 };
+        std::atomic<uint32_t> counts[MAX_BUCKET_NUM]{};
+    };
+    static constexpr uint64_t USED_BIT = 1ULL << 63;
+
+    const uint32_t bucketNum_;
+    const uint32_t slotNum_;
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<uint64_t> droppedNum_{ 0 };
+};
+} // namespace MiscServices
+} // namespace OHOS
+
+#endif // IMF_HISYSEVENT_HISTOGRAM_H
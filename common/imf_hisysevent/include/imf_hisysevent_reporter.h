@@ -16,6 +16,7 @@
 #ifndef IMF_HISYSEVENT_REPORTER_H
 #define IMF_HISYSEVENT_REPORTER_H
 
+#include <atomic>
 #include <cstdint>
 #include <unordered_map>
 
@@ -73,7 +74,7 @@ private:
         { IME_START_INPUT_FAILED, ImfHiSysEventUtil::ReportImeStartInputFault },
         { BASE_TEXT_OPERATION_FAILED, ImfHiSysEventUtil::ReportBaseTextOperationFault }
     };
-    int64_t timerStartTime_ = 0;
+    std::atomic<int64_t> timerStartTime_{ 0 };
     std::mutex selfNameLock_;
     std::string selfName_;
     std::mutex faultEventRecordsLock_;
@@ -82,6 +83,7 @@ private:
     std::mutex timerLock_;
     Utils::Timer timer_{ "OS_imfHiSysEventTimer" };
     uint32_t timerId_{ 0 };
+    std::atomic<bool> isTimerStarted_{ false }; // checked without timerLock_ on every event
 };
 } // namespace MiscServices
 } // namespace OHOS
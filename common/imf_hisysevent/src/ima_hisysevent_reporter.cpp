@@ -16,10 +16,66 @@
 #include "ima_hisysevent_reporter.h"
 
 #include <chrono>
+#include <cinttypes>
 
 namespace OHOS {
 namespace MiscServices {
 using namespace std::chrono;
+namespace {
+// for security reasons, the package name is not printed at this time, so every record has the same app
+constexpr const char *MASKED_APP_NAME = "*";
+constexpr uint64_t CODE_BITS = 16;
+constexpr uint64_t CLIENT_TYPE_BITS = 8;
+constexpr uint64_t ERR_CODE_BITS = 32;
+constexpr uint64_t CODE_MASK = (1ULL << CODE_BITS) - 1;
+constexpr uint64_t CLIENT_TYPE_MASK = (1ULL << CLIENT_TYPE_BITS) - 1;
+constexpr uint64_t ERR_CODE_MASK = (1ULL << ERR_CODE_BITS) - 1;
+constexpr uint64_t INVALID_KEY = ImfHiSysEventHistogram::MAX_KEY + 1;
+
+// the fields of a statistics key packed into the key of a histogram: clientType | code | errCode
+uint64_t PackKey(int32_t code, int32_t errCode = 0, uint32_t clientType = 0)
+{
+    if (code < 0 || static_cast<uint64_t>(code) > CODE_MASK || clientType > CLIENT_TYPE_MASK) {
+        return INVALID_KEY;
+    }
+    return (static_cast<uint64_t>(clientType) << (CODE_BITS + ERR_CODE_BITS))
+        | (static_cast<uint64_t>(code) << ERR_CODE_BITS) | (static_cast<uint32_t>(errCode) & ERR_CODE_MASK);
+}
+
+int32_t GetCode(uint64_t key)
+{
+    return static_cast<int32_t>((key >> ERR_CODE_BITS) & CODE_MASK);
+}
+
+int32_t GetErrCode(uint64_t key)
+{
+    return static_cast<int32_t>(static_cast<uint32_t>(key & ERR_CODE_MASK));
+}
+
+uint32_t GetClientType(uint64_t key)
+{
+    return static_cast<uint32_t>((key >> (CODE_BITS + ERR_CODE_BITS)) & CLIENT_TYPE_MASK);
+}
+
+// moves the counts of a histogram into the distribution reported, keyed as before by "appIndex/fields"
+void Collect(ImfHiSysEventHistogram &histogram, std::vector<std::string> &appNames, CountDistributionInfo &info,
+    const std::function<std::string(uint64_t)> &toString)
+{
+    auto droppedNum = histogram.Collect([&appNames, &info, &toString](uint64_t key, uint32_t bucket,
+        uint32_t count) {
+        std::string statisticsKey(ImfHiSysEventUtil::AddIfAbsent(MASKED_APP_NAME, appNames));
+        statisticsKey.append("/").append(toString(key));
+        info.count += static_cast<int32_t>(count);
+        if (bucket < info.countDistributions.size()) {
+            info.countDistributions[bucket].emplace_back(statisticsKey, count);
+        }
+    });
+    if (droppedNum != 0) {
+        IMSA_HILOGW("%{public}" PRIu64 " records dropped.", droppedNum);
+    }
+}
+} // namespace
+
 const std::vector<std::pair<int32_t, int32_t>> ImaHiSysEventReporter::BASE_TEXT_OPERATION_TIME_INTERVAL = { { 0, 4 },
     { 4, 8 }, { 8, 16 }, { 16, 24 }, { 24, 500 } }; // 0-4ms 4-8ms 8-16ms 16-24ms  24ms+
 const std::vector<std::pair<int32_t, int32_t>> ImaHiSysEventReporter::IME_CB_TIME_INTERVAL = { { 0, 10 }, { 10, 50 },
@@ -30,11 +86,13 @@ ImaHiSysEventReporter &ImaHiSysEventReporter::GetInstance()
     return instance;
 }
 
-ImaHiSysEventReporter::ImaHiSysEventReporter()
-    : imeStartInputAllInfo_(ImeStartInputAllInfo(
-        COUNT_STATISTICS_INTERVAL_NUM, COUNT_STATISTICS_INTERVAL_NUM, IME_CB_TIME_INTERVAL.size())),
-      baseTextOperationAllInfo_(
-          BaseTextOperationAllInfo(BASE_TEXT_OPERATION_TIME_INTERVAL.size(), COUNT_STATISTICS_INTERVAL_NUM))
+ImaHiSysEventReporter::ImaHiSysEventReporter(
+    const std::vector<std::pair<int32_t, int32_t>> &baseTextOperationIntervals,
+    const std::vector<std::pair<int32_t, int32_t>> &imeCbIntervals)
+    : baseTextOperationIntervals_(baseTextOperationIntervals), imeCbIntervals_(imeCbIntervals),
+      imeStartInputSucceed_(COUNT_STATISTICS_INTERVAL_NUM), imeStartInputFailed_(COUNT_STATISTICS_INTERVAL_NUM),
+      imeCbTimeConsume_(imeCbIntervals.size()), baseTextOperationSucceed_(baseTextOperationIntervals.size()),
+      baseTextOperationFailed_(COUNT_STATISTICS_INTERVAL_NUM)
 {
 }
 
@@ -55,7 +113,6 @@ bool ImaHiSysEventReporter::IsFault(int32_t errCode)
 
 void ImaHiSysEventReporter::RecordStatisticsEvent(ImfStatisticsEvent event, const HiSysOriginalInfo &info)
 {
-    std::lock_guard<std::mutex> lock(statisticsEventLock_);
     switch (event) {
         case ImfStatisticsEvent::IME_START_INPUT_STATISTICS: {
             RecordImeStartInputStatistics(info);
@@ -73,19 +130,13 @@ void ImaHiSysEventReporter::RecordStatisticsEvent(ImfStatisticsEvent event, cons
 void ImaHiSysEventReporter::ReportStatisticsEvent()
 {
     ImeStartInputAllInfo imeStartInputInfo(
-        COUNT_STATISTICS_INTERVAL_NUM, COUNT_STATISTICS_INTERVAL_NUM, IME_CB_TIME_INTERVAL.size());
-    BaseTextOperationAllInfo baseTextOperationInfo(
-        BASE_TEXT_OPERATION_TIME_INTERVAL.size(), COUNT_STATISTICS_INTERVAL_NUM);
+        COUNT_STATISTICS_INTERVAL_NUM, COUNT_STATISTICS_INTERVAL_NUM, imeCbIntervals_.size());
+    BaseTextOperationAllInfo baseTextOperationInfo(baseTextOperationIntervals_.size(), COUNT_STATISTICS_INTERVAL_NUM);
     {
         std::lock_guard<std::mutex> lock(statisticsEventLock_);
         auto time = duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
         ResetTimerStartTime(time);
-        imeStartInputInfo = imeStartInputAllInfo_;
-        baseTextOperationInfo = baseTextOperationAllInfo_;
-        imeStartInputAllInfo_ = ImeStartInputAllInfo(
-            COUNT_STATISTICS_INTERVAL_NUM, COUNT_STATISTICS_INTERVAL_NUM, IME_CB_TIME_INTERVAL.size());
-        baseTextOperationAllInfo_ =
-            BaseTextOperationAllInfo(BASE_TEXT_OPERATION_TIME_INTERVAL.size(), COUNT_STATISTICS_INTERVAL_NUM);
+        CollectStatistics(imeStartInputInfo, baseTextOperationInfo);
     }
     if (!imeStartInputInfo.appNames.empty()) {
         std::string imeStartInputStatistics;
@@ -101,20 +152,44 @@ void ImaHiSysEventReporter::ReportStatisticsEvent()
     }
 }
 
+void ImaHiSysEventReporter::CollectStatistics(
+    ImeStartInputAllInfo &imeStartInputInfo, BaseTextOperationAllInfo &baseTextOperationInfo)
+{
+    auto &appNames = imeStartInputInfo.appNames;
+    Collect(imeStartInputSucceed_, appNames, imeStartInputInfo.succeedRateInfo.succeedInfo,
+        [](uint64_t key) { return std::to_string(GetCode(key)); });
+    Collect(imeStartInputFailed_, appNames, imeStartInputInfo.succeedRateInfo.failedInfo, [](uint64_t key) {
+        return std::to_string(GetCode(key)).append("/").append(std::to_string(GetErrCode(key)));
+    });
+    auto &timeConsumeInfo = imeStartInputInfo.imeCbTimeConsumeInfo;
+    imeCbTimeConsume_.Collect([&timeConsumeInfo](uint64_t, uint32_t bucket, uint32_t count) {
+        timeConsumeInfo.count += static_cast<int32_t>(count);
+        if (bucket < timeConsumeInfo.countDistributions.size()) {
+            timeConsumeInfo.countDistributions[bucket] += count;
+        }
+    });
+
+    Collect(baseTextOperationSucceed_, baseTextOperationInfo.appNames,
+        baseTextOperationInfo.succeedRateInfo.succeedInfo, [](uint64_t key) { return std::to_string(GetCode(key)); });
+    Collect(baseTextOperationFailed_, baseTextOperationInfo.appNames,
+        baseTextOperationInfo.succeedRateInfo.failedInfo, [](uint64_t key) {
+            return std::to_string(GetClientType(key))
+                .append("/")
+                .append(std::to_string(GetCode(key)))
+                .append("/")
+                .append(std::to_string(GetErrCode(key)));
+        });
+}
+
 void ImaHiSysEventReporter::RecordImeStartInputStatistics(const HiSysOriginalInfo &info)
 {
-    std::string appName = "*";  // for security reasons, the package name is not printed at this time
-    auto appIndex = ImfHiSysEventUtil::AddIfAbsent(appName, imeStartInputAllInfo_.appNames);
     ModImeCbTimeConsumeInfo(info.imeCbTime);
     auto intervalIndex = GetStatisticalIntervalIndex();
-    std::string key(appIndex);
     if (info.errCode == ErrorCode::NO_ERROR) {
-        key.append("/").append(std::to_string(info.isShowKeyboard));
-        imeStartInputAllInfo_.succeedRateInfo.succeedInfo.ModCountDistributions(intervalIndex, key);
+        imeStartInputSucceed_.Record(PackKey(info.isShowKeyboard), intervalIndex);
         return;
     }
-    key.append("/").append(std::to_string(info.eventCode)).append("/").append(std::to_string(info.errCode));
-    imeStartInputAllInfo_.succeedRateInfo.failedInfo.ModCountDistributions(intervalIndex, key);
+    imeStartInputFailed_.Record(PackKey(info.eventCode, info.errCode), intervalIndex);
 }
 
 void ImaHiSysEventReporter::ModImeCbTimeConsumeInfo(int32_t imeCbTime)
@@ -122,34 +197,18 @@ void ImaHiSysEventReporter::ModImeCbTimeConsumeInfo(int32_t imeCbTime)
     if (imeCbTime < 0) {
         return;
     }
-    auto index = IME_CB_TIME_INTERVAL.size() - 1;
-    for (size_t i = 0; i < IME_CB_TIME_INTERVAL.size() - 1; i++) {
-        if (IME_CB_TIME_INTERVAL[i].first <= imeCbTime && imeCbTime <= IME_CB_TIME_INTERVAL[i].second) {
-            index = i;
-            break;
-        }
-    }
-    imeStartInputAllInfo_.imeCbTimeConsumeInfo.ModCountDistributions(index);
+    imeCbTimeConsume_.Record(0, ImfHiSysEventHistogram::GetIntervalIndex(imeCbIntervals_, imeCbTime));
 }
 
 void ImaHiSysEventReporter::RecordBaseTextOperationStatistics(const HiSysOriginalInfo &info)
 {
-    std::string appName = "*";
-    auto appIndex = ImfHiSysEventUtil::AddIfAbsent(appName, baseTextOperationAllInfo_.appNames);
-    std::string key(appIndex);
     if (info.errCode == ErrorCode::NO_ERROR) {
-        key.append("/").append(std::to_string(info.eventCode));
-        baseTextOperationAllInfo_.succeedRateInfo.succeedInfo.ModCountDistributions(
-            GetBaseTextOperationSucceedIntervalIndex(info.baseTextOperationTime), key);
+        baseTextOperationSucceed_.Record(
+            PackKey(info.eventCode), GetBaseTextOperationSucceedIntervalIndex(info.baseTextOperationTime));
         return;
     }
-    key.append("/")
-        .append(std::to_string(info.clientType))
-        .append("/")
-        .append(std::to_string(info.eventCode))
-        .append("/")
-        .append(std::to_string(info.errCode));
-    baseTextOperationAllInfo_.succeedRateInfo.failedInfo.ModCountDistributions(GetStatisticalIntervalIndex(), key);
+    baseTextOperationFailed_.Record(
+        PackKey(info.eventCode, info.errCode, info.clientType), GetStatisticalIntervalIndex());
 }
 
 uint32_t ImaHiSysEventReporter::GetBaseTextOperationSucceedIntervalIndex(int32_t baseTextOperationTime)
@@ -157,15 +216,7 @@ uint32_t ImaHiSysEventReporter::GetBaseTextOperationSucceedIntervalIndex(int32_t
     if (baseTextOperationTime < 0) {
         return 0;
     }
-    auto index = BASE_TEXT_OPERATION_TIME_INTERVAL.size() - 1;
-    for (size_t i = 0; i < BASE_TEXT_OPERATION_TIME_INTERVAL.size() - 1; i++) {
-        if (BASE_TEXT_OPERATION_TIME_INTERVAL[i].first <= baseTextOperationTime
-            && baseTextOperationTime <= BASE_TEXT_OPERATION_TIME_INTERVAL[i].second) {
-            index = i;
-            break;
-        }
-    }
-    return index;
+    return ImfHiSysEventHistogram::GetIntervalIndex(baseTextOperationIntervals_, baseTextOperationTime);
 }
 } // namespace MiscServices
 } // namespace OHOS
\ No newline at end of file
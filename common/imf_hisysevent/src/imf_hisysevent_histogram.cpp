@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "imf_hisysevent_histogram.h"
+
+#include <algorithm>
+
+namespace OHOS {
+namespace MiscServices {
+namespace {
+constexpr uint64_t HASH_MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+constexpr uint32_t HASH_SHIFT = 32;
+} // namespace
+
+ImfHiSysEventHistogram::ImfHiSysEventHistogram(uint32_t bucketNum, uint32_t slotNum)
+    : bucketNum_(std::clamp(bucketNum, 1U, MAX_BUCKET_NUM)), slotNum_(std::max(slotNum, 1U)),
+      slots_(std::make_unique<Slot[]>(slotNum_))
+{
+}
+
+bool ImfHiSysEventHistogram::Record(uint64_t key, uint32_t bucket)
+{
+    if (key > MAX_KEY) {
+        droppedNum_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    bucket = std::min(bucket, bucketNum_ - 1);
+    auto usedKey = key | USED_BIT;
+    auto start = static_cast<uint32_t>((key * HASH_MULTIPLIER) >> HASH_SHIFT) % slotNum_;
+    for (uint32_t i = 0; i < slotNum_; ++i) {
+        auto &slot = slots_[(start + i) % slotNum_];
+        auto slotKey = slot.key.load(std::memory_order_acquire);
+        if (slotKey == 0 && slot.key.compare_exchange_strong(slotKey, usedKey, std::memory_order_acq_rel)) {
+            slotKey = usedKey;
+        }
+        if (slotKey == usedKey) {
+            slot.counts[bucket].fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    droppedNum_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+uint64_t ImfHiSysEventHistogram::Collect(const Visitor &visitor)
+{
+    for (uint32_t i = 0; i < slotNum_; ++i) {
+        auto &slot = slots_[i];
+        auto slotKey = slot.key.load(std::memory_order_acquire);
+        if (slotKey == 0) {
+            continue;
+        }
+        for (uint32_t bucket = 0; bucket < bucketNum_; ++bucket) {
+            auto count = slot.counts[bucket].exchange(0, std::memory_order_relaxed);
+            if (count != 0 && visitor != nullptr) {
+                visitor(slotKey & ~USED_BIT, bucket, count);
+            }
+        }
+    }
+    return droppedNum_.exchange(0, std::memory_order_relaxed);
+}
+
+uint32_t ImfHiSysEventHistogram::GetBucketNum() const
+{
+    return bucketNum_;
+}
+
+uint32_t ImfHiSysEventHistogram::GetIntervalIndex(
+    const std::vector<std::pair<int32_t, int32_t>> &intervals, int32_t value)
+{
+    if (intervals.empty()) {
+        return 0;
+    }
+    auto index = intervals.size() - 1;
+    for (size_t i = 0; i < intervals.size() - 1; i++) {
+        if (intervals[i].first <= value && value <= intervals[i].second) {
+            index = i;
+            break;
+        }
+    }
+    return index;
+}
+} // namespace MiscServices
+} // namespace OHOS
@@ -53,6 +53,9 @@ void ImfHiSysEventReporter::ReportFaultEvent(ImfFaultEvent event, const HiSysOri
 
 void ImfHiSysEventReporter::StartTimer()
 {
+    if (isTimerStarted_.load(std::memory_order_acquire)) {
+        return;
+    }
     std::lock_guard<std::mutex> lock(timerLock_);
     if (timerId_ != 0) {
         return;
@@ -65,6 +68,7 @@ void ImfHiSysEventReporter::StartTimer()
     auto callback = [this]() { TimerCallback(); };
     timerId_ = timer_.Register(callback, HISYSEVENT_TIMER_TASK_INTERNAL, false);
     timerStartTime_ = duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+    isTimerStarted_.store(timerId_ != 0, std::memory_order_release);
 }
 
 void ImfHiSysEventReporter::TimerCallback()
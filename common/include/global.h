@@ -89,6 +89,7 @@ enum {
     ERROR_IMA_DATA_CHANNEL_ABNORMAL,
     ERROR_IMA_INVALID_IMMERSIVE_EFFECT,
     ERROR_IMA_PRECONDITION_REQUIRED,
+    ERROR_IMA_RESPONSE_TIMEOUT,
     ERROR_IMA_END,
 
     ERROR_IMC_BEGIN,
@@ -136,6 +137,7 @@ enum {
     ERROR_OPERATION_NOT_ALLOWED,
     ERROR_REQUEST_RATE_EXCEEDED,
     ERROR_INVALID_DISPLAYID,
+    ERROR_IMSA_CLIENT_BUSY, // the client still handles older notifies, a notify is dropped or queued behind them
     ERROR_IMSA_END,
 };
 }; // namespace ErrorCode
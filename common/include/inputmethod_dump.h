@@ -20,6 +20,8 @@
 #include <functional>
 #include <iosfwd>
 #include <list>
+#include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -33,13 +35,20 @@ public:
     InputmethodDump() = default;
     virtual ~InputmethodDump() = default;
     void AddDumpAllMethod(const DumpNoParamFunc dumpAllMethod);
+    void AddDumpCommand(const std::string &command, const std::string &description, const DumpNoParamFunc func);
     bool Dump(int fd, const std::vector<std::string> &args);
 
 private:
+    struct DumpCommand {
+        std::string description;
+        DumpNoParamFunc func;
+    };
+    bool RunDumpCommand(int fd, const std::string &command);
     void ShowHelp(int fd);
     void ShowIllegalInformation(int fd);
     mutable std::mutex hidumperMutex_;
     DumpNoParamFunc dumpAllMethod_;
+    std::map<std::string, DumpCommand> dumpCommands_;
 };
 } // namespace MiscServices
 } // namespace OHOS
@@ -17,8 +17,12 @@
 #define INPUTMETHOD_MESSAGE_HANDLER_H
 
 #include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
 #include <mutex>
-#include <queue>
+#include <string>
+#include <unordered_map>
 
 #include "global.h"
 #include "message.h"
@@ -82,17 +86,36 @@ enum {
 
 class MessageHandler {
 public:
+    // a message is dropped if the latest queued message of its scope is of the same kind,
+    // the queued one reads the state when it is handled and covers both
+    struct CoalesceKey {
+        std::string scope; // empty if the message is never folded
+        int32_t kind{ 0 };
+    };
+    using CoalesceKeyGetter = std::function<CoalesceKey(const Message &)>;
+    struct CoalesceStats {
+        uint64_t receivedNum{ 0 };
+        uint64_t coalescedNum{ 0 };
+    };
+
     MessageHandler();
     ~MessageHandler();
     void SendMessage(Message *msg);
     Message *GetMessage();
+    void SetCoalesceKeyGetter(CoalesceKeyGetter getter);
+    std::map<int32_t, CoalesceStats> GetCoalesceStats(); // by message id
     static MessageHandler *Instance();
     static std::mutex handlerMutex_;
 
 private:
+    bool Coalesce(Message *msg);
+
     std::mutex mMutex;            // a mutex to guard message queue
     std::condition_variable mCV;  // condition variable to work with mMutex
-    std::queue<Message *> mQueue; // Message queue, guarded by mMutex;
+    std::deque<Message *> mQueue; // Message queue, guarded by mMutex;
+    CoalesceKeyGetter mKeyGetter = nullptr;
+    std::unordered_map<const Message *, CoalesceKey> mKeys; // keys of the queued foldable messages
+    std::map<int32_t, CoalesceStats> mStats;
 
     MessageHandler(const MessageHandler &);
     MessageHandler &operator=(const MessageHandler &);
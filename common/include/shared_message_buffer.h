@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INPUTMETHOD_IMF_COMMON_INCLUDE_SHARED_MESSAGE_BUFFER_H
+#define INPUTMETHOD_IMF_COMMON_INCLUDE_SHARED_MESSAGE_BUFFER_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "ashmem.h"
+
+namespace OHOS {
+namespace MiscServices {
+/*
+ * Ring buffer on shared memory used to pass large message payloads between editor and ime.
+ * The writer side creates the buffer and shares it with the peer once per bind, after that
+ * only (offset, length) descriptors go through the ipc. A region is only valid until the
+ * next write, so the writer must not write again before the peer has read the last message.
+ */
+class SharedMessageBuffer final {
+public:
+    static std::shared_ptr<SharedMessageBuffer> Create(int32_t capacity);
+    static std::shared_ptr<SharedMessageBuffer> Attach(const sptr<Ashmem> &ashmem);
+
+    bool Write(const std::vector<uint8_t> &data, uint32_t &offset);
+    bool Read(uint32_t offset, uint32_t length, std::vector<uint8_t> &data);
+    sptr<Ashmem> GetAshmem() const;
+    int32_t GetCapacity() const;
+
+private:
+    SharedMessageBuffer(const sptr<Ashmem> &ashmem, int32_t capacity);
+    std::mutex lock_;
+    sptr<Ashmem> ashmem_ = nullptr;
+    int32_t capacity_ = 0;
+    uint32_t writePos_ = 0;
+};
+} // namespace MiscServices
+} // namespace OHOS
+#endif // INPUTMETHOD_IMF_COMMON_INCLUDE_SHARED_MESSAGE_BUFFER_H
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INPUTMETHOD_IMF_COMMON_INCLUDE_TYPING_LATENCY_TRACER_H
+#define INPUTMETHOD_IMF_COMMON_INCLUDE_TYPING_LATENCY_TRACER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace OHOS {
+namespace MiscServices {
+enum class TypingTracePoint : uint32_t {
+    IMC_DISPATCH_KEY = 0, // id: key event id
+    IMSA_START_INPUT,     // id: client pid
+    IMA_DISPATCH_KEY,     // id: key event id
+    IMA_TASK,             // id: task seq id, link: task type
+    IMA_REQUEST,          // id: msg id, link: the last key dispatched to the ime
+    IMA_RESPONSE,         // id: msg id
+    END,
+};
+
+enum class TypingTracePhase : uint32_t {
+    BEGIN = 0,
+    END,
+    INSTANT,
+};
+
+/*
+ * Per process ring of typing trace points with monotonic timestamps, shared by editor, imsa and ime.
+ * The points of one key are correlated across processes by the key event id, the text operations of the
+ * ime by their msg id and the key they follow. Recording is lock-free, old points are overwritten.
+ * When tracing is off, a trace point costs one relaxed load and a branch.
+ * Editor and ime processes can not be dumped, they report their ring to imsa when tracing stops and imsa
+ * exports it together with its own.
+ */
+class TypingLatencyTracer {
+public:
+    static constexpr uint32_t CAPACITY = 2048;
+    static constexpr uint32_t MAX_REMOTE_NUM = 8;
+    static constexpr const char *ENABLE_PARAM_KEY = "imf.typing_trace.enable";
+    struct Record {
+        uint64_t seq{ 0 };
+        int64_t timeNs{ 0 };
+        uint64_t id{ 0 };
+        uint64_t linkId{ 0 };
+        TypingTracePoint point{ TypingTracePoint::END };
+        TypingTracePhase phase{ TypingTracePhase::INSTANT };
+        int32_t tid{ 0 };
+    };
+
+    using Reporter = std::function<void(const std::string &ring)>;
+
+    static TypingLatencyTracer &GetInstance();
+    // reads and watches the enable parameter, once per process
+    static void Init();
+    static bool IsEnabled()
+    {
+        return isEnabled_.load(std::memory_order_relaxed);
+    }
+    static void SetEnabled(bool isEnabled);
+    // gets the packed ring when tracing stops
+    static void SetReporter(Reporter reporter);
+
+    void Trace(TypingTracePoint point, TypingTracePhase phase, uint64_t id, uint64_t linkId = 0);
+    // the recorded points from the oldest to the latest
+    std::vector<Record> Snapshot() const;
+    // the ring in the format read by AddRemote
+    std::string Pack() const;
+    // keeps the ring reported by another process, the oldest one is dropped beyond MAX_REMOTE_NUM
+    void AddRemote(int32_t pid, const std::string &ring);
+    // chrome trace event format of the own ring and the reported ones
+    std::string ExportChromeTrace() const;
+    void Clear();
+    void SetLastKeyId(uint64_t keyId);
+    uint64_t GetLastKeyId() const;
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> seq{ 0 };
+        std::atomic<int64_t> timeNs{ 0 };
+        std::atomic<uint64_t> id{ 0 };
+        std::atomic<uint64_t> linkId{ 0 };
+        std::atomic<uint32_t> pointAndPhase{ 0 };
+        std::atomic<int32_t> tid{ 0 };
+    };
+    static void OnParamChange(const char *key, const char *value, void *context);
+    static void Report();
+    static std::atomic<bool> isEnabled_;
+    static std::mutex reporterLock_;
+    static Reporter reporter_;
+
+    std::atomic<uint64_t> head_{ 0 };
+    std::atomic<uint64_t> lastKeyId_{ 0 };
+    std::array<Slot, CAPACITY> slots_;
+    mutable std::mutex remoteLock_;
+    std::deque<std::pair<int32_t, std::vector<Record>>> remotes_;
+};
+
+// records the begin and the end of a trace point, the enable state is read once at the begin
+class TypingTraceScope final {
+public:
+    TypingTraceScope(TypingTracePoint point, uint64_t id, uint64_t linkId = 0)
+        : isEnabled_(TypingLatencyTracer::IsEnabled()), point_(point), id_(id), linkId_(linkId)
+    {
+        if (isEnabled_) {
+            TypingLatencyTracer::GetInstance().Trace(point_, TypingTracePhase::BEGIN, id_, linkId_);
+        }
+    }
+    ~TypingTraceScope()
+    {
+        if (isEnabled_) {
+            TypingLatencyTracer::GetInstance().Trace(point_, TypingTracePhase::END, id_, linkId_);
+        }
+    }
+    TypingTraceScope(const TypingTraceScope &) = delete;
+    TypingTraceScope &operator=(const TypingTraceScope &) = delete;
+
+private:
+    const bool isEnabled_;
+    const TypingTracePoint point_;
+    const uint64_t id_;
+    const uint64_t linkId_;
+};
+} // namespace MiscServices
+} // namespace OHOS
+#endif // INPUTMETHOD_IMF_COMMON_INCLUDE_TYPING_LATENCY_TRACER_H
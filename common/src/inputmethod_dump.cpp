@@ -39,6 +39,16 @@ void InputmethodDump::AddDumpAllMethod(const DumpNoParamFunc dumpAllMethod)
     dumpAllMethod_ = dumpAllMethod;
 }
 
+void InputmethodDump::AddDumpCommand(const std::string &command, const std::string &description,
+    const DumpNoParamFunc func)
+{
+    if (command.empty() || func == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(hidumperMutex_);
+    dumpCommands_.insert_or_assign(command, DumpCommand{ description, func });
+}
+
 bool InputmethodDump::Dump(int fd, const std::vector<std::string> &args)
 {
     IMSA_HILOGI("InputmethodDump::Dump start.");
@@ -55,13 +65,28 @@ bool InputmethodDump::Dump(int fd, const std::vector<std::string> &args)
             return false;
         }
         dumpAllMethod_(fd);
-    } else {
+    } else if (!RunDumpCommand(fd, command)) {
         ShowIllegalInformation(fd);
     }
     IMSA_HILOGI("InputmethodDump::Dump command=%{public}s.", command.c_str());
     return true;
 }
 
+bool InputmethodDump::RunDumpCommand(int fd, const std::string &command)
+{
+    DumpNoParamFunc func = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(hidumperMutex_);
+        auto iter = dumpCommands_.find(command);
+        if (iter == dumpCommands_.end()) {
+            return false;
+        }
+        func = iter->second.func;
+    }
+    func(fd);
+    return true;
+}
+
 void InputmethodDump::ShowHelp(int fd)
 {
     std::string result;
@@ -69,6 +94,12 @@ void InputmethodDump::ShowHelp(int fd)
         .append("Description:\n")
         .append("-h show help\n")
         .append("-a dump all input methods\n");
+    {
+        std::lock_guard<std::mutex> lock(hidumperMutex_);
+        for (const auto &command : dumpCommands_) {
+            result.append(command.first).append(" ").append(command.second.description).append("\n");
+        }
+    }
     dprintf(fd, "%s\n", result.c_str());
 }
 
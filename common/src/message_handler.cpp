@@ -28,10 +28,11 @@ MessageHandler::~MessageHandler()
     std::unique_lock<std::mutex> lock(mMutex);
     while (!mQueue.empty()) {
         Message *msg = mQueue.front();
-        mQueue.pop();
+        mQueue.pop_front();
         delete msg;
         msg = nullptr;
     }
+    mKeys.clear();
 }
 
 /*! Send a message
@@ -41,7 +42,10 @@ MessageHandler::~MessageHandler()
 void MessageHandler::SendMessage(Message *msg)
 {
     std::unique_lock<std::mutex> lock(mMutex);
-    mQueue.push(msg);
+    if (Coalesce(msg)) {
+        return;
+    }
+    mQueue.push_back(msg);
     mCV.notify_one();
 }
 
@@ -54,10 +58,57 @@ Message *MessageHandler::GetMessage()
     std::unique_lock<std::mutex> lock(mMutex);
     mCV.wait(lock, [this] { return !this->mQueue.empty(); });
     Message *msg = reinterpret_cast<Message *>(mQueue.front());
-    mQueue.pop();
+    mQueue.pop_front();
+    mKeys.erase(msg);
     return msg;
 }
 
+void MessageHandler::SetCoalesceKeyGetter(CoalesceKeyGetter getter)
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    mKeyGetter = std::move(getter);
+}
+
+std::map<int32_t, MessageHandler::CoalesceStats> MessageHandler::GetCoalesceStats()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    return mStats;
+}
+
+/*! Fold a message into the queued ones
+ * @param msg a message to be sent
+ * @return true if the message is dropped, false if it should be queued
+ * @note called with mMutex held
+ */
+bool MessageHandler::Coalesce(Message *msg)
+{
+    if (mKeyGetter == nullptr || msg == nullptr) {
+        return false;
+    }
+    auto key = mKeyGetter(*msg);
+    if (key.scope.empty()) {
+        return false;
+    }
+    auto &stats = mStats[msg->msgId_];
+    ++stats.receivedNum;
+    // only the latest message of the scope counts, so that e.g. remove and add of one package keep their order
+    for (auto it = mQueue.rbegin(); it != mQueue.rend(); ++it) {
+        auto queued = mKeys.find(*it);
+        if (queued == mKeys.end() || queued->second.scope != key.scope) {
+            continue;
+        }
+        if (queued->second.kind != key.kind) {
+            break;
+        }
+        ++stats.coalescedNum;
+        IMSA_HILOGD("message %{public}d folded, scope: %{public}s.", msg->msgId_, key.scope.c_str());
+        delete msg;
+        return true;
+    }
+    mKeys[msg] = std::move(key);
+    return false;
+}
+
 /*! The single instance of MessageHandler in the service
  * @return the pointer referred to an object.
  */
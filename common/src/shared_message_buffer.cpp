@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "shared_message_buffer.h"
+
+#include "global.h"
+
+namespace OHOS {
+namespace MiscServices {
+constexpr const char *SHARED_MESSAGE_BUFFER_NAME = "imf_message_buffer";
+
+SharedMessageBuffer::SharedMessageBuffer(const sptr<Ashmem> &ashmem, int32_t capacity)
+    : ashmem_(ashmem), capacity_(capacity)
+{
+}
+
+std::shared_ptr<SharedMessageBuffer> SharedMessageBuffer::Create(int32_t capacity)
+{
+    if (capacity <= 0) {
+        IMSA_HILOGE("invalid capacity: %{public}d.", capacity);
+        return nullptr;
+    }
+    auto ashmem = Ashmem::CreateAshmem(SHARED_MESSAGE_BUFFER_NAME, capacity);
+    if (ashmem == nullptr) {
+        IMSA_HILOGE("failed to create ashmem, capacity: %{public}d.", capacity);
+        return nullptr;
+    }
+    if (!ashmem->MapReadAndWriteAshmem()) {
+        IMSA_HILOGE("failed to map ashmem.");
+        ashmem->CloseAshmem();
+        return nullptr;
+    }
+    return std::shared_ptr<SharedMessageBuffer>(new (std::nothrow) SharedMessageBuffer(ashmem, capacity));
+}
+
+std::shared_ptr<SharedMessageBuffer> SharedMessageBuffer::Attach(const sptr<Ashmem> &ashmem)
+{
+    if (ashmem == nullptr) {
+        IMSA_HILOGE("ashmem is nullptr!");
+        return nullptr;
+    }
+    int32_t capacity = ashmem->GetAshmemSize();
+    if (capacity <= 0 || !ashmem->MapReadOnlyAshmem()) {
+        IMSA_HILOGE("failed to map ashmem, capacity: %{public}d.", capacity);
+        ashmem->CloseAshmem();
+        return nullptr;
+    }
+    return std::shared_ptr<SharedMessageBuffer>(new (std::nothrow) SharedMessageBuffer(ashmem, capacity));
+}
+
+bool SharedMessageBuffer::Write(const std::vector<uint8_t> &data, uint32_t &offset)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    auto capacity = static_cast<uint32_t>(capacity_);
+    if (data.empty() || data.size() > capacity) {
+        IMSA_HILOGE("invalid size: %{public}zu, capacity: %{public}u.", data.size(), capacity);
+        return false;
+    }
+    auto size = static_cast<uint32_t>(data.size());
+    // messages never wrap around, start over from the head when the tail is too short
+    if (size > capacity - writePos_) {
+        writePos_ = 0;
+    }
+    if (!ashmem_->WriteToAshmem(data.data(), static_cast<int32_t>(size), static_cast<int32_t>(writePos_))) {
+        IMSA_HILOGE("failed to write ashmem, size: %{public}u, offset: %{public}u.", size, writePos_);
+        return false;
+    }
+    offset = writePos_;
+    writePos_ += size;
+    return true;
+}
+
+bool SharedMessageBuffer::Read(uint32_t offset, uint32_t length, std::vector<uint8_t> &data)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    auto capacity = static_cast<uint32_t>(capacity_);
+    if (length == 0 || offset > capacity || length > capacity - offset) {
+        IMSA_HILOGE("invalid region: %{public}u/%{public}u, capacity: %{public}u.", offset, length, capacity);
+        return false;
+    }
+    auto buffer = static_cast<const uint8_t *>(
+        ashmem_->ReadFromAshmem(static_cast<int32_t>(length), static_cast<int32_t>(offset)));
+    if (buffer == nullptr) {
+        IMSA_HILOGE("failed to read ashmem.");
+        return false;
+    }
+    data.assign(buffer, buffer + length);
+    return true;
+}
+
+sptr<Ashmem> SharedMessageBuffer::GetAshmem() const
+{
+    return ashmem_;
+}
+
+int32_t SharedMessageBuffer::GetCapacity() const
+{
+    return capacity_;
+}
+} // namespace MiscServices
+} // namespace OHOS
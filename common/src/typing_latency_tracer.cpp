@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "typing_latency_tracer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstring>
+#include <sstream>
+#include <unistd.h>
+
+#include "global.h"
+#include "parameter.h"
+#include "parameters.h"
+
+namespace OHOS {
+namespace MiscServices {
+namespace {
+constexpr uint32_t PHASE_SHIFT = 16;
+constexpr uint32_t POINT_MASK = (1U << PHASE_SHIFT) - 1;
+constexpr int64_t NS_PER_US = 1000;
+constexpr uint64_t SLOT_BUSY = UINT64_MAX;
+constexpr const char *POINT_NAMES[] = { "IMC_DISPATCH_KEY", "IMSA_START_INPUT", "IMA_DISPATCH_KEY", "IMA_TASK",
+    "IMA_REQUEST", "IMA_RESPONSE" };
+static_assert(sizeof(POINT_NAMES) / sizeof(POINT_NAMES[0]) == static_cast<uint32_t>(TypingTracePoint::END));
+
+enum class FlowType : uint32_t {
+    START,
+    STEP,
+    FINISH,
+};
+
+struct Flow {
+    const char *category;
+    uint64_t id;
+    FlowType type;
+};
+
+int64_t GetMonotonicNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// the arrows drawn between the points: key -> ime -> text operation -> response
+std::vector<Flow> GetFlows(const TypingLatencyTracer::Record &record)
+{
+    if (record.phase == TypingTracePhase::END) {
+        return {};
+    }
+    switch (record.point) {
+        case TypingTracePoint::IMC_DISPATCH_KEY:
+            return { { "imf.key", record.id, FlowType::START } };
+        case TypingTracePoint::IMA_DISPATCH_KEY:
+            return { { "imf.key", record.id, FlowType::STEP } };
+        case TypingTracePoint::IMA_REQUEST:
+            if (record.linkId == 0) {
+                return { { "imf.msg", record.id, FlowType::START } };
+            }
+            return { { "imf.key", record.linkId, FlowType::STEP }, { "imf.msg", record.id, FlowType::START } };
+        case TypingTracePoint::IMA_RESPONSE:
+            return { { "imf.msg", record.id, FlowType::FINISH } };
+        default:
+            return {};
+    }
+}
+
+std::string ToTimestamp(int64_t timeNs)
+{
+    char buffer[32] = { 0 };
+    auto len = snprintf(buffer, sizeof(buffer), "%" PRId64 ".%03" PRId64, timeNs / NS_PER_US, timeNs % NS_PER_US);
+    return len > 0 ? std::string(buffer) : std::string("0");
+}
+
+void AppendEvent(std::string &out, const TypingLatencyTracer::Record &record, const std::string &pid)
+{
+    static constexpr const char *PHASES[] = { "B", "E", "i" };
+    auto common = std::string(",\"ts\":").append(ToTimestamp(record.timeNs)).append(",\"pid\":").append(pid)
+        .append(",\"tid\":").append(std::to_string(record.tid));
+    out.append("{\"name\":\"").append(POINT_NAMES[static_cast<uint32_t>(record.point)])
+        .append("\",\"cat\":\"imf\",\"ph\":\"").append(PHASES[static_cast<uint32_t>(record.phase)]).append("\"")
+        .append(common);
+    if (record.phase == TypingTracePhase::INSTANT) {
+        out.append(",\"s\":\"t\"");
+    }
+    out.append(",\"args\":{\"id\":").append(std::to_string(record.id)).append(",\"link\":")
+        .append(std::to_string(record.linkId)).append("}}");
+    static constexpr const char *FLOW_PHASES[] = { "s", "t", "f" };
+    for (const auto &flow : GetFlows(record)) {
+        out.append(",\n{\"name\":\"typing\",\"cat\":\"").append(flow.category).append("\",\"ph\":\"")
+            .append(FLOW_PHASES[static_cast<uint32_t>(flow.type)]).append("\",\"bp\":\"e\",\"id\":")
+            .append(std::to_string(flow.id)).append(common).append("}");
+    }
+}
+
+void AppendEvents(std::string &out, const std::vector<TypingLatencyTracer::Record> &records, int32_t pid)
+{
+    auto pidStr = std::to_string(pid);
+    for (const auto &record : records) {
+        out.append(out.size() == 1 ? "\n" : ",\n");
+        AppendEvent(out, record, pidStr);
+    }
+}
+
+// one record a line: seq timeNs id linkId point phase tid
+std::vector<TypingLatencyTracer::Record> Unpack(const std::string &ring)
+{
+    std::vector<TypingLatencyTracer::Record> records;
+    std::istringstream in(ring);
+    std::string line;
+    while (records.size() < TypingLatencyTracer::CAPACITY && std::getline(in, line)) {
+        TypingLatencyTracer::Record record;
+        uint32_t point = 0;
+        uint32_t phase = 0;
+        std::istringstream fields(line);
+        if (!(fields >> record.seq >> record.timeNs >> record.id >> record.linkId >> point >> phase >> record.tid) ||
+            point >= static_cast<uint32_t>(TypingTracePoint::END) ||
+            phase > static_cast<uint32_t>(TypingTracePhase::INSTANT)) {
+            IMSA_HILOGW("invalid typing trace record, skip.");
+            continue;
+        }
+        record.point = static_cast<TypingTracePoint>(point);
+        record.phase = static_cast<TypingTracePhase>(phase);
+        records.push_back(record);
+    }
+    return records;
+}
+} // namespace
+
+std::atomic<bool> TypingLatencyTracer::isEnabled_{ false };
+std::mutex TypingLatencyTracer::reporterLock_;
+TypingLatencyTracer::Reporter TypingLatencyTracer::reporter_ = nullptr;
+
+TypingLatencyTracer &TypingLatencyTracer::GetInstance()
+{
+    static TypingLatencyTracer tracer;
+    return tracer;
+}
+
+void TypingLatencyTracer::Init()
+{
+    static std::once_flag flag;
+    std::call_once(flag, []() {
+        SetEnabled(system::GetBoolParameter(ENABLE_PARAM_KEY, false));
+        auto ret = WatchParameter(ENABLE_PARAM_KEY, OnParamChange, nullptr);
+        IMSA_HILOGD("watch typing trace param ret: %{public}d.", ret);
+    });
+}
+
+void TypingLatencyTracer::SetEnabled(bool isEnabled)
+{
+    if (isEnabled_.exchange(isEnabled) != isEnabled) {
+        IMSA_HILOGI("typing trace enabled: %{public}d.", isEnabled);
+    }
+}
+
+void TypingLatencyTracer::OnParamChange(const char *key, const char *value, void *context)
+{
+    if (key == nullptr || value == nullptr || strcmp(key, ENABLE_PARAM_KEY) != 0) {
+        return;
+    }
+    bool isEnabled = strcmp(value, "true") == 0 || strcmp(value, "1") == 0;
+    SetEnabled(isEnabled);
+    if (isEnabled) {
+        // the rings reported for the last session are outdated
+        std::lock_guard<std::mutex> lock(GetInstance().remoteLock_);
+        GetInstance().remotes_.clear();
+        return;
+    }
+    Report();
+}
+
+void TypingLatencyTracer::SetReporter(Reporter reporter)
+{
+    std::lock_guard<std::mutex> lock(reporterLock_);
+    reporter_ = std::move(reporter);
+}
+
+void TypingLatencyTracer::Report()
+{
+    Reporter reporter = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(reporterLock_);
+        reporter = reporter_;
+    }
+    if (reporter == nullptr) {
+        return;
+    }
+    auto ring = GetInstance().Pack();
+    if (!ring.empty()) {
+        reporter(ring);
+    }
+}
+
+void TypingLatencyTracer::Trace(TypingTracePoint point, TypingTracePhase phase, uint64_t id, uint64_t linkId)
+{
+    if (point >= TypingTracePoint::END) {
+        return;
+    }
+    auto seq = head_.fetch_add(1, std::memory_order_relaxed) + 1;
+    auto &slot = slots_[seq % CAPACITY];
+    // a reader which sees another seq after reading the fields drops the slot, a writer a full ring ahead
+    // of a preempted one drops its point
+    auto old = slot.seq.load(std::memory_order_relaxed);
+    if (old == SLOT_BUSY || !slot.seq.compare_exchange_strong(old, SLOT_BUSY, std::memory_order_relaxed)) {
+        return;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.timeNs.store(GetMonotonicNs(), std::memory_order_relaxed);
+    slot.id.store(id, std::memory_order_relaxed);
+    slot.linkId.store(linkId, std::memory_order_relaxed);
+    slot.pointAndPhase.store(
+        static_cast<uint32_t>(point) | (static_cast<uint32_t>(phase) << PHASE_SHIFT), std::memory_order_relaxed);
+    slot.tid.store(gettid(), std::memory_order_relaxed);
+    slot.seq.store(seq, std::memory_order_release);
+}
+
+std::vector<TypingLatencyTracer::Record> TypingLatencyTracer::Snapshot() const
+{
+    std::vector<Record> records;
+    records.reserve(CAPACITY);
+    for (const auto &slot : slots_) {
+        auto seq = slot.seq.load(std::memory_order_acquire);
+        if (seq == 0 || seq == SLOT_BUSY) {
+            continue;
+        }
+        Record record;
+        record.seq = seq;
+        record.timeNs = slot.timeNs.load(std::memory_order_relaxed);
+        record.id = slot.id.load(std::memory_order_relaxed);
+        record.linkId = slot.linkId.load(std::memory_order_relaxed);
+        auto pointAndPhase = slot.pointAndPhase.load(std::memory_order_relaxed);
+        record.tid = slot.tid.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != seq) {
+            continue;
+        }
+        record.point = static_cast<TypingTracePoint>(pointAndPhase & POINT_MASK);
+        record.phase = static_cast<TypingTracePhase>(pointAndPhase >> PHASE_SHIFT);
+        records.push_back(record);
+    }
+    std::sort(records.begin(), records.end(), [](const Record &a, const Record &b) { return a.seq < b.seq; });
+    return records;
+}
+
+std::string TypingLatencyTracer::Pack() const
+{
+    std::string out;
+    for (const auto &record : Snapshot()) {
+        out.append(std::to_string(record.seq)).append(" ").append(std::to_string(record.timeNs)).append(" ")
+            .append(std::to_string(record.id)).append(" ").append(std::to_string(record.linkId)).append(" ")
+            .append(std::to_string(static_cast<uint32_t>(record.point))).append(" ")
+            .append(std::to_string(static_cast<uint32_t>(record.phase))).append(" ")
+            .append(std::to_string(record.tid)).append("\n");
+    }
+    return out;
+}
+
+void TypingLatencyTracer::AddRemote(int32_t pid, const std::string &ring)
+{
+    auto records = Unpack(ring);
+    IMSA_HILOGI("typing trace of %{public}d: %{public}zu records.", pid, records.size());
+    std::lock_guard<std::mutex> lock(remoteLock_);
+    auto iter = std::find_if(remotes_.begin(), remotes_.end(), [pid](const auto &remote) {
+        return remote.first == pid;
+    });
+    if (iter != remotes_.end()) {
+        remotes_.erase(iter);
+    }
+    if (remotes_.size() >= MAX_REMOTE_NUM) {
+        remotes_.pop_front();
+    }
+    remotes_.emplace_back(pid, std::move(records));
+}
+
+std::string TypingLatencyTracer::ExportChromeTrace() const
+{
+    std::string out("[");
+    AppendEvents(out, Snapshot(), getpid());
+    {
+        std::lock_guard<std::mutex> lock(remoteLock_);
+        for (const auto &[pid, records] : remotes_) {
+            AppendEvents(out, records, pid);
+        }
+    }
+    out.append("\n]\n");
+    return out;
+}
+
+void TypingLatencyTracer::Clear()
+{
+    {
+        std::lock_guard<std::mutex> lock(remoteLock_);
+        remotes_.clear();
+    }
+    for (auto &slot : slots_) {
+        auto seq = slot.seq.load(std::memory_order_relaxed);
+        if (seq != SLOT_BUSY) {
+            slot.seq.compare_exchange_strong(seq, 0, std::memory_order_relaxed);
+        }
+    }
+}
+
+void TypingLatencyTracer::SetLastKeyId(uint64_t keyId)
+{
+    lastKeyId_.store(keyId, std::memory_order_relaxed);
+}
+
+uint64_t TypingLatencyTracer::GetLastKeyId() const
+{
+    return lastKeyId_.load(std::memory_order_relaxed);
+}
+} // namespace MiscServices
+} // namespace OHOS
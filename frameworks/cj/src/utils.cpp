@@ -84,6 +84,7 @@ const std::map<int32_t, IMFErrorCode> Utils::ERROR_CODE_MAP = {
     { ErrorCode::ERROR_OPERATE_SYSTEM_IME, EXCEPTION_OPERATE_DEFAULTIME },
     { ErrorCode::ERROR_SWITCH_IME, EXCEPTION_IMMS },
     { ErrorCode::ERROR_IMA_DATA_CHANNEL_ABNORMAL, EXCEPTION_IMCLIENT },
+    { ErrorCode::ERROR_IMA_RESPONSE_TIMEOUT, EXCEPTION_IMCLIENT },
     { ErrorCode::ERROR_IMA_INVALID_IMMERSIVE_EFFECT, EXCEPTION_INVALID_IMMERSIVE_EFFECT },
     { ErrorCode::ERROR_IMA_PRECONDITION_REQUIRED, EXCEPTION_PRECONDITION_REQUIRED },
 };
@@ -0,0 +1,343 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_INPUTMETHOD_IMF_FRAMEWORKS_COMMON_SHARDED_CONCURRENT_MAP_H
+#define OHOS_INPUTMETHOD_IMF_FRAMEWORKS_COMMON_SHARDED_CONCURRENT_MAP_H
+#include <array>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+namespace OHOS {
+/*
+ * ConcurrentMap split into shards by the hash of the key, each shard has its own reader-writer lock.
+ * The api follows ConcurrentMap so that a registry can move over without touching its call sites, except:
+ * - the locks are not recursive, an action must not call back into the same map;
+ * - ForEach visits the entries shard by shard, the key order only holds inside a shard.
+ */
+template<typename _Key, typename _Tp, typename _Container = std::map<_Key, _Tp>, size_t _ShardNum = 16>
+class ShardedConcurrentMap {
+    static_assert(_ShardNum > 0, "at least one shard");
+
+public:
+    using map_type = _Container;
+    using key_type = typename _Container::key_type;
+    using mapped_type = typename _Container::mapped_type;
+    using value_type = typename _Container::value_type;
+    using size_type = typename _Container::size_type;
+
+    ShardedConcurrentMap() = default;
+    ~ShardedConcurrentMap() = default;
+
+    ShardedConcurrentMap(const ShardedConcurrentMap &other)
+    {
+        operator=(other);
+    }
+
+    ShardedConcurrentMap &operator=(const ShardedConcurrentMap &other) noexcept
+    {
+        if (this == &other) {
+            return *this;
+        }
+        for (size_t i = 0; i < _ShardNum; ++i) {
+            auto tmp = other.shards_[i].Clone();
+            std::unique_lock<std::shared_mutex> lock(shards_[i].mutex);
+            shards_[i].entries = std::move(tmp);
+        }
+        return *this;
+    }
+
+    ShardedConcurrentMap(ShardedConcurrentMap &&other) noexcept
+    {
+        operator=(std::move(other));
+    }
+
+    ShardedConcurrentMap &operator=(ShardedConcurrentMap &&other) noexcept
+    {
+        if (this == &other) {
+            return *this;
+        }
+        for (size_t i = 0; i < _ShardNum; ++i) {
+            auto tmp = other.shards_[i].Steal();
+            std::unique_lock<std::shared_mutex> lock(shards_[i].mutex);
+            shards_[i].entries = std::move(tmp);
+        }
+        return *this;
+    }
+
+    template<typename... _Args>
+    bool Emplace(const key_type &key, _Args &&...args) noexcept
+    {
+        auto &shard = GetShard(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        return shard.entries.try_emplace(key, std::forward<_Args>(args)...).second;
+    }
+
+    std::pair<bool, mapped_type> Find(const key_type &key) const noexcept
+    {
+        auto &shard = GetShard(key);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.entries.find(key);
+        if (it == shard.entries.end()) {
+            return std::pair{ false, mapped_type() };
+        }
+        return std::pair{ true, it->second };
+    }
+
+    // reads the value in place under the shared lock, no copy
+    bool FindShared(const key_type &key, const std::function<void(const key_type &, const mapped_type &)> &action) const
+    {
+        if (action == nullptr) {
+            return false;
+        }
+        auto &shard = GetShard(key);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.entries.find(key);
+        if (it == shard.entries.end()) {
+            return false;
+        }
+        action(it->first, it->second);
+        return true;
+    }
+
+    bool Contains(const key_type &key) const noexcept
+    {
+        auto &shard = GetShard(key);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        return shard.entries.find(key) != shard.entries.end();
+    }
+
+    template<typename _Obj>
+    bool InsertOrAssign(const key_type &key, _Obj &&obj) noexcept
+    {
+        auto &shard = GetShard(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        return shard.entries.insert_or_assign(key, std::forward<_Obj>(obj)).second;
+    }
+
+    bool Insert(const key_type &key, const mapped_type &value) noexcept
+    {
+        auto &shard = GetShard(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        return shard.entries.insert(value_type{ key, value }).second;
+    }
+
+    size_type Erase(const key_type &key) noexcept
+    {
+        auto &shard = GetShard(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        return shard.entries.erase(key);
+    }
+
+    void Clear() noexcept
+    {
+        for (auto &shard : shards_) {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            shard.entries.clear();
+        }
+    }
+
+    bool Empty() const noexcept
+    {
+        for (auto &shard : shards_) {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            if (!shard.entries.empty()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    size_type Size() const noexcept
+    {
+        size_type size = 0;
+        for (auto &shard : shards_) {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            size += shard.entries.size();
+        }
+        return size;
+    }
+
+    // The action`s return true means meeting the erase condition
+    // The action`s return false means not meeting the erase condition
+    size_type EraseIf(const std::function<bool(const key_type &key, mapped_type &value)> &action) noexcept
+    {
+        if (action == nullptr) {
+            return 0;
+        }
+        size_type count = 0;
+        for (auto &shard : shards_) {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            for (auto it = shard.entries.begin(); it != shard.entries.end();) {
+                if (action(it->first, it->second)) {
+                    it = shard.entries.erase(it);
+                    ++count;
+                } else {
+                    ++it;
+                }
+            }
+        }
+        return count;
+    }
+
+    // only the shard being visited is locked, the action's return true stops the traversal
+    void ForEach(const std::function<bool(const key_type &, mapped_type &)> &action)
+    {
+        if (action == nullptr) {
+            return;
+        }
+        for (auto &shard : shards_) {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            for (auto &[key, value] : shard.entries) {
+                if (action(key, value)) {
+                    return;
+                }
+            }
+        }
+    }
+
+    // read-only traversal, readers of the same shard run at the same time
+    void ForEachShared(const std::function<bool(const key_type &, const mapped_type &)> &action) const
+    {
+        if (action == nullptr) {
+            return;
+        }
+        for (auto &shard : shards_) {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            for (const auto &[key, value] : shard.entries) {
+                if (action(key, value)) {
+                    return;
+                }
+            }
+        }
+    }
+
+    void ForEachCopies(const std::function<bool(const key_type &, mapped_type &)> &action)
+    {
+        if (action == nullptr) {
+            return;
+        }
+        for (auto &shard : shards_) {
+            auto entries = shard.Clone();
+            for (auto &[key, value] : entries) {
+                if (action(key, value)) {
+                    return;
+                }
+            }
+        }
+    }
+
+    // The action's return value means that the element is keep in map or not; true means keeping, false means removing.
+    bool Compute(const key_type &key, const std::function<bool(const key_type &, mapped_type &)> &action)
+    {
+        if (action == nullptr) {
+            return false;
+        }
+        auto &shard = GetShard(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.entries.try_emplace(key).first;
+        if (!action(it->first, it->second)) {
+            shard.entries.erase(it);
+        }
+        return true;
+    }
+
+    // The action's return value means that the element is keep in map or not; true means keeping, false means removing.
+    bool ComputeIfPresent(const key_type &key, const std::function<bool(const key_type &, mapped_type &)> &action)
+    {
+        if (action == nullptr) {
+            return false;
+        }
+        auto &shard = GetShard(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.entries.find(key);
+        if (it == shard.entries.end()) {
+            return false;
+        }
+        if (!action(it->first, it->second)) {
+            shard.entries.erase(it);
+        }
+        return true;
+    }
+
+    bool ComputeIfAbsent(const key_type &key, const std::function<mapped_type(const key_type &)> &action)
+    {
+        if (action == nullptr) {
+            return false;
+        }
+        auto &shard = GetShard(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        if (shard.entries.find(key) != shard.entries.end()) {
+            return false;
+        }
+        shard.entries.emplace(key, action(key));
+        return true;
+    }
+
+    bool ComputeIfAbsent(const key_type &key, const std::function<bool(const key_type &, mapped_type &)> &action)
+    {
+        if (action == nullptr) {
+            return false;
+        }
+        auto &shard = GetShard(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto result = shard.entries.try_emplace(key);
+        if (!result.second) {
+            return false;
+        }
+        if (!action(result.first->first, result.first->second)) {
+            shard.entries.erase(result.first);
+            return false;
+        }
+        return true;
+    }
+
+private:
+    // a cache line each, so that the locks of two shards are not bounced together
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        _Container entries;
+
+        _Container Clone() const noexcept
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            return entries;
+        }
+
+        _Container Steal() noexcept
+        {
+            std::unique_lock<std::shared_mutex> lock(mutex);
+            return std::move(entries);
+        }
+    };
+
+    Shard &GetShard(const key_type &key) noexcept
+    {
+        return shards_[std::hash<key_type>{}(key) % _ShardNum];
+    }
+
+    const Shard &GetShard(const key_type &key) const noexcept
+    {
+        return shards_[std::hash<key_type>{}(key) % _ShardNum];
+    }
+
+    std::array<Shard, _ShardNum> shards_;
+};
+
+template<typename _Key, typename _Tp, size_t _ShardNum = 16>
+using ShardedConcurrentHashMap = ShardedConcurrentMap<_Key, _Tp, std::unordered_map<_Key, _Tp>, _ShardNum>;
+} // namespace OHOS
+#endif // OHOS_INPUTMETHOD_IMF_FRAMEWORKS_COMMON_SHARDED_CONCURRENT_MAP_H
@@ -238,10 +238,10 @@ napi_value JsTextInputClientEngine::GetTextInputClientInstance(napi_env env)
     return instance;
 }
 
-napi_value JsTextInputClientEngine::GetResult(napi_env env, std::string &text)
+napi_value JsTextInputClientEngine::GetResult(napi_env env, const std::u16string &text)
 {
     napi_value jsText = nullptr;
-    napi_create_string_utf8(env, text.c_str(), NAPI_AUTO_LENGTH, &jsText);
+    napi_create_string_utf16(env, text.c_str(), text.size(), &jsText);
     return jsText;
 }
 
@@ -550,7 +550,7 @@ napi_value JsTextInputClientEngine::GetForwardSync(napi_env env, napi_callback_i
         return JsUtil::Const::Null(env);
     }
     napi_value result = nullptr;
-    auto status = JsUtils::GetValue(env, Str16ToStr8(text), result);
+    auto status = JsUtils::GetValue(env, text, result);
     CHECK_RETURN(status == napi_ok, "GetValue failed", JsUtil::Const::Null(env));
     return result;
 }
@@ -619,7 +619,7 @@ napi_value JsTextInputClientEngine::GetBackwardSync(napi_env env, napi_callback_
         return JsUtil::Const::Null(env);
     }
     napi_value result = nullptr;
-    auto status = JsUtils::GetValue(env, Str16ToStr8(text), result);
+    auto status = JsUtils::GetValue(env, text, result);
     CHECK_RETURN(status == napi_ok, "GetValue failed", JsUtil::Const::Null(env));
     return result;
 }
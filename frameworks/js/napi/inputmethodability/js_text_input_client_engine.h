@@ -180,7 +180,7 @@ struct InsertTextContext : public AsyncCall::Context {
 
 struct GetForwardContext : public AsyncCall::Context {
     int32_t length = 0;
-    std::string text;
+    std::u16string text;
     napi_status status = napi_generic_failure;
     GetForwardContext() : Context(nullptr, nullptr){};
     GetForwardContext(InputAction input, OutputAction output) : Context(std::move(input), std::move(output)){};
@@ -202,7 +202,7 @@ struct GetForwardContext : public AsyncCall::Context {
 
 struct GetBackwardContext : public AsyncCall::Context {
     int32_t length = 0;
-    std::string text;
+    std::u16string text;
     napi_status status = napi_generic_failure;
     GetBackwardContext() : Context(nullptr, nullptr){};
     GetBackwardContext(InputAction input, OutputAction output) : Context(std::move(input), std::move(output)){};
@@ -430,7 +430,7 @@ private:
     static napi_value JsConstructor(napi_env env, napi_callback_info info);
     static std::shared_ptr<JsTextInputClientEngine> GetTextInputClientEngine();
     static bool InitTextInputClientEngine();
-    static napi_value GetResult(napi_env env, std::string &text);
+    static napi_value GetResult(napi_env env, const std::u16string &text);
     static napi_value GetResultEditorAttribute(napi_env env,
         std::shared_ptr<GetEditorAttributeContext> getEditorAttribute);
     static napi_value HandleParamCheckFailure(napi_env env);
@@ -92,6 +92,7 @@ const std::map<int32_t, int32_t> JsUtils::ERROR_CODE_MAP = {
     { ErrorCode::ERROR_OPERATE_SYSTEM_IME, EXCEPTION_OPERATE_DEFAULTIME },
     { ErrorCode::ERROR_SWITCH_IME, EXCEPTION_IMMS },
     { ErrorCode::ERROR_IMA_DATA_CHANNEL_ABNORMAL, EXCEPTION_IMCLIENT },
+    { ErrorCode::ERROR_IMA_RESPONSE_TIMEOUT, EXCEPTION_IMCLIENT },
     { ErrorCode::ERROR_IMA_INVALID_IMMERSIVE_EFFECT, EXCEPTION_INVALID_IMMERSIVE_EFFECT },
     { ErrorCode::ERROR_IMA_PRECONDITION_REQUIRED, EXCEPTION_PRECONDITION_REQUIRED },
     { ErrorCode::ERROR_INVALID_DISPLAYID, EXCEPTION_INVALID_DISPLAYID },
@@ -464,6 +465,11 @@ napi_status JsUtils::GetValue(napi_env env, const std::string &in, napi_value &o
     return napi_create_string_utf8(env, in.c_str(), in.size(), &out);
 }
 
+napi_status JsUtils::GetValue(napi_env env, const std::u16string &in, napi_value &out)
+{
+    return napi_create_string_utf16(env, in.c_str(), in.size(), &out);
+}
+
 napi_value JsUtils::GetJsPrivateCommand(napi_env env, const std::unordered_map<std::string, PrivateDataValue> &in)
 {
     napi_value jsPrivateCommand = nullptr;
@@ -15,12 +15,13 @@
 
 #ifndef FRAMEWORKS_INPUTMETHOD_CONTROLLER_INCLUDE_INPUT_DATA_CHANNEL_PROXY_WRAP_H
 #define FRAMEWORKS_INPUTMETHOD_CONTROLLER_INCLUDE_INPUT_DATA_CHANNEL_PROXY_WRAP_H
+#include <array>
 #include <atomic>
 #include <condition_variable>
-#include <map>
 #include <memory>
 #include <mutex>
 #include <variant>
+#include <vector>
 
 #include "block_data.h"
 #include "input_data_channel_proxy.h"
@@ -38,43 +39,95 @@ struct ResponseInfo {
 };
 struct ResponseHandler {
     static constexpr uint32_t SYNC_REPLY_TIMEOUT = 3000; // unit ms
+    static constexpr uint32_t NO_TIMEOUT = 0;
     int32_t eventCode = 0;
+    // event codes of the operations sent in one batch, each one is reported on its own
+    std::vector<int32_t> batchEventCodes;
     uint64_t msgId = 0;
     int64_t reportStartTime =
         duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
     AsyncIpcCallBack asyncCallback = nullptr;
     std::shared_ptr<BlockData<ResponseInfo>> syncBlockData = nullptr;
-    ResponseHandler(uint64_t msgId, bool isSync, const AsyncIpcCallBack &callback, int32_t eventCode)
+    uint32_t timeoutMs = SYNC_REPLY_TIMEOUT;
+    ResponseHandler(uint64_t msgId, bool isSync, const AsyncIpcCallBack &callback, int32_t eventCode,
+        uint32_t timeoutMs = SYNC_REPLY_TIMEOUT)
     {
         this->msgId = msgId;
         asyncCallback = callback;
         this->eventCode = eventCode;
+        this->timeoutMs = timeoutMs;
         if (isSync) {
-            syncBlockData = std::make_shared<BlockData<ResponseInfo>>(SYNC_REPLY_TIMEOUT);
+            syncBlockData = std::make_shared<BlockData<ResponseInfo>>(timeoutMs);
         }
     }
 };
+/*
+ * Fixed capacity table of unanswered requests, the slot of a request is its msgId modulo capacity.
+ * The owner of a slot is the msgId which claimed it, it also works as generation of the slot,
+ * so the response of an evicted or timed out request never matches the current owner.
+ * Insert and take are lock-free, a slot is only busy while its handler is moved in or out.
+ */
+class ResponseSlotTable {
+public:
+    static constexpr uint32_t CAPACITY = 1024;
+    static constexpr uint64_t SLOT_FREE = 0;
+    static constexpr uint64_t SLOT_BUSY = UINT64_MAX;
+    // evicted is set to the unanswered handler which occupied the slot before, if any
+    void Insert(const std::shared_ptr<ResponseHandler> &handler, std::shared_ptr<ResponseHandler> &evicted);
+    std::shared_ptr<ResponseHandler> Take(uint64_t msgId);
+    std::vector<std::shared_ptr<ResponseHandler>> TakeAll();
+    bool Contains(uint64_t msgId) const;
+    size_t Size() const;
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> owner{ SLOT_FREE };
+        std::shared_ptr<ResponseHandler> handler = nullptr;
+    };
+    static std::shared_ptr<ResponseHandler> TakeSlot(Slot &slot, uint64_t msgId);
+    std::array<Slot, CAPACITY> slots_;
+};
 class InputDataChannelProxyWrap {
 public:
     InputDataChannelProxyWrap(
         const std::shared_ptr<InputDataChannelProxy> &channel, const sptr<IRemoteObject> &agentObject);
     ~InputDataChannelProxyWrap();
 
-    int32_t InsertText(const std::string &text, const AsyncIpcCallBack &callback = nullptr);
-    int32_t DeleteForward(int32_t length, const AsyncIpcCallBack &callback = nullptr);
-    int32_t DeleteBackward(int32_t length, const AsyncIpcCallBack &callback = nullptr);
-    int32_t GetTextBeforeCursor(int32_t number, std::string &text, const AsyncIpcCallBack &callback = nullptr);
-    int32_t GetTextAfterCursor(int32_t number, std::string &text, const AsyncIpcCallBack &callback = nullptr);
-    int32_t SendFunctionKey(int32_t funcKey, const AsyncIpcCallBack &callback = nullptr);
-    int32_t MoveCursor(int32_t keyCode, const AsyncIpcCallBack &callback = nullptr);
-    int32_t SelectByRange(int32_t start, int32_t end, const AsyncIpcCallBack &callback = nullptr);
-    int32_t SelectByMovement(int32_t direction, int32_t cursorMoveSkip, const AsyncIpcCallBack &callback = nullptr);
-    int32_t HandleExtendAction(int32_t action, const AsyncIpcCallBack &callback = nullptr);
-    int32_t GetTextIndexAtCursor(int32_t &index, const AsyncIpcCallBack &callback = nullptr);
-    int32_t SetPreviewText(
-        const std::string &text, const RangeInner &range, const AsyncIpcCallBack &callback = nullptr);
-    int32_t FinishTextPreview(const AsyncIpcCallBack &callback = nullptr);
-    int32_t ClearRspHandlers();
+    int32_t InsertText(const std::string &text, const AsyncIpcCallBack &callback = nullptr,
+        uint32_t timeoutMs = ResponseHandler::SYNC_REPLY_TIMEOUT);
+    int32_t DeleteForward(int32_t length, const AsyncIpcCallBack &callback = nullptr,
+        uint32_t timeoutMs = ResponseHandler::SYNC_REPLY_TIMEOUT);
+    int32_t DeleteBackward(int32_t length, const AsyncIpcCallBack &callback = nullptr,
+        uint32_t timeoutMs = ResponseHandler::SYNC_REPLY_TIMEOUT);
+    int32_t GetTextBeforeCursor(int32_t number, std::u16string &text, const AsyncIpcCallBack &callback = nullptr,
+        uint32_t timeoutMs = ResponseHandler::SYNC_REPLY_TIMEOUT);
+    int32_t GetTextAfterCursor(int32_t number, std::u16string &text, const AsyncIpcCallBack &callback = nullptr,
+        uint32_t timeoutMs = ResponseHandler::SYNC_REPLY_TIMEOUT);
+    // legacy utf-8 variants, the text still goes through the ipc as utf-16
+    int32_t GetTextBeforeCursor(int32_t number, std::string &text, const AsyncIpcCallBack &callback = nullptr,
+        uint32_t timeoutMs = ResponseHandler::SYNC_REPLY_TIMEOUT);
+    int32_t GetTextAfterCursor(int32_t number, std::string &text, const AsyncIpcCallBack &callback = nullptr,
+        uint32_t timeoutMs = ResponseHandler::SYNC_REPLY_TIMEOUT);
+    int32_t SendFunctionKey(int32_t funcKey, const AsyncIpcCallBack &callback = nullptr,
+        uint32_t timeoutMs = ResponseHandler::SYNC_REPLY_TIMEOUT);
+    int32_t MoveCursor(int32_t keyCode, const AsyncIpcCallBack &callback = nullptr,
+        uint32_t timeoutMs = ResponseHandler::SYNC_REPLY_TIMEOUT);
+    int32_t SelectByRange(int32_t start, int32_t end, const AsyncIpcCallBack &callback = nullptr,
+        uint32_t timeoutMs = ResponseHandler::SYNC_REPLY_TIMEOUT);
+    int32_t SelectByMovement(int32_t direction, int32_t cursorMoveSkip, const AsyncIpcCallBack &callback = nullptr,
+        uint32_t timeoutMs = ResponseHandler::SYNC_REPLY_TIMEOUT);
+    int32_t HandleExtendAction(int32_t action, const AsyncIpcCallBack &callback = nullptr,
+        uint32_t timeoutMs = ResponseHandler::SYNC_REPLY_TIMEOUT);
+    int32_t GetTextIndexAtCursor(int32_t &index, const AsyncIpcCallBack &callback = nullptr,
+        uint32_t timeoutMs = ResponseHandler::SYNC_REPLY_TIMEOUT);
+    int32_t SetPreviewText(const std::string &text, const RangeInner &range, const AsyncIpcCallBack &callback = nullptr,
+        uint32_t timeoutMs = ResponseHandler::SYNC_REPLY_TIMEOUT);
+    int32_t FinishTextPreview(const AsyncIpcCallBack &callback = nullptr,
+        uint32_t timeoutMs = ResponseHandler::SYNC_REPLY_TIMEOUT);
+    int32_t CommitEditBatch(const EditBatchInner &batch, const AsyncIpcCallBack &callback = nullptr,
+        uint32_t timeoutMs = ResponseHandler::SYNC_REPLY_TIMEOUT);
+    int32_t RequestTextSync();
+    int32_t CancelAllPending();
 
 public:
     int32_t HandleResponse(uint64_t msgId, const ResponseInfo &rspInfo);
@@ -82,18 +135,23 @@ public:
 
 private:
     void ReportBaseTextOperation(int32_t eventCode, int32_t errCode, int64_t consumeTime);
-    std::shared_ptr<ResponseHandler> AddRspHandler(const AsyncIpcCallBack &callback, bool isSync, int32_t eventCode);
+    void ReportBaseTextOperation(const std::shared_ptr<ResponseHandler> &handler, int32_t errCode, int64_t consumeTime);
+    static std::vector<int32_t> GetBatchEventCodes(const EditBatchInner &batch);
+    static AsyncIpcCallBack ToUtf8Callback(const AsyncIpcCallBack &callback);
+    std::shared_ptr<ResponseHandler> AddRspHandler(const AsyncIpcCallBack &callback, bool isSync, int32_t eventCode,
+        uint32_t timeoutMs = ResponseHandler::SYNC_REPLY_TIMEOUT);
     int32_t WaitResponse(const std::shared_ptr<ResponseHandler> &rspHandler, const SyncOutput &output);
     int32_t DeleteRspHandler(uint64_t msgId);
     uint64_t GenerateMsgId();
     int32_t Request(const AsyncIpcCallBack &callback, const ChannelWork &work, bool isSync,
-        int32_t eventCode, const SyncOutput &output = nullptr);
+        int32_t eventCode, uint32_t timeoutMs, const SyncOutput &output = nullptr,
+        const std::vector<int32_t> &batchEventCodes = {});
     int32_t HandleMsg(uint64_t msgId, const ResponseInfo &rspInfo);
+    static void NotifyHandler(const std::shared_ptr<ResponseHandler> &handler, const ResponseInfo &rspInfo);
 
 private:
-    uint64_t msgId_{ 0 };
-    std::mutex rspMutex_;
-    std::map<uint64_t, std::shared_ptr<ResponseHandler>> rspHandlers_;
+    std::atomic<uint64_t> msgId_{ 0 };
+    ResponseSlotTable rspHandlers_;
     std::mutex channelMutex_;
     std::shared_ptr<InputDataChannelProxy> channel_ = nullptr;
     sptr<IRemoteObject> agentObject_ = nullptr;
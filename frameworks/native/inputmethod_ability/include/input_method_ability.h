@@ -43,9 +43,11 @@
 #include "inputmethod_message_handler.h"
 #include "input_data_channel_proxy_wrap.h"
 #include "ime_mirror_manager.h"
+#include "text_mirror.h"
 
 namespace OHOS {
 namespace MiscServices {
+class SharedMessageBuffer;
 class InputMethodAbility : public RefBase, public PrivateCommandInterface {
 public:
     static InputMethodAbility &GetInstance();
@@ -108,6 +110,8 @@ public:
     void OnSetInputType(InputType inputType);
     int32_t SendMessage(const ArrayBuffer &arrayBuffer);
     int32_t RecvMessage(const ArrayBuffer &arrayBuffer);
+    int32_t SetRecvMessageBuffer(const sptr<Ashmem> &ashmem);
+    int32_t RecvSharedMessage(const SharedMessageInner &msg);
     int32_t RegisterMsgHandler(const std::shared_ptr<MsgHandlerCallbackInterface> &msgHandler = nullptr);
     int32_t OnCallingDisplayIdChanged(uint64_t displayId);
     int32_t OnSendPrivateData(const std::unordered_map<std::string, PrivateDataValue> &privateCommand);
@@ -117,6 +121,11 @@ public:
     AttachOptions GetAttachOptions();
     int32_t HandleKeyEventResult(uint64_t cbId, bool consumeResult, const sptr<IRemoteObject> &channelObject);
     void RemoveDeathRecipient();
+    /* InsertText, DeleteForward, DeleteBackward, MoveCursor and SelectByRange called between BeginEdit and
+       CommitEdit are cached and sent to the editor in one ipc, the editor applies them in order at once */
+    int32_t BeginEdit();
+    int32_t CommitEdit(const AsyncIpcCallBack &callback = nullptr);
+    int32_t AbortEdit();
 
 public:
     /* called from TaskManager worker thread */
@@ -131,6 +140,8 @@ public:
     void OnSetSubtype(SubProperty subProperty);
     void OnCursorUpdate(int32_t positionX, int32_t positionY, int32_t height);
     void OnSelectionChange(std::u16string text, int32_t oldBegin, int32_t oldEnd, int32_t newBegin, int32_t newEndg);
+    void OnTextDeltaChange(
+        const TextDeltaInner &delta, int32_t oldBegin, int32_t oldEnd, int32_t newBegin, int32_t newEnd);
     void OnAttributeChange(InputAttribute attribute);
     void OnFunctionKey(int32_t funcKey);
 
@@ -167,6 +178,8 @@ private:
     void SetInputDataChannel(const sptr<IRemoteObject> &object);
     std::shared_ptr<InputDataChannelProxyWrap> GetInputDataChannelProxyWrap();
     std::shared_ptr<InputDataChannelProxy> GetInputDataChannelProxy();
+    bool WriteSharedMessage(
+        const std::shared_ptr<InputDataChannelProxy> &channel, const ArrayBuffer &arrayBuffer, SharedMessageInner &msg);
     void ClearDataChannel(const sptr<IRemoteObject> &channel);
     void SetInputControlChannel(sptr<IRemoteObject> &object);
     void ClearInputControlChannel();
@@ -201,6 +214,8 @@ private:
     void ClearBindClientInfo();
     void ReportImeStartInput(int32_t eventCode, int32_t errCode, bool isShowKeyboard, int64_t consumeTime = -1);
     void ClearBindInfo(const sptr<IRemoteObject> &channel);
+    bool AddToEditBatch(const EditOperation &operation, const AsyncIpcCallBack &callback, int32_t &ret);
+    static void NotifyEditBatchCallbacks(const std::vector<AsyncIpcCallBack> &callbacks, int32_t code);
 
     ConcurrentMap<PanelType, std::shared_ptr<InputMethodPanel>> panels_ {};
     std::atomic_bool isBound_ { false };
@@ -240,6 +255,21 @@ private:
     bool isInputStartNotified_ = false;
     ImeMirrorManager imeMirrorMgr_;
 
+    struct EditBatch {
+        bool isEditing = false;
+        std::vector<EditOperation> operations;
+        std::vector<AsyncIpcCallBack> callbacks;
+    };
+    std::mutex editBatchLock_;
+    EditBatch editBatch_;
+    TextMirror textMirror_;
+
+    std::mutex sendMsgBufferLock_;
+    std::shared_ptr<SharedMessageBuffer> sendMsgBuffer_ = nullptr;
+    std::weak_ptr<InputDataChannelProxy> msgBufferPeer_;
+    std::mutex recvMsgBufferLock_;
+    std::shared_ptr<SharedMessageBuffer> recvMsgBuffer_ = nullptr;
+
     bool IsDisplayChanged(uint64_t oldDisplayId, uint64_t newDisplayId);
 };
 } // namespace MiscServices
@@ -31,6 +31,8 @@ public:
     ~InputMethodAgentServiceImpl();
     ErrCode DispatchKeyEvent(
         const MiscServices::KeyEventValue &keyEvent, uint64_t cbId, const sptr<IRemoteObject> &channelObject) override;
+    ErrCode DispatchKeyEventAsync(
+        const MiscServices::KeyEventValue &keyEvent, uint64_t cbId, const sptr<IRemoteObject> &channelObject) override;
     ErrCode OnCursorUpdate(int32_t positionX, int32_t positionY, int height) override;
     ErrCode OnSelectionChange(
         const std::string& text, int32_t oldBegin, int32_t oldEnd, int32_t newBegin, int32_t newEnd) override;
@@ -38,9 +40,14 @@ public:
     ErrCode OnAttributeChange(const InputAttributeInner &attributeInner) override;
     ErrCode SendPrivateCommand(const Value &value) override;
     ErrCode SendMessage(const ArrayBuffer &arraybuffer) override;
+    ErrCode SetMessageBuffer(const SharedMessageBufferInner &buffer) override;
+    ErrCode SendSharedMessage(const SharedMessageInner &msg) override;
     ErrCode DiscardTypingText() override;
     ErrCode ResponseDataChannel(uint64_t msgId, int code, const ResponseDataInner &msg) override;
+    ErrCode ResponseDataChannelAsync(uint64_t msgId, int code, const ResponseDataInner &msg) override;
     ErrCode OnFunctionKey(int32_t funcKey) override;
+    ErrCode OnTextDeltaChange(
+        const TextDeltaInner &delta, int32_t oldBegin, int32_t oldEnd, int32_t newBegin, int32_t newEnd) override;
 };
 }  // namespace MiscServices
 }  // namespace OHOS
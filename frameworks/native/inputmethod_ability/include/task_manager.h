@@ -15,8 +15,11 @@
 #ifndef FRAMEWORKS_INPUTMETHOD_ABILITY_INCLUDE_TASK_MANAGER_H
 #define FRAMEWORKS_INPUTMETHOD_ABILITY_INCLUDE_TASK_MANAGER_H
 
+#include <atomic>
 #include <list>
+#include <map>
 #include <memory>
+#include <mutex>
 
 #include "actions/action.h"
 #include "event_handler.h"
@@ -28,6 +31,21 @@ namespace MiscServices {
 using task_ptr_t = std::shared_ptr<Task>;
 using action_ptr_t = std::unique_ptr<Action>;
 
+struct TaskStats {
+    uint64_t executedNum { 0 };
+    uint64_t coalescedNum { 0 };
+    uint64_t expiredNum { 0 };
+    int64_t totalWaitUs { 0 }; // from queued to started
+    int64_t maxWaitUs { 0 };
+    int64_t totalExecUs { 0 }; // from started to completed, paused time included
+    int64_t maxExecUs { 0 };
+};
+
+enum class SchedulePolicy : uint32_t {
+    FIFO = 0,  // the imsa tasks run in arrival order
+    PRIORITY,  // by TaskPriority, the supersedable tasks are coalesced and the expired ones dropped
+};
+
 class TaskManager final {
 private:
     TaskManager();
@@ -58,6 +76,9 @@ public:
     // Wait for task and execute
     int32_t WaitExec(uint64_t seqId, uint32_t timeoutMs, std::function<void()>);
 
+    void SetSchedulePolicy(SchedulePolicy policy);
+    std::map<TaskType, TaskStats> GetTaskStats();
+
 private:
     friend class InputMethodAbility;
     friend class TaskAmsInit;
@@ -65,12 +86,18 @@ private:
 
 private:
     void OnNewTask(task_ptr_t task); // Accept a new task
+    void Enqueue(task_ptr_t task);   // Put a new task into the queue of its source
+    void EnqueueImsaTask(task_ptr_t task);
+    void DrainInbox();               // Move the tasks posted by other threads into the queues
     void Process();                  // Process next task
     void ProcessNextInnerTask();     // Process next inner task
     void ProcessNextAmsTask();       // Process next AMS task
     void ProcessNextImaTask();       // process next IMA task
     void ProcessNextImsaTask();      // process next IMSA task
     void ExecuteCurrentTask();       // Execute current task
+    void FinishCurrentTask();        // Reset current task and count it as completed
+    void CountTask(TaskType type, const std::function<void(TaskStats &)> &counter);
+    static int64_t GetNowUs();
 
     void Reset();
 
@@ -83,6 +110,14 @@ private:
     std::list<task_ptr_t> imaTasks_;
     std::list<task_ptr_t> imsaTasks_;
     std::list<task_ptr_t> innerTasks_;
+
+    std::mutex inboxLock_;
+    std::list<task_ptr_t> inbox_;
+    std::atomic<SchedulePolicy> policy_ { SchedulePolicy::PRIORITY };
+    int64_t curTaskStartUs_ { 0 };
+
+    std::mutex statsLock_;
+    std::map<TaskType, TaskStats> stats_;
 };
 } // namespace MiscServices
 } // namespace OHOS
@@ -69,6 +69,13 @@ enum TaskType : uint32_t {
     TASK_TYPE_RESUME,
 };
 
+// a HIGH task overtakes the queued LOW ones, the NORMAL tasks change the input state and are never overtaken
+enum TaskPriority : uint32_t {
+    TASK_PRIORITY_HIGH = 0,
+    TASK_PRIORITY_NORMAL,
+    TASK_PRIORITY_LOW,
+};
+
 class Task {
 public:
     explicit Task(TaskType t);
@@ -85,6 +92,16 @@ public:
 
     TaskType GetType() const;
     SourceType GetSourceType() const;
+    TaskPriority GetPriority() const;
+    // a queued task superseded by a newer one is dropped, only the latest one runs
+    bool IsSupersededBy(const Task &task) const;
+    // called on the newer task with the oldest queued task it supersedes, to keep what the ime has not seen yet
+    virtual void TakeOver(const Task &task) { }
+    // the task is dropped if it has not started within timeoutMs after being queued
+    void SetDeadline(uint32_t timeoutMs);
+    bool IsExpired(int64_t nowUs) const;
+    void MarkQueued(int64_t nowUs);
+    int64_t GetQueuedTime() const;
     uint64_t GetSeqId() const;
     RunningState GetState() const;
     bool IsRunning() const;
@@ -99,6 +116,9 @@ protected:
     const TaskType type_;
     RunningState state_ { RUNNING_STATE_IDLE };
     const uint64_t seqId_;
+    bool isSupersedable_ { false };
+    uint32_t timeoutMs_ { 0 };
+    int64_t queuedUs_ { 0 };
     std::unique_ptr<Action> curAction_ { nullptr };
     std::list<std::unique_ptr<Action>> actions_;
     std::list<std::unique_ptr<Action>> pendingActions_;
@@ -103,6 +103,7 @@ class TaskImsaOnCursorUpdate : public Task {
 public:
     TaskImsaOnCursorUpdate(int32_t x, int32_t y, int32_t h) : Task(TASK_TYPE_IMSA_CURSOR_UPDATE)
     {
+        isSupersedable_ = true;
         auto func = [x, y, h]() {
             InputMethodAbility::GetInstance().OnCursorUpdate(x, y, h);
         };
@@ -139,14 +140,48 @@ public:
 class TaskImsaOnSelectionChange : public Task {
 public:
     TaskImsaOnSelectionChange(std::u16string text, int32_t oldBegin, int32_t oldEnd, int32_t newBegin, int32_t newEnd)
-        : Task(TASK_TYPE_IMSA_SELECTION_CHANGE)
+        : Task(TASK_TYPE_IMSA_SELECTION_CHANGE), text_(std::move(text)), oldBegin_(oldBegin), oldEnd_(oldEnd),
+          newBegin_(newBegin), newEnd_(newEnd)
     {
-        auto func = [text, oldBegin, oldEnd, newBegin, newEnd]() {
-            InputMethodAbility::GetInstance().OnSelectionChange(text, oldBegin, oldEnd, newBegin, newEnd);
+        isSupersedable_ = true;
+        auto func = [this]() {
+            InputMethodAbility::GetInstance().OnSelectionChange(text_, oldBegin_, oldEnd_, newBegin_, newEnd_);
         };
         actions_.emplace_back(std::make_unique<Action>(func));
     }
     ~TaskImsaOnSelectionChange() = default;
+
+    // the ime never saw the range of a dropped change, so the change starts from where the dropped one started
+    void TakeOver(const Task &task) override
+    {
+        auto older = dynamic_cast<const TaskImsaOnSelectionChange *>(&task);
+        if (older == nullptr) {
+            return;
+        }
+        oldBegin_ = older->oldBegin_;
+        oldEnd_ = older->oldEnd_;
+    }
+
+private:
+    std::u16string text_;
+    int32_t oldBegin_ { 0 };
+    int32_t oldEnd_ { 0 };
+    int32_t newBegin_ { 0 };
+    int32_t newEnd_ { 0 };
+};
+
+class TaskImsaOnTextDeltaChange : public Task {
+public:
+    TaskImsaOnTextDeltaChange(
+        const TextDeltaInner &delta, int32_t oldBegin, int32_t oldEnd, int32_t newBegin, int32_t newEnd)
+        : Task(TASK_TYPE_IMSA_SELECTION_CHANGE)
+    {
+        auto func = [delta, oldBegin, oldEnd, newBegin, newEnd]() {
+            InputMethodAbility::GetInstance().OnTextDeltaChange(delta, oldBegin, oldEnd, newBegin, newEnd);
+        };
+        actions_.emplace_back(std::make_unique<Action>(func));
+    }
+    ~TaskImsaOnTextDeltaChange() = default;
 };
 
 class TaskImsaAttributeChange : public Task {
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FRAMEWORKS_INPUTMETHOD_ABILITY_INCLUDE_TEXT_MIRROR_H
+#define FRAMEWORKS_INPUTMETHOD_ABILITY_INCLUDE_TEXT_MIRROR_H
+
+#include <cinttypes>
+#include <mutex>
+#include <string>
+
+#include "global.h"
+#include "input_method_utils.h"
+
+namespace OHOS {
+namespace MiscServices {
+// copy of the editor text kept by ime, updated by the text deltas sent from the editor
+class TextMirror {
+public:
+    /* returns false if the delta does not apply to the current version, a full resync is needed then */
+    bool Apply(const TextDeltaInner &delta, std::u16string &text)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!delta.IsFullText() && delta.baseVersion != version_) {
+            IMSA_HILOGW("version mismatch, base: %{public}" PRIu64 ", current: %{public}" PRIu64 ".",
+                delta.baseVersion, version_);
+            return false;
+        }
+        if (!delta.ApplyTo(text_)) {
+            version_ = 0;
+            text_.clear();
+            return false;
+        }
+        version_ = delta.version;
+        text = text_;
+        return true;
+    }
+
+    void Reset()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        version_ = 0;
+        text_.clear();
+    }
+
+    uint64_t GetVersion()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return version_;
+    }
+
+    std::u16string GetText()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return text_;
+    }
+
+private:
+    std::mutex mutex_;
+    uint64_t version_ = 0;
+    std::u16string text_;
+};
+} // namespace MiscServices
+} // namespace OHOS
+#endif // FRAMEWORKS_INPUTMETHOD_ABILITY_INCLUDE_TEXT_MIRROR_H
@@ -15,26 +15,28 @@
 #include "input_data_channel_proxy_wrap.h"
 
 #include <cinttypes>
+#include <map>
 #include <string>
+#include <thread>
 
 #include "global.h"
 #include "input_method_tools.h"
 #include "string_ex.h"
+#include "typing_latency_tracer.h"
 #include "variant_util.h"
 #include "input_method_ability.h"
 #include "ima_hisysevent_reporter.h"
 
 namespace OHOS {
 namespace MiscServices {
-constexpr std::size_t MESSAGE_UNANSWERED_MAX_NUMBER = 1000;
 constexpr uint32_t BASE_TEXT_OPERATION_TIMEOUT = 200; // text operation timeout, unit ms
 InputDataChannelProxyWrap::InputDataChannelProxyWrap(
     const std::shared_ptr<InputDataChannelProxy> &channel, const sptr<IRemoteObject> &agentObject)
 {
     auto now = std::chrono::steady_clock::now();
     auto duration = now.time_since_epoch();
-    msgId_ = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(duration).count());
-    msgId_ = msgId_ ? msgId_ : ++msgId_;
+    auto msgId = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(duration).count());
+    msgId_.store(msgId ? msgId : 1);
     channel_ = channel;
     agentObject_ = agentObject;
 }
@@ -43,118 +45,153 @@ InputDataChannelProxyWrap::~InputDataChannelProxyWrap()
 {
 }
 
-int32_t InputDataChannelProxyWrap::InsertText(const std::string &text, const AsyncIpcCallBack &callback)
+int32_t InputDataChannelProxyWrap::InsertText(
+    const std::string &text, const AsyncIpcCallBack &callback, uint32_t timeoutMs)
 {
     auto work = [agentObject = agentObject_, text](
                     uint64_t msgId, const std::shared_ptr<InputDataChannelProxy> &channel) -> int32_t {
         return channel->InsertText(text, msgId, agentObject);
     };
     return Request(callback, work, callback == nullptr,
-        static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_INSERT_TEXT));
+        static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_INSERT_TEXT), timeoutMs);
 }
 
-int32_t InputDataChannelProxyWrap::DeleteForward(int32_t length, const AsyncIpcCallBack &callback)
+int32_t InputDataChannelProxyWrap::DeleteForward(int32_t length, const AsyncIpcCallBack &callback, uint32_t timeoutMs)
 {
     auto work = [agentObject = agentObject_, length](
                     uint64_t msgId, const std::shared_ptr<InputDataChannelProxy> &channel) -> int32_t {
         return channel->DeleteForward(length, msgId, agentObject);
     };
     return Request(callback, work, callback == nullptr,
-        static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_DELETE_FORWARD));
+        static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_DELETE_FORWARD), timeoutMs);
 }
 
-int32_t InputDataChannelProxyWrap::DeleteBackward(int32_t length, const AsyncIpcCallBack &callback)
+int32_t InputDataChannelProxyWrap::DeleteBackward(int32_t length, const AsyncIpcCallBack &callback, uint32_t timeoutMs)
 {
     auto work = [agentObject = agentObject_, length](
                     uint64_t msgId, const std::shared_ptr<InputDataChannelProxy> &channel) -> int32_t {
         return channel->DeleteBackward(length, msgId, agentObject);
     };
     return Request(callback, work, callback == nullptr,
-        static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_DELETE_BACKWARD));
+        static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_DELETE_BACKWARD), timeoutMs);
 }
 
 int32_t InputDataChannelProxyWrap::GetTextBeforeCursor(
-    int32_t number, std::string &text, const AsyncIpcCallBack &callback)
+    int32_t number, std::u16string &text, const AsyncIpcCallBack &callback, uint32_t timeoutMs)
 {
     auto work = [agentObject = agentObject_, number](
                     uint64_t msgId, const std::shared_ptr<InputDataChannelProxy> &channel) -> int32_t {
-        return channel->GetTextBeforeCursor(number, msgId, agentObject);
+        return channel->GetTextBeforeCursorU16(number, msgId, agentObject);
     };
     SyncOutput output = nullptr;
     if (callback == nullptr) {
         output = [&text](const ResponseData &data) -> void { VariantUtil::GetValue(data, text); };
     }
     return Request(callback, work, callback == nullptr,
-        static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_GET_TEXT_BEFORE_CURSOR), output);
+        static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_GET_TEXT_BEFORE_CURSOR_U16), timeoutMs, output);
 }
 
 int32_t InputDataChannelProxyWrap::GetTextAfterCursor(
-    int32_t number, std::string &text, const AsyncIpcCallBack &callback)
+    int32_t number, std::u16string &text, const AsyncIpcCallBack &callback, uint32_t timeoutMs)
 {
-    auto work = [agentObject = agentObject_, number, text](
+    auto work = [agentObject = agentObject_, number](
                     uint64_t msgId, const std::shared_ptr<InputDataChannelProxy> &channel) -> int32_t {
-        return channel->GetTextAfterCursor(number, msgId, agentObject);
+        return channel->GetTextAfterCursorU16(number, msgId, agentObject);
     };
     SyncOutput output = nullptr;
     if (callback == nullptr) {
         output = [&text](const ResponseData &data) -> void { VariantUtil::GetValue(data, text); };
     }
     return Request(callback, work, callback == nullptr,
-        static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_GET_TEXT_AFTER_CURSOR), output);
+        static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_GET_TEXT_AFTER_CURSOR_U16), timeoutMs, output);
+}
+
+int32_t InputDataChannelProxyWrap::GetTextBeforeCursor(
+    int32_t number, std::string &text, const AsyncIpcCallBack &callback, uint32_t timeoutMs)
+{
+    std::u16string textU16;
+    auto ret = GetTextBeforeCursor(number, textU16, ToUtf8Callback(callback), timeoutMs);
+    text = Str16ToStr8(textU16);
+    return ret;
+}
+
+int32_t InputDataChannelProxyWrap::GetTextAfterCursor(
+    int32_t number, std::string &text, const AsyncIpcCallBack &callback, uint32_t timeoutMs)
+{
+    std::u16string textU16;
+    auto ret = GetTextAfterCursor(number, textU16, ToUtf8Callback(callback), timeoutMs);
+    text = Str16ToStr8(textU16);
+    return ret;
+}
+
+AsyncIpcCallBack InputDataChannelProxyWrap::ToUtf8Callback(const AsyncIpcCallBack &callback)
+{
+    if (callback == nullptr) {
+        return nullptr;
+    }
+    return [callback](int32_t code, const ResponseData &data) {
+        std::u16string text;
+        VariantUtil::GetValue(data, text);
+        callback(code, Str16ToStr8(text));
+    };
 }
 
-int32_t InputDataChannelProxyWrap::SendFunctionKey(int32_t funcKey, const AsyncIpcCallBack &callback)
+int32_t InputDataChannelProxyWrap::SendFunctionKey(
+    int32_t funcKey, const AsyncIpcCallBack &callback, uint32_t timeoutMs)
 {
     auto work = [agentObject = agentObject_, funcKey](
                     uint64_t msgId, const std::shared_ptr<InputDataChannelProxy> &channel) -> int32_t {
         return channel->SendFunctionKey(funcKey, msgId, agentObject);
     };
     return Request(callback, work, callback == nullptr,
-        static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_SEND_FUNCTION_KEY));
+        static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_SEND_FUNCTION_KEY), timeoutMs);
 }
 
-int32_t InputDataChannelProxyWrap::MoveCursor(int32_t keyCode, const AsyncIpcCallBack &callback)
+int32_t InputDataChannelProxyWrap::MoveCursor(int32_t keyCode, const AsyncIpcCallBack &callback, uint32_t timeoutMs)
 {
     auto work = [agentObject = agentObject_, keyCode](
                     uint64_t msgId, const std::shared_ptr<InputDataChannelProxy> &channel) -> int32_t {
         return channel->MoveCursor(keyCode, msgId, agentObject);
     };
     return Request(callback, work, callback == nullptr,
-        static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_MOVE_CURSOR));
+        static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_MOVE_CURSOR), timeoutMs);
 }
 
-int32_t InputDataChannelProxyWrap::SelectByRange(int32_t start, int32_t end, const AsyncIpcCallBack &callback)
+int32_t InputDataChannelProxyWrap::SelectByRange(
+    int32_t start, int32_t end, const AsyncIpcCallBack &callback, uint32_t timeoutMs)
 {
     auto work = [agentObject = agentObject_, start, end](
                     uint64_t msgId, const std::shared_ptr<InputDataChannelProxy> &channel) -> int32_t {
         return channel->SelectByRange(start, end, msgId, agentObject);
     };
     return Request(callback, work, callback == nullptr,
-        static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_SELECT_BY_RANGE));
+        static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_SELECT_BY_RANGE), timeoutMs);
 }
 
 int32_t InputDataChannelProxyWrap::SelectByMovement(
-    int32_t direction, int32_t cursorMoveSkip, const AsyncIpcCallBack &callback)
+    int32_t direction, int32_t cursorMoveSkip, const AsyncIpcCallBack &callback, uint32_t timeoutMs)
 {
     auto work = [agentObject = agentObject_, direction, cursorMoveSkip](
                     uint64_t msgId, const std::shared_ptr<InputDataChannelProxy> &channel) -> int32_t {
         return channel->SelectByMovement(direction, cursorMoveSkip, msgId, agentObject);
     };
     return Request(callback, work, callback == nullptr,
-        static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_SELECT_BY_MOVEMENT));
+        static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_SELECT_BY_MOVEMENT), timeoutMs);
 }
 
-int32_t InputDataChannelProxyWrap::HandleExtendAction(int32_t action, const AsyncIpcCallBack &callback)
+int32_t InputDataChannelProxyWrap::HandleExtendAction(
+    int32_t action, const AsyncIpcCallBack &callback, uint32_t timeoutMs)
 {
     auto work = [agentObject = agentObject_, action](
                     uint64_t msgId, const std::shared_ptr<InputDataChannelProxy> &channel) -> int32_t {
         return channel->HandleExtendAction(action, msgId, agentObject);
     };
     return Request(callback, work, callback == nullptr,
-        static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_HANDLE_EXTEND_ACTION));
+        static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_HANDLE_EXTEND_ACTION), timeoutMs);
 }
 
-int32_t InputDataChannelProxyWrap::GetTextIndexAtCursor(int32_t &index, const AsyncIpcCallBack &callback)
+int32_t InputDataChannelProxyWrap::GetTextIndexAtCursor(
+    int32_t &index, const AsyncIpcCallBack &callback, uint32_t timeoutMs)
 {
     auto work = [agentObject = agentObject_](
                     uint64_t msgId, const std::shared_ptr<InputDataChannelProxy> &channel) -> int32_t {
@@ -165,32 +202,55 @@ int32_t InputDataChannelProxyWrap::GetTextIndexAtCursor(int32_t &index, const As
         output = [&index](const ResponseData &data) -> void { VariantUtil::GetValue(data, index); };
     }
     return Request(callback, work, callback == nullptr,
-        static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_GET_TEXT_INDEX_AT_CURSOR), output);
+        static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_GET_TEXT_INDEX_AT_CURSOR), timeoutMs, output);
 }
 
 int32_t InputDataChannelProxyWrap::SetPreviewText(
-    const std::string &text, const RangeInner &range, const AsyncIpcCallBack &callback)
+    const std::string &text, const RangeInner &range, const AsyncIpcCallBack &callback, uint32_t timeoutMs)
 {
     auto work = [agentObject = agentObject_, text, range](
                     uint64_t msgId, const std::shared_ptr<InputDataChannelProxy> &channel) -> int32_t {
         return channel->SetPreviewText(text, range, msgId, agentObject);
     };
     return Request(callback, work, callback == nullptr,
-        static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_SET_PREVIEW_TEXT));
+        static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_SET_PREVIEW_TEXT), timeoutMs);
 }
 
-int32_t InputDataChannelProxyWrap::FinishTextPreview(const AsyncIpcCallBack &callback)
+int32_t InputDataChannelProxyWrap::FinishTextPreview(const AsyncIpcCallBack &callback, uint32_t timeoutMs)
 {
     auto work = [agentObject = agentObject_](
                     uint64_t msgId, const std::shared_ptr<InputDataChannelProxy> &channel) -> int32_t {
         return channel->FinishTextPreview(msgId, agentObject);
     };
     return Request(callback, work, callback == nullptr,
-        static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_FINISH_TEXT_PREVIEW));
+        static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_FINISH_TEXT_PREVIEW), timeoutMs);
+}
+
+int32_t InputDataChannelProxyWrap::CommitEditBatch(
+    const EditBatchInner &batch, const AsyncIpcCallBack &callback, uint32_t timeoutMs)
+{
+    auto work = [agentObject = agentObject_, batch](
+                    uint64_t msgId, const std::shared_ptr<InputDataChannelProxy> &channel) -> int32_t {
+        return channel->CommitEditBatch(batch, msgId, agentObject);
+    };
+    return Request(callback, work, callback == nullptr,
+        static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_COMMIT_EDIT_BATCH), timeoutMs, nullptr,
+        GetBatchEventCodes(batch));
+}
+
+int32_t InputDataChannelProxyWrap::RequestTextSync()
+{
+    auto channel = GetDataChannel();
+    if (channel == nullptr) {
+        IMSA_HILOGE("data channel is nullptr!");
+        return ErrorCode::ERROR_IMA_CHANNEL_NULLPTR;
+    }
+    return channel->RequestTextSync(agentObject_);
 }
 
 int32_t InputDataChannelProxyWrap::Request(const AsyncIpcCallBack &callback, const ChannelWork &work,
-    bool isSync, int32_t eventCode, const SyncOutput &output)
+    bool isSync, int32_t eventCode, uint32_t timeoutMs, const SyncOutput &output,
+    const std::vector<int32_t> &batchEventCodes)
 {
     if (work == nullptr) {
         IMSA_HILOGE("work is nullptr. sync: %{public}d event code: %{public}d", isSync, eventCode);
@@ -201,11 +261,15 @@ int32_t InputDataChannelProxyWrap::Request(const AsyncIpcCallBack &callback, con
         IMSA_HILOGE("data channel is nullptr!");
         return ErrorCode::ERROR_IMA_CHANNEL_NULLPTR;
     }
-    auto handler = AddRspHandler(callback, isSync, eventCode);
+    auto handler = AddRspHandler(callback, isSync, eventCode, timeoutMs);
     if (handler == nullptr) {
         IMSA_HILOGE("add rsp handler failed. sync: %{public}d event code: %{public}d", isSync, eventCode);
         return ErrorCode::ERROR_IMA_DATA_CHANNEL_ABNORMAL;
     }
+    handler->batchEventCodes = batchEventCodes;
+    // a text operation is linked to the last key dispatched to the ime, it is most likely what caused it
+    TypingTraceScope traceScope(TypingTracePoint::IMA_REQUEST, handler->msgId,
+        TypingLatencyTracer::IsEnabled() ? TypingLatencyTracer::GetInstance().GetLastKeyId() : 0);
     auto ret = work(handler->msgId, channel);
     if (ret != ErrorCode::NO_ERROR) {
         IMSA_HILOGE("work error id: %{public}" PRIu64 " sync: %{public}d event code: %{public}d ret: %{public}d.",
@@ -229,84 +293,95 @@ std::shared_ptr<InputDataChannelProxy> InputDataChannelProxyWrap::GetDataChannel
 
 uint64_t InputDataChannelProxyWrap::GenerateMsgId()
 {
-    return ++msgId_ ? msgId_ : ++msgId_;
+    uint64_t msgId = ++msgId_;
+    while (msgId == ResponseSlotTable::SLOT_FREE || msgId == ResponseSlotTable::SLOT_BUSY) {
+        msgId = ++msgId_;
+    }
+    return msgId;
 }
 
 std::shared_ptr<ResponseHandler> InputDataChannelProxyWrap::AddRspHandler(const AsyncIpcCallBack &callback,
-    bool isSync, int32_t eventCode)
+    bool isSync, int32_t eventCode, uint32_t timeoutMs)
 {
-    std::lock_guard<std::mutex> lock(rspMutex_);
-    if (rspHandlers_.size() >= MESSAGE_UNANSWERED_MAX_NUMBER) {
-        auto it = rspHandlers_.begin();
+    auto msgId = GenerateMsgId();
+    auto handler = std::make_shared<ResponseHandler>(msgId, isSync, callback, eventCode, timeoutMs);
+    std::shared_ptr<ResponseHandler> evicted = nullptr;
+    rspHandlers_.Insert(handler, evicted);
+    if (evicted != nullptr) {
         IMSA_HILOGW("too many unanswered id: %{public}" PRIu64 " event code: %{public}d sync: %{public}d",
-            it->first, eventCode, isSync);
-        ResponseInfo rspInfo = { ErrorCode::ERROR_IMA_DATA_CHANNEL_ABNORMAL, std::monostate{} };
-        HandleMsg(it->first, rspInfo);
+            evicted->msgId, eventCode, isSync);
+        NotifyHandler(evicted, { ErrorCode::ERROR_IMA_DATA_CHANNEL_ABNORMAL, std::monostate{} });
     }
-    auto msgId = GenerateMsgId();
-    auto handler = std::make_shared<ResponseHandler>(msgId, isSync, callback, eventCode);
-    rspHandlers_.insert({ msgId, handler });
     return handler;
 }
 
-int32_t InputDataChannelProxyWrap::ClearRspHandlers()
+int32_t InputDataChannelProxyWrap::CancelAllPending()
 {
-    std::lock_guard<std::mutex> lock(rspMutex_);
+    auto handlers = rspHandlers_.TakeAll();
     ResponseInfo rspInfo = { ErrorCode::ERROR_IMA_DATA_CHANNEL_ABNORMAL, std::monostate{} };
-    for (const auto &handler : rspHandlers_) {
-        if (handler.second == nullptr) {
-            continue;
-        }
-        if (handler.second->syncBlockData != nullptr) {
-            handler.second->syncBlockData->SetValue(rspInfo);
-            continue;
-        }
-        if (handler.second->asyncCallback != nullptr) {
-            handler.second->asyncCallback(rspInfo.dealRet_, rspInfo.data_);
-        }
+    for (const auto &handler : handlers) {
+        NotifyHandler(handler, rspInfo);
     }
-    rspHandlers_.clear();
+    IMSA_HILOGD("cancel %{public}zu pending.", handlers.size());
     return ErrorCode::NO_ERROR;
 }
 
 int32_t InputDataChannelProxyWrap::HandleResponse(uint64_t msgId, const ResponseInfo &rspInfo)
 {
-    std::lock_guard<std::mutex> lock(rspMutex_);
     return HandleMsg(msgId, rspInfo);
 }
 
 int32_t InputDataChannelProxyWrap::HandleMsg(uint64_t msgId, const ResponseInfo &rspInfo)
 {
-    auto it = rspHandlers_.find(msgId);
-    if (it == rspHandlers_.end()) {
+    TypingTraceScope traceScope(TypingTracePoint::IMA_RESPONSE, msgId);
+    auto handler = rspHandlers_.Take(msgId);
+    if (handler == nullptr) {
         IMSA_HILOGE("not found id: %{public}" PRIu64 "", msgId);
         return ErrorCode::NO_ERROR;
     }
-    if (it->second == nullptr) {
-        rspHandlers_.erase(it);
-        return ErrorCode::NO_ERROR;
-    }
     IMSA_HILOGD("msg info id: %{public}" PRIu64 " event code: %{public}d sync: %{public}d code: %{public}d",
-         msgId, it->second->eventCode, it->second->syncBlockData != nullptr, rspInfo.dealRet_);
-    if (it->second->syncBlockData != nullptr) {
-        it->second->syncBlockData->SetValue(rspInfo);
-    }
-    if (it->second->asyncCallback != nullptr) {
-        it->second->asyncCallback(rspInfo.dealRet_, rspInfo.data_);
-    }
+         msgId, handler->eventCode, handler->syncBlockData != nullptr, rspInfo.dealRet_);
+    NotifyHandler(handler, rspInfo);
+    // the slot is already released, reporting does not hold up other responses
     int64_t now = duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
-    ReportBaseTextOperation(it->second->eventCode, rspInfo.dealRet_, now - it->second->reportStartTime);
-    rspHandlers_.erase(it);
+    ReportBaseTextOperation(handler, rspInfo.dealRet_, now - handler->reportStartTime);
     return ErrorCode::NO_ERROR;
 }
 
+void InputDataChannelProxyWrap::NotifyHandler(
+    const std::shared_ptr<ResponseHandler> &handler, const ResponseInfo &rspInfo)
+{
+    if (handler == nullptr) {
+        return;
+    }
+    if (handler->syncBlockData != nullptr) {
+        handler->syncBlockData->SetValue(rspInfo);
+    }
+    if (handler->asyncCallback != nullptr) {
+        handler->asyncCallback(rspInfo.dealRet_, rspInfo.data_);
+    }
+}
+
 int32_t InputDataChannelProxyWrap::WaitResponse(
     const std::shared_ptr<ResponseHandler> &handler, const SyncOutput &output)
 {
     if (handler == nullptr || handler->syncBlockData == nullptr) {
         return ErrorCode::ERROR_IMA_DATA_CHANNEL_ABNORMAL;
     }
-    ResponseInfo rspInfo = handler->syncBlockData->GetValueWithoutTimeout();
+    ResponseInfo rspInfo;
+    if (handler->timeoutMs == ResponseHandler::NO_TIMEOUT) {
+        rspInfo = handler->syncBlockData->GetValueWithoutTimeout();
+    } else if (!handler->syncBlockData->GetValue(rspInfo)) {
+        if (rspHandlers_.Take(handler->msgId) != nullptr) {
+            // the handler is reclaimed, a late response will not find it and is dropped
+            IMSA_HILOGW("timeout id: %{public}" PRIu64 " event code: %{public}d.", handler->msgId,
+                handler->eventCode);
+            ReportBaseTextOperation(handler, ErrorCode::ERROR_IMA_RESPONSE_TIMEOUT, handler->timeoutMs);
+            return ErrorCode::ERROR_IMA_RESPONSE_TIMEOUT;
+        }
+        // the response came in right at the deadline and has already been set
+        rspInfo = handler->syncBlockData->GetValueWithoutTimeout();
+    }
     IMSA_HILOGD("rsp info id: %{public}" PRIu64 " ret: %{public}d", handler->msgId, rspInfo.dealRet_);
     if (rspInfo.dealRet_ != ErrorCode::NO_ERROR) {
         return rspInfo.dealRet_;
@@ -319,11 +394,7 @@ int32_t InputDataChannelProxyWrap::WaitResponse(
 
 int32_t InputDataChannelProxyWrap::DeleteRspHandler(uint64_t msgId)
 {
-    std::lock_guard<std::mutex> lock(rspMutex_);
-    auto it = rspHandlers_.find(msgId);
-    if (it != rspHandlers_.end()) {
-        rspHandlers_.erase(it);
-    }
+    rspHandlers_.Take(msgId);
     return ErrorCode::NO_ERROR;
 }
 
@@ -345,5 +416,112 @@ void InputDataChannelProxyWrap::ReportBaseTextOperation(int32_t eventCode, int32
     ImaHiSysEventReporter::GetInstance().ReportEvent(ImfEventType::BASE_TEXT_OPERATOR, *evenInfo);
     IMSA_HILOGD("HiSysEvent report end:[%{public}d, %{public}d]!", eventCode, errCode);
 }
+
+void InputDataChannelProxyWrap::ReportBaseTextOperation(
+    const std::shared_ptr<ResponseHandler> &handler, int32_t errCode, int64_t consumeTime)
+{
+    if (handler->batchEventCodes.empty()) {
+        ReportBaseTextOperation(handler->eventCode, errCode, consumeTime);
+        return;
+    }
+    // a batch is applied as a whole, every operation in it shares the result and the time of the batch
+    for (auto eventCode : handler->batchEventCodes) {
+        ReportBaseTextOperation(eventCode, errCode, consumeTime);
+    }
+}
+
+std::vector<int32_t> InputDataChannelProxyWrap::GetBatchEventCodes(const EditBatchInner &batch)
+{
+    static const std::map<EditOperationType, IInputDataChannelIpcCode> EVENT_CODES = {
+        { EditOperationType::INSERT_TEXT, IInputDataChannelIpcCode::COMMAND_INSERT_TEXT },
+        { EditOperationType::DELETE_FORWARD, IInputDataChannelIpcCode::COMMAND_DELETE_FORWARD },
+        { EditOperationType::DELETE_BACKWARD, IInputDataChannelIpcCode::COMMAND_DELETE_BACKWARD },
+        { EditOperationType::MOVE_CURSOR, IInputDataChannelIpcCode::COMMAND_MOVE_CURSOR },
+        { EditOperationType::SELECT_BY_RANGE, IInputDataChannelIpcCode::COMMAND_SELECT_BY_RANGE },
+    };
+    std::vector<int32_t> eventCodes;
+    eventCodes.reserve(batch.operations.size());
+    for (const auto &operation : batch.operations) {
+        auto it = EVENT_CODES.find(operation.type);
+        eventCodes.push_back(static_cast<int32_t>(
+            it != EVENT_CODES.end() ? it->second : IInputDataChannelIpcCode::COMMAND_COMMIT_EDIT_BATCH));
+    }
+    return eventCodes;
+}
+
+void ResponseSlotTable::Insert(
+    const std::shared_ptr<ResponseHandler> &handler, std::shared_ptr<ResponseHandler> &evicted)
+{
+    auto &slot = slots_[handler->msgId % CAPACITY];
+    while (true) {
+        uint64_t owner = slot.owner.load(std::memory_order_acquire);
+        if (owner == SLOT_BUSY) {
+            std::this_thread::yield();
+            continue;
+        }
+        if (!slot.owner.compare_exchange_weak(owner, SLOT_BUSY, std::memory_order_acquire)) {
+            continue;
+        }
+        if (owner != SLOT_FREE) {
+            evicted = std::move(slot.handler);
+        }
+        slot.handler = handler;
+        slot.owner.store(handler->msgId, std::memory_order_release);
+        return;
+    }
+}
+
+std::shared_ptr<ResponseHandler> ResponseSlotTable::Take(uint64_t msgId)
+{
+    if (msgId == SLOT_FREE || msgId == SLOT_BUSY) {
+        return nullptr;
+    }
+    return TakeSlot(slots_[msgId % CAPACITY], msgId);
+}
+
+std::vector<std::shared_ptr<ResponseHandler>> ResponseSlotTable::TakeAll()
+{
+    std::vector<std::shared_ptr<ResponseHandler>> handlers;
+    for (auto &slot : slots_) {
+        uint64_t owner = slot.owner.load(std::memory_order_acquire);
+        if (owner == SLOT_FREE || owner == SLOT_BUSY) {
+            continue;
+        }
+        auto handler = TakeSlot(slot, owner);
+        if (handler != nullptr) {
+            handlers.push_back(std::move(handler));
+        }
+    }
+    return handlers;
+}
+
+bool ResponseSlotTable::Contains(uint64_t msgId) const
+{
+    return slots_[msgId % CAPACITY].owner.load(std::memory_order_acquire) == msgId;
+}
+
+size_t ResponseSlotTable::Size() const
+{
+    size_t size = 0;
+    for (const auto &slot : slots_) {
+        auto owner = slot.owner.load(std::memory_order_acquire);
+        if (owner != SLOT_FREE && owner != SLOT_BUSY) {
+            ++size;
+        }
+    }
+    return size;
+}
+
+std::shared_ptr<ResponseHandler> ResponseSlotTable::TakeSlot(Slot &slot, uint64_t msgId)
+{
+    uint64_t expected = msgId;
+    if (!slot.owner.compare_exchange_strong(expected, SLOT_BUSY, std::memory_order_acquire)) {
+        return nullptr;
+    }
+    auto handler = std::move(slot.handler);
+    slot.handler = nullptr;
+    slot.owner.store(SLOT_FREE, std::memory_order_release);
+    return handler;
+}
 } // namespace MiscServices
 } // namespace OHOS
\ No newline at end of file
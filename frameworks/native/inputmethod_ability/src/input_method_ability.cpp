@@ -31,12 +31,14 @@
 #include "itypes_util.h"
 #include "message_parcel.h"
 #include "on_demand_start_stop_sa.h"
+#include "shared_message_buffer.h"
 #include "string_ex.h"
 #include "sys/prctl.h"
 #include "system_ability_definition.h"
 #include "task_manager.h"
 #include "tasks/task.h"
 #include "tasks/task_imsa.h"
+#include "typing_latency_tracer.h"
 #include "variant_util.h"
 
 namespace OHOS {
@@ -247,6 +249,13 @@ int32_t InputMethodAbility::UnbindImeMirror()
 void InputMethodAbility::Initialize()
 {
     IMSA_HILOGD("IMA init.");
+    TypingLatencyTracer::Init();
+    TypingLatencyTracer::SetReporter([this](const std::string &ring) {
+        auto proxy = GetImsaProxy();
+        if (proxy != nullptr) {
+            proxy->ReportTypingTrace(ring);
+        }
+    });
     sptr<InputMethodCoreStub> coreStub = new (std::nothrow) InputMethodCoreServiceImpl();
     if (coreStub == nullptr) {
         IMSA_HILOGE("failed to create core!");
@@ -402,7 +411,7 @@ void InputMethodAbility::ClearDataChannel(const sptr<IRemoteObject> &channel)
     if (dataChannelObject_.GetRefPtr() == channel.GetRefPtr()) {
         dataChannelObject_ = nullptr;
         if (dataChannelProxyWrap_ != nullptr) {
-            dataChannelProxyWrap_->ClearRspHandlers();
+            dataChannelProxyWrap_->CancelAllPending();
         }
         dataChannelProxyWrap_ = nullptr;
         IMSA_HILOGD("end.");
@@ -425,6 +434,12 @@ int32_t InputMethodAbility::StopInput(sptr<IRemoteObject> channelObject, uint32_
 
 void InputMethodAbility::ClearBindInfo(const sptr<IRemoteObject> &channel)
 {
+    AbortEdit();
+    textMirror_.Reset();
+    {
+        std::lock_guard<std::mutex> lock(recvMsgBufferLock_);
+        recvMsgBuffer_ = nullptr;
+    }
     ClearDataChannel(channel);
     ClearInputAttribute();
     ClearAttachOptions();
@@ -443,7 +458,11 @@ int32_t InputMethodAbility::DispatchKeyEvent(
         return ErrorCode::ERROR_CLIENT_NULL_POINTER;
     }
     IMSA_HILOGD("InputMethodAbility, start.");
-
+    auto keyId = static_cast<uint32_t>(keyEvent->GetId());
+    TypingTraceScope traceScope(TypingTracePoint::IMA_DISPATCH_KEY, keyId);
+    if (TypingLatencyTracer::IsEnabled()) {
+        TypingLatencyTracer::GetInstance().SetLastKeyId(keyId);
+    }
     if (!kdListener_->OnDealKeyEvent(keyEvent, cbId, channelObject)) {
         IMSA_HILOGE("keyEvent not deal!");
         return ErrorCode::ERROR_DISPATCH_KEY_EVENT;
@@ -490,6 +509,27 @@ void InputMethodAbility::OnSelectionChange(
     kdListener_->OnSelectionChange(oldBegin, oldEnd, newBegin, newEnd);
 }
 
+void InputMethodAbility::OnTextDeltaChange(
+    const TextDeltaInner &delta, int32_t oldBegin, int32_t oldEnd, int32_t newBegin, int32_t newEnd)
+{
+    std::u16string text;
+    if (!textMirror_.Apply(delta, text)) {
+        // the mirror is out of date, ask the editor for the full text
+        std::shared_ptr<InputDataChannelProxyWrap> channel = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(dataChannelLock_);
+            channel = dataChannelProxyWrap_;
+        }
+        if (channel == nullptr) {
+            IMSA_HILOGE("channel is nullptr!");
+            return;
+        }
+        channel->RequestTextSync();
+        return;
+    }
+    OnSelectionChange(text, oldBegin, oldEnd, newBegin, newEnd);
+}
+
 void InputMethodAbility::OnAttributeChange(InputAttribute attribute)
 {
     if (kdListener_ == nullptr) {
@@ -724,6 +764,13 @@ int32_t InputMethodAbility::InsertText(const std::string &text, const AsyncIpcCa
 {
     InputMethodSyncTrace tracer("IMA_InsertText");
     IMSA_HILOGD("InputMethodAbility start.");
+    EditOperation operation;
+    operation.type = EditOperationType::INSERT_TEXT;
+    operation.text = text;
+    int32_t batchRet = ErrorCode::NO_ERROR;
+    if (AddToEditBatch(operation, callback, batchRet)) {
+        return batchRet;
+    }
     auto channel = GetInputDataChannelProxyWrap();
     if (channel == nullptr) {
         IMSA_HILOGE("channel is nullptr!");
@@ -737,6 +784,13 @@ int32_t InputMethodAbility::DeleteForward(int32_t length, const AsyncIpcCallBack
 {
     InputMethodSyncTrace tracer("IMA_DeleteForward");
     IMSA_HILOGD("InputMethodAbility start, length: %{public}d.", length);
+    EditOperation operation;
+    operation.type = EditOperationType::DELETE_FORWARD;
+    operation.length = length;
+    int32_t batchRet = ErrorCode::NO_ERROR;
+    if (AddToEditBatch(operation, callback, batchRet)) {
+        return batchRet;
+    }
     auto channel = GetInputDataChannelProxyWrap();
     if (channel == nullptr) {
         IMSA_HILOGE("channel is nullptr!");
@@ -748,6 +802,13 @@ int32_t InputMethodAbility::DeleteForward(int32_t length, const AsyncIpcCallBack
 int32_t InputMethodAbility::DeleteBackward(int32_t length, const AsyncIpcCallBack &callback)
 {
     IMSA_HILOGD("InputMethodAbility start, length: %{public}d.", length);
+    EditOperation operation;
+    operation.type = EditOperationType::DELETE_BACKWARD;
+    operation.length = length;
+    int32_t batchRet = ErrorCode::NO_ERROR;
+    if (AddToEditBatch(operation, callback, batchRet)) {
+        return batchRet;
+    }
     auto channel = GetInputDataChannelProxyWrap();
     if (channel == nullptr) {
         IMSA_HILOGE("channel is nullptr!");
@@ -801,10 +862,7 @@ int32_t InputMethodAbility::GetTextBeforeCursor(int32_t number, std::u16string &
         IMSA_HILOGE("channel is nullptr!");
         return ErrorCode::ERROR_CLIENT_NULL_POINTER;
     }
-    std::string textu8 = "";
-    auto ret = channel->GetTextBeforeCursor(number, textu8, callback);
-    text = Str8ToStr16(textu8);
-    return ret;
+    return channel->GetTextBeforeCursor(number, text, callback);
 }
 
 int32_t InputMethodAbility::GetTextAfterCursor(
@@ -817,15 +875,19 @@ int32_t InputMethodAbility::GetTextAfterCursor(
         IMSA_HILOGE("channel is nullptr!");
         return ErrorCode::ERROR_CLIENT_NULL_POINTER;
     }
-    std::string textu8 = "";
-    auto ret = channel->GetTextAfterCursor(number, textu8, callback);
-    text = Str8ToStr16(textu8);
-    return ret;
+    return channel->GetTextAfterCursor(number, text, callback);
 }
 
 int32_t InputMethodAbility::MoveCursor(int32_t keyCode, const AsyncIpcCallBack &callback)
 {
     IMSA_HILOGD("InputMethodAbility, keyCode: %{public}d.", keyCode);
+    EditOperation operation;
+    operation.type = EditOperationType::MOVE_CURSOR;
+    operation.direction = keyCode;
+    int32_t batchRet = ErrorCode::NO_ERROR;
+    if (AddToEditBatch(operation, callback, batchRet)) {
+        return batchRet;
+    }
     auto channel = GetInputDataChannelProxyWrap();
     if (channel == nullptr) {
         IMSA_HILOGE("channel is nullptr!");
@@ -841,6 +903,13 @@ int32_t InputMethodAbility::SelectByRange(int32_t start, int32_t end, const Asyn
         IMSA_HILOGE("check parameter failed, start: %{public}d, end: %{public}d!", start, end);
         return ErrorCode::ERROR_PARAMETER_CHECK_FAILED;
     }
+    EditOperation operation;
+    operation.type = EditOperationType::SELECT_BY_RANGE;
+    operation.range = { start, end };
+    int32_t batchRet = ErrorCode::NO_ERROR;
+    if (AddToEditBatch(operation, callback, batchRet)) {
+        return batchRet;
+    }
     auto dataChannel = GetInputDataChannelProxyWrap();
     if (dataChannel == nullptr) {
         IMSA_HILOGE("datachannel is nullptr!");
@@ -849,6 +918,103 @@ int32_t InputMethodAbility::SelectByRange(int32_t start, int32_t end, const Asyn
     return dataChannel->SelectByRange(start, end, callback);
 }
 
+int32_t InputMethodAbility::BeginEdit()
+{
+    std::lock_guard<std::mutex> lock(editBatchLock_);
+    if (editBatch_.isEditing) {
+        IMSA_HILOGE("edit batch already began!");
+        return ErrorCode::ERROR_IMA_PRECONDITION_REQUIRED;
+    }
+    editBatch_.isEditing = true;
+    return ErrorCode::NO_ERROR;
+}
+
+int32_t InputMethodAbility::CommitEdit(const AsyncIpcCallBack &callback)
+{
+    InputMethodSyncTrace tracer("IMA_CommitEdit");
+    EditBatchInner batch;
+    std::vector<AsyncIpcCallBack> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(editBatchLock_);
+        if (!editBatch_.isEditing) {
+            IMSA_HILOGE("edit batch not began!");
+            return ErrorCode::ERROR_IMA_PRECONDITION_REQUIRED;
+        }
+        batch.operations = std::move(editBatch_.operations);
+        callbacks = std::move(editBatch_.callbacks);
+        editBatch_ = {};
+    }
+    IMSA_HILOGD("InputMethodAbility, size: %{public}zu.", batch.operations.size());
+    if (batch.operations.empty()) {
+        if (callback != nullptr) {
+            callback(ErrorCode::NO_ERROR, std::monostate{});
+        }
+        return ErrorCode::NO_ERROR;
+    }
+    auto channel = GetInputDataChannelProxyWrap();
+    if (channel == nullptr) {
+        IMSA_HILOGE("channel is nullptr!");
+        NotifyEditBatchCallbacks(callbacks, ErrorCode::ERROR_IMA_CHANNEL_NULLPTR);
+        return ErrorCode::ERROR_IMA_CHANNEL_NULLPTR;
+    }
+    AsyncIpcCallBack batchCallback = nullptr;
+    if (callback != nullptr) {
+        batchCallback = [callbacks, callback](int32_t code, const ResponseData &data) {
+            NotifyEditBatchCallbacks(callbacks, code);
+            callback(code, data);
+        };
+    }
+    auto ret = channel->CommitEditBatch(batch, batchCallback);
+    if (callback == nullptr || ret != ErrorCode::NO_ERROR) {
+        NotifyEditBatchCallbacks(callbacks, ret);
+    }
+    return ret;
+}
+
+int32_t InputMethodAbility::AbortEdit()
+{
+    std::vector<AsyncIpcCallBack> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(editBatchLock_);
+        if (!editBatch_.isEditing) {
+            return ErrorCode::NO_ERROR;
+        }
+        callbacks = std::move(editBatch_.callbacks);
+        editBatch_ = {};
+    }
+    IMSA_HILOGI("edit batch aborted, callback size: %{public}zu.", callbacks.size());
+    NotifyEditBatchCallbacks(callbacks, ErrorCode::ERROR_IMA_DATA_CHANNEL_ABNORMAL);
+    return ErrorCode::NO_ERROR;
+}
+
+bool InputMethodAbility::AddToEditBatch(const EditOperation &operation, const AsyncIpcCallBack &callback, int32_t &ret)
+{
+    std::lock_guard<std::mutex> lock(editBatchLock_);
+    if (!editBatch_.isEditing) {
+        return false;
+    }
+    if (editBatch_.operations.size() >= MAX_EDIT_BATCH_OPERATION_COUNT) {
+        IMSA_HILOGE("too many operations in edit batch!");
+        ret = ErrorCode::ERROR_PARAMETER_CHECK_FAILED;
+        return true;
+    }
+    editBatch_.operations.push_back(operation);
+    if (callback != nullptr) {
+        editBatch_.callbacks.push_back(callback);
+    }
+    ret = ErrorCode::NO_ERROR;
+    return true;
+}
+
+void InputMethodAbility::NotifyEditBatchCallbacks(const std::vector<AsyncIpcCallBack> &callbacks, int32_t code)
+{
+    for (const auto &callback : callbacks) {
+        if (callback != nullptr) {
+            callback(code, std::monostate{});
+        }
+    }
+}
+
 int32_t InputMethodAbility::SelectByMovement(int32_t direction, const AsyncIpcCallBack &callback)
 {
     IMSA_HILOGD("InputMethodAbility, direction: %{public}d.", direction);
@@ -935,7 +1101,7 @@ void InputMethodAbility::SetInputDataChannel(const sptr<IRemoteObject> &object)
         return;
     }
     if (dataChannelProxyWrap_ != nullptr) {
-        dataChannelProxyWrap_->ClearRspHandlers();
+        dataChannelProxyWrap_->CancelAllPending();
     }
     dataChannelProxyWrap_ = channelWrap;
     dataChannelObject_ = object;
@@ -1661,9 +1827,51 @@ int32_t InputMethodAbility::SendMessage(const ArrayBuffer &arrayBuffer)
         IMSA_HILOGE("datachannel is nullptr.");
         return ErrorCode::ERROR_CLIENT_NULL_POINTER;
     }
+    if (arrayBuffer.msgParam.size() >= SHARED_MESSAGE_MIN_SIZE) {
+        // hold the lock until the editor has read the message, the region is reused by the next write
+        std::lock_guard<std::mutex> lock(sendMsgBufferLock_);
+        SharedMessageInner msg;
+        if (WriteSharedMessage(dataChannel, arrayBuffer, msg)) {
+            auto ret = dataChannel->SendSharedMessage(msg);
+            // a failed message handler has seen the message already, anything else did not deliver it
+            if (ret == ErrorCode::NO_ERROR || ret == ErrorCode::ERROR_MESSAGE_HANDLER) {
+                return ret;
+            }
+            // the editor may have dropped the buffer on rebind, the next message shares it again
+            IMSA_HILOGW("send shared message failed, ret: %{public}d, send by parcel.", ret);
+            msgBufferPeer_.reset();
+        } else {
+            IMSA_HILOGW("shared message buffer unavailable, send by parcel.");
+        }
+    }
     return dataChannel->SendMessage(arrayBuffer);
 }
 
+bool InputMethodAbility::WriteSharedMessage(
+    const std::shared_ptr<InputDataChannelProxy> &channel, const ArrayBuffer &arrayBuffer, SharedMessageInner &msg)
+{
+    if (sendMsgBuffer_ == nullptr) {
+        sendMsgBuffer_ = SharedMessageBuffer::Create(SHARED_MESSAGE_BUFFER_SIZE);
+        if (sendMsgBuffer_ == nullptr) {
+            return false;
+        }
+    }
+    if (msgBufferPeer_.lock() != channel) {
+        SharedMessageBufferInner buffer;
+        buffer.ashmem = sendMsgBuffer_->GetAshmem();
+        auto ret = channel->SetMessageBuffer(buffer);
+        if (ret != ErrorCode::NO_ERROR) {
+            IMSA_HILOGE("failed to share message buffer, ret: %{public}d!", ret);
+            return false;
+        }
+        msgBufferPeer_ = channel;
+    }
+    msg.jsArgc = arrayBuffer.jsArgc;
+    msg.msgId = arrayBuffer.msgId;
+    msg.length = static_cast<uint32_t>(arrayBuffer.msgParam.size());
+    return sendMsgBuffer_->Write(arrayBuffer.msgParam, msg.offset);
+}
+
 int32_t InputMethodAbility::RecvMessage(const ArrayBuffer &arrayBuffer)
 {
     int32_t securityMode = -1;
@@ -1684,6 +1892,40 @@ int32_t InputMethodAbility::RecvMessage(const ArrayBuffer &arrayBuffer)
     return msgHandlerCallback->OnMessage(arrayBuffer);
 }
 
+int32_t InputMethodAbility::SetRecvMessageBuffer(const sptr<Ashmem> &ashmem)
+{
+    auto buffer = SharedMessageBuffer::Attach(ashmem);
+    if (buffer == nullptr) {
+        IMSA_HILOGE("failed to attach message buffer!");
+        return ErrorCode::ERROR_CLIENT_NULL_POINTER;
+    }
+    std::lock_guard<std::mutex> lock(recvMsgBufferLock_);
+    recvMsgBuffer_ = buffer;
+    return ErrorCode::NO_ERROR;
+}
+
+int32_t InputMethodAbility::RecvSharedMessage(const SharedMessageInner &msg)
+{
+    std::shared_ptr<SharedMessageBuffer> buffer = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(recvMsgBufferLock_);
+        buffer = recvMsgBuffer_;
+    }
+    if (buffer == nullptr) {
+        IMSA_HILOGE("message buffer is not set!");
+        return ErrorCode::ERROR_CLIENT_NULL_POINTER;
+    }
+    ArrayBuffer arrayBuffer;
+    arrayBuffer.jsArgc = msg.jsArgc;
+    arrayBuffer.msgId = msg.msgId;
+    if (msg.length > MAX_ARRAY_BUFFER_MSG_PARAM_SIZE || !buffer->Read(msg.offset, msg.length, arrayBuffer.msgParam) ||
+        !ArrayBuffer::IsSizeValid(arrayBuffer)) {
+        IMSA_HILOGE("invalid shared message: %{public}u/%{public}u!", msg.offset, msg.length);
+        return ErrorCode::ERROR_INVALID_ARRAY_BUFFER_SIZE;
+    }
+    return RecvMessage(arrayBuffer);
+}
+
 int32_t InputMethodAbility::RegisterMsgHandler(const std::shared_ptr<MsgHandlerCallbackInterface> &msgHandler)
 {
     IMSA_HILOGI("isRegist: %{public}d", msgHandler != nullptr);
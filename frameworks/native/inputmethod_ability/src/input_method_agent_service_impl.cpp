@@ -36,6 +36,17 @@ ErrCode InputMethodAgentServiceImpl::DispatchKeyEvent(
     return InputMethodAbility::GetInstance().DispatchKeyEvent(keyEvent.event, cbId, channelObject);
 }
 
+ErrCode InputMethodAgentServiceImpl::DispatchKeyEventAsync(
+    const MiscServices::KeyEventValue &keyEvent, uint64_t cbId, const sptr<IRemoteObject> &channelObject)
+{
+    auto ret = InputMethodAbility::GetInstance().DispatchKeyEvent(keyEvent.event, cbId, channelObject);
+    if (ret != ErrorCode::NO_ERROR) {
+        // the editor waits for the result of every pipelined key event, report it as not consumed
+        InputMethodAbility::GetInstance().HandleKeyEventResult(cbId, false, channelObject);
+    }
+    return ret;
+}
+
 ErrCode InputMethodAgentServiceImpl::SetCallingWindow(uint32_t windowId)
 {
     InputMethodAbility::GetInstance().SetCallingWindow(windowId);
@@ -58,6 +69,14 @@ ErrCode InputMethodAgentServiceImpl::OnSelectionChange(
     return ERR_OK;
 }
 
+ErrCode InputMethodAgentServiceImpl::OnTextDeltaChange(
+    const TextDeltaInner &delta, int32_t oldBegin, int32_t oldEnd, int32_t newBegin, int32_t newEnd)
+{
+    auto task = std::make_shared<TaskImsaOnTextDeltaChange>(delta, oldBegin, oldEnd, newBegin, newEnd);
+    TaskManager::GetInstance().PostTask(task);
+    return ERR_OK;
+}
+
 ErrCode InputMethodAgentServiceImpl::SendPrivateCommand(
     const Value &value)
 {
@@ -85,6 +104,16 @@ ErrCode InputMethodAgentServiceImpl::SendMessage(const ArrayBuffer &arraybuffer)
     return InputMethodAbility::GetInstance().RecvMessage(arraybuffer);
 }
 
+ErrCode InputMethodAgentServiceImpl::SetMessageBuffer(const SharedMessageBufferInner &buffer)
+{
+    return InputMethodAbility::GetInstance().SetRecvMessageBuffer(buffer.ashmem);
+}
+
+ErrCode InputMethodAgentServiceImpl::SendSharedMessage(const SharedMessageInner &msg)
+{
+    return InputMethodAbility::GetInstance().RecvSharedMessage(msg);
+}
+
 
 ErrCode InputMethodAgentServiceImpl::DiscardTypingText()
 {
@@ -111,5 +140,10 @@ ErrCode InputMethodAgentServiceImpl::ResponseDataChannel(uint64_t msgId, int cod
 {
     return InputMethodAbility::GetInstance().OnResponse(msgId, code, msg.rspData);
 }
+
+ErrCode InputMethodAgentServiceImpl::ResponseDataChannelAsync(uint64_t msgId, int code, const ResponseDataInner &msg)
+{
+    return InputMethodAbility::GetInstance().OnResponse(msgId, code, msg.rspData);
+}
 } // namespace MiscServices
 } // namespace OHOS
\ No newline at end of file
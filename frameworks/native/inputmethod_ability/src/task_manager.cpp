@@ -15,6 +15,9 @@
 
 #include "task_manager.h"
 
+#include <algorithm>
+#include <chrono>
+#include <iterator>
 #include <string>
 
 #include "actions/action.h"
@@ -22,6 +25,7 @@
 #include "global.h"
 #include "tasks/task.h"
 #include "tasks/task_inner.h"
+#include "typing_latency_tracer.h"
 
 namespace OHOS {
 namespace MiscServices {
@@ -47,8 +51,22 @@ uint64_t TaskManager::PostTask(task_ptr_t task, uint32_t delayMs)
         return 0;
     }
 
-    auto func = [this, task]() { OnNewTask(task); };
-    eventHandler_->PostTask(func, __FUNCTION__, delayMs);
+    if (delayMs != 0) {
+        auto func = [this, task]() { OnNewTask(task); };
+        eventHandler_->PostTask(func, __FUNCTION__, delayMs);
+        return task->GetSeqId();
+    }
+    // queued at once, a later task of a higher priority can overtake it while the work thread is busy
+    task->MarkQueued(GetNowUs());
+    {
+        std::lock_guard<std::mutex> lock(inboxLock_);
+        inbox_.push_back(task);
+    }
+    auto func = [this]() {
+        DrainInbox();
+        Process();
+    };
+    eventHandler_->PostTask(func, __FUNCTION__);
     return task->GetSeqId();
 }
 
@@ -101,6 +119,17 @@ int32_t TaskManager::WaitExec(uint64_t seqId, uint32_t timeoutMs, std::function<
     return ErrorCode::NO_ERROR;
 }
 
+void TaskManager::SetSchedulePolicy(SchedulePolicy policy)
+{
+    policy_ = policy;
+}
+
+std::map<TaskType, TaskStats> TaskManager::GetTaskStats()
+{
+    std::lock_guard<std::mutex> lock(statsLock_);
+    return stats_;
+}
+
 void TaskManager::SetInited(bool flag)
 {
     inited_ = flag;
@@ -112,6 +141,35 @@ void TaskManager::OnNewTask(task_ptr_t task)
         IMSA_HILOGE("task is NULL!");
         return;
     }
+    task->MarkQueued(GetNowUs());
+    Enqueue(task);
+    Process();
+}
+
+void TaskManager::DrainInbox()
+{
+    std::list<task_ptr_t> tasks;
+    {
+        std::lock_guard<std::mutex> lock(inboxLock_);
+        // a run of imsa tasks or a single task of another source, so that the sources keep their order
+        while (!inbox_.empty()) {
+            bool isImsaTask = inbox_.front()->GetSourceType() == SOURCE_TYPE_IMSA;
+            if (!isImsaTask && !tasks.empty()) {
+                break;
+            }
+            tasks.splice(tasks.end(), inbox_, inbox_.begin());
+            if (!isImsaTask) {
+                break;
+            }
+        }
+    }
+    for (auto &task : tasks) {
+        Enqueue(task);
+    }
+}
+
+void TaskManager::Enqueue(task_ptr_t task)
+{
     auto srcType = task->GetSourceType();
     switch (srcType) {
         case SOURCE_TYPE_AMS:
@@ -121,7 +179,7 @@ void TaskManager::OnNewTask(task_ptr_t task)
             imaTasks_.push_back(task);
             break;
         case SOURCE_TYPE_IMSA:
-            imsaTasks_.push_back(task);
+            EnqueueImsaTask(task);
             break;
         case SOURCE_TYPE_INNER:
             innerTasks_.push_back(task);
@@ -130,7 +188,34 @@ void TaskManager::OnNewTask(task_ptr_t task)
             IMSA_HILOGE("task type %{public}d unknown!", srcType);
             return;
     }
-    Process();
+}
+
+void TaskManager::EnqueueImsaTask(task_ptr_t task)
+{
+    if (policy_ == SchedulePolicy::FIFO) {
+        imsaTasks_.push_back(task);
+        return;
+    }
+    bool isTakenOver = false;
+    for (auto it = imsaTasks_.begin(); it != imsaTasks_.end();) {
+        if (!(*it)->IsSupersededBy(*task)) {
+            ++it;
+            continue;
+        }
+        if (!isTakenOver) {
+            task->TakeOver(**it);
+            isTakenOver = true;
+        }
+        CountTask((*it)->GetType(), [](TaskStats &stats) { ++stats.coalescedNum; });
+        it = imsaTasks_.erase(it);
+    }
+    auto pos = imsaTasks_.end();
+    if (task->GetPriority() == TASK_PRIORITY_HIGH) {
+        while (pos != imsaTasks_.begin() && (*std::prev(pos))->GetPriority() == TASK_PRIORITY_LOW) {
+            --pos;
+        }
+    }
+    imsaTasks_.insert(pos, task);
 }
 
 void TaskManager::Process()
@@ -156,7 +241,7 @@ void TaskManager::ProcessNextInnerTask()
         auto state = curTask_->OnTask(task);
         if (state == RUNNING_STATE_COMPLETED) {
             // current task completed
-            curTask_.reset();
+            FinishCurrentTask();
             innerTasks_.clear();
             return;
         }
@@ -209,7 +294,7 @@ void TaskManager::ProcessNextImaTask()
             imaTasks_.pop_front();
             auto state = curTask_->OnTask(task);
             if (state == RUNNING_STATE_COMPLETED) {
-                curTask_.reset();
+                FinishCurrentTask();
                 break;
             }
         }
@@ -231,16 +316,27 @@ void TaskManager::ProcessNextImsaTask()
         return;
     }
 
-    if (curTask_ || imsaTasks_.empty()) {
-        return;
-    }
-
     while (!curTask_) {
+        // the tasks posted meanwhile compete with the queued ones, unless an earlier task of another source waits
+        bool isOtherTaskPending = !innerTasks_.empty() || !amsTasks_.empty() || !imaTasks_.empty();
+        if (!isOtherTaskPending) {
+            DrainInbox();
+            isOtherTaskPending = !innerTasks_.empty() || !amsTasks_.empty() || !imaTasks_.empty();
+        }
         if (imsaTasks_.empty()) {
+            if (isOtherTaskPending) {
+                ProcessAsync();
+            }
             return;
         }
-        curTask_ = imsaTasks_.front();
+        auto task = imsaTasks_.front();
         imsaTasks_.pop_front();
+        if (policy_ == SchedulePolicy::PRIORITY && task->IsExpired(GetNowUs())) {
+            IMSA_HILOGW("task %{public}u expired, drop it.", task->GetType());
+            CountTask(task->GetType(), [](TaskStats &stats) { ++stats.expiredNum; });
+            continue;
+        }
+        curTask_ = task;
         ExecuteCurrentTask();
     }
 }
@@ -250,10 +346,20 @@ void TaskManager::ExecuteCurrentTask()
     if (curTask_ == nullptr) {
         return;
     }
-    auto state = curTask_->Execute();
+    curTaskStartUs_ = GetNowUs();
+    auto waitUs = curTask_->GetQueuedTime() == 0 ? 0 : curTaskStartUs_ - curTask_->GetQueuedTime();
+    CountTask(curTask_->GetType(), [waitUs](TaskStats &stats) {
+        stats.totalWaitUs += waitUs;
+        stats.maxWaitUs = std::max(stats.maxWaitUs, waitUs);
+    });
+    RunningState state = RUNNING_STATE_IDLE;
+    {
+        TypingTraceScope traceScope(TypingTracePoint::IMA_TASK, curTask_->GetSeqId(), curTask_->GetType());
+        state = curTask_->Execute();
+    }
     if (state == RUNNING_STATE_COMPLETED) {
         IMSA_HILOGD("curTask_ completed");
-        curTask_.reset();
+        FinishCurrentTask();
         ProcessAsync();
         return;
     }
@@ -265,10 +371,40 @@ void TaskManager::ExecuteCurrentTask()
     curTask_.reset();
 }
 
+void TaskManager::FinishCurrentTask()
+{
+    if (curTask_ == nullptr) {
+        return;
+    }
+    auto execUs = GetNowUs() - curTaskStartUs_;
+    CountTask(curTask_->GetType(), [execUs](TaskStats &stats) {
+        ++stats.executedNum;
+        stats.totalExecUs += execUs;
+        stats.maxExecUs = std::max(stats.maxExecUs, execUs);
+    });
+    curTask_.reset();
+}
+
+void TaskManager::CountTask(TaskType type, const std::function<void(TaskStats &)> &counter)
+{
+    std::lock_guard<std::mutex> lock(statsLock_);
+    counter(stats_[type]);
+}
+
+int64_t TaskManager::GetNowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 void TaskManager::Reset()
 {
     inited_ = false;
     curTask_ = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(inboxLock_);
+        inbox_.clear();
+    }
     innerTasks_.clear();
     imaTasks_.clear();
     imsaTasks_.clear();
@@ -95,6 +95,46 @@ SourceType Task::GetSourceType() const
     return SOURCE_TYPE_INNER;
 }
 
+TaskPriority Task::GetPriority() const
+{
+    switch (type_) {
+        case TASK_TYPE_IMSA_SHOW_KEYBOARD:
+        case TASK_TYPE_IMSA_HIDE_KEYBOARD:
+            return TASK_PRIORITY_HIGH;
+        case TASK_TYPE_IMSA_CURSOR_UPDATE:
+        case TASK_TYPE_IMSA_SELECTION_CHANGE:
+            return TASK_PRIORITY_LOW;
+        default:
+            return TASK_PRIORITY_NORMAL;
+    }
+}
+
+bool Task::IsSupersededBy(const Task &task) const
+{
+    return isSupersedable_ && task.isSupersedable_ && type_ == task.type_ && state_ == RUNNING_STATE_IDLE;
+}
+
+void Task::SetDeadline(uint32_t timeoutMs)
+{
+    timeoutMs_ = timeoutMs;
+}
+
+bool Task::IsExpired(int64_t nowUs) const
+{
+    constexpr int64_t msToUs = 1000;
+    return timeoutMs_ != 0 && queuedUs_ != 0 && nowUs - queuedUs_ > static_cast<int64_t>(timeoutMs_) * msToUs;
+}
+
+void Task::MarkQueued(int64_t nowUs)
+{
+    queuedUs_ = nowUs;
+}
+
+int64_t Task::GetQueuedTime() const
+{
+    return queuedUs_;
+}
+
 uint64_t Task::GetSeqId() const
 {
     return seqId_;
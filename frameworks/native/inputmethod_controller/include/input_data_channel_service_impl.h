@@ -36,6 +36,8 @@ public:
     ErrCode DeleteBackward(int32_t length, uint64_t msgId, const sptr<IRemoteObject> &agent) override;
     ErrCode GetTextBeforeCursor(int32_t number, uint64_t msgId, const sptr<IRemoteObject> &agent) override;
     ErrCode GetTextAfterCursor(int32_t number, uint64_t msgId, const sptr<IRemoteObject> &agent) override;
+    ErrCode GetTextBeforeCursorU16(int32_t number, uint64_t msgId, const sptr<IRemoteObject> &agent) override;
+    ErrCode GetTextAfterCursorU16(int32_t number, uint64_t msgId, const sptr<IRemoteObject> &agent) override;
     ErrCode GetTextConfig(TextTotalConfigInner &textConfigInner) override;
     ErrCode SendKeyboardStatus(int32_t status) override;
     ErrCode SendFunctionKey(int32_t funcKey, uint64_t msgId, const sptr<IRemoteObject> &agent) override;
@@ -54,7 +56,11 @@ public:
         const sptr<IRemoteObject> &agent) override;
     ErrCode FinishTextPreview(uint64_t msgId, const sptr<IRemoteObject> &agent) override;
     ErrCode SendMessage(const ArrayBuffer &arraybuffer) override;
+    ErrCode SetMessageBuffer(const SharedMessageBufferInner &buffer) override;
+    ErrCode SendSharedMessage(const SharedMessageInner &msg) override;
     ErrCode HandleKeyEventResult(uint64_t cbId, bool consumeResult) override;
+    ErrCode CommitEditBatch(const EditBatchInner &batch, uint64_t msgId, const sptr<IRemoteObject> &agent) override;
+    ErrCode RequestTextSync(const sptr<IRemoteObject> &agent) override;
 };
 }  // namespace MiscServices
 }  // namespace OHOS
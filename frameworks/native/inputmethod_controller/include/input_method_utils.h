@@ -35,6 +35,9 @@ constexpr size_t MAX_SYS_PRIVATE_COMMAND_COUNT = MAX_PRIVATE_COMMAND_COUNT + 1;
 constexpr size_t MAX_VALUE_MAP_COUNT = 256;
 constexpr size_t MAX_ARRAY_BUFFER_MSG_ID_SIZE = 256; // 256B
 constexpr size_t MAX_ARRAY_BUFFER_MSG_PARAM_SIZE = 128 * 1024; // 128KB
+constexpr size_t SHARED_MESSAGE_MIN_SIZE = 16 * 1024; // msgParam from 16KB goes through shared memory
+constexpr int32_t SHARED_MESSAGE_BUFFER_SIZE = 2 * MAX_ARRAY_BUFFER_MSG_PARAM_SIZE;
+constexpr size_t MAX_EDIT_BATCH_OPERATION_COUNT = 64;
 static constexpr uint64_t INVALID_DISPLAY_ID = -1ULL;
 const constexpr char *SYSTEM_CMD_KEY = "sys_cmd";
 enum class EnterKeyType {
@@ -519,6 +522,25 @@ struct ArrayBuffer : public Parcelable {
     static ArrayBuffer *Unmarshalling(Parcel &in);
 };
 
+// shared memory negotiated once per bind to carry large ArrayBuffer messages
+struct SharedMessageBufferInner : public Parcelable {
+    sptr<Ashmem> ashmem = nullptr;
+    bool ReadFromParcel(Parcel &in);
+    bool Marshalling(Parcel &out) const override;
+    static SharedMessageBufferInner *Unmarshalling(Parcel &in);
+};
+
+// ArrayBuffer whose msgParam is located at [offset, offset + length) of the shared message buffer
+struct SharedMessageInner : public Parcelable {
+    size_t jsArgc = 0;
+    std::string msgId;
+    uint32_t offset = 0;
+    uint32_t length = 0;
+    bool ReadFromParcel(Parcel &in);
+    bool Marshalling(Parcel &out) const override;
+    static SharedMessageInner *Unmarshalling(Parcel &in);
+};
+
 struct AttachOptions {
     bool isShowKeyboard = false;
     bool isSimpleKeyboardEnabled = false;
@@ -536,9 +558,65 @@ struct DetachOptions {
     bool isNotifyClientAsync{ false };
 };
 
-enum class ResponseDataType : uint64_t { NONE_TYPE = 0, STRING_TYPE, INT32_TYPE };
+enum class ResponseDataType : uint64_t { NONE_TYPE = 0, STRING_TYPE, INT32_TYPE, U16STRING_TYPE };
 
-using ResponseData = std::variant<std::monostate, std::string, int32_t>;
+using ResponseData = std::variant<std::monostate, std::string, int32_t, std::u16string>;
+
+/*
+ * Difference between two versions of the editor text: replace removedLength UTF-16 code units at offset
+ * with insertedText. A delta whose baseVersion is 0 carries the full text.
+ */
+struct TextDeltaInner : public Parcelable {
+    uint64_t baseVersion = 0;
+    uint64_t version = 0;
+    int32_t offset = 0;
+    int32_t removedLength = 0;
+    std::u16string insertedText;
+    bool IsFullText() const
+    {
+        return baseVersion == 0;
+    }
+    static TextDeltaInner Diff(const std::u16string &oldText, const std::u16string &newText);
+    static TextDeltaInner FullText(const std::u16string &text, uint64_t version);
+    bool ApplyTo(std::u16string &text) const;
+    bool ReadFromParcel(Parcel &in);
+    bool Marshalling(Parcel &out) const override;
+    static TextDeltaInner *Unmarshalling(Parcel &in);
+};
+
+enum class EditOperationType : int32_t {
+    INSERT_TEXT = 0,
+    DELETE_FORWARD,
+    DELETE_BACKWARD,
+    MOVE_CURSOR,
+    SELECT_BY_RANGE,
+    END,
+};
+
+struct EditOperation {
+    EditOperationType type = EditOperationType::END;
+    std::string text;          // valid for INSERT_TEXT
+    int32_t length = 0;        // valid for DELETE_FORWARD and DELETE_BACKWARD
+    int32_t direction = 0;     // valid for MOVE_CURSOR
+    Range range = {};          // valid for SELECT_BY_RANGE
+    bool operator==(const EditOperation &operation) const
+    {
+        return type == operation.type && text == operation.text && length == operation.length &&
+            direction == operation.direction && range == operation.range;
+    }
+};
+
+/*
+ * A sequence of edit operations which is sent to the editor in one ipc and applied in order,
+ * without other text operations being interleaved.
+ */
+struct EditBatchInner : public Parcelable {
+    std::vector<EditOperation> operations;
+    static bool IsValid(const std::vector<EditOperation> &operations);
+    bool ReadFromParcel(Parcel &in);
+    bool Marshalling(Parcel &out) const override;
+    static EditBatchInner *Unmarshalling(Parcel &in);
+};
 
 struct ResponseDataInner : public Parcelable {
     bool ReadFromParcel(Parcel &in);
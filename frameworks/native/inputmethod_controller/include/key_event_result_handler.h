@@ -14,6 +14,8 @@
  */
 #ifndef FRAMEWORKS_INPUTMETHOD_KEY_EVENT_RESULT_HANDLER_H
 #define FRAMEWORKS_INPUTMETHOD_KEY_EVENT_RESULT_HANDLER_H
+#include <atomic>
+#include <condition_variable>
 #include <map>
 #include <mutex>
 
@@ -24,6 +26,12 @@ using KeyEventCallback = std::function<void(std::shared_ptr<MMI::KeyEvent> &keyE
 struct KeyEventCbInfo {
     std::shared_ptr<MMI::KeyEvent> keyEvent{ nullptr };
     KeyEventCallback callback{ nullptr };
+    // results of ordered key events are delivered in the order the events were dispatched
+    bool isOrdered{ false };
+    bool isDone{ false };
+    bool isConsumed{ false };
+    // no longer holds a window slot nor the results behind it, its own result is still delivered when it comes
+    bool isExpired{ false };
 };
 class KeyEventResultHandler {
 public:
@@ -31,13 +39,20 @@ public:
     void RemoveKeyEventCbInfo(uint64_t cbId);
     void HandleKeyEventResult(uint64_t cbId, bool consumeResult);
     void ClearKeyEventCbInfo();
+    /* waits until less than window ordered key events are in flight, the oldest one expires on timeout */
+    void WaitForWindow(uint32_t window, uint32_t timeoutMs);
+    uint32_t GetInflightCount();
 
 private:
     int32_t GetKeyEventCbInfo(uint64_t cbId, KeyEventCbInfo &info);
     uint64_t GenerateKeyEventCbId();
+    void DeliverOrderedResults();
     std::mutex keyEventCbHandlersMutex_;
     std::map<uint64_t, KeyEventCbInfo> keyEventCbHandlers_;
     std::atomic<uint64_t> maxCbId_{1};
+    std::condition_variable windowCv_;
+    uint32_t inflightCount_{ 0 };
+    std::mutex deliverMutex_;
 };
 } // namespace MiscServices
 } // namespace OHOS
@@ -101,6 +101,36 @@ ErrCode InputDataChannelServiceImpl::GetTextAfterCursor(
     return ret;
 }
 
+ErrCode InputDataChannelServiceImpl::GetTextBeforeCursorU16(
+    int32_t number, uint64_t msgId, const sptr<IRemoteObject> &agent)
+{
+    auto instance = InputMethodController::GetInstance();
+    if (instance == nullptr) {
+        IMSA_HILOGE("failed to get InputMethodController instance!");
+        return ErrorCode::ERROR_EX_NULL_POINTER;
+    }
+    std::u16string text;
+    int32_t ret = instance->GetLeft(number, text);
+    ResponseData data = std::move(text);
+    instance->ResponseDataChannel(agent, msgId, ret, data);
+    return ret;
+}
+
+ErrCode InputDataChannelServiceImpl::GetTextAfterCursorU16(
+    int32_t number, uint64_t msgId, const sptr<IRemoteObject> &agent)
+{
+    auto instance = InputMethodController::GetInstance();
+    if (instance == nullptr) {
+        IMSA_HILOGE("failed to get InputMethodController instance!");
+        return ErrorCode::ERROR_EX_NULL_POINTER;
+    }
+    std::u16string text;
+    auto ret = instance->GetRight(number, text);
+    ResponseData data = std::move(text);
+    instance->ResponseDataChannel(agent, msgId, ret, data);
+    return ret;
+}
+
 ErrCode InputDataChannelServiceImpl::GetTextIndexAtCursor(uint64_t msgId, const sptr<IRemoteObject> &agent)
 {
     int32_t index = 0;
@@ -302,6 +332,26 @@ ErrCode InputDataChannelServiceImpl::SendMessage(const ArrayBuffer &arraybuffer)
     return instance->RecvMessage(arraybuffer);
 }
 
+ErrCode InputDataChannelServiceImpl::SetMessageBuffer(const SharedMessageBufferInner &buffer)
+{
+    auto instance = InputMethodController::GetInstance();
+    if (instance == nullptr) {
+        IMSA_HILOGE("failed to get InputMethodController instance!");
+        return ErrorCode::ERROR_EX_NULL_POINTER;
+    }
+    return instance->SetRecvMessageBuffer(buffer.ashmem);
+}
+
+ErrCode InputDataChannelServiceImpl::SendSharedMessage(const SharedMessageInner &msg)
+{
+    auto instance = InputMethodController::GetInstance();
+    if (instance == nullptr) {
+        IMSA_HILOGE("failed to get InputMethodController instance!");
+        return ErrorCode::ERROR_EX_NULL_POINTER;
+    }
+    return instance->RecvSharedMessage(msg);
+}
+
 ErrCode InputDataChannelServiceImpl::HandleKeyEventResult(uint64_t cbId, bool consumeResult)
 {
     auto instance = InputMethodController::GetInstance();
@@ -312,5 +362,31 @@ ErrCode InputDataChannelServiceImpl::HandleKeyEventResult(uint64_t cbId, bool co
     instance->HandleKeyEventResult(cbId, consumeResult);
     return ERR_OK;
 }
+// LCOV_EXCL_START
+ErrCode InputDataChannelServiceImpl::CommitEditBatch(
+    const EditBatchInner &batch, uint64_t msgId, const sptr<IRemoteObject> &agent)
+{
+    auto instance = InputMethodController::GetInstance();
+    if (instance == nullptr) {
+        IMSA_HILOGE("failed to get InputMethodController instance!");
+        return ErrorCode::ERROR_EX_NULL_POINTER;
+    }
+    auto ret = instance->CommitEditBatch(batch.operations);
+    ResponseData data = std::monostate{};
+    instance->ResponseDataChannel(agent, msgId, ret, data);
+    return ret;
+}
+
+ErrCode InputDataChannelServiceImpl::RequestTextSync(const sptr<IRemoteObject> &agent)
+{
+    auto instance = InputMethodController::GetInstance();
+    if (instance == nullptr) {
+        IMSA_HILOGE("failed to get InputMethodController instance!");
+        return ErrorCode::ERROR_EX_NULL_POINTER;
+    }
+    instance->OnTextSyncRequest(agent);
+    return ERR_OK;
+}
+// LCOV_EXCL_STOP
 } // namespace MiscServices
 } // namespace OHOS
\ No newline at end of file
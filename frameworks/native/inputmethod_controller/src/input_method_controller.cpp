@@ -34,11 +34,13 @@
 #include "iservice_registry.h"
 #include "keyevent_consumer_service_impl.h"
 #include "on_demand_start_stop_sa.h"
+#include "shared_message_buffer.h"
 #include "string_ex.h"
 #include "string_utils.h"
 #include "sys/prctl.h"
 #include "system_ability_definition.h"
 #include "system_cmd_channel_stub.h"
+#include "typing_latency_tracer.h"
 #include "input_method_tools.h"
 #include "notify_service_impl.h"
 #include "on_input_stop_notify_proxy.h"
@@ -66,6 +68,9 @@ constexpr int32_t MAX_PLACEHOLDER_SIZE = 255; // 256 utf16 char
 constexpr int32_t MAX_ABILITY_NAME_SIZE = 127; // 127 utf16 char
 static constexpr int32_t MAX_TIMEOUT = 2500;
 constexpr int64_t DISPATCH_KEYBOARD_TIME_OUT = 5; // 5ms
+constexpr uint32_t MAX_KEY_EVENT_WINDOW = 32;
+constexpr uint32_t KEY_EVENT_WINDOW_WAIT_TIME = 200; // 200ms
+constexpr uint32_t MAX_COALESCE_INTERVAL = 100; // 100ms
 constexpr size_t MAX_AGENT_NUMBER = 2;
 const std::string IME_MIRROR_NAME = "proxyIme_IME_MIRROR";
 InputMethodController::InputMethodController()
@@ -135,6 +140,13 @@ void InputMethodController::SetControllerListener(std::shared_ptr<ControllerList
 
 int32_t InputMethodController::Initialize()
 {
+    TypingLatencyTracer::Init();
+    TypingLatencyTracer::SetReporter([this](const std::string &ring) {
+        auto proxy = GetSystemAbilityProxy(false);
+        if (proxy != nullptr) {
+            proxy->ReportTypingTrace(ring);
+        }
+    });
     sptr<IInputClient> client = new (std::nothrow) InputClientServiceImpl();
     if (client == nullptr) {
         IMSA_HILOGE("failed to create client!");
@@ -804,6 +816,20 @@ int32_t InputMethodController::OnCursorUpdate(CursorInfo cursorInfo)
         }
         cursorInfo_ = cursorInfo;
     }
+    auto isBuffered = BufferUpdate([&cursorInfo](PendingUpdates &pending) {
+        bool isReplaced = pending.hasCursor;
+        pending.hasCursor = true;
+        pending.cursorInfo = cursorInfo;
+        return isReplaced;
+    });
+    if (isBuffered) {
+        return ErrorCode::NO_ERROR;
+    }
+    return SendCursorToAllAgents(cursorInfo);
+}
+
+int32_t InputMethodController::SendCursorToAllAgents(const CursorInfo &cursorInfo)
+{
     IMSA_HILOGI("left: %{public}d, top: %{public}d, height: %{public}d.", static_cast<int32_t>(cursorInfo.left),
         static_cast<int32_t>(cursorInfo.top), static_cast<int32_t>(cursorInfo.height));
     return SendRequestToAllAgents([cursorInfo](std::shared_ptr<IInputMethodAgent> agent) -> int32_t {
@@ -827,27 +853,96 @@ int32_t InputMethodController::OnSelectionChange(std::u16string text, int start,
         textConfig_.range.start = start;
         textConfig_.range.end = end;
     }
+    TextDeltaInner delta;
+    Range oldRange;
+    bool isBuffered = false;
     {
         std::lock_guard<std::mutex> lock(editorContentLock_);
         if (isTextNotified_.exchange(true) && textString_ == text && selectNewBegin_ == start && selectNewEnd_ == end) {
             IMSA_HILOGD("same to last update.");
             return ErrorCode::NO_ERROR;
         }
+        // the first buffered change keeps the state the agents hold, the flush sends one delta from there
+        isBuffered = BufferUpdate([this](PendingUpdates &pending) {
+            if (pending.hasText) {
+                return true;
+            }
+            pending.hasText = true;
+            pending.baseText = textString_;
+            pending.baseVersion = textVersion_;
+            pending.oldRange = { selectNewBegin_, selectNewEnd_ };
+            return false;
+        });
+        if (textString_ != text) {
+            if (!isBuffered) {
+                delta = TextDeltaInner::Diff(textString_, text);
+            }
+            delta.baseVersion = textVersion_;
+            delta.version = ++textVersion_;
+        } else {
+            delta.baseVersion = textVersion_;
+            delta.version = textVersion_;
+        }
         textString_ = text;
         selectOldBegin_ = selectNewBegin_;
         selectOldEnd_ = selectNewEnd_;
         selectNewBegin_ = start;
         selectNewEnd_ = end;
+        oldRange = { selectOldBegin_, selectOldEnd_ };
     }
     IMSA_HILOGI("IMC size: %{public}zu, range: %{public}d/%{public}d/%{public}d/%{public}d.", text.size(),
-        selectOldBegin_, selectOldEnd_, start, end);
-    std::string testString = Str16ToStr8(text);
-    return SendRequestToAllAgents(
-        [testString, selectOldBegin = selectOldBegin_, selectOldEnd = selectOldEnd_, selectNewBegin = selectNewBegin_,
-            selectNewEnd = selectNewEnd_](std::shared_ptr<IInputMethodAgent> agent) -> int32_t {
-            agent->OnSelectionChange(testString, selectOldBegin, selectOldEnd, selectNewBegin, selectNewEnd);
-            return ErrorCode::NO_ERROR;
-        });
+        oldRange.start, oldRange.end, start, end);
+    if (isBuffered) {
+        return ErrorCode::NO_ERROR;
+    }
+    return SendTextDeltaToAllAgents(delta, text, oldRange, { start, end });
+}
+
+int32_t InputMethodController::SendTextDeltaToAllAgents(const TextDeltaInner &delta, const std::u16string &text,
+    const Range &oldRange, const Range &newRange)
+{
+    return SendRequestToAllAgentInfos([&delta, &text, &oldRange, &newRange](AgentInfo &agentInfo) -> int32_t {
+        // the delta is only usable if the agent holds its base version, otherwise send the full text
+        bool useDelta = !delta.IsFullText() && agentInfo.textVersion == delta.baseVersion;
+        auto ret = agentInfo.agent->OnTextDeltaChange(useDelta ? delta : TextDeltaInner::FullText(text, delta.version),
+            oldRange.start, oldRange.end, newRange.start, newRange.end);
+        agentInfo.textVersion = ret == ErrorCode::NO_ERROR ? delta.version : 0;
+        return ret;
+    });
+}
+
+void InputMethodController::OnTextSyncRequest(const sptr<IRemoteObject> &agentObject)
+{
+    if (agentObject == nullptr || !IsEditable()) {
+        IMSA_HILOGD("not editable or agent is nullptr.");
+        return;
+    }
+    std::u16string text;
+    uint64_t version = 0;
+    Range oldRange;
+    Range newRange;
+    {
+        std::lock_guard<std::mutex> lock(editorContentLock_);
+        text = textString_;
+        version = textVersion_;
+        oldRange = { selectOldBegin_, selectOldEnd_ };
+        newRange = { selectNewBegin_, selectNewEnd_ };
+    }
+    std::lock_guard guard(agentLock_);
+    auto it = std::find_if(agentInfoList_.begin(), agentInfoList_.end(),
+        [&agentObject](const AgentInfo &info) { return info.agentObject == agentObject; });
+    if (it == agentInfoList_.end() || it->agent == nullptr) {
+        IMSA_HILOGW("agent not found.");
+        return;
+    }
+    if (it->imeType == ImeType::IME_MIRROR && textConfig_.inputAttribute.IsSecurityImeFlag()) {
+        IMSA_HILOGW("password not allow send to ime mirror");
+        return;
+    }
+    IMSA_HILOGI("resync text, version: %{public}" PRIu64 ", size: %{public}zu.", version, text.size());
+    auto ret = it->agent->OnTextDeltaChange(TextDeltaInner::FullText(text, version), oldRange.start, oldRange.end,
+        newRange.start, newRange.end);
+    it->textVersion = ret == ErrorCode::NO_ERROR ? version : 0;
 }
 
 int32_t InputMethodController::OnConfigurationChange(Configuration info)
@@ -881,6 +976,20 @@ int32_t InputMethodController::OnConfigurationChange(Configuration info)
         SetInputReady(agents, imeInfos);
     }
 
+    auto isBuffered = BufferUpdate([&attribute](PendingUpdates &pending) {
+        bool isReplaced = pending.hasAttribute;
+        pending.hasAttribute = true;
+        pending.attribute = attribute;
+        return isReplaced;
+    });
+    if (isBuffered) {
+        return ErrorCode::NO_ERROR;
+    }
+    return SendAttributeToAgent(attribute);
+}
+
+int32_t InputMethodController::SendAttributeToAgent(const InputAttribute &attribute)
+{
     auto agent = GetAgent();
     if (agent == nullptr) {
         IMSA_HILOGE("agent is nullptr!");
@@ -891,6 +1000,98 @@ int32_t InputMethodController::OnConfigurationChange(Configuration info)
     return ErrorCode::NO_ERROR;
 }
 
+int32_t InputMethodController::SetUpdateCoalesceInterval(uint32_t intervalMs)
+{
+    if (intervalMs > MAX_COALESCE_INTERVAL) {
+        IMSA_HILOGE("invalid interval: %{public}u.", intervalMs);
+        return ErrorCode::ERROR_PARAMETER_CHECK_FAILED;
+    }
+    IMSA_HILOGI("coalesce interval: %{public}u.", intervalMs);
+    coalesceInterval_.store(intervalMs);
+    if (intervalMs == 0) {
+        FlushPendingUpdates();
+    }
+    return ErrorCode::NO_ERROR;
+}
+
+void InputMethodController::GetUpdateCoalesceStats(uint64_t &coalesced, uint64_t &sent)
+{
+    coalesced = coalescedUpdateCount_.load();
+    sent = sentUpdateCount_.load();
+}
+
+bool InputMethodController::BufferUpdate(const std::function<bool(PendingUpdates &)> &update)
+{
+    auto interval = coalesceInterval_.load();
+    if (interval == 0 || handler_ == nullptr) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(coalesceLock_);
+    if (update(pendingUpdates_)) {
+        coalescedUpdateCount_++;
+    }
+    hasPendingUpdates_.store(true);
+    if (isFlushScheduled_) {
+        return true;
+    }
+    auto flushTask = [this]() {
+        {
+            std::lock_guard<std::mutex> lock(coalesceLock_);
+            isFlushScheduled_ = false;
+        }
+        FlushPendingUpdates();
+    };
+    isFlushScheduled_ = handler_->PostTask(flushTask, "FlushPendingUpdates", interval);
+    if (!isFlushScheduled_) {
+        IMSA_HILOGE("failed to schedule flush, retry on next update.");
+    }
+    return true;
+}
+
+void InputMethodController::FlushPendingUpdates()
+{
+    if (!hasPendingUpdates_.load()) {
+        return;
+    }
+    PendingUpdates pending;
+    TextDeltaInner delta;
+    std::u16string text;
+    Range newRange;
+    {
+        std::lock_guard<std::mutex> contentLock(editorContentLock_);
+        std::lock_guard<std::mutex> lock(coalesceLock_);
+        pending = std::move(pendingUpdates_);
+        pendingUpdates_ = PendingUpdates();
+        hasPendingUpdates_.store(false);
+        if (pending.hasText) {
+            text = textString_;
+            delta = TextDeltaInner::Diff(pending.baseText, textString_);
+            delta.baseVersion = pending.baseVersion;
+            delta.version = textVersion_;
+            newRange = { selectNewBegin_, selectNewEnd_ };
+        }
+    }
+    if (pending.hasText) {
+        SendTextDeltaToAllAgents(delta, text, pending.oldRange, newRange);
+        sentUpdateCount_++;
+    }
+    if (pending.hasCursor) {
+        SendCursorToAllAgents(pending.cursorInfo);
+        sentUpdateCount_++;
+    }
+    if (pending.hasAttribute) {
+        SendAttributeToAgent(pending.attribute);
+        sentUpdateCount_++;
+    }
+}
+
+void InputMethodController::DropPendingUpdates()
+{
+    std::lock_guard<std::mutex> lock(coalesceLock_);
+    pendingUpdates_ = PendingUpdates();
+    hasPendingUpdates_.store(false);
+}
+
 int32_t InputMethodController::GetLeft(int32_t length, std::u16string &text)
 {
     InputMethodSyncTrace tracer("IMC_GetForward");
@@ -959,7 +1160,11 @@ void InputMethodController::PrintKeyEventLog()
 int32_t InputMethodController::DispatchKeyEvent(std::shared_ptr<MMI::KeyEvent> keyEvent, KeyEventCallback callback)
 {
     int64_t startTime = duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+    TypingTraceScope traceScope(
+        TypingTracePoint::IMC_DISPATCH_KEY, keyEvent == nullptr ? 0 : static_cast<uint32_t>(keyEvent->GetId()));
     PrintKeyEventLog();
+    // the input method handles the key with the latest cursor and selection
+    FlushPendingUpdates();
     KeyEventInfo keyEventInfo = { std::chrono::system_clock::now(), keyEvent };
     keyEventQueue_.Push(keyEventInfo);
     InputMethodSyncTrace tracer("DispatchKeyEvent trace");
@@ -991,13 +1196,18 @@ int32_t InputMethodController::DispatchKeyEvent(std::shared_ptr<MMI::KeyEvent> k
         keyEventQueue_.Pop();
         return ErrorCode::ERROR_EX_NULL_POINTER;
     }
-    auto cbId = keyEventRetHandler_.AddKeyEventCbInfo({ keyEvent, callback });
-    KeyEventValue keyEventValue;
-    keyEventValue.event = keyEvent;
-    auto ret = agent->DispatchKeyEvent(keyEventValue, cbId, channelObject);
-    if (ret != ErrorCode::NO_ERROR) {
-        IMSA_HILOGE("failed to DispatchKeyEvent: %{public}d", ret);
-        keyEventRetHandler_.RemoveKeyEventCbInfo(cbId);
+    int32_t ret = ErrorCode::NO_ERROR;
+    if (keyEventWindow_.load() > 0) {
+        ret = DispatchKeyEventPipelined(agent, keyEvent, callback, channelObject);
+    } else {
+        auto cbId = keyEventRetHandler_.AddKeyEventCbInfo({ keyEvent, callback });
+        KeyEventValue keyEventValue;
+        keyEventValue.event = keyEvent;
+        ret = agent->DispatchKeyEvent(keyEventValue, cbId, channelObject);
+        if (ret != ErrorCode::NO_ERROR) {
+            IMSA_HILOGE("failed to DispatchKeyEvent: %{public}d", ret);
+            keyEventRetHandler_.RemoveKeyEventCbInfo(cbId);
+        }
     }
     keyEventQueue_.Pop();
     int64_t endTime = duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
@@ -1007,6 +1217,36 @@ int32_t InputMethodController::DispatchKeyEvent(std::shared_ptr<MMI::KeyEvent> k
     return ret;
 }
 
+int32_t InputMethodController::DispatchKeyEventPipelined(const std::shared_ptr<IInputMethodAgent> &agent,
+    const std::shared_ptr<MMI::KeyEvent> &keyEvent, const KeyEventCallback &callback,
+    const sptr<IRemoteObject> &channelObject)
+{
+    // the event is sent oneway, its result comes back through HandleKeyEventResult in dispatch order
+    keyEventRetHandler_.WaitForWindow(keyEventWindow_.load(), KEY_EVENT_WINDOW_WAIT_TIME);
+    KeyEventCbInfo cbInfo = { keyEvent, callback };
+    cbInfo.isOrdered = true;
+    auto cbId = keyEventRetHandler_.AddKeyEventCbInfo(cbInfo);
+    KeyEventValue keyEventValue;
+    keyEventValue.event = keyEvent;
+    auto ret = agent->DispatchKeyEventAsync(keyEventValue, cbId, channelObject);
+    if (ret != ErrorCode::NO_ERROR) {
+        IMSA_HILOGE("failed to DispatchKeyEventAsync: %{public}d", ret);
+        keyEventRetHandler_.RemoveKeyEventCbInfo(cbId);
+    }
+    return ret;
+}
+
+int32_t InputMethodController::SetKeyEventPipelineWindow(uint32_t window)
+{
+    if (window > MAX_KEY_EVENT_WINDOW) {
+        IMSA_HILOGE("invalid window: %{public}u.", window);
+        return ErrorCode::ERROR_PARAMETER_CHECK_FAILED;
+    }
+    IMSA_HILOGI("key event window: %{public}u.", window);
+    keyEventWindow_.store(window);
+    return ErrorCode::NO_ERROR;
+}
+
 void InputMethodController::HandleKeyEventResult(uint64_t cbId, bool consumeResult)
 {
     keyEventRetHandler_.HandleKeyEventResult(cbId, consumeResult);
@@ -1268,6 +1508,8 @@ void InputMethodController::OnImeMirrorStop(sptr<IRemoteObject> object)
 void InputMethodController::ClearEditorCache(bool isNewEditor, sptr<OnTextChangedListener> lastListener)
 {
     IMSA_HILOGD("isNewEditor: %{public}d.", isNewEditor);
+    // buffered updates belong to the last editor
+    DropPendingUpdates();
     if (isNewEditor && isBound_.load() && lastListener != nullptr &&
         textConfig_.inputAttribute.isTextPreviewSupported) {
         IMSA_HILOGD("last editor FinishTextPreview");
@@ -1279,6 +1521,8 @@ void InputMethodController::ClearEditorCache(bool isNewEditor, sptr<OnTextChange
         if (isNewEditor || !isBound_.load()) {
             isTextNotified_.store(false);
             textString_ = Str8ToStr16("");
+            // agents holding the old text must resync from the full text
+            textVersion_++;
             selectOldBegin_ = INVALID_VALUE;
             selectOldEnd_ = INVALID_VALUE;
             selectNewBegin_ = INVALID_VALUE;
@@ -1304,6 +1548,7 @@ void InputMethodController::ClearEditorCache(bool isNewEditor, sptr<OnTextChange
 void InputMethodController::SelectByRange(int32_t start, int32_t end)
 {
     IMSA_HILOGD("InputMethodController start: %{public}d, end: %{public}d.", start, end);
+    FlushPendingUpdates();
     auto listener = GetTextListener();
     if (IsEditable() && listener != nullptr) {
         listener->HandleSetSelectionV2(start, end);
@@ -1322,6 +1567,7 @@ void InputMethodController::SelectByMovement(int32_t direction, int32_t cursorMo
 {
     IMSA_HILOGD(
         "InputMethodController start, direction: %{public}d, cursorMoveSkip: %{public}d", direction, cursorMoveSkip);
+    FlushPendingUpdates();
     auto listener = GetTextListener();
     if (IsEditable() && listener != nullptr) {
         listener->HandleSelectV2(CURSOR_DIRECTION_BASE_VALUE + direction, cursorMoveSkip);
@@ -1339,6 +1585,7 @@ void InputMethodController::SelectByMovement(int32_t direction, int32_t cursorMo
 int32_t InputMethodController::HandleExtendAction(int32_t action)
 {
     IMSA_HILOGD("InputMethodController start, action: %{public}d.", action);
+    FlushPendingUpdates();
     auto listener = GetTextListener();
     if (!IsEditable() || listener == nullptr) {
         IMSA_HILOGE("not editable or textListener is nullptr!");
@@ -1392,6 +1639,7 @@ int32_t InputMethodController::InsertText(const std::u16string &text)
 {
     InputMethodSyncTrace tracer("IMC_InsertText");
     IMSA_HILOGD("start.");
+    FlushPendingUpdates();
     auto listener = GetTextListener();
     if (!IsEditable() || listener == nullptr) {
         IMSA_HILOGE("not editable or textListener is nullptr!");
@@ -1414,6 +1662,7 @@ int32_t InputMethodController::DeleteForward(int32_t length)
 {
     InputMethodSyncTrace tracer("IMC_DeleteForward");
     IMSA_HILOGD("start, length: %{public}d.", length);
+    FlushPendingUpdates();
     auto listener = GetTextListener();
     if (!IsEditable() || listener == nullptr) {
         IMSA_HILOGE("not editable or textListener is nullptr!");
@@ -1434,6 +1683,7 @@ int32_t InputMethodController::DeleteForward(int32_t length)
 int32_t InputMethodController::DeleteBackward(int32_t length)
 {
     IMSA_HILOGD("InputMethodController start, length: %{public}d.", length);
+    FlushPendingUpdates();
     auto listener = GetTextListener();
     if (!IsEditable() || listener == nullptr) {
         IMSA_HILOGE("not editable or textListener is nullptr!");
@@ -1446,9 +1696,43 @@ int32_t InputMethodController::DeleteBackward(int32_t length)
     return ErrorCode::NO_ERROR;
 }
 
+int32_t InputMethodController::CommitEditBatch(const std::vector<EditOperation> &operations)
+{
+    InputMethodSyncTrace tracer("IMC_CommitEditBatch");
+    IMSA_HILOGD("start, size: %{public}zu.", operations.size());
+    FlushPendingUpdates();
+    auto listener = GetTextListener();
+    if (!IsEditable() || listener == nullptr) {
+        IMSA_HILOGE("not editable or textListener is nullptr!");
+        ReportBaseTextOperation(static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_COMMIT_EDIT_BATCH),
+            ErrorCode::ERROR_CLIENT_NOT_EDITABLE);
+        return ErrorCode::ERROR_CLIENT_NOT_EDITABLE;
+    }
+    // validate the whole batch first, so that either all operations are applied or none of them
+    if (!EditBatchInner::IsValid(operations)) {
+        return ErrorCode::ERROR_PARAMETER_CHECK_FAILED;
+    }
+    int64_t start = duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+    {
+        InputMethodSyncTrace aceTracer("ACE_CommitEditBatch");
+        listener->CommitEditBatchV2(operations);
+    }
+    if (controllerListener_ != nullptr) {
+        for (const auto &operation : operations) {
+            if (operation.type == EditOperationType::SELECT_BY_RANGE) {
+                controllerListener_->OnSelectByRange(operation.range.start, operation.range.end);
+            }
+        }
+    }
+    PrintTextChangeLog();
+    PrintLogIfAceTimeout(start);
+    return ErrorCode::NO_ERROR;
+}
+
 int32_t InputMethodController::MoveCursor(Direction direction)
 {
     IMSA_HILOGD("InputMethodController start, direction: %{public}d.", static_cast<int32_t>(direction));
+    FlushPendingUpdates();
     auto listener = GetTextListener();
     if (!IsEditable() || listener == nullptr) {
         IMSA_HILOGE("not editable or textListener_ is nullptr!");
@@ -1512,6 +1796,7 @@ void InputMethodController::NotifyKeyboardHeight(uint32_t height)
 int32_t InputMethodController::SendFunctionKey(int32_t functionKey)
 {
     IMSA_HILOGD("InputMethodController start, functionKey: %{public}d", static_cast<int32_t>(functionKey));
+    FlushPendingUpdates();
     auto listener = GetTextListener();
     if (!IsEditable() || listener == nullptr) {
         IMSA_HILOGE("not editable or listener is nullptr!");
@@ -1700,6 +1985,7 @@ int32_t InputMethodController::SetPreviewTextInner(const std::string &text, cons
 {
     InputMethodSyncTrace tracer("IMC_SetPreviewText");
     IMSA_HILOGD("IMC start.");
+    FlushPendingUpdates();
     if (!textConfig_.inputAttribute.isTextPreviewSupported) {
         IMSA_HILOGE("text preview do not supported!");
         return ErrorCode::ERROR_TEXT_PREVIEW_NOT_SUPPORTED;
@@ -1728,6 +2014,7 @@ int32_t InputMethodController::FinishTextPreview()
 {
     InputMethodSyncTrace tracer("IMC_FinishTextPreview");
     IMSA_HILOGD("IMC start.");
+    FlushPendingUpdates();
     if (!textConfig_.inputAttribute.isTextPreviewSupported) {
         IMSA_HILOGD("text preview do not supported!");
         ReportBaseTextOperation(static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_FINISH_TEXT_PREVIEW),
@@ -1767,9 +2054,51 @@ int32_t InputMethodController::SendMessage(const ArrayBuffer &arrayBuffer)
         IMSA_HILOGE("agent is nullptr!");
         return ErrorCode::ERROR_CLIENT_NULL_POINTER;
     }
+    if (arrayBuffer.msgParam.size() >= SHARED_MESSAGE_MIN_SIZE) {
+        // hold the lock until the ime has read the message, the region is reused by the next write
+        std::lock_guard<std::mutex> lock(sendMsgBufferLock_);
+        SharedMessageInner msg;
+        if (WriteSharedMessage(agent, arrayBuffer, msg)) {
+            auto ret = agent->SendSharedMessage(msg);
+            // a failed message handler has seen the message already, anything else did not deliver it
+            if (ret == ErrorCode::NO_ERROR || ret == ErrorCode::ERROR_MESSAGE_HANDLER) {
+                return ret;
+            }
+            // the ime may have dropped the buffer on rebind, the next message shares it again
+            IMSA_HILOGW("send shared message failed, ret: %{public}d, send by parcel.", ret);
+            msgBufferPeer_.reset();
+        } else {
+            IMSA_HILOGW("shared message buffer unavailable, send by parcel.");
+        }
+    }
     return agent->SendMessage(arrayBuffer);
 }
 
+bool InputMethodController::WriteSharedMessage(
+    const std::shared_ptr<IInputMethodAgent> &agent, const ArrayBuffer &arrayBuffer, SharedMessageInner &msg)
+{
+    if (sendMsgBuffer_ == nullptr) {
+        sendMsgBuffer_ = SharedMessageBuffer::Create(SHARED_MESSAGE_BUFFER_SIZE);
+        if (sendMsgBuffer_ == nullptr) {
+            return false;
+        }
+    }
+    if (msgBufferPeer_.lock() != agent) {
+        SharedMessageBufferInner buffer;
+        buffer.ashmem = sendMsgBuffer_->GetAshmem();
+        auto ret = agent->SetMessageBuffer(buffer);
+        if (ret != ErrorCode::NO_ERROR) {
+            IMSA_HILOGE("failed to share message buffer, ret: %{public}d!", ret);
+            return false;
+        }
+        msgBufferPeer_ = agent;
+    }
+    msg.jsArgc = arrayBuffer.jsArgc;
+    msg.msgId = arrayBuffer.msgId;
+    msg.length = static_cast<uint32_t>(arrayBuffer.msgParam.size());
+    return sendMsgBuffer_->Write(arrayBuffer.msgParam, msg.offset);
+}
+
 int32_t InputMethodController::RecvMessage(const ArrayBuffer &arrayBuffer)
 {
     if (!IsBound()) {
@@ -1788,6 +2117,40 @@ int32_t InputMethodController::RecvMessage(const ArrayBuffer &arrayBuffer)
     return msgHandlerCallback->OnMessage(arrayBuffer);
 }
 
+int32_t InputMethodController::SetRecvMessageBuffer(const sptr<Ashmem> &ashmem)
+{
+    auto buffer = SharedMessageBuffer::Attach(ashmem);
+    if (buffer == nullptr) {
+        IMSA_HILOGE("failed to attach message buffer!");
+        return ErrorCode::ERROR_CLIENT_NULL_POINTER;
+    }
+    std::lock_guard<std::mutex> lock(recvMsgBufferLock_);
+    recvMsgBuffer_ = buffer;
+    return ErrorCode::NO_ERROR;
+}
+
+int32_t InputMethodController::RecvSharedMessage(const SharedMessageInner &msg)
+{
+    std::shared_ptr<SharedMessageBuffer> buffer = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(recvMsgBufferLock_);
+        buffer = recvMsgBuffer_;
+    }
+    if (buffer == nullptr) {
+        IMSA_HILOGE("message buffer is not set!");
+        return ErrorCode::ERROR_CLIENT_NULL_POINTER;
+    }
+    ArrayBuffer arrayBuffer;
+    arrayBuffer.jsArgc = msg.jsArgc;
+    arrayBuffer.msgId = msg.msgId;
+    if (msg.length > MAX_ARRAY_BUFFER_MSG_PARAM_SIZE || !buffer->Read(msg.offset, msg.length, arrayBuffer.msgParam) ||
+        !ArrayBuffer::IsSizeValid(arrayBuffer)) {
+        IMSA_HILOGE("invalid shared message: %{public}u/%{public}u!", msg.offset, msg.length);
+        return ErrorCode::ERROR_INVALID_ARRAY_BUFFER_SIZE;
+    }
+    return RecvMessage(arrayBuffer);
+}
+
 int32_t InputMethodController::RegisterMsgHandler(const std::shared_ptr<MsgHandlerCallbackInterface> &msgHandler)
 {
     IMSA_HILOGI("isRegist: %{public}d", msgHandler != nullptr);
@@ -1925,10 +2288,49 @@ int32_t InputMethodController::ResponseDataChannel(
         IMSA_HILOGE("agentObject is nullptr!");
         return ErrorCode::ERROR_IME_NOT_STARTED;
     }
-    auto agent = std::make_shared<InputMethodAgentProxy>(agentObject);
+    auto agent = GetResponseAgent(agentObject);
+    if (agent == nullptr) {
+        IMSA_HILOGE("agent is nullptr!");
+        return ErrorCode::ERROR_IME_NOT_STARTED;
+    }
     ResponseDataInner inner;
     inner.rspData = data;
-    return agent->ResponseDataChannel(msgId, code, inner);
+    // oneway, the ime matches the response by msgId and the editor does not wait for the ime
+    auto ret = agent->ResponseDataChannelAsync(msgId, code, inner);
+    if (ret != ERR_OK) {
+        IMSA_HILOGE("failed to response, id: %{public}" PRIu64 ", ret: %{public}d.", msgId, ret);
+        ClearResponseAgent();
+    }
+    return ret;
+}
+
+std::shared_ptr<IInputMethodAgent> InputMethodController::GetResponseAgent(const sptr<IRemoteObject> &agentObject)
+{
+    {
+        // every bound agent, the ime and its mirror or proxy, replies through its own proxy
+        std::lock_guard guard(agentLock_);
+        auto it = std::find_if(agentInfoList_.begin(), agentInfoList_.end(), [&agentObject](const AgentInfo &info) {
+            return info.agent != nullptr && info.agentObject == agentObject;
+        });
+        if (it != agentInfoList_.end()) {
+            return it->agent;
+        }
+    }
+    // the agent is not bound any more, e.g. it replies after unbind
+    std::lock_guard<std::mutex> lock(rspAgentLock_);
+    if (rspAgent_ != nullptr && rspAgentObject_ == agentObject && !agentObject->IsObjectDead()) {
+        return rspAgent_;
+    }
+    rspAgentObject_ = agentObject;
+    rspAgent_ = std::make_shared<InputMethodAgentProxy>(agentObject);
+    return rspAgent_;
+}
+
+void InputMethodController::ClearResponseAgent()
+{
+    std::lock_guard<std::mutex> lock(rspAgentLock_);
+    rspAgentObject_ = nullptr;
+    rspAgent_ = nullptr;
 }
 
 void InputMethodController::ClearAgentInfo()
@@ -1941,9 +2343,20 @@ void InputMethodController::ClearAgentInfo()
 
     IMSA_HILOGD("Clear all agent info");
     agentInfoList_.clear();
+    ClearResponseAgent();
+    DropPendingUpdates();
+    {
+        std::lock_guard<std::mutex> lock(recvMsgBufferLock_);
+        recvMsgBuffer_ = nullptr;
+    }
 }
 // LCOV_EXCL_START
 int32_t InputMethodController::SendRequestToAllAgents(std::function<int32_t(std::shared_ptr<IInputMethodAgent>)> task)
+{
+    return SendRequestToAllAgentInfos([&task](AgentInfo &agentInfo) { return task(agentInfo.agent); });
+}
+
+int32_t InputMethodController::SendRequestToAllAgentInfos(const std::function<int32_t(AgentInfo &)> &task)
 {
     std::lock_guard guard(agentLock_);
     int32_t finalRet = ErrorCode::NO_ERROR;
@@ -1960,7 +2373,7 @@ int32_t InputMethodController::SendRequestToAllAgents(std::function<int32_t(std:
             IMSA_HILOGE("agent is null");
             return ErrorCode::ERROR_CLIENT_NULL_POINTER;
         }
-        auto ret = task(agentInfo.agent);
+        auto ret = task(agentInfo);
         if (ret != ErrorCode::NO_ERROR) {
             IMSA_HILOGE("failed, ret = %{public}d", ret);
         }
@@ -2401,6 +2814,62 @@ void OnTextChangedListener::OnDetachV2()
     };
     eventHandler->PostTask(task, "OnDetachV2", 0, AppExecFwk::EventQueue::Priority::VIP);
 }
+
+void OnTextChangedListener::CommitEditBatchV2(const std::vector<EditOperation> &operations)
+{
+    auto eventHandler = GetEventHandler();
+    if (eventHandler == nullptr) {
+        for (const auto &operation : operations) {
+            ApplyEditOperation(operation);
+        }
+        return;
+    }
+    auto weakPtr = wptr<OnTextChangedListener>(this);
+    // all operations run in one task, no other text operation can be interleaved
+    auto task = [weakPtr, operations]() {
+        auto listener = weakPtr.promote();
+        if (listener == nullptr) {
+            IMSA_HILOGE("CommitEditBatchV2 listener is nullptr.");
+            return;
+        }
+        for (const auto &operation : operations) {
+            listener->ApplyEditOperation(operation);
+        }
+    };
+    eventHandler->PostTask(task, "CommitEditBatchV2", 0, AppExecFwk::EventQueue::Priority::VIP);
+}
+
+void OnTextChangedListener::ApplyEditOperation(const EditOperation &operation)
+{
+    switch (operation.type) {
+        case EditOperationType::INSERT_TEXT: {
+            InsertText(Str8ToStr16(operation.text));
+            break;
+        }
+        case EditOperationType::DELETE_FORWARD: {
+            // reverse for compatibility
+            DeleteBackward(operation.length);
+            break;
+        }
+        case EditOperationType::DELETE_BACKWARD: {
+            // reverse for compatibility
+            DeleteForward(operation.length);
+            break;
+        }
+        case EditOperationType::MOVE_CURSOR: {
+            MoveCursor(static_cast<Direction>(operation.direction));
+            break;
+        }
+        case EditOperationType::SELECT_BY_RANGE: {
+            HandleSetSelection(operation.range.start, operation.range.end);
+            break;
+        }
+        default: {
+            IMSA_HILOGE("invalid operation type: %{public}d.", static_cast<int32_t>(operation.type));
+            break;
+        }
+    }
+}
 // LCOV_EXCL_STOP
 } // namespace MiscServices
 } // namespace OHOS
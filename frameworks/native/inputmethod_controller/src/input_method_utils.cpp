@@ -13,6 +13,7 @@
  * limitations under the License.
  */
  
+#include <algorithm>
 #include <cinttypes>
 #include "input_method_utils.h"
 #include "input_method_tools.h"
@@ -339,6 +340,55 @@ bool ArrayBuffer::Marshalling(Parcel &out) const
     return true;
 }
 
+bool SharedMessageBufferInner::ReadFromParcel(Parcel &in)
+{
+    ashmem = static_cast<MessageParcel *>(&in)->ReadAshmem();
+    return ashmem != nullptr;
+}
+
+bool SharedMessageBufferInner::Marshalling(Parcel &out) const
+{
+    if (ashmem == nullptr) {
+        return false;
+    }
+    return static_cast<MessageParcel *>(&out)->WriteAshmem(ashmem);
+}
+
+SharedMessageBufferInner *SharedMessageBufferInner::Unmarshalling(Parcel &in)
+{
+    SharedMessageBufferInner *data = new (std::nothrow) SharedMessageBufferInner();
+    if (data && !data->ReadFromParcel(in)) {
+        delete data;
+        data = nullptr;
+    }
+    return data;
+}
+
+bool SharedMessageInner::ReadFromParcel(Parcel &in)
+{
+    jsArgc = static_cast<size_t>(in.ReadUint64());
+    msgId = in.ReadString();
+    offset = in.ReadUint32();
+    length = in.ReadUint32();
+    return true;
+}
+
+bool SharedMessageInner::Marshalling(Parcel &out) const
+{
+    return out.WriteUint64(static_cast<uint64_t>(jsArgc)) && out.WriteString(msgId) && out.WriteUint32(offset) &&
+        out.WriteUint32(length);
+}
+
+SharedMessageInner *SharedMessageInner::Unmarshalling(Parcel &in)
+{
+    SharedMessageInner *data = new (std::nothrow) SharedMessageInner();
+    if (data && !data->ReadFromParcel(in)) {
+        delete data;
+        data = nullptr;
+    }
+    return data;
+}
+
 bool ResponseDataInner::ReadFromParcel(Parcel &in)
 {
     uint64_t index = in.ReadUint64();
@@ -355,6 +405,10 @@ bool ResponseDataInner::ReadFromParcel(Parcel &in)
             rspData = in.ReadInt32();
             break;
         }
+        case static_cast<uint64_t>(ResponseDataType::U16STRING_TYPE): {
+            rspData = in.ReadString16();
+            break;
+        }
         default: {
             IMSA_HILOGE("bad parameter index: %{public}" PRIu64 "", index);
             return false;
@@ -385,11 +439,212 @@ bool ResponseDataInner::Marshalling(Parcel &out) const
             }
             return out.WriteInt32(std::get<int32_t>(rspData));
         }
+        case static_cast<uint64_t>(ResponseDataType::U16STRING_TYPE): {
+            if (!std::holds_alternative<std::u16string>(rspData)) {
+                return false;
+            }
+            return out.WriteString16(std::get<std::u16string>(rspData));
+        }
         default: {
             return false;
         }
     }
 }
 // LCOV_EXCL_STOP
+TextDeltaInner TextDeltaInner::Diff(const std::u16string &oldText, const std::u16string &newText)
+{
+    size_t minSize = std::min(oldText.size(), newText.size());
+    size_t prefix = 0;
+    while (prefix < minSize && oldText[prefix] == newText[prefix]) {
+        prefix++;
+    }
+    size_t suffix = 0;
+    while (suffix < minSize - prefix &&
+        oldText[oldText.size() - 1 - suffix] == newText[newText.size() - 1 - suffix]) {
+        suffix++;
+    }
+    TextDeltaInner delta;
+    delta.offset = static_cast<int32_t>(prefix);
+    delta.removedLength = static_cast<int32_t>(oldText.size() - prefix - suffix);
+    delta.insertedText = newText.substr(prefix, newText.size() - prefix - suffix);
+    return delta;
+}
+
+TextDeltaInner TextDeltaInner::FullText(const std::u16string &text, uint64_t version)
+{
+    TextDeltaInner delta;
+    delta.version = version;
+    delta.insertedText = text;
+    return delta;
+}
+
+bool TextDeltaInner::ApplyTo(std::u16string &text) const
+{
+    if (IsFullText()) {
+        text = insertedText;
+        return true;
+    }
+    if (offset < 0 || removedLength < 0 || static_cast<size_t>(offset) > text.size() ||
+        static_cast<size_t>(removedLength) > text.size() - static_cast<size_t>(offset)) {
+        IMSA_HILOGE("invalid delta: %{public}d/%{public}d, size: %{public}zu.", offset, removedLength, text.size());
+        return false;
+    }
+    text.replace(static_cast<size_t>(offset), static_cast<size_t>(removedLength), insertedText);
+    return true;
+}
+
+bool TextDeltaInner::ReadFromParcel(Parcel &in)
+{
+    baseVersion = in.ReadUint64();
+    version = in.ReadUint64();
+    offset = in.ReadInt32();
+    removedLength = in.ReadInt32();
+    insertedText = in.ReadString16();
+    return true;
+}
+
+bool TextDeltaInner::Marshalling(Parcel &out) const
+{
+    return out.WriteUint64(baseVersion) && out.WriteUint64(version) && out.WriteInt32(offset) &&
+        out.WriteInt32(removedLength) && out.WriteString16(insertedText);
+}
+
+TextDeltaInner *TextDeltaInner::Unmarshalling(Parcel &in)
+{
+    TextDeltaInner *data = new (std::nothrow) TextDeltaInner();
+    if (data && !data->ReadFromParcel(in)) {
+        delete data;
+        data = nullptr;
+    }
+    return data;
+}
+
+bool EditBatchInner::IsValid(const std::vector<EditOperation> &operations)
+{
+    if (operations.empty() || operations.size() > MAX_EDIT_BATCH_OPERATION_COUNT) {
+        IMSA_HILOGE("invalid operation count: %{public}zu.", operations.size());
+        return false;
+    }
+    for (const auto &operation : operations) {
+        switch (operation.type) {
+            case EditOperationType::INSERT_TEXT:
+            case EditOperationType::MOVE_CURSOR:
+                break;
+            case EditOperationType::DELETE_FORWARD:
+            case EditOperationType::DELETE_BACKWARD: {
+                if (operation.length < 0) {
+                    IMSA_HILOGE("invalid delete length: %{public}d.", operation.length);
+                    return false;
+                }
+                break;
+            }
+            case EditOperationType::SELECT_BY_RANGE: {
+                if (operation.range.start < 0 || operation.range.end < 0) {
+                    IMSA_HILOGE("invalid range: %{public}d/%{public}d.", operation.range.start, operation.range.end);
+                    return false;
+                }
+                break;
+            }
+            default: {
+                IMSA_HILOGE("invalid operation type: %{public}d.", static_cast<int32_t>(operation.type));
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool EditBatchInner::ReadFromParcel(Parcel &in)
+{
+    uint32_t size = in.ReadUint32();
+    if (size > MAX_EDIT_BATCH_OPERATION_COUNT) {
+        IMSA_HILOGE("size is invalid: %{public}u!", size);
+        return false;
+    }
+    operations.clear();
+    operations.reserve(size);
+    for (uint32_t index = 0; index < size; index++) {
+        EditOperation operation;
+        operation.type = static_cast<EditOperationType>(in.ReadInt32());
+        switch (operation.type) {
+            case EditOperationType::INSERT_TEXT: {
+                operation.text = in.ReadString();
+                break;
+            }
+            case EditOperationType::DELETE_FORWARD:
+            case EditOperationType::DELETE_BACKWARD: {
+                operation.length = in.ReadInt32();
+                break;
+            }
+            case EditOperationType::MOVE_CURSOR: {
+                operation.direction = in.ReadInt32();
+                break;
+            }
+            case EditOperationType::SELECT_BY_RANGE: {
+                operation.range.start = in.ReadInt32();
+                operation.range.end = in.ReadInt32();
+                break;
+            }
+            default: {
+                IMSA_HILOGE("bad operation type: %{public}d", static_cast<int32_t>(operation.type));
+                return false;
+            }
+        }
+        operations.push_back(std::move(operation));
+    }
+    return true;
+}
+
+bool EditBatchInner::Marshalling(Parcel &out) const
+{
+    if (operations.size() > MAX_EDIT_BATCH_OPERATION_COUNT) {
+        return false;
+    }
+    if (!out.WriteUint32(static_cast<uint32_t>(operations.size()))) {
+        return false;
+    }
+    for (const auto &operation : operations) {
+        if (!out.WriteInt32(static_cast<int32_t>(operation.type))) {
+            return false;
+        }
+        bool ret = false;
+        switch (operation.type) {
+            case EditOperationType::INSERT_TEXT: {
+                ret = out.WriteString(operation.text);
+                break;
+            }
+            case EditOperationType::DELETE_FORWARD:
+            case EditOperationType::DELETE_BACKWARD: {
+                ret = out.WriteInt32(operation.length);
+                break;
+            }
+            case EditOperationType::MOVE_CURSOR: {
+                ret = out.WriteInt32(operation.direction);
+                break;
+            }
+            case EditOperationType::SELECT_BY_RANGE: {
+                ret = out.WriteInt32(operation.range.start) && out.WriteInt32(operation.range.end);
+                break;
+            }
+            default: {
+                break;
+            }
+        }
+        if (!ret) {
+            return false;
+        }
+    }
+    return true;
+}
+
+EditBatchInner *EditBatchInner::Unmarshalling(Parcel &in)
+{
+    EditBatchInner *data = new (std::nothrow) EditBatchInner();
+    if (data && !data->ReadFromParcel(in)) {
+        delete data;
+        data = nullptr;
+    }
+    return data;
+}
 } // namespace MiscServices
 } // namespace OHOS
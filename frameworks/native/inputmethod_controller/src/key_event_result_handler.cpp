@@ -15,6 +15,8 @@
 
 #include "key_event_result_handler.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cinttypes>
 
 #include "global.h"
@@ -27,6 +29,9 @@ uint64_t KeyEventResultHandler::AddKeyEventCbInfo(const KeyEventCbInfo &cbInfo)
     auto cbId = GenerateKeyEventCbId();
     IMSA_HILOGD("%{public}" PRIu64 "add.", cbId);
     keyEventCbHandlers_.insert_or_assign(cbId, cbInfo);
+    if (cbInfo.isOrdered) {
+        inflightCount_++;
+    }
     return cbId;
 }
 // LCOV_EXCL_STOP
@@ -39,6 +44,18 @@ void KeyEventResultHandler::HandleKeyEventResult(uint64_t cbId, bool consumeResu
         IMSA_HILOGE("%{public}" PRIu64 "not be found.", cbId);
         return;
     }
+    if (info.isOrdered) {
+        {
+            std::lock_guard<std::mutex> lock(keyEventCbHandlersMutex_);
+            auto iter = keyEventCbHandlers_.find(cbId);
+            if (iter != keyEventCbHandlers_.end()) {
+                iter->second.isDone = true;
+                iter->second.isConsumed = consumeResult;
+            }
+        }
+        DeliverOrderedResults();
+        return;
+    }
     if (info.callback == nullptr) {
         IMSA_HILOGE("%{public}" PRIu64 "callback is nullptr.", cbId);
     } else {
@@ -48,19 +65,89 @@ void KeyEventResultHandler::HandleKeyEventResult(uint64_t cbId, bool consumeResu
 }
 
 void KeyEventResultHandler::ClearKeyEventCbInfo()
+{
+    {
+        std::lock_guard<std::mutex> lock(keyEventCbHandlersMutex_);
+        keyEventCbHandlers_.clear();
+        inflightCount_ = 0;
+    }
+    windowCv_.notify_all();
+}
+
+void KeyEventResultHandler::WaitForWindow(uint32_t window, uint32_t timeoutMs)
+{
+    {
+        std::unique_lock<std::mutex> lock(keyEventCbHandlersMutex_);
+        if (windowCv_.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+            [this, window] { return inflightCount_ < window; })) {
+            return;
+        }
+        auto iter = std::find_if(keyEventCbHandlers_.begin(), keyEventCbHandlers_.end(), [](const auto &item) {
+            return item.second.isOrdered && !item.second.isDone && !item.second.isExpired;
+        });
+        // the ime may still consume the key, so no result is made up for it
+        if (iter != keyEventCbHandlers_.end()) {
+            IMSA_HILOGW("%{public}" PRIu64 " no result yet, stop waiting for it.", iter->first);
+            iter->second.isExpired = true;
+            inflightCount_--;
+        }
+    }
+    DeliverOrderedResults();
+}
+
+uint32_t KeyEventResultHandler::GetInflightCount()
 {
     std::lock_guard<std::mutex> lock(keyEventCbHandlersMutex_);
-    keyEventCbHandlers_.clear();
+    return inflightCount_;
+}
+
+void KeyEventResultHandler::DeliverOrderedResults()
+{
+    // only one thread delivers at a time, so results arriving on different threads keep their order
+    std::lock_guard<std::mutex> deliverLock(deliverMutex_);
+    while (true) {
+        KeyEventCbInfo info;
+        {
+            std::lock_guard<std::mutex> lock(keyEventCbHandlersMutex_);
+            auto iter = std::find_if(keyEventCbHandlers_.begin(), keyEventCbHandlers_.end(), [](const auto &item) {
+                return item.second.isOrdered && (item.second.isDone || !item.second.isExpired);
+            });
+            if (iter == keyEventCbHandlers_.end() || !iter->second.isDone) {
+                return;
+            }
+            info = iter->second;
+            keyEventCbHandlers_.erase(iter);
+            if (!info.isExpired) {
+                inflightCount_--;
+            }
+        }
+        windowCv_.notify_all();
+        if (info.callback != nullptr) {
+            info.callback(info.keyEvent, info.isConsumed);
+        }
+    }
 }
 // LCOV_EXCL_START
 void KeyEventResultHandler::RemoveKeyEventCbInfo(uint64_t cbId)
 {
-    std::lock_guard<std::mutex> lock(keyEventCbHandlersMutex_);
-    auto iter = keyEventCbHandlers_.find(cbId);
-    if (iter == keyEventCbHandlers_.end()) {
-        return;
+    bool isOrdered = false;
+    {
+        std::lock_guard<std::mutex> lock(keyEventCbHandlersMutex_);
+        auto iter = keyEventCbHandlers_.find(cbId);
+        if (iter == keyEventCbHandlers_.end()) {
+            return;
+        }
+        isOrdered = iter->second.isOrdered;
+        if (isOrdered && !iter->second.isExpired) {
+            inflightCount_--;
+        }
+        keyEventCbHandlers_.erase(iter);
+    }
+    if (isOrdered) {
+        windowCv_.notify_all();
+        // the removed event may have held back the results behind it
+        DeliverOrderedResults();
     }
-    keyEventCbHandlers_.erase(cbId);
 }
 // LCOV_EXCL_STOP
 int32_t KeyEventResultHandler::GetKeyEventCbInfo(uint64_t cbId, KeyEventCbInfo &info)
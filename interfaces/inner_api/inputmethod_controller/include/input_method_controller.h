@@ -48,6 +48,7 @@
 
 namespace OHOS {
 namespace MiscServices {
+class SharedMessageBuffer;
 class OnTextChangedListener : public virtual RefBase {
 public:
     virtual ~OnTextChangedListener() {}
@@ -143,6 +144,8 @@ private:
     int32_t SetPreviewTextV2(const std::u16string &text, const Range &range);
     void FinishTextPreviewV2();
     void OnDetachV2();
+    void CommitEditBatchV2(const std::vector<EditOperation> &operations);
+    void ApplyEditOperation(const EditOperation &operation);
 };
 using PrivateDataValue = std::variant<std::string, bool, int32_t>;
 using KeyEventCallback = std::function<void(std::shared_ptr<MMI::KeyEvent> &keyEvent, bool isConsumed)>;
@@ -992,6 +995,43 @@ public:
      */
     IMF_API int32_t RegisterWindowScaleCallbackHandler(WindowScaleCallback&& callback);
 
+    /**
+     * @brief Set the in-flight window of pipelined key event dispatch.
+     *
+     * With a window greater than 0, DispatchKeyEvent sends key events to the input method without waiting
+     * for each one, at most window events wait for their results at the same time. The results are still
+     * delivered in dispatch order. An event without result for 200ms stops holding the window and the results
+     * behind it, its own result is delivered whenever it comes. 0 restores the synchronous dispatch, which is
+     * the default.
+     *
+     * @param window Indicates the number of key events which can be in flight, max is 32.
+     * @return Returns 0 for success, others for failure.
+     * @since 20
+     */
+    IMF_API int32_t SetKeyEventPipelineWindow(uint32_t window);
+
+    /**
+     * @brief Set the interval of coalescing cursor, selection and attribute updates.
+     *
+     * With an interval greater than 0, the updates sent to the input method are buffered per kind and only
+     * the latest one of each kind is sent, at most once per interval. Buffered updates are sent at once
+     * before an edit from the input method is applied. 0 sends every update immediately, which is the default.
+     *
+     * @param intervalMs Indicates the coalescing interval in milliseconds, max is 100.
+     * @return Returns 0 for success, others for failure.
+     * @since 20
+     */
+    IMF_API int32_t SetUpdateCoalesceInterval(uint32_t intervalMs);
+
+    /**
+     * @brief Get the counters of coalesced updates.
+     *
+     * @param coalesced Indicates the number of updates replaced by a newer one before being sent.
+     * @param sent Indicates the number of updates sent after being buffered.
+     * @since 20
+     */
+    IMF_API void GetUpdateCoalesceStats(uint64_t &coalesced, uint64_t &sent);
+
     void HandleKeyEventResult(uint64_t cbId, bool consumeResult);
 private:
     friend class MockInputMethodSystemAbilityProxy;
@@ -1035,6 +1075,34 @@ private:
     void GetWindowScaleCoordinate(uint32_t windowId, CursorInfo &cursorInfo);
     int32_t ResponseDataChannel(
         const sptr<IRemoteObject> &agentObject, uint64_t msgId, int32_t code, const ResponseData &data);
+    std::shared_ptr<IInputMethodAgent> GetResponseAgent(const sptr<IRemoteObject> &agentObject);
+    void ClearResponseAgent();
+    int32_t CommitEditBatch(const std::vector<EditOperation> &operations);
+    int32_t DispatchKeyEventPipelined(const std::shared_ptr<IInputMethodAgent> &agent,
+        const std::shared_ptr<MMI::KeyEvent> &keyEvent, const KeyEventCallback &callback,
+        const sptr<IRemoteObject> &channelObject);
+    void OnTextSyncRequest(const sptr<IRemoteObject> &agentObject);
+    int32_t SendTextDeltaToAllAgents(const TextDeltaInner &delta, const std::u16string &text,
+        const Range &oldRange, const Range &newRange);
+    int32_t SendCursorToAllAgents(const CursorInfo &cursorInfo);
+    int32_t SendAttributeToAgent(const InputAttribute &attribute);
+    struct PendingUpdates {
+        bool hasCursor = false;
+        CursorInfo cursorInfo;
+        bool hasText = false;
+        std::u16string baseText;
+        uint64_t baseVersion = 0;
+        Range oldRange;
+        bool hasAttribute = false;
+        InputAttribute attribute;
+    };
+    bool BufferUpdate(const std::function<bool(PendingUpdates &)> &update);
+    void FlushPendingUpdates();
+    void DropPendingUpdates();
+    bool WriteSharedMessage(
+        const std::shared_ptr<IInputMethodAgent> &agent, const ArrayBuffer &arrayBuffer, SharedMessageInner &msg);
+    int32_t SetRecvMessageBuffer(const sptr<Ashmem> &ashmem);
+    int32_t RecvSharedMessage(const SharedMessageInner &msg);
     void CalibrateImmersiveParam(InputAttribute &inputAttribute);
     void ClearAgentInfo();
     int32_t SendRequestToAllAgents(std::function<int32_t(std::shared_ptr<IInputMethodAgent>)> task);
@@ -1051,9 +1119,21 @@ private:
         sptr<IRemoteObject> agentObject = nullptr;
         std::shared_ptr<IInputMethodAgent> agent = nullptr;
         ImeType imeType = ImeType::NONE;
+        uint64_t textVersion = 0;
     };
+    int32_t SendRequestToAllAgentInfos(const std::function<int32_t(AgentInfo &)> &task);
     std::mutex agentLock_;
     std::vector<AgentInfo> agentInfoList_;
+    // proxy of an agent which is not bound, bound agents reply through their own AgentInfo::agent
+    std::mutex rspAgentLock_;
+    sptr<IRemoteObject> rspAgentObject_ = nullptr;
+    std::shared_ptr<IInputMethodAgent> rspAgent_ = nullptr;
+
+    std::mutex sendMsgBufferLock_;
+    std::shared_ptr<SharedMessageBuffer> sendMsgBuffer_ = nullptr;
+    std::weak_ptr<IInputMethodAgent> msgBufferPeer_;
+    std::mutex recvMsgBufferLock_;
+    std::shared_ptr<SharedMessageBuffer> recvMsgBuffer_ = nullptr;
 
     std::mutex textListenerLock_;
     sptr<OnTextChangedListener> textListener_ = nullptr;
@@ -1062,9 +1142,18 @@ private:
     std::mutex cursorInfoMutex_;
     CursorInfo cursorInfo_;
 
+    std::mutex coalesceLock_;
+    PendingUpdates pendingUpdates_;
+    bool isFlushScheduled_ = false;
+    std::atomic_bool hasPendingUpdates_{ false };
+    std::atomic<uint32_t> coalesceInterval_{ 0 };
+    std::atomic<uint64_t> coalescedUpdateCount_{ 0 };
+    std::atomic<uint64_t> sentUpdateCount_{ 0 };
+
     std::atomic_bool isTextNotified_{ false };
     std::mutex editorContentLock_;
     std::u16string textString_;
+    uint64_t textVersion_ = 0;
     int selectOldBegin_ = 0;
     int selectOldEnd_ = 0;
     int selectNewBegin_ = 0;
@@ -1114,6 +1203,7 @@ private:
     std::mutex windowScaleCallbackMutex_;
     WindowScaleCallback windowScaleCallback_ = nullptr;
     KeyEventResultHandler keyEventRetHandler_;
+    std::atomic<uint32_t> keyEventWindow_{ 0 };
 };
 } // namespace MiscServices
 } // namespace OHOS
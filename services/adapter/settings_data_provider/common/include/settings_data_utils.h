@@ -17,8 +17,10 @@
 #define SETTINGS_DATA_UTILS_H
 
 #include <list>
+#include <map>
 
 #include "datashare_helper.h"
+#include "event_handler.h"
 #include "input_method_property.h"
 #include "serializable.h"
 #include "settings_data_observer.h"
@@ -36,6 +38,7 @@ class SettingsDataUtils : public RefBase {
 public:
     static constexpr const char *ENABLE_IME = "settings.inputmethod.enable_ime";
     static constexpr const char *SECURITY_MODE = "settings.inputmethod.full_experience";
+    static constexpr int64_t HELPER_IDLE_TIME = 30000; // ms
     static SettingsDataUtils &GetInstance();
     std::shared_ptr<DataShare::DataShareHelper> CreateDataShareHelper(const std::string &uriProxy);
     int32_t CreateAndRegisterObserver(
@@ -44,18 +47,35 @@ public:
         const SettingsDataObserver::CallbackFunc &func, sptr<SettingsDataObserver> &observer);
     int32_t UnregisterObserver(const sptr<SettingsDataObserver> &observer);
     int32_t GetStringValue(const std::string &uriProxy, const std::string &key, std::string &value);
+    // reads each key with its own query on one helper, the keys not found are left out of values
+    int32_t GetStringValues(const std::string &uriProxy, const std::vector<std::string> &keys,
+        std::map<std::string, std::string> &values);
     bool SetStringValue(const std::string &uriProxy, const std::string &key, const std::string &value);
     bool ReleaseDataShareHelper(std::shared_ptr<DataShare::DataShareHelper> &helper);
     Uri GenerateTargetUri(const std::string &uriProxy, const std::string &key);
     void NotifyDataShareReady();
     bool IsDataShareReady();
+    void SetEventHandler(const std::shared_ptr<AppExecFwk::EventHandler> &eventHandler);
     void Release();
 
 private:
+    struct PooledHelper {
+        std::shared_ptr<DataShare::DataShareHelper> helper;
+        int64_t lastUsedTime{ 0 };
+    };
     SettingsDataUtils() = default;
     ~SettingsDataUtils();
     int32_t RegisterObserver(const sptr<SettingsDataObserver> &observer);
     sptr<IRemoteObject> GetToken();
+    // the helper of an uri is kept for later reads and writes until it is idle
+    std::shared_ptr<DataShare::DataShareHelper> AcquireHelper(const std::string &uriProxy);
+    // drops a helper whose call failed, the next call reconnects
+    void DiscardHelper(const std::string &uriProxy, const std::shared_ptr<DataShare::DataShareHelper> &helper);
+    int32_t QueryValue(const std::shared_ptr<DataShare::DataShareHelper> &helper, const std::string &uriProxy,
+        const std::string &key, std::string &value);
+    void ReleaseIdleHelpers(int64_t idleTime);
+    void PostReleaseIdleHelpersTask();
+    static int64_t GetSteadyTime();
 
 private:
     std::mutex remoteObjMutex_;
@@ -63,6 +83,11 @@ private:
     std::mutex observerListMutex_;
     std::list<sptr<SettingsDataObserver>> observerList_;
     std::atomic<bool> isDataShareReady_{ false };
+    std::mutex helperPoolMutex_;
+    std::map<std::string, PooledHelper> helperPool_;
+    bool isReleaseTaskPosted_{ false };
+    std::mutex eventHandlerMutex_;
+    std::shared_ptr<AppExecFwk::EventHandler> eventHandler_{ nullptr };
 };
 } // namespace MiscServices
 } // namespace OHOS
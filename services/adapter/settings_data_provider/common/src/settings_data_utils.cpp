@@ -14,12 +14,14 @@
  */
 #include "settings_data_utils.h"
 
+#include <chrono>
 #include <sstream>
 #include "iservice_registry.h"
 #include "system_ability_definition.h"
 
 namespace OHOS {
 namespace MiscServices {
+constexpr const char *RELEASE_IDLE_HELPERS_TASK = "ReleaseIdleDataShareHelpers";
 SettingsDataUtils::~SettingsDataUtils()
 {
     {
@@ -41,6 +43,7 @@ void SettingsDataUtils::Release()
             UnregisterObserver(observer);
         }
     }
+    ReleaseIdleHelpers(0);
 }
 // LCOV_EXCL_STOP
 SettingsDataUtils &SettingsDataUtils::GetInstance()
@@ -79,13 +82,12 @@ int32_t SettingsDataUtils::RegisterObserver(const sptr<SettingsDataObserver> &ob
         return ErrorCode::ERROR_NULL_POINTER;
     }
     auto uri = GenerateTargetUri(observer->GetUriProxy(), observer->GetKey());
-    auto helper = SettingsDataUtils::CreateDataShareHelper(observer->GetUriProxy());
+    auto helper = AcquireHelper(observer->GetUriProxy());
     if (helper == nullptr) {
         IMSA_HILOGE("helper is nullptr!");
         return ErrorCode::ERROR_NULL_POINTER;
     }
     helper->RegisterObserver(uri, observer);
-    ReleaseDataShareHelper(helper);
     IMSA_HILOGD("succeed to register observer of uri: %{public}s.", uri.ToString().c_str());
 
     std::lock_guard<decltype(observerListMutex_)> lock(observerListMutex_);
@@ -100,13 +102,12 @@ int32_t SettingsDataUtils::UnregisterObserver(const sptr<SettingsDataObserver> &
         return ErrorCode::ERROR_NULL_POINTER;
     }
     auto uri = GenerateTargetUri(observer->GetUriProxy(), observer->GetKey());
-    auto helper = SettingsDataUtils::CreateDataShareHelper(observer->GetUriProxy());
+    auto helper = AcquireHelper(observer->GetUriProxy());
     if (helper == nullptr) {
         IMSA_HILOGE("helper is nullptr!");
         return ErrorCode::ERROR_NULL_POINTER;
     }
     helper->UnregisterObserver(uri, observer);
-    ReleaseDataShareHelper(helper);
     IMSA_HILOGD("succeed to unregister observer of uri: %{public}s.", uri.ToString().c_str());
 
     std::lock_guard<decltype(observerListMutex_)> lock(observerListMutex_);
@@ -152,7 +153,7 @@ Uri SettingsDataUtils::GenerateTargetUri(const std::string &uriProxy, const std:
 bool SettingsDataUtils::SetStringValue(const std::string &uriProxy, const std::string &key, const std::string &value)
 {
     IMSA_HILOGD("start.");
-    auto helper = CreateDataShareHelper(uriProxy);
+    auto helper = AcquireHelper(uriProxy);
     if (helper == nullptr) {
         IMSA_HILOGE("helper is nullptr.");
         return false;
@@ -168,30 +169,63 @@ bool SettingsDataUtils::SetStringValue(const std::string &uriProxy, const std::s
     if (helper->Update(uri, predicates, bucket) <= 0) {
         int index = helper->Insert(uri, bucket);
         IMSA_HILOGI("no data exists, insert ret index: %{public}d", index);
+        if (index < 0) {
+            DiscardHelper(uriProxy, helper);
+        }
     } else {
         IMSA_HILOGI("data exits");
     }
-    bool ret = ReleaseDataShareHelper(helper);
-    IMSA_HILOGI("ReleaseDataShareHelper isSuccess: %{public}d", ret);
-    return ret;
+    return true;
 }
 
 int32_t SettingsDataUtils::GetStringValue(const std::string &uriProxy, const std::string &key, std::string &value)
 {
     IMSA_HILOGD("start.");
-    auto helper = CreateDataShareHelper(uriProxy);
+    auto helper = AcquireHelper(uriProxy);
+    if (helper == nullptr) {
+        IMSA_HILOGE("helper is nullptr.");
+        return ErrorCode::ERROR_NULL_POINTER;
+    }
+    return QueryValue(helper, uriProxy, key, value);
+}
+
+int32_t SettingsDataUtils::GetStringValues(const std::string &uriProxy, const std::vector<std::string> &keys,
+    std::map<std::string, std::string> &values)
+{
+    if (keys.empty()) {
+        return ErrorCode::NO_ERROR;
+    }
+    auto helper = AcquireHelper(uriProxy);
     if (helper == nullptr) {
         IMSA_HILOGE("helper is nullptr.");
         return ErrorCode::ERROR_NULL_POINTER;
     }
+    for (const auto &key : keys) {
+        std::string value;
+        auto ret = QueryValue(helper, uriProxy, key, value);
+        if (ret == ErrorCode::ERROR_KEYWORD_NOT_FOUND) {
+            continue;
+        }
+        if (ret != ErrorCode::NO_ERROR) {
+            return ret;
+        }
+        values.insert_or_assign(key, value);
+    }
+    IMSA_HILOGD("found %{public}zu of %{public}zu keys.", values.size(), keys.size());
+    return ErrorCode::NO_ERROR;
+}
+
+int32_t SettingsDataUtils::QueryValue(const std::shared_ptr<DataShare::DataShareHelper> &helper,
+    const std::string &uriProxy, const std::string &key, std::string &value)
+{
     std::vector<std::string> columns = { SETTING_COLUMN_VALUE };
     DataShare::DataSharePredicates predicates;
     predicates.EqualTo(SETTING_COLUMN_KEYWORD, key);
     Uri uri(GenerateTargetUri(uriProxy, key));
     auto resultSet = helper->Query(uri, predicates, columns);
-    ReleaseDataShareHelper(helper);
     if (resultSet == nullptr) {
         IMSA_HILOGE("resultSet is nullptr.");
+        DiscardHelper(uriProxy, helper);
         return ErrorCode::ERROR_NULL_POINTER;
     }
 
@@ -214,6 +248,112 @@ int32_t SettingsDataUtils::GetStringValue(const std::string &uriProxy, const std
     return ret;
 }
 // LCOV_EXCL_STOP
+std::shared_ptr<DataShare::DataShareHelper> SettingsDataUtils::AcquireHelper(const std::string &uriProxy)
+{
+    {
+        std::lock_guard<std::mutex> lock(helperPoolMutex_);
+        auto iter = helperPool_.find(uriProxy);
+        if (iter != helperPool_.end()) {
+            iter->second.lastUsedTime = GetSteadyTime();
+            return iter->second.helper;
+        }
+    }
+    // created outside the lock, it is an ipc to the settings data
+    auto helper = CreateDataShareHelper(uriProxy);
+    if (helper == nullptr) {
+        return nullptr;
+    }
+    std::shared_ptr<DataShare::DataShareHelper> redundant = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(helperPoolMutex_);
+        auto &pooled = helperPool_[uriProxy];
+        if (pooled.helper != nullptr) {
+            // another thread pooled one first
+            redundant = helper;
+            helper = pooled.helper;
+        }
+        pooled.helper = helper;
+        pooled.lastUsedTime = GetSteadyTime();
+    }
+    ReleaseDataShareHelper(redundant);
+    PostReleaseIdleHelpersTask();
+    return helper;
+}
+
+void SettingsDataUtils::DiscardHelper(
+    const std::string &uriProxy, const std::shared_ptr<DataShare::DataShareHelper> &helper)
+{
+    std::shared_ptr<DataShare::DataShareHelper> discarded = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(helperPoolMutex_);
+        auto iter = helperPool_.find(uriProxy);
+        if (iter == helperPool_.end() || iter->second.helper != helper) {
+            return;
+        }
+        discarded = iter->second.helper;
+        helperPool_.erase(iter);
+    }
+    IMSA_HILOGW("discard helper of uri: %{public}s.", uriProxy.c_str());
+    ReleaseDataShareHelper(discarded);
+}
+
+void SettingsDataUtils::ReleaseIdleHelpers(int64_t idleTime)
+{
+    std::vector<std::shared_ptr<DataShare::DataShareHelper>> idleHelpers;
+    {
+        std::lock_guard<std::mutex> lock(helperPoolMutex_);
+        auto now = GetSteadyTime();
+        for (auto iter = helperPool_.begin(); iter != helperPool_.end();) {
+            if (now - iter->second.lastUsedTime < idleTime) {
+                ++iter;
+                continue;
+            }
+            idleHelpers.push_back(iter->second.helper);
+            iter = helperPool_.erase(iter);
+        }
+    }
+    for (auto &helper : idleHelpers) {
+        ReleaseDataShareHelper(helper);
+    }
+    IMSA_HILOGD("release %{public}zu idle helpers.", idleHelpers.size());
+}
+
+void SettingsDataUtils::PostReleaseIdleHelpersTask()
+{
+    std::shared_ptr<AppExecFwk::EventHandler> eventHandler = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(eventHandlerMutex_);
+        eventHandler = eventHandler_;
+    }
+    if (eventHandler == nullptr) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(helperPoolMutex_);
+        if (isReleaseTaskPosted_ || helperPool_.empty()) {
+            return;
+        }
+        isReleaseTaskPosted_ = true;
+    }
+    auto task = [this]() {
+        ReleaseIdleHelpers(HELPER_IDLE_TIME);
+        {
+            std::lock_guard<std::mutex> lock(helperPoolMutex_);
+            isReleaseTaskPosted_ = false;
+        }
+        PostReleaseIdleHelpersTask();
+    };
+    if (!eventHandler->PostTask(task, RELEASE_IDLE_HELPERS_TASK, HELPER_IDLE_TIME)) {
+        std::lock_guard<std::mutex> lock(helperPoolMutex_);
+        isReleaseTaskPosted_ = false;
+    }
+}
+
+int64_t SettingsDataUtils::GetSteadyTime()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
 sptr<IRemoteObject> SettingsDataUtils::GetToken()
 {
     std::lock_guard<std::mutex> autoLock(remoteObjMutex_);
@@ -243,5 +383,11 @@ bool SettingsDataUtils::IsDataShareReady()
 {
     return isDataShareReady_.load();
 }
+
+void SettingsDataUtils::SetEventHandler(const std::shared_ptr<AppExecFwk::EventHandler> &eventHandler)
+{
+    std::lock_guard<std::mutex> lock(eventHandlerMutex_);
+    eventHandler_ = eventHandler;
+}
 } // namespace MiscServices
 } // namespace OHOS
\ No newline at end of file
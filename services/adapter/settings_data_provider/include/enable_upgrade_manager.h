@@ -15,6 +15,7 @@
 
 #ifndef ENABLE_UPGRADE_MANAGER_H
 #define ENABLE_UPGRADE_MANAGER_H
+#include <map>
 #include <set>
 
 #include "event_handler.h"
@@ -119,6 +120,7 @@ private:
     int32_t GetEnabledTable(int32_t userId, const std::string &uriProxy, std::set<std::string> &bundleNames);
     int32_t GetEnabledTable(int32_t userId, const std::string &uriProxy, std::string &content);
     int32_t ParseEnabledTable(int32_t userId, std::string &content, std::set<std::string> &bundleNames);
+    int32_t ParseFullExperienceTable(int32_t userId, const std::string &content, std::set<std::string> &bundleNames);
     int32_t GetGlobalTableUserId(const std::string &valueStr);
     std::string GenerateGlobalContent(int32_t userId, const std::vector<std::string> &bundleNames);
     bool SetGlobalEnabledTable(const std::string &content);
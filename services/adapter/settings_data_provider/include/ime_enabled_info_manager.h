@@ -15,6 +15,8 @@
 
 #ifndef IME_ENABLED_INFO_MANAGER_H
 #define IME_ENABLED_INFO_MANAGER_H
+#include <unordered_map>
+
 #include "event_handler.h"
 #include "input_method_property.h"
 #include "input_method_status.h"
@@ -114,6 +116,18 @@ struct ImeEnabledCfg : public Serializable {
         return version == enabledCfg.version && enabledInfos == enabledCfg.enabledInfos;
     }
 };
+/* immutable view of a user's enabled cfg, a new one is published on every update and read without lock */
+struct ImeEnabledSnapshot {
+    ImeEnabledCfg cfg;
+    std::unordered_map<std::string, size_t> bundleIndexes;
+    std::unordered_map<std::string, size_t> imeIdIndexes;
+    ImeNativeCfg currentIme; // tmp ime first, then default ime, imeId is empty if neither is set
+    bool isDefaultImeSet{ false };
+    static std::shared_ptr<const ImeEnabledSnapshot> Create(const ImeEnabledCfg &cfg);
+    const ImeEnabledInfo *FindByBundleName(const std::string &bundleName) const;
+    const ImeEnabledInfo *FindByImeId(const std::string &imeId) const;
+};
+using ImeEnabledSnapshots = std::map<int32_t, std::shared_ptr<const ImeEnabledSnapshot>>;
 using CurrentImeStatusChangedHandler =
     std::function<void(int32_t userId, const std::string &bundleName, EnabledStatus oldStatus)>;
 class ImeEnabledInfoManager {
@@ -151,7 +165,9 @@ private:
     int32_t GetEnabledStatesInner(int32_t userId, std::vector<Property> &props);
     void SetEnabledCache(int32_t userId, const ImeEnabledCfg &cfg);
     ImeEnabledCfg GetEnabledCache(int32_t userId);
+    std::shared_ptr<const ImeEnabledSnapshot> GetSnapshot(int32_t userId);
     void ClearEnabledCache(int32_t userId);
+    void ClearEnabledCache(); // for tdd
     bool IsInEnabledCache(int32_t userId, const std::string &bundleName, const std::string &extensionName);
     int32_t GetEnabledCacheWithCorrect(int32_t userId, ImeEnabledCfg &enabledCfg);
     int32_t GetEnabledCacheWithCorrect(
@@ -166,8 +182,8 @@ private:
     bool IsCurrentIme(const std::string &bundleName, const std::vector<ImeEnabledInfo> &enabledInfos);
     /* add for compatibility that sys ime listen global table change for smart menu in tablet */
     void UpdateGlobalEnabledTable(int32_t userId, const ImeEnabledCfg &newEnabledCfg);
-    std::mutex imeEnabledCfgLock_;
-    std::map<int32_t, ImeEnabledCfg> imeEnabledCfg_;
+    std::mutex imeEnabledCfgLock_; // serializes the writers of imeEnabledCfg_, readers use atomic_load
+    std::shared_ptr<const ImeEnabledSnapshots> imeEnabledCfg_{ std::make_shared<const ImeEnabledSnapshots>() };
     CurrentImeStatusChangedHandler currentImeStatusChangedHandler_;
     std::shared_ptr<AppExecFwk::EventHandler> serviceHandler_{ nullptr };
     std::mutex operateLock_;
@@ -137,6 +137,12 @@ int32_t EnableUpgradeManager::GetFullExperienceTable(int32_t userId, std::set<st
         IMSA_HILOGW("%{public}d get full experience table failed:%{public}d.", userId, ret);
         return ret;
     }
+    return ParseFullExperienceTable(userId, content, bundleNames);
+}
+
+int32_t EnableUpgradeManager::ParseFullExperienceTable(
+    int32_t userId, const std::string &content, std::set<std::string> &bundleNames)
+{
     SecurityModeCfg cfg;
     cfg.userImeCfg.userId = std::to_string(userId);
     if (!cfg.Unmarshall(content)) {
@@ -149,15 +155,30 @@ int32_t EnableUpgradeManager::GetFullExperienceTable(int32_t userId, std::set<st
 
 int32_t EnableUpgradeManager::MergeTwoTable(int32_t userId, std::vector<ImeEnabledInfo> &enabledInfos)
 {
+    // both old global tables are read on one helper
+    std::map<std::string, std::string> globalTables;
+    auto ret = SettingsDataUtils::GetInstance().GetStringValues(
+        SETTING_URI_PROXY, { SettingsDataUtils::ENABLE_IME, SettingsDataUtils::SECURITY_MODE }, globalTables);
+    if (ret != ErrorCode::NO_ERROR) {
+        IMSA_HILOGE("%{public}d get global tables failed:%{public}d.", userId, ret);
+        return ret;
+    }
     std::set<std::string> enabledBundleNames;
-    auto ret = GetEnabledTable(userId, enabledBundleNames);
+    auto iter = globalTables.find(SettingsDataUtils::ENABLE_IME);
+    ret = iter == globalTables.end() ? static_cast<int32_t>(ErrorCode::ERROR_KEYWORD_NOT_FOUND)
+                                     : ParseEnabledTable(userId, iter->second, enabledBundleNames);
+    if (ret == ErrorCode::ERROR_EX_PARCELABLE) {
+        ret = GetUserEnabledTable(userId, enabledBundleNames);
+    }
     if (ret != ErrorCode::NO_ERROR && ret != ErrorCode::ERROR_KEYWORD_NOT_FOUND &&
         ret != ErrorCode::ERROR_EX_PARCELABLE) {
         IMSA_HILOGE("%{public}d get enabled table failed:%{public}d.", userId, ret);
         return ret;
     }
     std::set<std::string> fullModeBundleNames;
-    ret = GetFullExperienceTable(userId, fullModeBundleNames);
+    iter = globalTables.find(SettingsDataUtils::SECURITY_MODE);
+    ret = iter == globalTables.end() ? static_cast<int32_t>(ErrorCode::ERROR_KEYWORD_NOT_FOUND)
+                                     : ParseFullExperienceTable(userId, iter->second, fullModeBundleNames);
     if (ret != ErrorCode::NO_ERROR && ret != ErrorCode::ERROR_KEYWORD_NOT_FOUND &&
         ret != ErrorCode::ERROR_EX_PARCELABLE) {
         IMSA_HILOGE("%{public}d get full experience table failed:%{public}d.", userId, ret);
@@ -26,6 +26,51 @@
 namespace OHOS {
 namespace MiscServices {
 using namespace std::chrono;
+std::shared_ptr<const ImeEnabledSnapshot> ImeEnabledSnapshot::Create(const ImeEnabledCfg &cfg)
+{
+    auto snapshot = std::make_shared<ImeEnabledSnapshot>();
+    snapshot->cfg = cfg;
+    const ImeEnabledInfo *tmpIme = nullptr;
+    const ImeEnabledInfo *defaultIme = nullptr;
+    for (size_t i = 0; i < snapshot->cfg.enabledInfos.size(); ++i) {
+        const auto &info = snapshot->cfg.enabledInfos[i];
+        // the first one wins, same as a linear search
+        snapshot->bundleIndexes.emplace(info.bundleName, i);
+        snapshot->imeIdIndexes.emplace(info.bundleName + "/" + info.extensionName, i);
+        if (tmpIme == nullptr && info.extraInfo.isTmpIme) {
+            tmpIme = &info;
+        }
+        if (defaultIme == nullptr && info.extraInfo.isDefaultIme) {
+            defaultIme = &info;
+        }
+    }
+    if (defaultIme != nullptr) {
+        snapshot->isDefaultImeSet = defaultIme->extraInfo.isDefaultImeSet;
+    }
+    auto currentIme = tmpIme != nullptr ? tmpIme : defaultIme;
+    if (currentIme != nullptr) {
+        snapshot->currentIme.imeId = currentIme->bundleName + "/" + currentIme->extensionName;
+        snapshot->currentIme.bundleName = currentIme->bundleName;
+        snapshot->currentIme.extName = currentIme->extensionName;
+        if (tmpIme == nullptr) {
+            snapshot->currentIme.subName = currentIme->extraInfo.currentSubName;
+        }
+    }
+    return snapshot;
+}
+
+const ImeEnabledInfo *ImeEnabledSnapshot::FindByBundleName(const std::string &bundleName) const
+{
+    auto it = bundleIndexes.find(bundleName);
+    return it == bundleIndexes.end() ? nullptr : &cfg.enabledInfos[it->second];
+}
+
+const ImeEnabledInfo *ImeEnabledSnapshot::FindByImeId(const std::string &imeId) const
+{
+    auto it = imeIdIndexes.find(imeId);
+    return it == imeIdIndexes.end() ? nullptr : &cfg.enabledInfos[it->second];
+}
+
 ImeEnabledInfoManager &ImeEnabledInfoManager::GetInstance()
 {
     static ImeEnabledInfoManager instance;
@@ -228,7 +273,6 @@ int32_t ImeEnabledInfoManager::Update(
 // LCOV_EXCL_STOP
 int32_t ImeEnabledInfoManager::GetEnabledState(int32_t userId, const std::string &bundleName, EnabledStatus &status)
 {
-    std::lock_guard<std::mutex> lock(operateLock_);
     IMSA_HILOGD("[%{public}d, %{public}s] start.", userId, bundleName.c_str());
     if (bundleName.empty()) {
         IMSA_HILOGW("%{public}d bundleName is empty.", userId);
@@ -238,7 +282,15 @@ int32_t ImeEnabledInfoManager::GetEnabledState(int32_t userId, const std::string
         status = EnabledStatus::FULL_EXPERIENCE_MODE;
         return ErrorCode::NO_ERROR;
     }
-    auto ret = GetEnabledStateInner(userId, bundleName, status);
+    int32_t ret = ErrorCode::NO_ERROR;
+    auto snapshot = GetSnapshot(userId);
+    auto info = snapshot == nullptr ? nullptr : snapshot->FindByBundleName(bundleName);
+    if (info != nullptr) {
+        status = info->enabledStatus;
+    } else {
+        std::lock_guard<std::mutex> lock(operateLock_);
+        ret = GetEnabledStateInner(userId, bundleName, status);
+    }
     if (bundleName == ImeInfoInquirer::GetInstance().GetDefaultIme().bundleName &&
         (ret != ErrorCode::NO_ERROR || status == EnabledStatus::DISABLED)) {
         IMSA_HILOGI("mod sys ime enabledStatus.");
@@ -253,7 +305,6 @@ int32_t ImeEnabledInfoManager::GetEnabledState(int32_t userId, const std::string
 
 int32_t ImeEnabledInfoManager::GetEnabledStates(int32_t userId, std::vector<Property> &props)
 {
-    std::lock_guard<std::mutex> lock(operateLock_);
     if (props.empty()) {
         return ErrorCode::ERROR_BAD_PARAMETERS;
     }
@@ -296,23 +347,29 @@ int32_t ImeEnabledInfoManager::GetEnabledStateInner(
 int32_t ImeEnabledInfoManager::GetEnabledStatesInner(int32_t userId, std::vector<Property> &props)
 {
     IMSA_HILOGD("%{public}d/%{public}zu get enabledStatus start.", userId, props.size());
-    auto cfg = GetEnabledCache(userId);
-    if (cfg.enabledInfos.empty()) {
-        auto ret = UpdateEnabledCfgCache(userId);
-        if (ret != ErrorCode::NO_ERROR) {
-            IMSA_HILOGE("%{public}d update enable info failed:%{public}d.", userId, ret);
-            return ret;
+    auto snapshot = GetSnapshot(userId);
+    if (snapshot == nullptr || snapshot->cfg.enabledInfos.empty()) {
+        std::lock_guard<std::mutex> lock(operateLock_);
+        snapshot = GetSnapshot(userId);
+        if (snapshot == nullptr || snapshot->cfg.enabledInfos.empty()) {
+            auto ret = UpdateEnabledCfgCache(userId);
+            if (ret != ErrorCode::NO_ERROR) {
+                IMSA_HILOGE("%{public}d update enable info failed:%{public}d.", userId, ret);
+                return ret;
+            }
+            snapshot = GetSnapshot(userId);
         }
-        cfg = GetEnabledCache(userId);
+    }
+    if (snapshot == nullptr) {
+        return ErrorCode::ERROR_ENABLE_IME;
     }
     for (auto &prop : props) {
-        auto iter = std::find_if(cfg.enabledInfos.begin(), cfg.enabledInfos.end(),
-            [&prop](const ImeEnabledInfo &info) { return prop.name == info.bundleName; });
-        if (iter == cfg.enabledInfos.end()) {
+        auto info = snapshot->FindByBundleName(prop.name);
+        if (info == nullptr) {
             IMSA_HILOGW("%{public}d/%{public}s enable info abnormal.", userId, prop.name.c_str());
             continue;
         }
-        prop.status = iter->enabledStatus;
+        prop.status = info->enabledStatus;
         IMSA_HILOGD("%{public}d/%{public}s get succeed:%{public}d.", userId, prop.name.c_str(),
             static_cast<int32_t>(prop.status));
     }
@@ -355,34 +412,55 @@ int32_t ImeEnabledInfoManager::GetEnabledCacheWithCorrect(
 bool ImeEnabledInfoManager::IsInEnabledCache(
     int32_t userId, const std::string &bundleName, const std::string &extensionName)
 {
-    auto cfg = GetEnabledCache(userId);
-    auto iter = std::find_if(cfg.enabledInfos.begin(), cfg.enabledInfos.end(),
-        [&bundleName](const ImeEnabledInfo &info) { return bundleName == info.bundleName; });
-    return iter != cfg.enabledInfos.end();
+    auto snapshot = GetSnapshot(userId);
+    if (snapshot == nullptr) {
+        return false;
+    }
+    if (extensionName.empty()) {
+        return snapshot->FindByBundleName(bundleName) != nullptr;
+    }
+    return snapshot->FindByImeId(bundleName + "/" + extensionName) != nullptr;
 }
 
 void ImeEnabledInfoManager::SetEnabledCache(int32_t userId, const ImeEnabledCfg &cfg)
 {
+    auto snapshot = ImeEnabledSnapshot::Create(cfg);
     std::lock_guard<std::mutex> cgfLock(imeEnabledCfgLock_);
-    imeEnabledCfg_.insert_or_assign(userId, cfg);
+    auto snapshots = std::make_shared<ImeEnabledSnapshots>(*std::atomic_load(&imeEnabledCfg_));
+    snapshots->insert_or_assign(userId, snapshot);
+    std::atomic_store(&imeEnabledCfg_, std::shared_ptr<const ImeEnabledSnapshots>(std::move(snapshots)));
 }
 
 ImeEnabledCfg ImeEnabledInfoManager::GetEnabledCache(int32_t userId)
 {
-    std::lock_guard<std::mutex> lock(imeEnabledCfgLock_);
-    auto it = imeEnabledCfg_.find(userId);
-    if (it == imeEnabledCfg_.end()) {
+    auto snapshot = GetSnapshot(userId);
+    if (snapshot == nullptr) {
         IMSA_HILOGE("not find %{public}d in cache.", userId);
         return {};
     }
-    IMSA_HILOGD("num %{public}zu in cache.", it->second.enabledInfos.size());
-    return it->second;
+    IMSA_HILOGD("num %{public}zu in cache.", snapshot->cfg.enabledInfos.size());
+    return snapshot->cfg;
+}
+
+std::shared_ptr<const ImeEnabledSnapshot> ImeEnabledInfoManager::GetSnapshot(int32_t userId)
+{
+    auto snapshots = std::atomic_load(&imeEnabledCfg_);
+    auto it = snapshots->find(userId);
+    return it == snapshots->end() ? nullptr : it->second;
 }
 
 void ImeEnabledInfoManager::ClearEnabledCache(int32_t userId)
 {
     std::lock_guard<std::mutex> cfgLock(imeEnabledCfgLock_);
-    imeEnabledCfg_.erase(userId);
+    auto snapshots = std::make_shared<ImeEnabledSnapshots>(*std::atomic_load(&imeEnabledCfg_));
+    snapshots->erase(userId);
+    std::atomic_store(&imeEnabledCfg_, std::shared_ptr<const ImeEnabledSnapshots>(std::move(snapshots)));
+}
+
+void ImeEnabledInfoManager::ClearEnabledCache()
+{
+    std::lock_guard<std::mutex> cfgLock(imeEnabledCfgLock_);
+    std::atomic_store(&imeEnabledCfg_, std::make_shared<const ImeEnabledSnapshots>());
 }
 // LCOV_EXCL_START
 int32_t ImeEnabledInfoManager::GetEnabledCfg(
@@ -693,6 +771,11 @@ int32_t ImeEnabledInfoManager::SetTmpIme(int32_t userId, const std::string &imeI
 
 std::shared_ptr<ImeNativeCfg> ImeEnabledInfoManager::GetCurrentImeCfg(int32_t userId)
 {
+    auto snapshot = GetSnapshot(userId);
+    if (snapshot != nullptr && !snapshot->cfg.enabledInfos.empty()) {
+        // callers may modify the result, hand out a copy of the precomputed one
+        return std::make_shared<ImeNativeCfg>(snapshot->currentIme);
+    }
     std::lock_guard<std::mutex> lock(operateLock_);
     ImeEnabledCfg enabledCfg;
     auto ret = GetEnabledCacheWithCorrect(userId, enabledCfg);
@@ -727,6 +810,10 @@ std::shared_ptr<ImeNativeCfg> ImeEnabledInfoManager::GetCurrentImeCfg(int32_t us
 // LCOV_EXCL_STOP
 bool ImeEnabledInfoManager::IsDefaultImeSet(int32_t userId)
 {
+    auto snapshot = GetSnapshot(userId);
+    if (snapshot != nullptr && !snapshot->cfg.enabledInfos.empty()) {
+        return snapshot->isDefaultImeSet;
+    }
     std::lock_guard<std::mutex> lock(operateLock_);
     ImeEnabledCfg enabledCfg;
     auto ret = GetEnabledCacheWithCorrect(userId, enabledCfg);
@@ -17,6 +17,7 @@
 #define IMF_SERVICES_INCLUDE_FILE_OPERATOR_H
 
 #include <fcntl.h>
+#include <functional>
 #include <string>
 
 #include "config_policy_utils.h"
@@ -24,16 +25,25 @@ namespace OHOS {
 namespace MiscServices {
 class FileOperator {
 public:
+    enum class WriteStage : uint32_t {
+        TEMP_WRITTEN,
+        TEMP_SYNCED,
+        RENAMED,
+    };
     static bool Create(const std::string &path, mode_t mode);
     static bool IsExist(const std::string &path);
     static bool Read(const std::string &path, std::string &content);
-    static bool Read(const std::string &path, const std::string &key, std::string &content);
     static bool Write(const std::string &path, const std::string &content, uint32_t flags,
         mode_t mode = S_IRUSR | S_IWUSR);
+    // writes a temp file, syncs it and renames it over the path, so a crash leaves the old or the new content
+    static bool WriteAtomically(const std::string &path, const std::string &content, mode_t mode = S_IRUSR | S_IWUSR);
     static std::string GetRealPath(const char *path);
 
 private:
-    static std::string Read(const std::string &path, const std::string &key);
+    static bool IsWriteStageDone(WriteStage stage);
+    static void SyncDir(const std::string &path);
+    // returns false to stop the write at a stage, for the tests to simulate a crash there
+    static std::function<bool(WriteStage)> writeStageHook_;
     static bool IsValidPath(const std::string &filePath);
     static bool CheckImeCfgFilePath(const std::string &path);
 };
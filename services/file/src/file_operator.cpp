@@ -16,6 +16,7 @@
 #include "file_operator.h"
 
 #include <fstream>
+#include <iterator>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -24,6 +25,8 @@ namespace OHOS {
 namespace MiscServices {
 // LCOV_EXCL_START
 constexpr int32_t SUCCESS = 0;
+constexpr const char *TEMP_FILE_SUFFIX = ".tmp";
+std::function<bool(FileOperator::WriteStage)> FileOperator::writeStageHook_ = nullptr;
 bool FileOperator::Create(const std::string &path, mode_t mode)
 {
     auto ret = mkdir(path.c_str(), mode);
@@ -46,10 +49,8 @@ bool FileOperator::Read(const std::string &path, std::string &content)
         IMSA_HILOGE("%{public}s open fail!", path.c_str());
         return false;
     }
-    std::string sLine;
-    while (getline(file, sLine)) {
-        content.append(sLine);
-    }
+    // one read of the whole file instead of one per line
+    content.append(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
     return true;
 }
 // LCOV_EXCL_START
@@ -122,45 +123,78 @@ bool FileOperator::Write(const std::string &path, const std::string &content, ui
     return true;
 }
 // LCOV_EXCL_STOP
-bool FileOperator::Read(const std::string &path, const std::string &key, std::string &content)
+bool FileOperator::WriteAtomically(const std::string &path, const std::string &content, mode_t mode)
 {
-    if (key.empty()) {
-        IMSA_HILOGE("key is empty!");
+    if (!CheckImeCfgFilePath(path)) {
+        IMSA_HILOGE("path check fail");
         return false;
     }
-    CfgFiles *cfgFiles = GetCfgFiles(path.c_str());
-    if (cfgFiles == nullptr) {
-        IMSA_HILOGE("%{public}s cfgFiles is nullptr!", path.c_str());
+    auto tempPath = path + TEMP_FILE_SUFFIX;
+    int fd = open(tempPath.c_str(), O_CREAT | O_WRONLY | O_TRUNC | O_CLOEXEC, mode);
+    if (fd < 0) {
+        IMSA_HILOGE("%{public}s open fail, errno: %{public}d", tempPath.c_str(), errno);
         return false;
     }
-    // parse config files, ordered by priority from high to low
-    for (int32_t i = MAX_CFG_POLICY_DIRS_CNT - 1; i >= 0; i--) {
-        auto realPath = GetRealPath(cfgFiles->paths[i]);
-        if (realPath.empty()) {
+    size_t written = 0;
+    while (written < content.size()) {
+        auto ret = write(fd, content.data() + written, content.size() - written);
+        if (ret < 0 && errno == EINTR) {
             continue;
         }
-        content = Read(realPath, key);
-        if (!content.empty()) {
-            break;
+        if (ret <= 0) {
+            IMSA_HILOGE("%{public}s write fail, errno: %{public}d", tempPath.c_str(), errno);
+            close(fd);
+            unlink(tempPath.c_str());
+            return false;
         }
+        written += static_cast<size_t>(ret);
+    }
+    if (!IsWriteStageDone(WriteStage::TEMP_WRITTEN)) {
+        close(fd);
+        return false;
+    }
+    // the content must be on the disk before the rename makes it visible
+    if (fsync(fd) != SUCCESS) {
+        IMSA_HILOGE("%{public}s fsync fail, errno: %{public}d", tempPath.c_str(), errno);
+        close(fd);
+        unlink(tempPath.c_str());
+        return false;
+    }
+    close(fd);
+    if (!IsWriteStageDone(WriteStage::TEMP_SYNCED)) {
+        return false;
+    }
+    if (rename(tempPath.c_str(), path.c_str()) != SUCCESS) {
+        IMSA_HILOGE("%{public}s rename fail, errno: %{public}d", path.c_str(), errno);
+        unlink(tempPath.c_str());
+        return false;
     }
-    FreeCfgFiles(cfgFiles);
-    return !content.empty();
+    if (!IsWriteStageDone(WriteStage::RENAMED)) {
+        return false;
+    }
+    SyncDir(path);
+    return true;
 }
 
-std::string FileOperator::Read(const std::string &path, const std::string &key)
+bool FileOperator::IsWriteStageDone(WriteStage stage)
 {
-    std::string content;
-    bool ret = Read(path, content);
-    if (!ret) {
-        IMSA_HILOGE("%{public}s read failed!", path.c_str());
-        return "";
-    }
-    if (content.find(key) == std::string::npos) {
-        IMSA_HILOGD("%{public}s not contain %{public}s!", path.c_str(), key.c_str());
-        return "";
-    }
-    return content;
+    return writeStageHook_ == nullptr || writeStageHook_(stage);
+}
+
+void FileOperator::SyncDir(const std::string &path)
+{
+    // the rename itself is durable once the directory is synced
+    auto pos = path.rfind('/');
+    auto dir = pos == 0 ? std::string("/") : path.substr(0, pos);
+    int fd = open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        IMSA_HILOGW("%{public}s open fail, errno: %{public}d", dir.c_str(), errno);
+        return;
+    }
+    if (fsync(fd) != SUCCESS) {
+        IMSA_HILOGW("%{public}s fsync fail, errno: %{public}d", dir.c_str(), errno);
+    }
+    close(fd);
 }
 
 std::string FileOperator::GetRealPath(const char *path)
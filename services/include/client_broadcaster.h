@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SERVICES_INCLUDE_CLIENT_BROADCASTER_H
+#define SERVICES_INCLUDE_CLIENT_BROADCASTER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "global.h"
+#include "input_client_info.h"
+
+namespace OHOS {
+namespace MiscServices {
+/*
+ * Sends the notifies of IMSA to the clients.
+ * Every process has its own serial queue on a shared pool of workers, so all its notifies keep their order
+ * and a client which hangs holds at most one worker.
+ * A full queue drops the oldest notify which has a newer one of the same kind behind it.
+ * A broadcast waits at most the timeout, the clients still busy are reported and finish in the background.
+ */
+class ClientBroadcaster {
+public:
+    using Notify = std::function<int32_t(const std::shared_ptr<InputClientInfo> &)>;
+    static constexpr uint32_t DEFAULT_WORKER_NUM = 4;
+    static constexpr size_t DEFAULT_MAX_PENDING_NUM = 16;
+    static constexpr int64_t DEFAULT_TIMEOUT_MS = 200;
+
+    static ClientBroadcaster &GetInstance();
+    // maxPendingNum: the max number of broadcast notifies queued for one process
+    ClientBroadcaster(uint32_t workerNum, size_t maxPendingNum);
+    ~ClientBroadcaster();
+
+    // returns the number of clients which failed, were dropped or did not answer within timeoutMs
+    uint32_t Broadcast(const std::string &event, const std::vector<std::shared_ptr<InputClientInfo>> &clients,
+        const Notify &notify, int64_t timeoutMs = DEFAULT_TIMEOUT_MS);
+    // notifies one client after its queued notifies and returns its result, it is never dropped
+    int32_t Send(const std::string &event, const std::shared_ptr<InputClientInfo> &clientInfo, const Notify &notify);
+
+private:
+    struct Round {
+        std::string event;
+        std::mutex lock;
+        std::condition_variable cv;
+        uint32_t pendingNum{ 0 };
+        uint32_t failedNum{ 0 };
+        int32_t result{ ErrorCode::NO_ERROR };
+        bool isExpired{ false };
+    };
+    struct Job {
+        std::shared_ptr<InputClientInfo> clientInfo;
+        std::shared_ptr<const Notify> notify;
+        std::shared_ptr<Round> round;
+        bool isDroppable{ true };
+    };
+    struct ClientQueue {
+        std::deque<Job> jobs;
+        bool isRunning{ false };
+        std::chrono::steady_clock::time_point runningSince;
+    };
+
+    int32_t Post(Job &&job, int64_t timeoutMs, std::vector<Job> &dropped);
+    void Schedule(pid_t pid);
+    void Release(pid_t pid);
+    void Work();
+    static void Finish(const Job &job, int32_t ret);
+
+    const uint32_t workerNum_;
+    const size_t maxPendingNum_;
+    std::mutex lock_;
+    std::condition_variable cv_;
+    std::map<pid_t, ClientQueue> clientQueues_;
+    std::deque<pid_t> readyPids_; // the processes with jobs and no running one, each at most once
+    std::vector<std::thread> workers_;
+    size_t idleNum_{ 0 };
+    bool isStopped_{ false };
+};
+} // namespace MiscServices
+} // namespace OHOS
+#endif // SERVICES_INCLUDE_CLIENT_BROADCASTER_H
@@ -16,9 +16,14 @@
 #ifndef SERVICES_INCLUDE_CLIENT_GROUP_H
 #define SERVICES_INCLUDE_CLIENT_GROUP_H
 
+#include <functional>
 #include <map>
+#include <memory>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
+#include "identity_checker.h"
 #include "input_client_info.h"
 #include "input_death_recipient.h"
 
@@ -31,6 +36,7 @@ enum ClientAddEvent : int32_t {
 
 class ClientGroup {
 public:
+    using ClientMap = std::map<sptr<IRemoteObject>, std::shared_ptr<InputClientInfo>>;
     using ClientDiedHandler = std::function<void(const sptr<IInputClient> &)>;
     ClientGroup(uint64_t displayGroupId, ClientDiedHandler diedHandler)
         : displayGroupId_(displayGroupId), clientDiedHandler_(std::move(diedHandler))
@@ -69,12 +75,25 @@ public:
     int32_t NotifyImeChangeToClients(const Property &property, const SubProperty &subProperty);
 
 private:
-    std::map<sptr<IRemoteObject>, std::shared_ptr<InputClientInfo>> GetClientMap();
+    // the clients plus their pid index, published as a whole so that the index always matches the map
+    struct ClientRegistry {
+        ClientMap clients;
+        std::unordered_map<pid_t, std::shared_ptr<InputClientInfo>> pidIndexes;
+        void Rebuild();
+    };
+    static std::shared_ptr<IdentityChecker> GetIdentityChecker();
+    std::shared_ptr<const ClientRegistry> GetRegistry();
+    std::shared_ptr<const ClientMap> GetClientMap();
+    // copies the map, modifies the copy and publishes it, the readers keep the snapshot they hold
+    void ModifyClients(const std::function<void(ClientMap &)> &modifier);
+    std::vector<std::shared_ptr<InputClientInfo>> GetClientsToNotify(
+        const std::function<bool(const InputClientInfo &)> &isNeeded);
     bool IsSameClient(sptr<IInputClient> source, sptr<IInputClient> dest);
     void OnClientDied(sptr<IInputClient> remote);
     uint64_t displayGroupId_{ DEFAULT_DISPLAY_ID };
-    std::recursive_mutex mtx_;
-    std::map<sptr<IRemoteObject>, std::shared_ptr<InputClientInfo>> mapClients_;
+    std::recursive_mutex mtx_; // serializes the writers of registry_ and the updates of the client infos
+    std::shared_ptr<const ClientRegistry> registry_ = std::make_shared<const ClientRegistry>();
+    std::shared_ptr<IdentityChecker> identityChecker_ = GetIdentityChecker();
 
     std::mutex currentClientLock_{};
     sptr<IInputClient> currentClient_; // the current input client
@@ -16,11 +16,13 @@
 #ifndef INPUTMETHOD_IMF_FREEZE_MANAGER_H
 #define INPUTMETHOD_IMF_FREEZE_MANAGER_H
 
+#include <memory>
+
 #include "ime_state_manager.h"
 
 namespace OHOS {
 namespace MiscServices {
-class FreezeManager final : public ImeStateManager {
+class FreezeManager final : public ImeStateManager, public std::enable_shared_from_this<FreezeManager> {
 public:
     explicit FreezeManager(pid_t pid) : ImeStateManager(pid)
     {
@@ -32,6 +34,9 @@ public:
     FreezeManager &operator=(const FreezeManager&) = delete;
     void TemporaryActiveIme() override;
     static void ReportRss(bool shouldFreeze, pid_t pid);
+
+private:
+    void ScheduleIdle() override;
 };
 } // namespace MiscServices
 } // namespace OHOS
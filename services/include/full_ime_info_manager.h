@@ -16,11 +16,21 @@
 #ifndef SERVICES_INCLUDE_FULL_IME_INFO_MANAGER_H
 #define SERVICES_INCLUDE_FULL_IME_INFO_MANAGER_H
 
+#include <unordered_map>
+
 #include "event_handler.h"
 #include "input_method_property.h"
 #include "timer.h"
 namespace OHOS {
 namespace MiscServices {
+// ime infos of one user with the indexes of the lookups, a published entry is never modified
+struct UserImeInfos {
+    std::vector<std::shared_ptr<const FullImeInfo>> infos;
+    std::unordered_map<std::string, std::shared_ptr<const FullImeInfo>> bundleIndexes;
+    std::unordered_map<uint32_t, std::shared_ptr<const FullImeInfo>> tokenIndexes;
+    void Rebuild();
+    std::vector<FullImeInfo> ToVector() const;
+};
 
 class FullImeInfoManager {
 public:
@@ -36,6 +46,8 @@ public:
     std::string Get(int32_t userId, uint32_t tokenId);
     bool Get(int32_t userId, const std::string &bundleName, FullImeInfo &fullImeInfo);
     bool Has(int32_t userId, const std::string &bundleName);
+    // no copy, prop.status is not filled
+    std::shared_ptr<const FullImeInfo> Find(int32_t userId, const std::string &bundleName);
     int32_t Get(int32_t userId, std::vector<Property> &props);
 
 private:
@@ -45,8 +57,10 @@ private:
     int32_t AddUser(int32_t userId, std::vector<FullImeInfo> &infos);
     int32_t AddPackage(int32_t userId, const std::string &bundleName, FullImeInfo &info);
     int32_t DeletePackage(int32_t userId, const std::string &bundleName);
+    void SetUser(int32_t userId, const std::vector<FullImeInfo> &infos);
+    void SetPackage(int32_t userId, const FullImeInfo &info);
     std::mutex lock_;
-    std::map<int32_t, std::vector<FullImeInfo>> fullImeInfos_;
+    std::map<int32_t, UserImeInfos> fullImeInfos_;
     Utils::Timer timer_{ "imeInfoCacheInitTimer" };
     uint32_t timerId_{ 0 };
     std::shared_ptr<AppExecFwk::EventHandler> serviceHandler_{ nullptr };
@@ -29,6 +29,7 @@ namespace MiscServices {
 
 class ImeCfgManager {
 public:
+    static constexpr int64_t WRITE_DELAY = 500; // ms, the changes within it are written once
     static ImeCfgManager &GetInstance();
     void Init();
     void AddImeCfg(const ImePersistInfo &cfg);
@@ -38,6 +39,8 @@ public:
     std::shared_ptr<ImeNativeCfg> GetCurrentImeCfg(int32_t userId);  // Return value is never nullptr.
     bool IsDefaultImeSet(int32_t userId);
     void SetEventHandler(const std::shared_ptr<AppExecFwk::EventHandler> &eventHandler);
+    // writes the pending changes now, e.g. on stop
+    void Flush();
 
 private:
     ImeCfgManager() = default;
@@ -47,8 +50,13 @@ private:
     ImePersistInfo GetImeCfg(int32_t userId);
     bool ParseImeCfg(const std::string &content);
     std::string PackageImeCfg();
-    std::recursive_mutex imeCfgLock_;
+    // called with imeCfgLock_ held
+    std::vector<ImePersistInfo>::iterator FindImeCfg(int32_t userId);
+    std::mutex imeCfgLock_;
     std::vector<ImePersistInfo> imeConfigs_;
+    bool isDirty_{ false };
+    bool isWritePosted_{ false };
+    std::mutex flushLock_;
     static std::shared_ptr<AppExecFwk::EventHandler> serviceHandler_;
 };
 } // namespace MiscServices
@@ -39,6 +39,8 @@ public:
 
 private:
     void ControlIme(bool shouldApply) override;
+    void ScheduleIdle() override;
+    void PostStopTask();
     std::function<void()> stopImeFunc_;
     int32_t stopDelayTime_ { STOP_DELAY_TIME };
     constexpr static int32_t STOP_DELAY_TIME = 20000;
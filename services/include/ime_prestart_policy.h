@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SERVICES_INCLUDE_IME_PRESTART_POLICY_H
+#define SERVICES_INCLUDE_IME_PRESTART_POLICY_H
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+
+namespace OHOS {
+namespace MiscServices {
+enum class PrestartSignal : int32_t {
+    SCREEN_UNLOCK = 0,
+    EDITOR_FOCUSED,
+    USER_SWITCHED,
+};
+
+/*
+ * Warms the current ime up before an editor needs it, so the first keyboard after idle does not wait for
+ * a cold start. A signal starts the ime if it is not running, or unfreezes it and restarts its stop delay.
+ * Warm ups are bounded by a budget refilled once per stop delay, and none is done under memory pressure.
+ */
+class ImePrestartPolicy {
+public:
+    // how the policy reaches the ime, implemented by the user session
+    struct ImeConnector {
+        std::function<bool()> isImeRunning;
+        std::function<int32_t()> warmUpIme;
+    };
+    struct Stats {
+        uint32_t warmUpNum{ 0 };
+        uint32_t skippedNum{ 0 };
+        uint32_t warmStartNum{ 0 };
+        uint32_t coldStartNum{ 0 };
+    };
+    using Clock = std::function<int64_t()>; // monotonic, in ms
+    static constexpr uint32_t MAX_BUDGET = 3;
+    static constexpr int64_t BUDGET_REFILL_TIME = 20000; // the stop delay of an unused ime
+    static constexpr int64_t MIN_WARM_UP_INTERVAL = 2000; // signals in a burst need one warm up only
+    static constexpr size_t MAX_EDITOR_PID_NUM = 8;
+
+    explicit ImePrestartPolicy(const ImeConnector &connector, const Clock &clock = nullptr);
+    // returns true if the ime was warmed up
+    bool OnSignal(PrestartSignal signal);
+    // a window of a process which started input recently is likely to need the ime again
+    bool OnWindowFocused(int32_t pid);
+    void SetLowMemory(bool isLowMemory);
+    // called when an editor starts input, counts whether the ime was already there
+    void OnImeRequired(int32_t pid);
+    Stats GetStats();
+    std::string Dump();
+
+private:
+    static int64_t GetSteadyTime();
+    void Refill(int64_t now);
+
+    const ImeConnector connector_;
+    const Clock clock_;
+    std::mutex lock_;
+    uint32_t budget_{ MAX_BUDGET };
+    int64_t lastRefillTime_{ 0 };
+    int64_t lastWarmUpTime_{ 0 };
+    bool hasWarmedUp_{ false };
+    bool isLowMemory_{ false };
+    Stats stats_;
+    std::deque<int32_t> editorPids_;
+};
+} // namespace MiscServices
+} // namespace OHOS
+#endif // SERVICES_INCLUDE_IME_PRESTART_POLICY_H
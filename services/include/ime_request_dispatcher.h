@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SERVICES_INCLUDE_IME_REQUEST_DISPATCHER_H
+#define SERVICES_INCLUDE_IME_REQUEST_DISPATCHER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OHOS {
+namespace MiscServices {
+/*
+ * Sends one request to several imes at once, e.g. the ime and its mirror.
+ * The first task runs on the calling thread, the others on a few workers started on demand.
+ * When every worker is busy a task runs on the calling thread after the first one, so a request never waits
+ * for a worker and the number of threads stays bounded.
+ */
+class ImeRequestDispatcher {
+public:
+    using Task = std::function<int32_t()>;
+    static constexpr uint32_t DEFAULT_WORKER_NUM = 2;
+
+    static ImeRequestDispatcher &GetInstance();
+    explicit ImeRequestDispatcher(uint32_t maxWorkerNum);
+    ~ImeRequestDispatcher();
+
+    // returns the result of every task in the order of the tasks, once all of them have finished
+    std::vector<int32_t> Dispatch(const std::vector<Task> &tasks);
+
+private:
+    struct Batch {
+        std::mutex lock;
+        std::condition_variable cv;
+        uint32_t pendingNum{ 0 };
+    };
+    struct Job {
+        const Task *task{ nullptr };
+        int32_t *result{ nullptr };
+        std::shared_ptr<Batch> batch;
+    };
+
+    bool Post(Job &&job);
+    void Work();
+    static void Finish(const std::shared_ptr<Batch> &batch);
+
+    const uint32_t maxWorkerNum_;
+    std::mutex lock_;
+    std::condition_variable cv_;
+    std::deque<Job> jobs_;
+    std::vector<std::thread> workers_;
+    uint32_t idleNum_{ 0 };
+    bool isStopped_{ false };
+};
+} // namespace MiscServices
+} // namespace OHOS
+#endif // SERVICES_INCLUDE_IME_REQUEST_DISPATCHER_H
@@ -34,6 +34,8 @@ public:
     void BeforeIpc(RequestType type);
     void AfterIpc(RequestType type, bool isSuccess);
     bool IsImeInUse();
+    // unfreezes an unused ime and leaves it thawed until its delayed freeze or stop, e.g. before an editor needs it
+    void KeepWarm();
     virtual void TemporaryActiveIme() { };
 
 protected:
@@ -41,10 +43,12 @@ protected:
     static std::shared_ptr<AppExecFwk::EventHandler> eventHandler_;
     pid_t pid_;
     bool isFrozen_ { true };
+    bool isImeInUse_ { false };
 
 private:
     virtual void ControlIme(bool shouldApply) = 0;
-    bool isImeInUse_ { false };
+    // arms only the delayed freeze or stop of a thawed ime, it must give up if the ime is in use by then
+    virtual void ScheduleIdle() = 0;
 };
 } // namespace MiscServices
 } // namespace OHOS
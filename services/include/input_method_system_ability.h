@@ -95,6 +95,7 @@ public:
     ErrCode IsCapacitySupport(int32_t capacity, bool &isSupport) override;
     ErrCode BindImeMirror(const sptr<IInputMethodCore> &core, const sptr<IRemoteObject> &agent) override;
     ErrCode UnbindImeMirror() override;
+    ErrCode ReportTypingTrace(const std::string &ring) override;
     int32_t GetCallingUserId();
 
 protected:
@@ -132,6 +133,7 @@ private:
         const std::shared_ptr<PerUserSession> &session);
     int32_t OnStartInputType(int32_t userId, const SwitchInfo &switchInfo, bool isCheckPermission);
     int32_t HandlePackageEvent(const Message *msg);
+    static MessageHandler::CoalesceKey GetCoalesceKey(const Message &msg);
     int32_t HandleUpdateLargeMemoryState(const Message *msg);
     int32_t OnPackageRemoved(int32_t userId, const std::string &packageName);
     void OnScreenUnlock(const Message *msg);
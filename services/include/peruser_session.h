@@ -24,6 +24,7 @@
 #include "iinput_method_core.h"
 #include "ime_cfg_manager.h"
 #include "ime_connection.h"
+#include "ime_prestart_policy.h"
 #include "input_method_types.h"
 #include "input_type_manager.h"
 #include "inputmethod_message_handler.h"
@@ -181,6 +182,7 @@ public:
     void IncreaseScbStartCount();
     int32_t TryStartIme();
     int32_t TryDisconnectIme();
+    ImePrestartPolicy &GetPrestartPolicy();
 
 private:
     struct ResetManager {
@@ -248,6 +250,7 @@ private:
     int32_t InitInputControlChannel();
     void StartImeInImeDied();
     void StartImeIfInstalled();
+    int32_t WarmUpIme();
     void ReplaceCurrentClient(const sptr<IInputClient> &client, const std::shared_ptr<ClientGroup> &clientGroup);
     bool IsSameClient(sptr<IInputClient> source, sptr<IInputClient> dest);
 
@@ -257,6 +260,8 @@ private:
     bool IsImeBindTypeChanged(ImeType bindImeType);
     int32_t RequestIme(const std::shared_ptr<ImeData> &data, RequestType type, const IpcExec &exec);
     int32_t RequestAllIme(const std::shared_ptr<ImeData> data, RequestType reqType, const CoreMethod &method);
+    int32_t MergeImeResults(const std::vector<std::shared_ptr<ImeData>> &dataArray,
+        const std::vector<int32_t> &results, const char *action);
     std::vector<std::shared_ptr<ImeData>> GetAllReadyImeData(ImeType type);
 
     bool WaitForCurrentImeStop();
@@ -350,6 +355,8 @@ private:
     sptr<AAFwk::IAbilityConnection> connection_ = nullptr;
     std::atomic<bool> isBlockStartedByLowMem_ = false;
     bool isFirstPreemption_ = false;
+    ImePrestartPolicy prestartPolicy_{ { [this]() { return GetReadyImeData(ImeType::IME) != nullptr; },
+        [this]() { return WarmUpIme(); } } };
 };
 } // namespace MiscServices
 } // namespace OHOS
@@ -16,6 +16,9 @@
 #ifndef SERVICES_INCLUDE_SYS_CFG_PARSE_H
 #define SERVICES_INCLUDE_SYS_CFG_PARSE_H
 
+#include <memory>
+#include <mutex>
+
 #include "input_method_status.h"
 #include "input_method_utils.h"
 #include "serializable.h"
@@ -178,6 +181,29 @@ struct IgnoreSysPanelAdjustCfg : public Serializable {
     }
 };
 
+template<typename T> struct SysCfgSection {
+    bool isFound = false; // one of the config files contains the key
+    bool isParsed = false;
+    T cfg;
+};
+
+struct SysCfgFileStamp {
+    std::string path;
+    int64_t mtimeNs = 0;
+    int64_t size = 0;
+};
+
+// every config file read and parsed once, shared until one of the files changes or Reload is called
+struct SysCfgSnapshot {
+    std::vector<SysCfgFileStamp> stamps;
+    SysCfgSection<ImeSystemConfig> systemConfig;
+    SysCfgSection<InputTypeCfg> inputType;
+    SysCfgSection<DynamicStartImeCfg> dynamicStartIme;
+    SysCfgSection<SysPanelAdjustCfg> panelAdjust;
+    SysCfgSection<DefaultFullImeCfg> defaultFullIme;
+    SysCfgSection<IgnoreSysPanelAdjustCfg> ignoreSysPanelAdjust;
+};
+
 class SysCfgParser {
 public:
     static bool ParseSystemConfig(SystemConfig &systemConfig);
@@ -186,9 +212,15 @@ public:
     static bool ParseDefaultFullIme(std::vector<DefaultFullImeInfo> &defaultFullImeList);
     static bool ParseIgnoreSysPanelAdjust(IgnoreSysPanelAdjust &ignoreSysPanelAdjust);
     static bool ParseDynamicStartImeCfg(std::vector<DynamicStartImeCfgItem> &dynamicStartImeCfgList);
+    static void Reload();
 
 private:
-    static std::string GetSysCfgContent(const std::string &key);
+    static std::shared_ptr<const SysCfgSnapshot> GetSnapshot();
+    static std::shared_ptr<const SysCfgSnapshot> LoadSnapshot();
+    static bool GetFileStamp(const std::string &path, SysCfgFileStamp &stamp);
+    static bool IsChanged(const SysCfgSnapshot &snapshot);
+    static std::mutex loadLock_;
+    static std::shared_ptr<const SysCfgSnapshot> snapshot_;
 };
 } // namespace MiscServices
 } // namespace OHOS
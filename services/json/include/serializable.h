@@ -101,12 +101,16 @@ public:
         }
         values.resize(size);
         bool ret = true;
-        for (int32_t i = 0; i < size; i++) {
-            auto item = cJSON_GetArrayItem(subNode, i);
-            if (item == NULL) {
-                return false;
+        // walk the list once, cJSON_GetArrayItem starts from the head on every call
+        int32_t i = 0;
+        cJSON *item = nullptr;
+        cJSON_ArrayForEach(item, subNode)
+        {
+            if (i >= size) {
+                break;
             }
             ret = GetValue(item, "", values[i]) && ret;
+            i++;
         }
         return ret;
     }
@@ -124,17 +128,20 @@ public:
             size = maxNum;
         }
         bool result = true;
-        for (int32_t i = 0; i < size; i++) {
-            auto item = cJSON_GetArrayItem(subNode, i);
-            if (item == NULL) {
-                return false;
+        int32_t i = 0;
+        cJSON *item = nullptr;
+        cJSON_ArrayForEach(item, subNode)
+        {
+            if (i >= size) {
+                break;
             }
             T value;
             bool ret = GetValue(item, "", value);
-            if (ret && !values.count(value)) {
-                values.insert(value);
+            if (ret) {
+                values.insert(std::move(value));
             }
             result = ret && result;
+            i++;
         }
         return result;
     }
@@ -117,22 +117,22 @@ bool Serializable::GetValue(cJSON *node, const std::string &name, std::vector<st
         IMSA_HILOGD("%{public}s not array", name.c_str());
         return false;
     }
-    auto arrLen = cJSON_GetArraySize(arrNode);
-    for (auto i = 0; i < arrLen; i++) {
-        auto subArrNode = cJSON_GetArrayItem(arrNode, i);
-        if (subArrNode == nullptr || !cJSON_IsArray(subArrNode)) {
+    cJSON *subArrNode = nullptr;
+    cJSON_ArrayForEach(subArrNode, arrNode)
+    {
+        if (!cJSON_IsArray(subArrNode)) {
             continue;
         }
         std::vector<std::string> subStringArr;
-        auto subArrLen = cJSON_GetArraySize(subArrNode);
-        for (auto j = 0; j < subArrLen; j++) {
-            auto strNode = cJSON_GetArrayItem(subArrNode, j);
-            if (strNode == nullptr || !cJSON_IsString(strNode)) {
+        cJSON *strNode = nullptr;
+        cJSON_ArrayForEach(strNode, subArrNode)
+        {
+            if (!cJSON_IsString(strNode)) {
                 continue;
             }
             subStringArr.push_back(strNode->valuestring);
         }
-        values.push_back(subStringArr);
+        values.push_back(std::move(subStringArr));
     }
     return true;
 }
@@ -237,11 +237,12 @@ cJSON *Serializable::GetSubNode(cJSON *node, const std::string &name)
         IMSA_HILOGD("not object, name:%{public}s", name.c_str());
         return nullptr;
     }
-    if (!cJSON_HasObjectItem(node, name.c_str())) {
+    // one lookup, cJSON_HasObjectItem is a full cJSON_GetObjectItem as well
+    auto subNode = cJSON_GetObjectItem(node, name.c_str());
+    if (subNode == nullptr) {
         IMSA_HILOGD("subNode: %{public}s not contain.", name.c_str());
-        return nullptr;
     }
-    return cJSON_GetObjectItem(node, name.c_str());
+    return subNode;
 }
 } // namespace MiscServices
 } // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "client_broadcaster.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <pthread.h>
+
+#include "global.h"
+
+namespace OHOS {
+namespace MiscServices {
+ClientBroadcaster &ClientBroadcaster::GetInstance()
+{
+    static ClientBroadcaster broadcaster(DEFAULT_WORKER_NUM, DEFAULT_MAX_PENDING_NUM);
+    return broadcaster;
+}
+
+ClientBroadcaster::ClientBroadcaster(uint32_t workerNum, size_t maxPendingNum)
+    : workerNum_(std::max(workerNum, 1U)), maxPendingNum_(std::max<size_t>(maxPendingNum, 1))
+{
+}
+
+ClientBroadcaster::~ClientBroadcaster()
+{
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        isStopped_ = true;
+    }
+    cv_.notify_all();
+    for (auto &worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    // wakes up the callers of Send still waiting
+    for (auto &[pid, queue] : clientQueues_) {
+        for (const auto &job : queue.jobs) {
+            Finish(job, ErrorCode::ERROR_IMSA_CLIENT_BUSY);
+        }
+    }
+}
+
+uint32_t ClientBroadcaster::Broadcast(const std::string &event,
+    const std::vector<std::shared_ptr<InputClientInfo>> &clients, const Notify &notify, int64_t timeoutMs)
+{
+    if (notify == nullptr) {
+        return 0;
+    }
+    auto round = std::make_shared<Round>();
+    round->event = event;
+    auto sharedNotify = std::make_shared<const Notify>(notify);
+    for (const auto &clientInfo : clients) {
+        if (clientInfo == nullptr || clientInfo->client == nullptr) {
+            continue;
+        }
+        {
+            std::lock_guard<std::mutex> lock(round->lock);
+            ++round->pendingNum;
+        }
+        Job job = { clientInfo, sharedNotify, round };
+        std::vector<Job> dropped;
+        auto ret = Post(Job(job), timeoutMs, dropped);
+        if (ret != ErrorCode::NO_ERROR) {
+            Finish(job, ret);
+        }
+        for (const auto &droppedJob : dropped) {
+            Finish(droppedJob, ErrorCode::ERROR_IMSA_CLIENT_BUSY);
+        }
+    }
+    std::unique_lock<std::mutex> lock(round->lock);
+    if (!round->cv.wait_for(lock, std::chrono::milliseconds(timeoutMs), [&round]() {
+        return round->pendingNum == 0;
+    })) {
+        round->isExpired = true;
+        IMSA_HILOGW("%{public}s: %{public}u clients not answered in %{public}" PRId64 " ms.", event.c_str(),
+            round->pendingNum, timeoutMs);
+        return round->failedNum + round->pendingNum;
+    }
+    return round->failedNum;
+}
+
+int32_t ClientBroadcaster::Send(
+    const std::string &event, const std::shared_ptr<InputClientInfo> &clientInfo, const Notify &notify)
+{
+    if (clientInfo == nullptr || clientInfo->client == nullptr || notify == nullptr) {
+        return ErrorCode::ERROR_CLIENT_NULL_POINTER;
+    }
+    auto pid = clientInfo->pid;
+    auto round = std::make_shared<Round>();
+    round->event = event;
+    round->pendingNum = 1;
+    bool isQueued = false;
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        auto &queue = clientQueues_[pid];
+        isQueued = !isStopped_ && (queue.isRunning || !queue.jobs.empty());
+        if (isQueued) {
+            queue.jobs.push_back({ clientInfo, std::make_shared<const Notify>(notify), round, false });
+            if (!queue.isRunning && queue.jobs.size() == 1) {
+                Schedule(pid);
+            }
+        } else {
+            // nothing queued before it, so the caller notifies the client itself
+            queue.isRunning = true;
+            queue.runningSince = std::chrono::steady_clock::now();
+        }
+    }
+    if (!isQueued) {
+        auto ret = notify(clientInfo);
+        std::lock_guard<std::mutex> lock(lock_);
+        Release(pid);
+        return ret;
+    }
+    IMSA_HILOGD("%{public}s: client: %{public}d busy, wait for its queued notifies.", event.c_str(), pid);
+    std::unique_lock<std::mutex> lock(round->lock);
+    round->cv.wait(lock, [&round]() { return round->pendingNum == 0; });
+    return round->result;
+}
+
+int32_t ClientBroadcaster::Post(Job &&job, int64_t timeoutMs, std::vector<Job> &dropped)
+{
+    auto pid = job.clientInfo->pid;
+    std::lock_guard<std::mutex> lock(lock_);
+    if (isStopped_) {
+        return ErrorCode::ERROR_IMSA_CLIENT_BUSY;
+    }
+    auto &queue = clientQueues_[pid];
+    if (queue.jobs.size() >= maxPendingNum_) {
+        // a notify with a newer one of the same kind behind it is outdated
+        auto isOutdated = [&queue, &job](std::deque<Job>::iterator iter) {
+            if (!iter->isDroppable) {
+                return false;
+            }
+            const auto &event = iter->round->event;
+            return event == job.round->event || std::any_of(std::next(iter), queue.jobs.end(),
+                [&event](const Job &newer) { return newer.isDroppable && newer.round->event == event; });
+        };
+        auto iter = queue.jobs.begin();
+        while (iter != queue.jobs.end() && !isOutdated(iter)) {
+            ++iter;
+        }
+        if (iter == queue.jobs.end()) {
+            IMSA_HILOGE("%{public}s: queue full, drop it for client: %{public}d.", job.round->event.c_str(), pid);
+            return ErrorCode::ERROR_IMSA_CLIENT_BUSY;
+        }
+        IMSA_HILOGW("%{public}s: queue full, drop outdated %{public}s for client: %{public}d.",
+            job.round->event.c_str(), iter->round->event.c_str(), pid);
+        dropped.push_back(std::move(*iter));
+        queue.jobs.erase(iter);
+    }
+    auto isHung = queue.isRunning &&
+        std::chrono::steady_clock::now() - queue.runningSince > std::chrono::milliseconds(timeoutMs);
+    auto round = job.round;
+    if (isHung) {
+        // still queued to keep the order, but the caller does not wait for it
+        auto detached = std::make_shared<Round>();
+        detached->event = round->event;
+        detached->pendingNum = 1;
+        detached->isExpired = true;
+        job.round = detached;
+    }
+    queue.jobs.push_back(std::move(job));
+    if (!queue.isRunning && queue.jobs.size() == 1) {
+        Schedule(pid);
+    }
+    if (isHung) {
+        IMSA_HILOGE("%{public}s: client: %{public}d not responding, queued.", round->event.c_str(), pid);
+        return ErrorCode::ERROR_IMSA_CLIENT_BUSY;
+    }
+    return ErrorCode::NO_ERROR;
+}
+
+void ClientBroadcaster::Schedule(pid_t pid)
+{
+    readyPids_.push_back(pid);
+    // a new worker only when the running ones are all taken
+    if (workers_.size() < workerNum_ && readyPids_.size() > idleNum_) {
+        workers_.emplace_back([this]() { Work(); });
+        return;
+    }
+    cv_.notify_one();
+}
+
+void ClientBroadcaster::Release(pid_t pid)
+{
+    // the queue of a process is only erased when it is neither running nor queued
+    auto iter = clientQueues_.find(pid);
+    if (iter == clientQueues_.end()) {
+        return;
+    }
+    iter->second.isRunning = false;
+    if (iter->second.jobs.empty()) {
+        clientQueues_.erase(iter);
+        return;
+    }
+    if (!isStopped_) {
+        Schedule(pid);
+    }
+}
+
+void ClientBroadcaster::Work()
+{
+    pthread_setname_np(pthread_self(), "OS_ImsaNotify");
+    std::unique_lock<std::mutex> lock(lock_);
+    while (true) {
+        ++idleNum_;
+        cv_.wait(lock, [this]() { return isStopped_ || !readyPids_.empty(); });
+        --idleNum_;
+        if (isStopped_) {
+            return;
+        }
+        auto pid = readyPids_.front();
+        readyPids_.pop_front();
+        auto &queue = clientQueues_[pid];
+        auto job = std::move(queue.jobs.front());
+        queue.jobs.pop_front();
+        queue.isRunning = true;
+        queue.runningSince = std::chrono::steady_clock::now();
+        lock.unlock();
+        Finish(job, (*job.notify)(job.clientInfo));
+        lock.lock();
+        Release(pid);
+    }
+}
+
+void ClientBroadcaster::Finish(const Job &job, int32_t ret)
+{
+    auto &round = job.round;
+    std::lock_guard<std::mutex> lock(round->lock);
+    if (ret != ErrorCode::NO_ERROR) {
+        ++round->failedNum;
+        round->result = ret;
+        IMSA_HILOGE("%{public}s: failed to notify client: %{public}d, ret: %{public}d.", round->event.c_str(),
+            job.clientInfo->pid, ret);
+    }
+    if (round->isExpired) {
+        IMSA_HILOGW("%{public}s: client: %{public}d answered late.", round->event.c_str(), job.clientInfo->pid);
+    }
+    if (--round->pendingNum == 0) {
+        round->cv.notify_all();
+    }
+}
+} // namespace MiscServices
+} // namespace OHOS
@@ -17,6 +17,7 @@
 
 #include <cinttypes>
 
+#include "client_broadcaster.h"
 #include "event_status_manager.h"
 #include "identity_checker_impl.h"
 #include "variant_util.h"
@@ -67,8 +68,7 @@ int32_t ClientGroup::AddClientInfo(
         IMSA_HILOGE("failed to add client death recipient!");
         return ErrorCode::ERROR_CLIENT_ADD_FAILED;
     }
-    std::lock_guard<std::recursive_mutex> lock(mtx_);
-    mapClients_.insert({ inputClient, info });
+    ModifyClients([&inputClient, &info](ClientMap &clients) { clients.insert({ inputClient, info }); });
     IMSA_HILOGI(
         "add client with pid: %{public}d displayGroupId: %{public}" PRIu64 " end.", clientInfo.pid, displayGroupId_);
     return ErrorCode::NO_ERROR;
@@ -94,8 +94,7 @@ void ClientGroup::RemoveClientInfo(const sptr<IRemoteObject> &client, bool isCli
         IMSA_HILOGD("deathRecipient remove.");
         client->RemoveDeathRecipient(clientInfo->deathRecipient);
     }
-    std::lock_guard<std::recursive_mutex> lock(mtx_);
-    mapClients_.erase(client);
+    ModifyClients([&client](ClientMap &clients) { clients.erase(client); });
     IMSA_HILOGI("client[%{public}d] is removed.", clientInfo->pid);
 }
 // LCOV_EXCL_START
@@ -107,8 +106,9 @@ void ClientGroup::UpdateClientInfo(const sptr<IRemoteObject> &client, const std:
         return;
     }
     std::lock_guard<std::recursive_mutex> lock(mtx_);
-    auto it = mapClients_.find(client);
-    if (it == mapClients_.end() || it->second == nullptr) {
+    auto clients = GetClientMap();
+    auto it = clients->find(client);
+    if (it == clients->end() || it->second == nullptr) {
         IMSA_HILOGD("client not found.");
         return;
     }
@@ -154,15 +154,15 @@ void ClientGroup::UpdateClientInfo(const sptr<IRemoteObject> &client, const std:
 
 std::shared_ptr<InputClientInfo> ClientGroup::GetClientInfo(pid_t pid)
 {
-    auto iter = std::find_if(
-        mapClients_.begin(), mapClients_.end(), [pid](const auto &mapClient) { return mapClient.second->pid == pid; });
-    if (iter == mapClients_.end()) {
+    auto registry = GetRegistry();
+    auto iter = registry->pidIndexes.find(pid);
+    if (iter == registry->pidIndexes.end()) {
         IMSA_HILOGD("not found.");
         return nullptr;
     }
-    std::lock_guard<std::recursive_mutex> lock(mtx_);
     return iter->second;
 }
+
 // LCOV_EXCL_STOP
 std::shared_ptr<InputClientInfo> ClientGroup::GetCurrentClientInfo()
 {
@@ -201,8 +201,8 @@ int64_t ClientGroup::GetInactiveClientPid()
 // LCOV_EXCL_STOP
 bool ClientGroup::IsClientExist(sptr<IRemoteObject> inputClient)
 {
-    std::lock_guard<std::recursive_mutex> lock(mtx_);
-    return mapClients_.find(inputClient) != mapClients_.end();
+    auto clients = GetClientMap();
+    return clients->find(inputClient) != clients->end();
 }
 
 bool ClientGroup::IsNotifyInputStop(const sptr<IInputClient> &client)
@@ -250,9 +250,8 @@ bool ClientGroup::IsCurClientFocused(int32_t pid, int32_t uid)
         IMSA_HILOGE("failed to get cur client info!");
         return false;
     }
-    auto identityChecker = std::make_shared<IdentityCheckerImpl>();
     if (clientInfo->uiExtensionTokenId != IMF_INVALID_TOKENID
-        && identityChecker->IsFocusedUIExtension(clientInfo->uiExtensionTokenId)) {
+        && identityChecker_->IsFocusedUIExtension(clientInfo->uiExtensionTokenId)) {
         IMSA_HILOGI("UIExtension focused");
         return true;
     }
@@ -266,9 +265,8 @@ bool ClientGroup::IsCurClientUnFocused(int32_t pid, int32_t uid)
         IMSA_HILOGE("failed to get cur client info!");
         return false;
     }
-    auto identityChecker = std::make_shared<IdentityCheckerImpl>();
     if (clientInfo->uiExtensionTokenId != IMF_INVALID_TOKENID
-        && !identityChecker->IsFocusedUIExtension(clientInfo->uiExtensionTokenId)) {
+        && !identityChecker_->IsFocusedUIExtension(clientInfo->uiExtensionTokenId)) {
         IMSA_HILOGI("UIExtension UnFocused.");
         return true;
     }
@@ -278,85 +276,51 @@ bool ClientGroup::IsCurClientUnFocused(int32_t pid, int32_t uid)
 int32_t ClientGroup::NotifyInputStartToClients(uint32_t callingWndId, int32_t requestKeyboardReason)
 {
     IMSA_HILOGD("NotifyInputStartToClients enter");
-    auto clientMap = GetClientMap();
-    for (const auto &client : clientMap) {
-        auto clientInfo = client.second;
-        if (clientInfo == nullptr || clientInfo->client == nullptr ||
-            !EventStatusManager::IsInputStatusChangedOn(clientInfo->eventFlag)) {
-            IMSA_HILOGD("nullptr clientInfo or no need to notify");
-            continue;
-        }
-        int32_t ret = clientInfo->client->NotifyInputStart(callingWndId, requestKeyboardReason);
-        if (ret != ErrorCode::NO_ERROR) {
-            IMSA_HILOGE("failed to notify OnInputStart, errorCode: %{public}d", ret);
-            continue;
-        }
-    }
+    auto clientInfos = GetClientsToNotify(
+        [](const InputClientInfo &info) { return EventStatusManager::IsInputStatusChangedOn(info.eventFlag); });
+    ClientBroadcaster::GetInstance().Broadcast("NotifyInputStart", clientInfos,
+        [callingWndId, requestKeyboardReason](const std::shared_ptr<InputClientInfo> &clientInfo) {
+            return clientInfo->client->NotifyInputStart(callingWndId, requestKeyboardReason);
+        });
     return ErrorCode::NO_ERROR;
 }
 
 int32_t ClientGroup::NotifyInputStopToClients()
 {
     IMSA_HILOGD("NotifyInputStopToClients enter");
-    auto clientMap = GetClientMap();
-    for (const auto &client : clientMap) {
-        auto clientInfo = client.second;
-        if (clientInfo == nullptr || clientInfo->client == nullptr
-            || !EventStatusManager::IsInputStatusChangedOn(clientInfo->eventFlag)) {
-            IMSA_HILOGD("nullptr clientInfo or no need to notify");
-            continue;
-        }
-        int32_t ret = clientInfo->client->NotifyInputStop();
-        if (ret != ErrorCode::NO_ERROR) {
-            IMSA_HILOGE("failed to notify OnInputStop, errorCode: %{public}d", ret);
-            continue;
-        }
-    }
+    auto clientInfos = GetClientsToNotify(
+        [](const InputClientInfo &info) { return EventStatusManager::IsInputStatusChangedOn(info.eventFlag); });
+    ClientBroadcaster::GetInstance().Broadcast("NotifyInputStop", clientInfos,
+        [](const std::shared_ptr<InputClientInfo> &clientInfo) { return clientInfo->client->NotifyInputStop(); });
     return ErrorCode::NO_ERROR;
 }
 
 int32_t ClientGroup::NotifyPanelStatusChange(const InputWindowStatus &status, const ImeWindowInfo &info)
 {
-    auto clientMap = GetClientMap();
-    for (const auto &client : clientMap) {
-        auto clientInfo = client.second;
-        if (clientInfo == nullptr) {
-            IMSA_HILOGD("client nullptr or no need to notify.");
-            continue;
+    auto clientInfos = GetClientsToNotify([status](const InputClientInfo &clientInfo) {
+        if (status == InputWindowStatus::SHOW) {
+            return EventStatusManager::IsImeShowOn(clientInfo.eventFlag);
         }
-        if (status == InputWindowStatus::SHOW && !EventStatusManager::IsImeShowOn(clientInfo->eventFlag)) {
-            IMSA_HILOGD("has not imeShow callback");
-            continue;
+        if (status == InputWindowStatus::HIDE) {
+            return EventStatusManager::IsImeHideOn(clientInfo.eventFlag);
         }
-        if (status == InputWindowStatus::HIDE && !EventStatusManager::IsImeHideOn(clientInfo->eventFlag)) {
-            IMSA_HILOGD("has not imeHide callback");
-            continue;
-        }
-        int32_t ret = clientInfo->client->OnPanelStatusChange(static_cast<uint32_t>(status), info);
-        if (ret != ErrorCode::NO_ERROR) {
-            IMSA_HILOGE("failed to NotifyPanelStatusChange, ret: %{public}d", ret);
-            continue;
-        }
-    }
+        return true;
+    });
+    ClientBroadcaster::GetInstance().Broadcast("NotifyPanelStatusChange", clientInfos,
+        [status, info](const std::shared_ptr<InputClientInfo> &clientInfo) {
+            return clientInfo->client->OnPanelStatusChange(static_cast<uint32_t>(status), info);
+        });
     return ErrorCode::NO_ERROR;
 }
 // LCOV_EXCL_STOP
 int32_t ClientGroup::NotifyImeChangeToClients(const Property &property, const SubProperty &subProperty)
 {
-    auto clientMap = GetClientMap();
-    for (const auto &client : clientMap) {
-        auto clientInfo = client.second;
-        if (clientInfo == nullptr || !EventStatusManager::IsImeChangeOn(clientInfo->eventFlag)) {
-            IMSA_HILOGD("client nullptr or no need to notify.");
-            continue;
-        }
-        IMSA_HILOGD("notify client: [%{public}d]", static_cast<int32_t>(clientInfo->pid));
-        int32_t ret = clientInfo->client->OnSwitchInput(property, subProperty);
-        if (ret != ErrorCode::NO_ERROR) {
-            IMSA_HILOGE("notify failed, ret: %{public}d, uid: %{public}d!", ret, static_cast<int32_t>(clientInfo->uid));
-            continue;
-        }
-    }
+    auto clientInfos = GetClientsToNotify(
+        [](const InputClientInfo &info) { return EventStatusManager::IsImeChangeOn(info.eventFlag); });
+    ClientBroadcaster::GetInstance().Broadcast("NotifyImeChange", clientInfos,
+        [property, subProperty](const std::shared_ptr<InputClientInfo> &clientInfo) {
+            return clientInfo->client->OnSwitchInput(property, subProperty);
+        });
     return ErrorCode::NO_ERROR;
 }
 
@@ -366,19 +330,66 @@ std::shared_ptr<InputClientInfo> ClientGroup::GetClientInfo(sptr<IRemoteObject>
         IMSA_HILOGE("inputClient is nullptr!");
         return nullptr;
     }
-    std::lock_guard<std::recursive_mutex> lock(mtx_);
-    auto it = mapClients_.find(inputClient);
-    if (it == mapClients_.end()) {
+    auto clients = GetClientMap();
+    auto it = clients->find(inputClient);
+    if (it == clients->end()) {
         IMSA_HILOGD("client not found.");
         return nullptr;
     }
     return it->second;
 }
 
-std::map<sptr<IRemoteObject>, std::shared_ptr<InputClientInfo>> ClientGroup::GetClientMap()
+void ClientGroup::ClientRegistry::Rebuild()
+{
+    pidIndexes.clear();
+    for (const auto &[object, clientInfo] : clients) {
+        if (clientInfo == nullptr) {
+            continue;
+        }
+        // the first client in the map wins, as the lookups did when they scanned the map
+        pidIndexes.try_emplace(clientInfo->pid, clientInfo);
+    }
+}
+
+std::shared_ptr<IdentityChecker> ClientGroup::GetIdentityChecker()
+{
+    static auto identityChecker = std::make_shared<IdentityCheckerImpl>();
+    return identityChecker;
+}
+
+std::shared_ptr<const ClientGroup::ClientRegistry> ClientGroup::GetRegistry()
+{
+    return std::atomic_load(&registry_);
+}
+
+std::shared_ptr<const ClientGroup::ClientMap> ClientGroup::GetClientMap()
+{
+    auto registry = GetRegistry();
+    return std::shared_ptr<const ClientMap>(registry, &registry->clients);
+}
+
+void ClientGroup::ModifyClients(const std::function<void(ClientMap &)> &modifier)
 {
     std::lock_guard<std::recursive_mutex> lock(mtx_);
-    return mapClients_;
+    auto registry = std::make_shared<ClientRegistry>();
+    registry->clients = GetRegistry()->clients;
+    modifier(registry->clients);
+    registry->Rebuild();
+    std::atomic_store(&registry_, std::shared_ptr<const ClientRegistry>(std::move(registry)));
+}
+
+std::vector<std::shared_ptr<InputClientInfo>> ClientGroup::GetClientsToNotify(
+    const std::function<bool(const InputClientInfo &)> &isNeeded)
+{
+    std::vector<std::shared_ptr<InputClientInfo>> clientInfos;
+    auto clients = GetClientMap();
+    for (const auto &[object, clientInfo] : *clients) {
+        if (clientInfo == nullptr || clientInfo->client == nullptr || !isNeeded(*clientInfo)) {
+            continue;
+        }
+        clientInfos.push_back(clientInfo);
+    }
+    return clientInfos;
 }
 
 bool ClientGroup::IsSameClient(sptr<IInputClient> source, sptr<IInputClient> dest)
@@ -46,6 +46,31 @@ void FreezeManager::ControlIme(bool shouldApply)
     }
 }
 
+void FreezeManager::ScheduleIdle()
+{
+    if (eventHandler_ == nullptr) {
+        IMSA_HILOGW("eventHandler_ is nullptr.");
+        return;
+    }
+    // the ime stays thawed until the delayed freeze, a later warm up restarts the delay
+    eventHandler_->RemoveTask(STOP_TASK_NAME);
+    std::weak_ptr<FreezeManager> weakThis = shared_from_this();
+    eventHandler_->PostTask(
+        [weakThis]() {
+            auto sharedThis = weakThis.lock();
+            if (sharedThis == nullptr) {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(sharedThis->mutex_);
+            if (sharedThis->isImeInUse_ || sharedThis->isFrozen_) {
+                return;
+            }
+            sharedThis->isFrozen_ = true;
+            ReportRss(true, sharedThis->pid_);
+        },
+        STOP_TASK_NAME, DELAY_TIME);
+}
+
 void FreezeManager::ReportRss(bool shouldFreeze, pid_t pid)
 {
     auto type = ResourceSchedule::ResType::RES_TYPE_SA_CONTROL_APP_EVENT;
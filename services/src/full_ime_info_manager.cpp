@@ -23,6 +23,29 @@
 namespace OHOS {
 namespace MiscServices {
 constexpr uint32_t TIMER_TASK_INTERNAL = 1 * 60 * 60 * 1000; // updated hourly
+void UserImeInfos::Rebuild()
+{
+    bundleIndexes.clear();
+    tokenIndexes.clear();
+    bundleIndexes.reserve(infos.size());
+    tokenIndexes.reserve(infos.size());
+    // the first one wins, as the linear search did
+    for (const auto &info : infos) {
+        bundleIndexes.emplace(info->prop.name, info);
+        tokenIndexes.emplace(info->tokenId, info);
+    }
+}
+
+std::vector<FullImeInfo> UserImeInfos::ToVector() const
+{
+    std::vector<FullImeInfo> result;
+    result.reserve(infos.size());
+    for (const auto &info : infos) {
+        result.push_back(*info);
+    }
+    return result;
+}
+
 FullImeInfoManager::~FullImeInfoManager()
 {
     timer_.Unregister(timerId_);
@@ -71,7 +94,7 @@ int32_t FullImeInfoManager::RegularInit()
     std::lock_guard<std::mutex> lock(lock_);
     fullImeInfos_.clear();
     for (const auto &infos : fullImeInfos) {
-        fullImeInfos_.insert_or_assign(infos.first, infos.second);
+        SetUser(infos.first, infos.second);
     }
     return ErrorCode::NO_ERROR;
 }
@@ -100,7 +123,7 @@ int32_t FullImeInfoManager::Update()
     {
         std::lock_guard<std::mutex> lock(lock_);
         for (const auto &infos : fullImeInfos) {
-            fullImeInfos_.insert_or_assign(infos.first, infos.second);
+            SetUser(infos.first, infos.second);
         }
     }
     return ErrorCode::NO_ERROR;
@@ -144,17 +167,7 @@ int32_t FullImeInfoManager::Update(int32_t userId, const std::string &bundleName
         return ErrorCode::ERROR_PACKAGE_MANAGER;
     }
     std::lock_guard<std::mutex> lock(lock_);
-    auto it = fullImeInfos_.find(userId);
-    if (it == fullImeInfos_.end()) {
-        fullImeInfos_.insert({ userId, { info } });
-        return ErrorCode::NO_ERROR;
-    }
-    auto iter = std::find_if(it->second.begin(), it->second.end(),
-        [&bundleName](const FullImeInfo &info) { return bundleName == info.prop.name; });
-    if (iter != it->second.end()) {
-        it->second.erase(iter);
-    }
-    it->second.push_back(info);
+    SetPackage(userId, info);
     return ErrorCode::NO_ERROR;
 }
 
@@ -166,8 +179,9 @@ int32_t FullImeInfoManager::Get(int32_t userId, std::vector<Property> &props)
         if (it == fullImeInfos_.end()) {
             return {};
         }
-        for (auto &fullImeInfo : it->second) {
-            props.push_back(fullImeInfo.prop);
+        props.reserve(props.size() + it->second.infos.size());
+        for (const auto &fullImeInfo : it->second.infos) {
+            props.push_back(fullImeInfo->prop);
         }
     }
     auto ret = ImeEnabledInfoManager::GetInstance().GetEnabledStates(userId, props);
@@ -180,21 +194,11 @@ int32_t FullImeInfoManager::Get(int32_t userId, std::vector<Property> &props)
 
 bool FullImeInfoManager::Get(int32_t userId, const std::string &bundleName, FullImeInfo &fullImeInfo)
 {
-    {
-        std::lock_guard<std::mutex> lock(lock_);
-        auto it = fullImeInfos_.find(userId);
-        if (it == fullImeInfos_.end()) {
-            IMSA_HILOGD("user %{public}d info", userId);
-            return false;
-        }
-        auto iter = std::find_if(it->second.begin(), it->second.end(),
-            [&bundleName](const FullImeInfo &info) { return bundleName == info.prop.name; });
-        if (iter == it->second.end()) {
-            IMSA_HILOGD("ime: %{public}s not in cache", bundleName.c_str());
-            return false;
-        }
-        fullImeInfo = *iter;
+    auto info = Find(userId, bundleName);
+    if (info == nullptr) {
+        return false;
     }
+    fullImeInfo = *info;
     auto ret =
         ImeEnabledInfoManager::GetInstance().GetEnabledState(userId, fullImeInfo.prop.name, fullImeInfo.prop.status);
     if (ret != ErrorCode::NO_ERROR) {
@@ -210,9 +214,23 @@ bool FullImeInfoManager::Has(int32_t userId, const std::string &bundleName)
     if (it == fullImeInfos_.end()) {
         return false;
     }
-    auto iter = std::find_if(it->second.begin(), it->second.end(),
-        [&bundleName](const FullImeInfo &info) { return bundleName == info.prop.name; });
-    return iter != it->second.end();
+    return it->second.bundleIndexes.find(bundleName) != it->second.bundleIndexes.end();
+}
+
+std::shared_ptr<const FullImeInfo> FullImeInfoManager::Find(int32_t userId, const std::string &bundleName)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    auto it = fullImeInfos_.find(userId);
+    if (it == fullImeInfos_.end()) {
+        IMSA_HILOGD("user %{public}d info", userId);
+        return nullptr;
+    }
+    auto iter = it->second.bundleIndexes.find(bundleName);
+    if (iter == it->second.bundleIndexes.end()) {
+        IMSA_HILOGD("ime: %{public}s not in cache", bundleName.c_str());
+        return nullptr;
+    }
+    return iter->second;
 }
 
 std::string FullImeInfoManager::Get(int32_t userId, uint32_t tokenId)
@@ -222,12 +240,11 @@ std::string FullImeInfoManager::Get(int32_t userId, uint32_t tokenId)
     if (it == fullImeInfos_.end()) {
         return "";
     }
-    auto iter = std::find_if(
-        it->second.begin(), it->second.end(), [&tokenId](const FullImeInfo &info) { return tokenId == info.tokenId; });
-    if (iter == it->second.end()) {
+    auto iter = it->second.tokenIndexes.find(tokenId);
+    if (iter == it->second.tokenIndexes.end()) {
         return "";
     }
-    return (*iter).prop.name;
+    return iter->second->prop.name;
 }
 
 int32_t FullImeInfoManager::Init()
@@ -246,7 +263,9 @@ int32_t FullImeInfoManager::Init(std::map<int32_t, std::vector<FullImeInfo>> &fu
     {
         std::lock_guard<std::mutex> lock(lock_);
         if (!fullImeInfos_.empty()) {
-            fullImeInfos = fullImeInfos_;
+            for (const auto &infos : fullImeInfos_) {
+                fullImeInfos.insert_or_assign(infos.first, infos.second.ToVector());
+            }
             return ErrorCode::NO_ERROR;
         }
     }
@@ -258,10 +277,10 @@ int32_t FullImeInfoManager::Init(std::map<int32_t, std::vector<FullImeInfo>> &fu
     }
     std::lock_guard<std::mutex> lock(lock_);
     fullImeInfos_.clear();
-    for (const auto &infos : imeInfos) {
-        fullImeInfos_.insert_or_assign(infos.first, infos.second);
+    for (auto &infos : imeInfos) {
+        SetUser(infos.first, infos.second);
+        fullImeInfos.insert_or_assign(infos.first, std::move(infos.second));
     }
-    fullImeInfos = fullImeInfos_;
     return ErrorCode::NO_ERROR;
 }
 
@@ -271,7 +290,7 @@ int32_t FullImeInfoManager::AddUser(int32_t userId, std::vector<FullImeInfo> &in
         std::lock_guard<std::mutex> lock(lock_);
         auto it = fullImeInfos_.find(userId);
         if (it != fullImeInfos_.end()) {
-            infos = it->second;
+            infos = it->second.ToVector();
             return ErrorCode::NO_ERROR;
         }
     }
@@ -281,7 +300,7 @@ int32_t FullImeInfoManager::AddUser(int32_t userId, std::vector<FullImeInfo> &in
         return ret;
     }
     std::lock_guard<std::mutex> lock(lock_);
-    fullImeInfos_.insert_or_assign(userId, infos);
+    SetUser(userId, infos);
     return ErrorCode::NO_ERROR;
 }
 
@@ -294,17 +313,7 @@ int32_t FullImeInfoManager::AddPackage(int32_t userId, const std::string &bundle
         return ErrorCode::ERROR_PACKAGE_MANAGER;
     }
     std::lock_guard<std::mutex> lock(lock_);
-    auto it = fullImeInfos_.find(userId);
-    if (it == fullImeInfos_.end()) {
-        fullImeInfos_.insert({ userId, { info } });
-        return ErrorCode::NO_ERROR;
-    }
-    auto iter = std::find_if(it->second.begin(), it->second.end(),
-                             [&bundleName](const FullImeInfo &info) { return bundleName == info.prop.name; });
-    if (iter != it->second.end()) {
-        it->second.erase(iter);
-    }
-    it->second.push_back(info);
+    SetPackage(userId, info);
     return ErrorCode::NO_ERROR;
 }
 
@@ -315,16 +324,45 @@ int32_t FullImeInfoManager::DeletePackage(int32_t userId, const std::string &bun
     if (it == fullImeInfos_.end()) {
         return ErrorCode::NO_ERROR;
     }
-    auto iter = std::find_if(it->second.begin(), it->second.end(),
-        [&bundleName](const FullImeInfo &info) { return bundleName == info.prop.name; });
-    if (iter == it->second.end()) {
+    auto &infos = it->second.infos;
+    auto iter = std::find_if(infos.begin(), infos.end(),
+        [&bundleName](const std::shared_ptr<const FullImeInfo> &info) { return bundleName == info->prop.name; });
+    if (iter == infos.end()) {
         return ErrorCode::NO_ERROR;
     }
-    it->second.erase(iter);
-    if (it->second.empty()) {
-        fullImeInfos_.erase(it->first);
+    infos.erase(iter);
+    if (infos.empty()) {
+        fullImeInfos_.erase(it);
+        return ErrorCode::NO_ERROR;
     }
+    it->second.Rebuild();
     return ErrorCode::NO_ERROR;
 }
+
+// lock_ is held by the caller
+void FullImeInfoManager::SetUser(int32_t userId, const std::vector<FullImeInfo> &infos)
+{
+    UserImeInfos userInfos;
+    userInfos.infos.reserve(infos.size());
+    for (const auto &info : infos) {
+        userInfos.infos.push_back(std::make_shared<const FullImeInfo>(info));
+    }
+    userInfos.Rebuild();
+    fullImeInfos_.insert_or_assign(userId, std::move(userInfos));
+}
+
+// lock_ is held by the caller, replaces the entry of the same bundle and reindexes this user only
+void FullImeInfoManager::SetPackage(int32_t userId, const FullImeInfo &info)
+{
+    auto &userInfos = fullImeInfos_[userId];
+    auto &infos = userInfos.infos;
+    auto iter = std::find_if(infos.begin(), infos.end(),
+        [&info](const std::shared_ptr<const FullImeInfo> &old) { return info.prop.name == old->prop.name; });
+    if (iter != infos.end()) {
+        infos.erase(iter);
+    }
+    infos.push_back(std::make_shared<const FullImeInfo>(info));
+    userInfos.Rebuild();
+}
 } // namespace MiscServices
 } // namespace OHOS
\ No newline at end of file
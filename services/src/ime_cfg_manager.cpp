@@ -50,22 +50,50 @@ void ImeCfgManager::ReadImeCfg()
 
 void ImeCfgManager::WriteImeCfg()
 {
+    auto serviceHandler = serviceHandler_;
+    {
+        std::lock_guard<std::mutex> lock(imeCfgLock_);
+        isDirty_ = true;
+        if (isWritePosted_) {
+            return;
+        }
+        if (serviceHandler == nullptr) {
+            // written by the next flush
+            IMSA_HILOGE("serviceHandler_ is nullptr!");
+            return;
+        }
+        isWritePosted_ = true;
+    }
+    auto task = [this]() {
+        {
+            std::lock_guard<std::mutex> lock(imeCfgLock_);
+            isWritePosted_ = false;
+        }
+        Flush();
+    };
+    serviceHandler->PostTask(task, "WriteImeCfg", WRITE_DELAY, AppExecFwk::EventQueue::Priority::IMMEDIATE);
+}
+
+void ImeCfgManager::Flush()
+{
+    // keeps the files written in the order of the changes
+    std::lock_guard<std::mutex> flushLock(flushLock_);
+    {
+        std::lock_guard<std::mutex> lock(imeCfgLock_);
+        if (!isDirty_) {
+            return;
+        }
+        isDirty_ = false;
+    }
     auto content = PackageImeCfg();
     if (content.empty()) {
         IMSA_HILOGE("failed to Package imeCfg!");
         return;
     }
-    if (serviceHandler_ == nullptr) {
-        IMSA_HILOGE("serviceHandler_ is nullptr!");
-        return;
+    IMSA_HILOGD("start WriteJsonFile!");
+    if (!FileOperator::WriteAtomically(IME_CFG_FILE_PATH, content)) {
+        IMSA_HILOGE("failed to WriteJsonFile!");
     }
-    auto task = [content]() {
-        IMSA_HILOGD("start WriteJsonFile!");
-        if (!FileOperator::Write(IME_CFG_FILE_PATH, content, O_CREAT | O_WRONLY | O_SYNC | O_TRUNC)) {
-            IMSA_HILOGE("failed to WriteJsonFile!");
-        }
-    };
-    serviceHandler_->PostTask(task, "WriteImeCfg", 0, AppExecFwk::EventQueue::Priority::IMMEDIATE);
 }
 
 bool ImeCfgManager::ParseImeCfg(const std::string &content)
@@ -77,7 +105,7 @@ bool ImeCfgManager::ParseImeCfg(const std::string &content)
         IMSA_HILOGE("Unmarshall failed!");
         return false;
     }
-    std::lock_guard<std::recursive_mutex> lock(imeCfgLock_);
+    std::lock_guard<std::mutex> lock(imeCfgLock_);
     imeConfigs_ = cfg.imePersistInfo;
     return true;
 }
@@ -86,7 +114,7 @@ std::string ImeCfgManager::PackageImeCfg()
 {
     ImePersistCfg cfg;
     {
-        std::lock_guard<std::recursive_mutex> lock(imeCfgLock_);
+        std::lock_guard<std::mutex> lock(imeCfgLock_);
         cfg.imePersistInfo = imeConfigs_;
     }
     std::string content;
@@ -115,11 +143,11 @@ void ImeCfgManager::ModifyTempScreenLockImeCfg(int32_t userId, const std::string
 
 void ImeCfgManager::DeleteImeCfg(int32_t userId)
 {
-    std::lock_guard<std::recursive_mutex> lock(imeCfgLock_);
-    for (auto iter = imeConfigs_.begin(); iter != imeConfigs_.end(); iter++) {
-        if (iter->userId == userId) {
+    {
+        std::lock_guard<std::mutex> lock(imeCfgLock_);
+        auto iter = FindImeCfg(userId);
+        if (iter != imeConfigs_.end()) {
             imeConfigs_.erase(iter);
-            break;
         }
     }
     WriteImeCfg();
@@ -127,15 +155,21 @@ void ImeCfgManager::DeleteImeCfg(int32_t userId)
 
 ImePersistInfo ImeCfgManager::GetImeCfg(int32_t userId)
 {
-    std::lock_guard<std::recursive_mutex> lock(imeCfgLock_);
-    auto it = std::find_if(imeConfigs_.begin(), imeConfigs_.end(),
-        [userId](const ImePersistInfo &cfg) { return cfg.userId == userId; });
+    std::lock_guard<std::mutex> lock(imeCfgLock_);
+    auto it = FindImeCfg(userId);
     if (it != imeConfigs_.end()) {
         return *it;
     }
     return {};
 }
 
+std::vector<ImePersistInfo>::iterator ImeCfgManager::FindImeCfg(int32_t userId)
+{
+    // one config per user, a scan is cheaper than keeping an index in step with the vector
+    return std::find_if(imeConfigs_.begin(), imeConfigs_.end(),
+        [userId](const ImePersistInfo &cfg) { return cfg.userId == userId; });
+}
+
 std::shared_ptr<ImeNativeCfg> ImeCfgManager::GetCurrentImeCfg(int32_t userId)
 {
     return ImeEnabledInfoManager::GetInstance().GetCurrentImeCfg(userId);
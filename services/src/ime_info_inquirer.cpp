@@ -153,7 +153,7 @@ std::shared_ptr<ImeInfo> ImeInfoInquirer::GetImeInfoFromCache(const int32_t user
         return nullptr;
     }
     auto info = std::make_shared<ImeInfo>();
-    auto subProps = imeInfo.subProps;
+    const auto &subProps = imeInfo.subProps;
     info->isSpecificSubName = !subName.empty();
     if (subName.empty() && !subProps.empty()) {
         info->subProp = subProps[0];
@@ -399,9 +399,9 @@ int32_t ImeInfoInquirer::ListInputMethodSubtype(int32_t userId, const std::strin
     std::vector<SubProperty> &subProps)
 {
     IMSA_HILOGD("userId: %{public}d, bundleName: %{public}s.", userId, bundleName.c_str());
-    FullImeInfo imeInfo;
-    if (FullImeInfoManager::GetInstance().Get(userId, bundleName, imeInfo)) {
-        subProps = imeInfo.subProps;
+    auto imeInfo = FullImeInfoManager::GetInstance().Find(userId, bundleName);
+    if (imeInfo != nullptr) {
+        subProps = imeInfo->subProps;
         return ErrorCode::NO_ERROR;
     }
 
@@ -699,15 +699,15 @@ std::shared_ptr<SubProperty> ImeInfoInquirer::GetCurrentSubtype(int32_t userId)
 {
     auto currentIme = ImeCfgManager::GetInstance().GetCurrentImeCfg(userId);
     IMSA_HILOGD("currentIme: %{public}s.", currentIme->imeId.c_str());
-    FullImeInfo imeInfo;
-    if (FullImeInfoManager::GetInstance().Get(userId, currentIme->bundleName, imeInfo) && !imeInfo.subProps.empty()) {
-        auto iter = std::find_if(imeInfo.subProps.begin(), imeInfo.subProps.end(),
+    auto imeInfo = FullImeInfoManager::GetInstance().Find(userId, currentIme->bundleName);
+    if (imeInfo != nullptr && !imeInfo->subProps.empty()) {
+        auto iter = std::find_if(imeInfo->subProps.begin(), imeInfo->subProps.end(),
             [&currentIme](const SubProperty &subProp) { return subProp.id == currentIme->subName; });
-        if (iter != imeInfo.subProps.end()) {
+        if (iter != imeInfo->subProps.end()) {
             return std::make_shared<SubProperty>(*iter);
         }
         IMSA_HILOGW("subtype %{public}s not found.", currentIme->subName.c_str());
-        return std::make_shared<SubProperty>(imeInfo.subProps[0]);
+        return std::make_shared<SubProperty>(imeInfo->subProps[0]);
     }
 
     IMSA_HILOGD("%{public}d get [%{public}s, %{public}s] form bms.", userId, currentIme->bundleName.c_str(),
@@ -1151,9 +1151,9 @@ bool ImeInfoInquirer::IsRunningIme(int32_t userId, const std::string &bundleName
 
 bool ImeInfoInquirer::GetImeAppId(int32_t userId, const std::string &bundleName, std::string &appId)
 {
-    FullImeInfo imeInfo;
-    if (FullImeInfoManager::GetInstance().Get(userId, bundleName, imeInfo) && !imeInfo.appId.empty()) {
-        appId = imeInfo.appId;
+    auto imeInfo = FullImeInfoManager::GetInstance().Find(userId, bundleName);
+    if (imeInfo != nullptr && !imeInfo->appId.empty()) {
+        appId = imeInfo->appId;
         return true;
     }
     BundleInfo bundleInfo;
@@ -1166,9 +1166,9 @@ bool ImeInfoInquirer::GetImeAppId(int32_t userId, const std::string &bundleName,
 
 bool ImeInfoInquirer::GetImeVersionCode(int32_t userId, const std::string &bundleName, uint32_t &versionCode)
 {
-    FullImeInfo imeInfo;
-    if (FullImeInfoManager::GetInstance().Get(userId, bundleName, imeInfo)) {
-        versionCode = imeInfo.versionCode;
+    auto imeInfo = FullImeInfoManager::GetInstance().Find(userId, bundleName);
+    if (imeInfo != nullptr) {
+        versionCode = imeInfo->versionCode;
         return true;
     }
     BundleInfo bundleInfo;
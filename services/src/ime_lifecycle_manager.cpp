@@ -35,6 +35,22 @@ void ImeLifecycleManager::ControlIme(bool shouldApply)
     }
 
     FreezeManager::ReportRss(true, pid_);
+    PostStopTask();
+}
+
+void ImeLifecycleManager::ScheduleIdle()
+{
+    if (eventHandler_ == nullptr) {
+        IMSA_HILOGE("eventHandler_ is nullptr.");
+        return;
+    }
+    // a warm ime is left running, only its stop is delayed
+    eventHandler_->RemoveTask(STOP_IME_TASK_NAME);
+    PostStopTask();
+}
+
+void ImeLifecycleManager::PostStopTask()
+{
     // Delay the stop report by 20s.
     std::weak_ptr<ImeLifecycleManager> weakThis = shared_from_this();
     eventHandler_->PostTask(
@@ -48,6 +64,11 @@ void ImeLifecycleManager::ControlIme(bool shouldApply)
                 IMSA_HILOGE("stopImeFunc_ is nullptr.");
                 return;
             }
+            // a warm ime may be taken by an editor before its stop
+            if (sharedThis->IsImeInUse()) {
+                IMSA_HILOGD("ime pid %{public}d in use, not stop", sharedThis->pid_);
+                return;
+            }
             IMSA_HILOGD("Stop ime pid %{public}d", sharedThis->pid_);
             sharedThis->stopImeFunc_();
         },
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ime_prestart_policy.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "global.h"
+
+namespace OHOS {
+namespace MiscServices {
+ImePrestartPolicy::ImePrestartPolicy(const ImeConnector &connector, const Clock &clock)
+    : connector_(connector), clock_(clock != nullptr ? clock : GetSteadyTime)
+{
+    lastRefillTime_ = clock_();
+}
+
+bool ImePrestartPolicy::OnSignal(PrestartSignal signal)
+{
+    if (connector_.warmUpIme == nullptr) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        auto now = clock_();
+        Refill(now);
+        if (isLowMemory_ || budget_ == 0 || (hasWarmedUp_ && now - lastWarmUpTime_ < MIN_WARM_UP_INTERVAL)) {
+            ++stats_.skippedNum;
+            IMSA_HILOGD("signal: %{public}d skipped, low memory: %{public}d, budget: %{public}u.",
+                static_cast<int32_t>(signal), isLowMemory_, budget_);
+            return false;
+        }
+        --budget_;
+        lastWarmUpTime_ = now;
+        hasWarmedUp_ = true;
+        ++stats_.warmUpNum;
+    }
+    auto ret = connector_.warmUpIme();
+    IMSA_HILOGI("signal: %{public}d, warm up ime ret: %{public}d.", static_cast<int32_t>(signal), ret);
+    return ret == ErrorCode::NO_ERROR;
+}
+
+bool ImePrestartPolicy::OnWindowFocused(int32_t pid)
+{
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        if (std::find(editorPids_.begin(), editorPids_.end(), pid) == editorPids_.end()) {
+            return false;
+        }
+    }
+    return OnSignal(PrestartSignal::EDITOR_FOCUSED);
+}
+
+void ImePrestartPolicy::SetLowMemory(bool isLowMemory)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    isLowMemory_ = isLowMemory;
+}
+
+void ImePrestartPolicy::OnImeRequired(int32_t pid)
+{
+    bool isRunning = connector_.isImeRunning != nullptr && connector_.isImeRunning();
+    std::lock_guard<std::mutex> lock(lock_);
+    auto it = std::find(editorPids_.begin(), editorPids_.end(), pid);
+    if (it != editorPids_.end()) {
+        editorPids_.erase(it);
+    } else if (editorPids_.size() >= MAX_EDITOR_PID_NUM) {
+        editorPids_.pop_front();
+    }
+    editorPids_.push_back(pid);
+    if (isRunning) {
+        ++stats_.warmStartNum;
+        return;
+    }
+    ++stats_.coldStartNum;
+    IMSA_HILOGI("ime cold start, warm/cold: %{public}u/%{public}u.", stats_.warmStartNum, stats_.coldStartNum);
+}
+
+ImePrestartPolicy::Stats ImePrestartPolicy::GetStats()
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    return stats_;
+}
+
+std::string ImePrestartPolicy::Dump()
+{
+    auto stats = GetStats();
+    return std::string("warm up: ").append(std::to_string(stats.warmUpNum))
+        .append(", skipped: ").append(std::to_string(stats.skippedNum))
+        .append(", warm start: ").append(std::to_string(stats.warmStartNum))
+        .append(", cold start: ").append(std::to_string(stats.coldStartNum)).append("\n");
+}
+
+int64_t ImePrestartPolicy::GetSteadyTime()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void ImePrestartPolicy::Refill(int64_t now)
+{
+    if (budget_ >= MAX_BUDGET) {
+        // a full budget does not save up refills
+        lastRefillTime_ = now;
+        return;
+    }
+    auto refillNum = (now - lastRefillTime_) / BUDGET_REFILL_TIME;
+    if (refillNum <= 0) {
+        return;
+    }
+    budget_ = static_cast<uint32_t>(std::min<int64_t>(MAX_BUDGET, budget_ + refillNum));
+    lastRefillTime_ += refillNum * BUDGET_REFILL_TIME;
+}
+} // namespace MiscServices
+} // namespace OHOS
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ime_request_dispatcher.h"
+
+#include <pthread.h>
+
+#include "global.h"
+
+namespace OHOS {
+namespace MiscServices {
+ImeRequestDispatcher &ImeRequestDispatcher::GetInstance()
+{
+    static ImeRequestDispatcher dispatcher(DEFAULT_WORKER_NUM);
+    return dispatcher;
+}
+
+ImeRequestDispatcher::ImeRequestDispatcher(uint32_t maxWorkerNum) : maxWorkerNum_(maxWorkerNum)
+{
+}
+
+ImeRequestDispatcher::~ImeRequestDispatcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        isStopped_ = true;
+    }
+    cv_.notify_all();
+    for (auto &worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+std::vector<int32_t> ImeRequestDispatcher::Dispatch(const std::vector<Task> &tasks)
+{
+    std::vector<int32_t> results(tasks.size(), ErrorCode::NO_ERROR);
+    if (tasks.empty()) {
+        return results;
+    }
+    auto batch = std::make_shared<Batch>();
+    std::vector<size_t> localTasks;
+    for (size_t i = 1; i < tasks.size(); ++i) {
+        if (tasks[i] == nullptr) {
+            continue;
+        }
+        {
+            std::lock_guard<std::mutex> lock(batch->lock);
+            ++batch->pendingNum;
+        }
+        if (!Post({ &tasks[i], &results[i], batch })) {
+            Finish(batch);
+            localTasks.push_back(i);
+        }
+    }
+    if (tasks[0] != nullptr) {
+        results[0] = tasks[0]();
+    }
+    for (auto index : localTasks) {
+        results[index] = tasks[index]();
+    }
+    std::unique_lock<std::mutex> lock(batch->lock);
+    batch->cv.wait(lock, [&batch]() { return batch->pendingNum == 0; });
+    return results;
+}
+
+bool ImeRequestDispatcher::Post(Job &&job)
+{
+    std::lock_guard<std::mutex> lock(lock_);
+    if (isStopped_) {
+        return false;
+    }
+    if (idleNum_ <= jobs_.size()) {
+        if (workers_.size() >= maxWorkerNum_) {
+            IMSA_HILOGD("all %{public}u workers busy, run on the caller.", maxWorkerNum_);
+            return false;
+        }
+        workers_.emplace_back([this]() { Work(); });
+    }
+    jobs_.push_back(std::move(job));
+    cv_.notify_one();
+    return true;
+}
+
+void ImeRequestDispatcher::Work()
+{
+    pthread_setname_np(pthread_self(), "OS_ImeRequest");
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(lock_);
+            ++idleNum_;
+            cv_.wait(lock, [this]() { return isStopped_ || !jobs_.empty(); });
+            --idleNum_;
+            if (jobs_.empty()) {
+                return;
+            }
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+        *job.result = (*job.task)();
+        Finish(job.batch);
+    }
+}
+
+void ImeRequestDispatcher::Finish(const std::shared_ptr<Batch> &batch)
+{
+    std::lock_guard<std::mutex> lock(batch->lock);
+    if (--batch->pendingNum == 0) {
+        batch->cv.notify_all();
+    }
+}
+} // namespace MiscServices
+} // namespace OHOS
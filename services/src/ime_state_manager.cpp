@@ -74,6 +74,19 @@ bool ImeStateManager::IsImeInUse()
     std::lock_guard<std::mutex> lock(mutex_);
     return isImeInUse_;
 }
+
+void ImeStateManager::KeepWarm()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (isImeInUse_) {
+        return;
+    }
+    if (isFrozen_) {
+        isFrozen_ = false;
+        ControlIme(false);
+    }
+    ScheduleIdle();
+}
 // LCOV_EXCL_STOP
 } // namespace MiscServices
 } // namespace OHOS
\ No newline at end of file
@@ -39,7 +39,9 @@
 #ifdef IMF_SCREENLOCK_MGR_ENABLE
 #include "screenlock_manager.h"
 #endif
+#include "sys_cfg_parser.h"
 #include "system_param_adapter.h"
+#include "typing_latency_tracer.h"
 #include "wms_connection_observer.h"
 #include "xcollie/xcollie.h"
 #ifdef IMF_ON_DEMAND_START_STOP_SA_ENABLE
@@ -73,6 +75,9 @@ constexpr const char *UNLOAD_SA_TASK = "unloadInputMethodSaTask";
 constexpr int64_t DELAY_UNLOAD_SA_TIME = 20000; // 20s
 constexpr int32_t REFUSE_UNLOAD_DELAY_TIME = 1000; // 1s
 #endif
+constexpr const char *CMD_RELOAD_SYS_CFG = "--reload-sys-cfg";
+constexpr const char *CMD_TYPING_TRACE = "--typing-trace";
+constexpr const char *CMD_IME_PRESTART = "--ime-prestart";
 const constexpr char *IMMERSIVE_EFFECT_CAP_NAME = "immersive_effect";
 InputMethodSystemAbility::InputMethodSystemAbility(int32_t systemAbilityId, bool runOnCreate)
     : SystemAbility(systemAbilityId, runOnCreate), state_(ServiceRunningState::STATE_NOT_START)
@@ -218,8 +223,26 @@ void InputMethodSystemAbility::OnStart()
     }
     HiviewDFX::XCollie::GetInstance().CancelTimer(id);
     InitHiTrace();
+    TypingLatencyTracer::Init();
     InputMethodSyncTrace tracer("InputMethodController Attach trace.");
     InputmethodDump::GetInstance().AddDumpAllMethod([this](int fd) { this->DumpAllMethod(fd); });
+    InputmethodDump::GetInstance().AddDumpCommand(CMD_RELOAD_SYS_CFG, "reload the system config files",
+        [](int fd) {
+            SysCfgParser::Reload();
+            dprintf(fd, "system config will be reloaded on the next read\n");
+        });
+    InputmethodDump::GetInstance().AddDumpCommand(CMD_TYPING_TRACE,
+        "export the typing trace of imsa and of the editors and imes which reported theirs as chrome trace json",
+        [](int fd) { dprintf(fd, "%s", TypingLatencyTracer::GetInstance().ExportChromeTrace().c_str()); });
+    InputmethodDump::GetInstance().AddDumpCommand(CMD_IME_PRESTART, "show the ime warm up and start statistics",
+        [this](int fd) {
+            auto session = UserSessionManager::GetInstance().GetUserSession(userId_);
+            if (session == nullptr) {
+                dprintf(fd, "no session of user %d\n", userId_);
+                return;
+            }
+            dprintf(fd, "%s", session->GetPrestartPolicy().Dump().c_str());
+        });
     IMSA_HILOGI("start imsa service success.");
     return;
 }
@@ -419,10 +442,12 @@ int32_t InputMethodSystemAbility::OnIdle(const SystemAbilityOnDemandReason &idle
 void InputMethodSystemAbility::OnStop()
 {
     IMSA_HILOGI("OnStop start.");
+    ImeCfgManager::GetInstance().Flush();
     ImeStateManager::SetEventHandler(nullptr);
     ImeCfgManager::GetInstance().SetEventHandler(nullptr);
     UserSessionManager::GetInstance().SetEventHandler(nullptr);
     ImeEnabledInfoManager::GetInstance().SetEventHandler(nullptr);
+    SettingsDataUtils::GetInstance().SetEventHandler(nullptr);
     serviceHandler_ = nullptr;
     state_ = ServiceRunningState::STATE_NOT_START;
     Memory::MemMgrClient::GetInstance().NotifyProcessStatus(getpid(), 1, 0, INPUT_METHOD_SYSTEM_ABILITY_ID);
@@ -441,6 +466,7 @@ void InputMethodSystemAbility::InitServiceHandler()
     serviceHandler_ = std::make_shared<AppExecFwk::EventHandler>(runner);
     ImeStateManager::SetEventHandler(serviceHandler_);
     ImeEnabledInfoManager::GetInstance().SetEventHandler(serviceHandler_);
+    SettingsDataUtils::GetInstance().SetEventHandler(serviceHandler_);
     IMSA_HILOGI("InitServiceHandler succeeded.");
 }
 
@@ -452,6 +478,7 @@ void InputMethodSystemAbility::Initialize()
 {
     IMSA_HILOGI("InputMethodSystemAbility::Initialize.");
     // init work thread to handle the messages
+    MessageHandler::Instance()->SetCoalesceKeyGetter(GetCoalesceKey);
     workThreadHandler = std::thread([this] { this->WorkThread(); });
     identityChecker_ = std::make_shared<IdentityCheckerImpl>();
     userId_ = OsAccountAdapter::MAIN_USER_ID;
@@ -701,6 +728,9 @@ int32_t InputMethodSystemAbility::StartInputInner(
         inputClientInfo.needHide = true;
         inputClientInfo.isNotifyInputStart = true;
     }
+    if (inputClientInfo.isNotifyInputStart) {
+        session->GetPrestartPolicy().OnImeRequired(IPCSkeleton::GetCallingPid());
+    }
     if (session->IsDefaultDisplayGroup(displayId) && !session->IsProxyImeEnable()) {
         auto ret = CheckInputTypeOption(userId, inputClientInfo);
         if (ret != ErrorCode::NO_ERROR) {
@@ -950,6 +980,12 @@ ErrCode InputMethodSystemAbility::UnbindImeMirror()
     return session->OnUnbindImeMirror();
 }
 
+ErrCode InputMethodSystemAbility::ReportTypingTrace(const std::string &ring)
+{
+    TypingLatencyTracer::GetInstance().AddRemote(IPCSkeleton::GetCallingPid(), ring);
+    return ErrorCode::NO_ERROR;
+}
+
 ErrCode InputMethodSystemAbility::InitConnect()
 {
     IMSA_HILOGD("InputMethodSystemAbility init connect.");
@@ -1737,6 +1773,7 @@ int32_t InputMethodSystemAbility::OnUserRemoved(const Message *msg)
 // LCOV_EXCL_START
 int32_t InputMethodSystemAbility::OnUserStop(const Message *msg)
 {
+    ImeCfgManager::GetInstance().Flush();
     auto session = GetSessionFromMsg(msg);
     if (session == nullptr) {
         return ErrorCode::ERROR_NULL_POINTER;
@@ -1807,6 +1844,34 @@ int32_t InputMethodSystemAbility::HandlePackageEvent(const Message *msg)
     return ErrorCode::NO_ERROR;
 }
 
+// bursts of package and language events are folded while queued, each of them queries the bundle manager
+MessageHandler::CoalesceKey InputMethodSystemAbility::GetCoalesceKey(const Message &msg)
+{
+    switch (msg.msgId_) {
+        case MSG_ID_PACKAGE_ADDED:
+        case MSG_ID_PACKAGE_CHANGED:
+        case MSG_ID_PACKAGE_REMOVED: {
+            if (msg.msgContent_ == nullptr) {
+                return {};
+            }
+            int32_t userId = 0;
+            std::string packageName;
+            bool isRead = ITypesUtil::Unmarshal(*msg.msgContent_, userId, packageName);
+            msg.msgContent_->RewindRead(0);
+            if (!isRead) {
+                return {};
+            }
+            return { "package/" + std::to_string(userId) + "/" + packageName, msg.msgId_ };
+        }
+        case MSG_ID_SYS_LANGUAGE_CHANGED:
+        case MSG_ID_BUNDLE_RESOURCES_CHANGED:
+            // both refresh all the imes
+            return { "full_ime_info", MSG_ID_SYS_LANGUAGE_CHANGED };
+        default:
+            return {};
+    }
+}
+
 /**
  *  Called when a package is removed.
  *  \n Run in work thread of input method management service
@@ -2406,6 +2471,7 @@ void InputMethodSystemAbility::HandleUserSwitched(int32_t userId)
     if (imeData == nullptr && session->IsWmsReady()) {
         session->StartCurrentIme();
     }
+    session->GetPrestartPolicy().OnSignal(PrestartSignal::USER_SWITCHED);
 }
 
 void InputMethodSystemAbility::HandleWmsDisconnected(int32_t userId, int32_t screenId)
@@ -2863,7 +2929,9 @@ void InputMethodSystemAbility::OnSysMemChanged()
     if (session == nullptr) {
         return;
     }
-    if (SystemParamAdapter::GetInstance().GetBoolParam(SystemParamAdapter::MEMORY_WATERMARK_KEY)) {
+    bool isLowMemory = SystemParamAdapter::GetInstance().GetBoolParam(SystemParamAdapter::MEMORY_WATERMARK_KEY);
+    session->GetPrestartPolicy().SetLowMemory(isLowMemory);
+    if (isLowMemory) {
         session->TryDisconnectIme();
         return;
     }
@@ -21,11 +21,13 @@
 #include <algorithm>
 
 #include "ability_manager_client.h"
+#include "client_broadcaster.h"
 #include "full_ime_info_manager.h"
 #include "identity_checker_impl.h"
 #include "im_common_event_manager.h"
 #include "ime_enabled_info_manager.h"
 #include "ime_info_inquirer.h"
+#include "ime_request_dispatcher.h"
 #include "input_control_channel_service_impl.h"
 #include "ipc_skeleton.h"
 #include "iservice_registry.h"
@@ -49,6 +51,7 @@
 #include "inputmethod_trace.h"
 #include "notify_service_impl.h"
 #include "display_adapter.h"
+#include "typing_latency_tracer.h"
 
 namespace OHOS {
 namespace MiscServices {
@@ -501,7 +504,8 @@ void PerUserSession::DeactivateClient(const sptr<IInputClient> &client)
         clientGroup->SetCurrentClient(nullptr);
     }
     clientGroup->SetInactiveClient(client);
-    client->DeactivateClient();
+    ClientBroadcaster::GetInstance().Send("DeactivateClient", clientInfo,
+        [](const std::shared_ptr<InputClientInfo> &info) { return info->client->DeactivateClient(); });
     auto data = GetReadyImeData(clientInfo->bindImeType);
     if (data == nullptr) {
         IMSA_HILOGE("ime %{public}d doesn't exist!", clientInfo->bindImeType);
@@ -525,6 +529,7 @@ bool PerUserSession::IsProxyImeEnable()
 int32_t PerUserSession::OnStartInput(const InputClientInfo &inputClientInfo,
     std::vector<sptr<IRemoteObject>> &agents, std::vector<BindImeInfo> &imeInfos)
 {
+    TypingTraceScope traceScope(TypingTracePoint::IMSA_START_INPUT, static_cast<uint32_t>(inputClientInfo.pid));
     const sptr<IInputClient> &client = inputClientInfo.client;
     if (client == nullptr) {
         IMSA_HILOGE("client is nullptr!");
@@ -583,21 +588,19 @@ int32_t PerUserSession::SendAllReadyImeToClient(
         }
     }
 
-    int32_t finalResult = ErrorCode::NO_ERROR;
-    int32_t ret;
+    std::vector<ImeRequestDispatcher::Task> tasks;
     for (const auto &dataItem : imeDatas) {
-        BindImeInfo imeInfo;
-        imeInfo.pid = dataItem->pid;
-        imeInfo.bundleName = dataItem->ime.first;
-        ret = clientInfo->client->OnInputReady(dataItem->agent, imeInfo);
-        if (ret != ErrorCode::NO_ERROR) {
-            IMSA_HILOGE("OnInputReady failed, ret = %{public}d", ret);
-        }
-        if (!dataItem->IsImeMirror()) {
-            finalResult = ret;
-        }
+        tasks.emplace_back([&dataItem, &clientInfo]() {
+            BindImeInfo imeInfo;
+            imeInfo.pid = dataItem->pid;
+            imeInfo.bundleName = dataItem->ime.first;
+            return ClientBroadcaster::GetInstance().Send("OnInputReady", clientInfo,
+                [&dataItem, &imeInfo](const std::shared_ptr<InputClientInfo> &info) {
+                    return info->client->OnInputReady(dataItem->agent, imeInfo);
+                });
+        });
     }
-    return finalResult;
+    return MergeImeResults(imeDatas, ImeRequestDispatcher::GetInstance().Dispatch(tasks), "OnInputReady");
 }
 
 int32_t PerUserSession::BindClientWithIme(
@@ -684,7 +687,10 @@ void PerUserSession::StopClientInput(
     }
     int32_t ret;
     if (isAsync == true) {
-        ret = clientInfo->client->OnInputStopAsync(isStopInactiveClient);
+        ret = ClientBroadcaster::GetInstance().Send("OnInputStopAsync", clientInfo,
+            [isStopInactiveClient](const std::shared_ptr<InputClientInfo> &info) {
+                return info->client->OnInputStopAsync(isStopInactiveClient);
+            });
     } else {
         auto onInputStopObject = new (std::nothrow) OnInputStopNotifyServiceImpl(clientInfo->pid);
         if (onInputStopObject == nullptr) {
@@ -693,7 +699,10 @@ void PerUserSession::StopClientInput(
         }
         std::lock_guard<std::mutex> lock(isNotifyFinishedLock_);
         isNotifyFinished_.Clear(false);
-        ret = clientInfo->client->OnInputStop(isStopInactiveClient, onInputStopObject);
+        ret = ClientBroadcaster::GetInstance().Send("OnInputStop", clientInfo,
+            [isStopInactiveClient, &onInputStopObject](const std::shared_ptr<InputClientInfo> &info) {
+                return info->client->OnInputStop(isStopInactiveClient, onInputStopObject);
+            });
         if (!isNotifyFinished_.GetValue()) {
             IMSA_HILOGE("OnInputStop is not finished!");
         }
@@ -902,7 +911,8 @@ int32_t PerUserSession::OnUnbindImeMirror()
         return ErrorCode::NO_ERROR;
     }
 
-    clientInfo->client->OnImeMirrorStop(data->agent);
+    ClientBroadcaster::GetInstance().Send("OnImeMirrorStop", clientInfo,
+        [&data](const std::shared_ptr<InputClientInfo> &info) { return info->client->OnImeMirrorStop(data->agent); });
     StopImeInput(ImeType::IME_MIRROR, clientInfo->channel, 0);
     RemoveImeData(ImeType::IME_MIRROR);
     return ErrorCode::NO_ERROR;
@@ -969,6 +979,40 @@ void PerUserSession::StartImeIfInstalled()
     StartCurrentIme();
 }
 
+int32_t PerUserSession::WarmUpIme()
+{
+    auto data = GetReadyImeData(ImeType::IME);
+    if (data != nullptr) {
+        if (data->imeStateManager != nullptr) {
+            data->imeStateManager->KeepWarm();
+        }
+        return ErrorCode::NO_ERROR;
+    }
+    if (eventHandler_ == nullptr) {
+        IMSA_HILOGE("eventHandler_ is nullptr!");
+        return ErrorCode::ERROR_IMSA_NULLPTR;
+    }
+    // starting the ime blocks until it is ready, so it is not done on the caller thread
+    auto task = [this]() {
+        if (GetImeData(ImeType::IME) != nullptr || !IsWmsReady() || IsLargeMemoryStateNeed()) {
+            return;
+        }
+        StartImeIfInstalled();
+        auto data = GetReadyImeData(ImeType::IME);
+        if (data != nullptr && data->imeStateManager != nullptr) {
+            // arms the stop delay of an ime no editor has used yet
+            data->imeStateManager->KeepWarm();
+        }
+    };
+    auto ret = eventHandler_->PostTask(task, "WarmUpImeTask", 0, AppExecFwk::EventQueue::Priority::IMMEDIATE);
+    return ret ? ErrorCode::NO_ERROR : ErrorCode::ERROR_IMSA_IME_CONNECT_FAILED;
+}
+
+ImePrestartPolicy &PerUserSession::GetPrestartPolicy()
+{
+    return prestartPolicy_;
+}
+
 void PerUserSession::ReplaceCurrentClient(
     const sptr<IInputClient> &client, const std::shared_ptr<ClientGroup> &clientGroup)
 {
@@ -1147,6 +1191,7 @@ void PerUserSession::RemoveImeData(ImeType type)
 
 void PerUserSession::OnFocused(uint64_t displayId, int32_t pid, int32_t uid)
 {
+    prestartPolicy_.OnWindowFocused(pid);
     std::lock_guard<std::mutex> lock(focusedClientLock_);
     auto clientGroup = GetClientGroup(displayId);
     if (clientGroup == nullptr) {
@@ -1197,6 +1242,10 @@ void PerUserSession::OnScreenUnlock()
     auto imeData = GetImeData(ImeType::IME);
     if (imeData != nullptr && imeData->ime == GetImeUsedBeforeScreenLocked()) {
         IMSA_HILOGD("no need to switch");
+        // the ime kept over the lock screen is the one to use, a dynamically started ime is left alone
+        if (!ImeStateManagerFactory::GetInstance().GetDynamicStartIme()) {
+            prestartPolicy_.OnSignal(PrestartSignal::SCREEN_UNLOCK);
+        }
         return;
     }
     IMSA_HILOGI("user %{public}d unlocked, start current ime", userId_);
@@ -1719,7 +1768,8 @@ bool PerUserSession::CheckSecurityMode()
 
 int32_t PerUserSession::RequestIme(const std::shared_ptr<ImeData> &data, RequestType type, const IpcExec &exec)
 {
-    if (IsProxyImeEnable() || data->IsImeMirror()) {
+    // the mirror is checked first, it may run on a dispatcher worker and must not take the session locks
+    if (data->IsImeMirror() || IsProxyImeEnable()) {
         IMSA_HILOGD("proxy enable.");
         return exec();
     }
@@ -1754,18 +1804,29 @@ int32_t PerUserSession::RequestAllIme(
         }
     }
 
-    int32_t finalResult = ErrorCode::NO_ERROR;
+    std::vector<ImeRequestDispatcher::Task> tasks;
     for (const auto &dataItem : dataArray) {
-        int32_t ret = RequestIme(dataItem, reqType, [&dataItem, &method]() {
-            return method(dataItem->core); // Execute the specified core method
+        tasks.emplace_back([this, &dataItem, reqType, &method]() {
+            return RequestIme(dataItem, reqType, [&dataItem, &method]() {
+                return method(dataItem->core); // Execute the specified core method
+            });
         });
-        if (ret != ErrorCode::NO_ERROR) {
-            IMSA_HILOGE(
-                "request ime failed, ret: %{public}d, IsImeMirror:%{public}d", ret, dataItem->IsImeMirror());
+    }
+    return MergeImeResults(dataArray, ImeRequestDispatcher::GetInstance().Dispatch(tasks), "request ime");
+}
+
+int32_t PerUserSession::MergeImeResults(const std::vector<std::shared_ptr<ImeData>> &dataArray,
+    const std::vector<int32_t> &results, const char *action)
+{
+    int32_t finalResult = ErrorCode::NO_ERROR;
+    for (size_t i = 0; i < dataArray.size() && i < results.size(); ++i) {
+        if (results[i] != ErrorCode::NO_ERROR) {
+            IMSA_HILOGE("%{public}s failed, ret: %{public}d, IsImeMirror:%{public}d", action, results[i],
+                dataArray[i]->IsImeMirror());
         }
         // IME_MIRROR not effect overall result
-        if (!dataItem->IsImeMirror()) {
-            finalResult = ret;
+        if (!dataArray[i]->IsImeMirror()) {
+            finalResult = results[i];
         }
     }
     return finalResult;
@@ -14,101 +14,189 @@
  */
 
 #include "sys_cfg_parser.h"
+
+#include <sys/stat.h>
+
 #include "file_operator.h"
 
 namespace OHOS {
 namespace MiscServices {
 // LCOV_EXCL_START
+constexpr int64_t NS_PER_SECOND = 1000000000;
 constexpr const char *SYS_CFG_FILE_PATH = "etc/inputmethod/inputmethod_framework_config.json";
+std::mutex SysCfgParser::loadLock_;
+std::shared_ptr<const SysCfgSnapshot> SysCfgParser::snapshot_;
+namespace {
+// a key is taken from the first file containing it, as the files are ordered by priority
+template<typename T>
+void ParseSection(const std::string &content, cJSON *&root, const std::string &key, SysCfgSection<T> &section)
+{
+    if (section.isFound || content.find(key) == std::string::npos) {
+        return;
+    }
+    section.isFound = true;
+    if (root == nullptr) {
+        root = cJSON_Parse(content.c_str());
+    }
+    if (root == nullptr) {
+        IMSA_HILOGE("parse %{public}s failed!", key.c_str());
+        return;
+    }
+    section.isParsed = section.cfg.Unmarshal(root);
+}
+} // namespace
+
 bool SysCfgParser::ParseSystemConfig(SystemConfig &systemConfig)
 {
-    auto content = GetSysCfgContent(GET_NAME(systemConfig));
-    if (content.empty()) {
+    auto snapshot = GetSnapshot();
+    if (!snapshot->systemConfig.isFound) {
         IMSA_HILOGE("content is empty");
         return false;
     }
-    ImeSystemConfig imeSysCfg;
-    auto ret = imeSysCfg.Unmarshall(content);
-    systemConfig = imeSysCfg.systemConfig;
-    return ret;
+    systemConfig = snapshot->systemConfig.cfg.systemConfig;
+    return snapshot->systemConfig.isParsed;
 }
 
 bool SysCfgParser::ParseInputType(std::vector<InputTypeInfo> &inputType)
 {
-    auto content = GetSysCfgContent(GET_NAME(supportedInputTypeList));
-    if (content.empty()) {
+    auto snapshot = GetSnapshot();
+    if (!snapshot->inputType.isFound) {
         IMSA_HILOGD("content is empty");
         return false;
     }
-    InputTypeCfg inputTypeCfg;
-    auto ret = inputTypeCfg.Unmarshall(content);
-    inputType = inputTypeCfg.inputType;
-    return ret;
+    inputType = snapshot->inputType.cfg.inputType;
+    return snapshot->inputType.isParsed;
 }
 
 bool SysCfgParser::ParseDynamicStartImeCfg(std::vector<DynamicStartImeCfgItem> &dynamicStartImeCfgList)
 {
-    auto content = GetSysCfgContent(GET_NAME(dynamicStartImeCfgList));
-    if (content.empty()) {
+    auto snapshot = GetSnapshot();
+    if (!snapshot->dynamicStartIme.isFound) {
         IMSA_HILOGW("dynamic start ime cfg content is empty");
         return false;
     }
-
-    DynamicStartImeCfg dynamicStartImeCfg;
-    auto ret = dynamicStartImeCfg.Unmarshall(content);
-    if (ret) {
-        dynamicStartImeCfgList = dynamicStartImeCfg.dynamicStartImeCfgList;
+    if (snapshot->dynamicStartIme.isParsed) {
+        dynamicStartImeCfgList = snapshot->dynamicStartIme.cfg.dynamicStartImeCfgList;
     }
-    return ret;
+    return snapshot->dynamicStartIme.isParsed;
 }
 
 bool SysCfgParser::ParsePanelAdjust(std::vector<SysPanelAdjust> &sysPanelAdjust)
 {
-    auto content = GetSysCfgContent(GET_NAME(sysPanelAdjust));
-    if (content.empty()) {
+    auto snapshot = GetSnapshot();
+    if (!snapshot->panelAdjust.isFound) {
         IMSA_HILOGE("content is empty");
         return false;
     }
-    SysPanelAdjustCfg sysPanelAdjustCfg;
-    auto ret = sysPanelAdjustCfg.Unmarshall(content);
-    sysPanelAdjust = sysPanelAdjustCfg.panelAdjust;
-    return ret;
+    sysPanelAdjust = snapshot->panelAdjust.cfg.panelAdjust;
+    return snapshot->panelAdjust.isParsed;
 }
 
 bool SysCfgParser::ParseDefaultFullIme(std::vector<DefaultFullImeInfo> &defaultFullImeList)
 {
-    auto content = GetSysCfgContent(GET_NAME(defaultFullImeList));
-    if (content.empty()) {
+    auto snapshot = GetSnapshot();
+    if (!snapshot->defaultFullIme.isFound) {
         IMSA_HILOGD("content is empty");
         return false;
     }
-    DefaultFullImeCfg defaultFullImeCfg;
-    auto ret = defaultFullImeCfg.Unmarshall(content);
-    defaultFullImeList = defaultFullImeCfg.defaultFullImeList;
-    return ret;
+    defaultFullImeList = snapshot->defaultFullIme.cfg.defaultFullImeList;
+    return snapshot->defaultFullIme.isParsed;
 }
 
 bool SysCfgParser::ParseIgnoreSysPanelAdjust(IgnoreSysPanelAdjust &ignoreSysPanelAdjust)
 {
-    auto content = GetSysCfgContent(GET_NAME(ignoreSysPanelAdjust));
-    if (content.empty()) {
+    auto snapshot = GetSnapshot();
+    if (!snapshot->ignoreSysPanelAdjust.isFound) {
         IMSA_HILOGD("content is empty");
         return false;
     }
-    IgnoreSysPanelAdjustCfg ignoreSysPanelAdjustCfg;
-    auto ret = ignoreSysPanelAdjustCfg.Unmarshall(content);
-    ignoreSysPanelAdjust = ignoreSysPanelAdjustCfg.ignoreSysPanelAdjust;
-    return ret;
+    ignoreSysPanelAdjust = snapshot->ignoreSysPanelAdjust.cfg.ignoreSysPanelAdjust;
+    return snapshot->ignoreSysPanelAdjust.isParsed;
+}
+
+void SysCfgParser::Reload()
+{
+    std::lock_guard<std::mutex> lock(loadLock_);
+    std::atomic_store(&snapshot_, std::shared_ptr<const SysCfgSnapshot>(nullptr));
+    IMSA_HILOGI("system config dropped.");
+}
+
+std::shared_ptr<const SysCfgSnapshot> SysCfgParser::GetSnapshot()
+{
+    auto snapshot = std::atomic_load(&snapshot_);
+    if (snapshot != nullptr && !IsChanged(*snapshot)) {
+        return snapshot;
+    }
+    std::lock_guard<std::mutex> lock(loadLock_);
+    snapshot = std::atomic_load(&snapshot_);
+    if (snapshot != nullptr && !IsChanged(*snapshot)) {
+        return snapshot;
+    }
+    snapshot = LoadSnapshot();
+    std::atomic_store(&snapshot_, snapshot);
+    return snapshot;
+}
+
+std::shared_ptr<const SysCfgSnapshot> SysCfgParser::LoadSnapshot()
+{
+    auto snapshot = std::make_shared<SysCfgSnapshot>();
+    CfgFiles *cfgFiles = GetCfgFiles(SYS_CFG_FILE_PATH);
+    if (cfgFiles == nullptr) {
+        IMSA_HILOGE("%{public}s cfgFiles is nullptr!", SYS_CFG_FILE_PATH);
+        return snapshot;
+    }
+    // parse config files, ordered by priority from high to low
+    for (int32_t i = MAX_CFG_POLICY_DIRS_CNT - 1; i >= 0; i--) {
+        auto realPath = FileOperator::GetRealPath(cfgFiles->paths[i]);
+        SysCfgFileStamp stamp;
+        // the stamp is taken before the read, a write in between is seen as a change by the next call
+        if (realPath.empty() || !GetFileStamp(realPath, stamp)) {
+            continue;
+        }
+        std::string content;
+        if (!FileOperator::Read(realPath, content)) {
+            continue;
+        }
+        snapshot->stamps.push_back(stamp);
+        cJSON *root = nullptr;
+        ParseSection(content, root, GET_NAME(systemConfig), snapshot->systemConfig);
+        ParseSection(content, root, GET_NAME(supportedInputTypeList), snapshot->inputType);
+        ParseSection(content, root, GET_NAME(dynamicStartImeCfgList), snapshot->dynamicStartIme);
+        ParseSection(content, root, GET_NAME(sysPanelAdjust), snapshot->panelAdjust);
+        ParseSection(content, root, GET_NAME(defaultFullImeList), snapshot->defaultFullIme);
+        ParseSection(content, root, GET_NAME(ignoreSysPanelAdjust), snapshot->ignoreSysPanelAdjust);
+        if (root != nullptr) {
+            cJSON_Delete(root);
+        }
+    }
+    FreeCfgFiles(cfgFiles);
+    IMSA_HILOGI("system config loaded, file num: %{public}zu.", snapshot->stamps.size());
+    return snapshot;
+}
+
+bool SysCfgParser::GetFileStamp(const std::string &path, SysCfgFileStamp &stamp)
+{
+    struct stat fileStat = {};
+    if (stat(path.c_str(), &fileStat) != 0) {
+        return false;
+    }
+    stamp.path = path;
+    stamp.mtimeNs = static_cast<int64_t>(fileStat.st_mtim.tv_sec) * NS_PER_SECOND + fileStat.st_mtim.tv_nsec;
+    stamp.size = static_cast<int64_t>(fileStat.st_size);
+    return true;
 }
 
-std::string SysCfgParser::GetSysCfgContent(const std::string &key)
+// a new file in a directory which had none is not seen here, Reload picks it up
+bool SysCfgParser::IsChanged(const SysCfgSnapshot &snapshot)
 {
-    std::string content;
-    auto ret = FileOperator::Read(SYS_CFG_FILE_PATH, key, content);
-    if (!ret) {
-        IMSA_HILOGD("get content by %{public}s failed.", key.c_str());
+    for (const auto &stamp : snapshot.stamps) {
+        SysCfgFileStamp current;
+        if (!GetFileStamp(stamp.path, current) || current.mtimeNs != stamp.mtimeNs || current.size != stamp.size) {
+            IMSA_HILOGI("%{public}s changed.", stamp.path.c_str());
+            return true;
+        }
     }
-    return content;
+    return false;
 }
 // LCOV_EXCL_STOP
 } // namespace MiscServices
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <memory>
+
+#include "concurrent_map.h"
+#include "sharded_concurrent_map.h"
+
+namespace OHOS {
+namespace MiscServices {
+namespace {
+constexpr int32_t KEY_NUM = 64;
+constexpr int32_t MAX_THREAD_NUM = 16;
+constexpr int32_t WRITER_INTERVAL = 8; // every 8th thread writes, the others read
+constexpr int32_t REPETITIONS = 5;
+
+// the value type of a registry entry, copied by Find
+struct Entry {
+    std::shared_ptr<int32_t> object = std::make_shared<int32_t>(0);
+    int64_t counter = 0;
+};
+
+template<typename Map> Map &GetMap()
+{
+    static Map map;
+    return map;
+}
+
+template<typename Map> void Fill(Map &map)
+{
+    for (int32_t i = 0; i < KEY_NUM; ++i) {
+        map.InsertOrAssign(i, Entry());
+    }
+}
+
+template<typename Map> void Write(Map &map, int32_t key)
+{
+    map.ComputeIfPresent(key, [](const int32_t &, Entry &entry) {
+        ++entry.counter;
+        return true;
+    });
+}
+} // namespace
+
+// the same key pattern on both maps, state.threads() from 1 to 16
+template<typename Map> static void BM_MapReadWrite(benchmark::State &state)
+{
+    auto &map = GetMap<Map>();
+    if (state.thread_index() == 0) {
+        Fill(map);
+    }
+    bool isWriter = state.thread_index() % WRITER_INTERVAL == WRITER_INTERVAL - 1;
+    int32_t key = state.thread_index();
+    for (auto _ : state) {
+        key = (key + 1) % KEY_NUM;
+        if (isWriter) {
+            Write(map, key);
+        } else {
+            benchmark::DoNotOptimize(map.Find(key));
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_MapReadWrite, ConcurrentMap<int32_t, Entry>)
+    ->ThreadRange(1, MAX_THREAD_NUM)
+    ->UseRealTime()
+    ->Repetitions(REPETITIONS)
+    ->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(BM_MapReadWrite, ShardedConcurrentMap<int32_t, Entry>)
+    ->ThreadRange(1, MAX_THREAD_NUM)
+    ->UseRealTime()
+    ->Repetitions(REPETITIONS)
+    ->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(BM_MapReadWrite, ShardedConcurrentHashMap<int32_t, Entry>)
+    ->ThreadRange(1, MAX_THREAD_NUM)
+    ->UseRealTime()
+    ->Repetitions(REPETITIONS)
+    ->ReportAggregatesOnly(true);
+
+// a whole traversal per iteration, ForEach takes the lock exclusively, ForEachShared does not
+template<typename Map> static void BM_MapTraverse(benchmark::State &state)
+{
+    auto &map = GetMap<Map>();
+    if (state.thread_index() == 0) {
+        Fill(map);
+    }
+    for (auto _ : state) {
+        int64_t sum = 0;
+        if constexpr (std::is_same_v<Map, ConcurrentMap<int32_t, Entry>>) {
+            map.ForEach([&sum](const int32_t &, Entry &entry) {
+                sum += entry.counter;
+                return false;
+            });
+        } else {
+            map.ForEachShared([&sum](const int32_t &, const Entry &entry) {
+                sum += entry.counter;
+                return false;
+            });
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * KEY_NUM);
+}
+BENCHMARK_TEMPLATE(BM_MapTraverse, ConcurrentMap<int32_t, Entry>)
+    ->ThreadRange(1, MAX_THREAD_NUM)
+    ->UseRealTime()
+    ->Repetitions(REPETITIONS)
+    ->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(BM_MapTraverse, ShardedConcurrentMap<int32_t, Entry>)
+    ->ThreadRange(1, MAX_THREAD_NUM)
+    ->UseRealTime()
+    ->Repetitions(REPETITIONS)
+    ->ReportAggregatesOnly(true);
+} // namespace MiscServices
+} // namespace OHOS
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define private public
+#include "ime_enabled_info_manager.h"
+#undef private
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <mutex>
+#include <string>
+
+namespace OHOS {
+namespace MiscServices {
+namespace {
+constexpr int32_t BENCHMARK_USER_ID = 100;
+constexpr int32_t INSTALLED_IME_NUM = 100;
+constexpr int32_t MAX_READER_NUM = 16;
+constexpr int32_t REPETITIONS = 5;
+
+ImeEnabledCfg MakeEnabledCfg()
+{
+    ImeEnabledCfg cfg;
+    for (int32_t i = 0; i < INSTALLED_IME_NUM; ++i) {
+        cfg.enabledInfos.emplace_back("com.example.ime" + std::to_string(i), "InputMethodExtAbility",
+            i % 2 == 0 ? EnabledStatus::BASIC_MODE : EnabledStatus::FULL_EXPERIENCE_MODE);
+    }
+    cfg.enabledInfos.back().extraInfo.isDefaultIme = true;
+    return cfg;
+}
+
+const std::string &GetLookupName()
+{
+    // the last one, the worst case of a linear search
+    static const std::string name = "com.example.ime" + std::to_string(INSTALLED_IME_NUM - 1);
+    return name;
+}
+
+// the cache as it was read before the snapshots: a whole copy under a lock, then a linear search
+class LockedCopyCache {
+public:
+    static LockedCopyCache &GetInstance()
+    {
+        static LockedCopyCache cache;
+        return cache;
+    }
+
+    EnabledStatus GetEnabledState(const std::string &bundleName)
+    {
+        std::lock_guard<std::mutex> operateLock(operateLock_);
+        ImeEnabledCfg cfg;
+        {
+            std::lock_guard<std::mutex> cfgLock(cfgLock_);
+            cfg = cfg_;
+        }
+        auto iter = std::find_if(cfg.enabledInfos.begin(), cfg.enabledInfos.end(),
+            [&bundleName](const ImeEnabledInfo &info) { return info.bundleName == bundleName; });
+        return iter == cfg.enabledInfos.end() ? EnabledStatus::DISABLED : iter->enabledStatus;
+    }
+
+private:
+    LockedCopyCache() : cfg_(MakeEnabledCfg())
+    {
+    }
+    std::mutex operateLock_;
+    std::mutex cfgLock_;
+    ImeEnabledCfg cfg_;
+};
+} // namespace
+
+static void BM_EnabledStateLockedCopy(benchmark::State &state)
+{
+    auto &cache = LockedCopyCache::GetInstance();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cache.GetEnabledState(GetLookupName()));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EnabledStateLockedCopy)
+    ->ThreadRange(1, MAX_READER_NUM)
+    ->UseRealTime()
+    ->Repetitions(REPETITIONS)
+    ->ReportAggregatesOnly(true);
+
+static void BM_EnabledStateSnapshot(benchmark::State &state)
+{
+    auto &manager = ImeEnabledInfoManager::GetInstance();
+    if (state.thread_index() == 0) {
+        manager.SetEnabledCache(BENCHMARK_USER_ID, MakeEnabledCfg());
+    }
+    for (auto _ : state) {
+        auto snapshot = manager.GetSnapshot(BENCHMARK_USER_ID);
+        benchmark::DoNotOptimize(snapshot == nullptr ? nullptr : snapshot->FindByBundleName(GetLookupName()));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EnabledStateSnapshot)
+    ->ThreadRange(1, MAX_READER_NUM)
+    ->UseRealTime()
+    ->Repetitions(REPETITIONS)
+    ->ReportAggregatesOnly(true);
+
+static void BM_CurrentImeCfgSnapshot(benchmark::State &state)
+{
+    auto &manager = ImeEnabledInfoManager::GetInstance();
+    if (state.thread_index() == 0) {
+        manager.SetEnabledCache(BENCHMARK_USER_ID, MakeEnabledCfg());
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(manager.GetCurrentImeCfg(BENCHMARK_USER_ID));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CurrentImeCfgSnapshot)
+    ->ThreadRange(1, MAX_READER_NUM)
+    ->UseRealTime()
+    ->Repetitions(REPETITIONS)
+    ->ReportAggregatesOnly(true);
+} // namespace MiscServices
+} // namespace OHOS
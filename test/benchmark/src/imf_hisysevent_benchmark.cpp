@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <mutex>
+#include <string>
+
+#include "imf_hisysevent_histogram.h"
+#include "imf_hisysevent_info.h"
+
+namespace OHOS {
+namespace MiscServices {
+namespace {
+constexpr int32_t CODE_NUM = 8;
+constexpr uint32_t BUCKET_NUM = 5;
+constexpr int32_t MAX_THREAD_NUM = 8;
+constexpr int32_t REPETITIONS = 5;
+
+// the record path before the histogram: a lock, a string key and a search in the distribution
+struct LockedDistribution {
+    std::mutex lock;
+    CountDistributionInfo info{ BUCKET_NUM };
+};
+
+LockedDistribution &GetLockedDistribution()
+{
+    static LockedDistribution distribution;
+    return distribution;
+}
+
+ImfHiSysEventHistogram &GetHistogram()
+{
+    static ImfHiSysEventHistogram histogram(BUCKET_NUM);
+    return histogram;
+}
+} // namespace
+
+// one record of a succeeded text operation, state.threads() from 1 to 8
+static void BM_RecordLocked(benchmark::State &state)
+{
+    auto &distribution = GetLockedDistribution();
+    int32_t code = state.thread_index();
+    for (auto _ : state) {
+        code = (code + 1) % CODE_NUM;
+        std::lock_guard<std::mutex> lock(distribution.lock);
+        std::string key = std::to_string(0).append("/").append(std::to_string(code));
+        distribution.info.ModCountDistributions(static_cast<uint32_t>(code) % BUCKET_NUM, key);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RecordLocked)
+    ->ThreadRange(1, MAX_THREAD_NUM)
+    ->UseRealTime()
+    ->Repetitions(REPETITIONS)
+    ->ReportAggregatesOnly(true);
+
+static void BM_RecordHistogram(benchmark::State &state)
+{
+    auto &histogram = GetHistogram();
+    int32_t code = state.thread_index();
+    for (auto _ : state) {
+        code = (code + 1) % CODE_NUM;
+        benchmark::DoNotOptimize(
+            histogram.Record(static_cast<uint64_t>(code), static_cast<uint32_t>(code) % BUCKET_NUM));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RecordHistogram)
+    ->ThreadRange(1, MAX_THREAD_NUM)
+    ->UseRealTime()
+    ->Repetitions(REPETITIONS)
+    ->ReportAggregatesOnly(true);
+} // namespace MiscServices
+} // namespace OHOS
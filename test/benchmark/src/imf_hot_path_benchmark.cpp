@@ -0,0 +1,452 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define private public
+#include "input_method_ability.h"
+#include "input_method_controller.h"
+#undef private
+
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <string>
+#include <string_ex.h>
+#include <vector>
+
+#include "global.h"
+#include "input_method_agent_proxy.h"
+#include "input_method_agent_service_impl.h"
+#include "key_event.h"
+#include "msg_handler_callback_interface.h"
+#include "keyboard_listener_test_impl.h"
+#include "sys_cfg_parser.h"
+#include "text_listener.h"
+#include "variant_util.h"
+
+/*
+ * Hot path benchmarks of the editor and ime sides. Controller, data channel and ability are wired together
+ * through their idl stubs and proxies in this process, a proxy on a local stub calls OnRemoteRequest directly,
+ * so every case pays for the marshalling and the dispatch of the ipc but not for the binder driver.
+ * No system ability and no device is needed.
+ */
+namespace OHOS {
+namespace MiscServices {
+namespace {
+constexpr const char *BENCHMARK_IME_NAME = "com.example.benchmark.ime";
+constexpr int32_t BENCHMARK_IME_PID = 1;
+constexpr int32_t REPETITIONS = 5;
+constexpr int64_t MIN_TEXT_SIZE = 10;
+constexpr int64_t MAX_TEXT_SIZE = 100000;
+constexpr int64_t MAX_AGENT_NUM = 16;
+constexpr uint32_t PIPELINE_WINDOW = 8;
+constexpr int64_t MIN_MESSAGE_SIZE = 16 * 1024;
+constexpr int64_t MAX_MESSAGE_SIZE = 128 * 1024;
+constexpr int32_t SURROUNDING_TEXT_LENGTH = 300;
+constexpr int64_t TEXT_ASCII = 0;
+constexpr int64_t TEXT_CJK = 1;
+constexpr int64_t TEXT_EMOJI = 2;
+constexpr int64_t TRANSCODE_UTF8 = 0;
+constexpr int64_t TRANSCODE_NONE = 1;
+constexpr int64_t SEND_BY_PARCEL = 0;
+constexpr int64_t SEND_BY_SHARED_BUFFER = 1;
+
+// consumes every key and reports the result back through the data channel, as an ime does
+class BenchmarkKeyboardListener : public KeyboardListenerTestImpl {
+public:
+    bool OnDealKeyEvent(const std::shared_ptr<MMI::KeyEvent> &keyEvent, uint64_t cbId,
+        const sptr<IRemoteObject> &channelObject) override
+    {
+        InputMethodAbility::GetInstance().HandleKeyEventResult(cbId, true, channelObject);
+        return true;
+    }
+};
+
+// an editor holding the text before and after the cursor
+class BenchmarkTextListener : public TextListener {
+public:
+    std::u16string GetLeftTextOfCursor(int32_t number) override
+    {
+        return text_;
+    }
+    std::u16string GetRightTextOfCursor(int32_t number) override
+    {
+        return text_;
+    }
+    std::u16string text_;
+};
+
+// takes every message the editor sends, as an ime message handler does
+class BenchmarkMsgHandler : public MsgHandlerCallbackInterface {
+public:
+    int32_t OnTerminated() override
+    {
+        return ErrorCode::NO_ERROR;
+    }
+    int32_t OnMessage(const ArrayBuffer &arrayBuffer) override
+    {
+        receivedBytes_ += static_cast<int64_t>(arrayBuffer.msgParam.size());
+        return ErrorCode::NO_ERROR;
+    }
+    int64_t receivedBytes_ = 0;
+};
+
+class LoopbackEnv {
+public:
+    static LoopbackEnv &GetInstance()
+    {
+        static LoopbackEnv env;
+        return env;
+    }
+
+    sptr<InputMethodController> GetController() const
+    {
+        return controller_;
+    }
+
+    void SetEditorText(const std::u16string &text)
+    {
+        textListener_->text_ = text;
+    }
+
+    // keeps the ime agent only, plus extraNum agents which receive the fan-out updates as well
+    void ResetAgents(int64_t extraNum)
+    {
+        controller_->ClearAgentInfo();
+        BindImeInfo imeInfo;
+        imeInfo.pid = BENCHMARK_IME_PID;
+        imeInfo.bundleName = BENCHMARK_IME_NAME;
+        controller_->OnInputReady(InputMethodAbility::GetInstance().agentStub_->AsObject(), imeInfo);
+        std::lock_guard<std::mutex> lock(controller_->agentLock_);
+        for (int64_t i = 0; i < extraNum; ++i) {
+            sptr<InputMethodAgentStub> agentStub = new (std::nothrow) InputMethodAgentServiceImpl();
+            if (agentStub == nullptr) {
+                continue;
+            }
+            InputMethodController::AgentInfo agentInfo;
+            agentInfo.agent = std::make_shared<InputMethodAgentProxy>(agentStub->AsObject());
+            agentInfo.agentObject = agentStub->AsObject();
+            controller_->agentInfoList_.push_back(agentInfo);
+        }
+    }
+
+private:
+    LoopbackEnv()
+    {
+        controller_ = InputMethodController::GetInstance();
+        controller_->SetTextListener(textListener_);
+        controller_->SetUpdateCoalesceInterval(0);
+        auto &ability = InputMethodAbility::GetInstance();
+        ability.SetKdListener(std::make_shared<BenchmarkKeyboardListener>());
+        ability.SetInputDataChannel(controller_->clientInfo_.channel);
+        ability.securityMode_.store(static_cast<int32_t>(SecurityMode::FULL));
+        ability.RegisterMsgHandler(msgHandler_);
+        {
+            std::lock_guard<std::recursive_mutex> lock(controller_->clientInfoLock_);
+            controller_->clientInfo_.state = ClientState::ACTIVE;
+        }
+        controller_->isBound_.store(true);
+        controller_->isEditable_.store(true);
+        ResetAgents(0);
+    }
+
+    sptr<InputMethodController> controller_ = nullptr;
+    sptr<BenchmarkTextListener> textListener_ = new (std::nothrow) BenchmarkTextListener();
+    std::shared_ptr<BenchmarkMsgHandler> msgHandler_ = std::make_shared<BenchmarkMsgHandler>();
+};
+
+std::shared_ptr<MMI::KeyEvent> CreateKeyEvent(int32_t keyCode)
+{
+    auto keyEvent = MMI::KeyEvent::Create();
+    if (keyEvent == nullptr) {
+        return nullptr;
+    }
+    MMI::KeyEvent::KeyItem item;
+    item.SetKeyCode(keyCode);
+    item.SetPressed(true);
+    keyEvent->SetKeyCode(keyCode);
+    keyEvent->SetKeyAction(MMI::KeyEvent::KEY_ACTION_DOWN);
+    keyEvent->AddKeyItem(item);
+    return keyEvent;
+}
+
+std::u16string MakeText(const std::u16string &unit, int32_t size)
+{
+    std::u16string text;
+    while (text.size() < static_cast<size_t>(size)) {
+        text += unit;
+    }
+    return text;
+}
+
+std::u16string MakeText(int64_t size)
+{
+    static const std::u16string unit = u"hello 输入法 ";
+    std::u16string text;
+    text.reserve(static_cast<size_t>(size));
+    while (text.size() < static_cast<size_t>(size)) {
+        text += unit;
+    }
+    text.resize(static_cast<size_t>(size));
+    return text;
+}
+} // namespace
+
+// editor to ime key dispatch until the consume result is back, state.range(0) is the pipeline window
+static void BM_DispatchKeyEvent(benchmark::State &state)
+{
+    auto &env = LoopbackEnv::GetInstance();
+    auto controller = env.GetController();
+    env.ResetAgents(0);
+    controller->SetKeyEventPipelineWindow(static_cast<uint32_t>(state.range(0)));
+    auto keyEvent = CreateKeyEvent(MMI::KeyEvent::KEYCODE_A);
+    if (keyEvent == nullptr) {
+        state.SkipWithError("failed to create key event");
+        return;
+    }
+    int64_t consumed = 0;
+    for (auto _ : state) {
+        auto ret = controller->DispatchKeyEvent(keyEvent,
+            [&consumed](std::shared_ptr<MMI::KeyEvent> &event, bool isConsumed) { consumed += isConsumed; });
+        if (ret != ErrorCode::NO_ERROR) {
+            state.SkipWithError("failed to dispatch key event");
+            break;
+        }
+    }
+    controller->SetKeyEventPipelineWindow(0);
+    state.counters["consumed"] = static_cast<double>(consumed);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DispatchKeyEvent)->Arg(0)->Arg(PIPELINE_WINDOW)->Repetitions(REPETITIONS)->ReportAggregatesOnly(true);
+
+// ime InsertText waiting for the editor reply through the agent
+static void BM_InsertTextRoundTrip(benchmark::State &state)
+{
+    auto &env = LoopbackEnv::GetInstance();
+    env.ResetAgents(0);
+    auto &ability = InputMethodAbility::GetInstance();
+    const std::string text = "a";
+    for (auto _ : state) {
+        if (ability.InsertText(text) != ErrorCode::NO_ERROR) {
+            state.SkipWithError("failed to insert text");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_InsertTextRoundTrip)->Repetitions(REPETITIONS)->ReportAggregatesOnly(true);
+
+// one character typed in the middle of a text of state.range(0) utf-16 units
+static void BM_OnSelectionChange(benchmark::State &state)
+{
+    auto &env = LoopbackEnv::GetInstance();
+    auto controller = env.GetController();
+    env.ResetAgents(0);
+    auto size = state.range(0);
+    std::u16string texts[] = { MakeText(size), MakeText(size) };
+    auto cursor = static_cast<int32_t>(size / 2);
+    texts[1][cursor] = u'x';
+    controller->OnSelectionChange(texts[0], cursor, cursor);
+    size_t index = 0;
+    for (auto _ : state) {
+        index ^= 1;
+        controller->OnSelectionChange(texts[index], cursor + static_cast<int32_t>(index),
+            cursor + static_cast<int32_t>(index));
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * size * static_cast<int64_t>(sizeof(char16_t)));
+}
+BENCHMARK(BM_OnSelectionChange)
+    ->RangeMultiplier(10)
+    ->Range(MIN_TEXT_SIZE, MAX_TEXT_SIZE)
+    ->Repetitions(REPETITIONS)
+    ->ReportAggregatesOnly(true);
+
+// cursor update sent to the ime plus state.range(0) other agents
+static void BM_CursorFanOut(benchmark::State &state)
+{
+    auto &env = LoopbackEnv::GetInstance();
+    auto controller = env.GetController();
+    env.ResetAgents(state.range(0));
+    double position = 0;
+    for (auto _ : state) {
+        position += 1;
+        CursorInfo cursorInfo = { position, position, 1, 1 };
+        controller->OnCursorUpdate(cursorInfo);
+    }
+    env.ResetAgents(0);
+    state.counters["agents"] = static_cast<double>(state.range(0) + 1);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CursorFanOut)
+    ->RangeMultiplier(2)
+    ->Range(0, MAX_AGENT_NUM)
+    ->Repetitions(REPETITIONS)
+    ->ReportAggregatesOnly(true);
+
+// the legacy getForward: utf-8 on the wire, back to utf-16 in the ime and to utf-8 again for napi
+static int32_t GetTextBeforeCursorUtf8(const std::shared_ptr<InputDataChannelProxyWrap> &channel, std::string &text)
+{
+    auto work = [agentObject = channel->agentObject_](
+                    uint64_t msgId, const std::shared_ptr<InputDataChannelProxy> &dataChannel) -> int32_t {
+        return dataChannel->GetTextBeforeCursor(SURROUNDING_TEXT_LENGTH, msgId, agentObject);
+    };
+    std::string textU8;
+    auto ret = channel->Request(nullptr, work, true,
+        static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_GET_TEXT_BEFORE_CURSOR),
+        ResponseHandler::SYNC_REPLY_TIMEOUT,
+        [&textU8](const ResponseData &data) { VariantUtil::GetValue(data, textU8); });
+    text = Str16ToStr8(Str8ToStr16(textU8));
+    return ret;
+}
+
+// ime getForward of 300 utf-16 units, state.range(0) is the text kind, state.range(1) the transcoding path
+static void BM_GetTextBeforeCursor(benchmark::State &state)
+{
+    static const std::u16string units[] = { u"hello world ", u"输入法框架", u"\U0001F600\U0001F44D\U0001F389 " };
+    auto &env = LoopbackEnv::GetInstance();
+    env.ResetAgents(0);
+    env.SetEditorText(MakeText(units[state.range(0)], SURROUNDING_TEXT_LENGTH));
+    auto &ability = InputMethodAbility::GetInstance();
+    auto channel = ability.GetInputDataChannelProxyWrap();
+    if (channel == nullptr) {
+        state.SkipWithError("no data channel");
+        return;
+    }
+    bool isUtf16 = state.range(1) == TRANSCODE_NONE;
+    for (auto _ : state) {
+        int32_t ret = ErrorCode::NO_ERROR;
+        if (isUtf16) {
+            // napi_create_string_utf16 takes the text as is
+            std::u16string text;
+            ret = ability.GetTextBeforeCursor(SURROUNDING_TEXT_LENGTH, text, nullptr);
+            benchmark::DoNotOptimize(text);
+        } else {
+            std::string text;
+            ret = GetTextBeforeCursorUtf8(channel, text);
+            benchmark::DoNotOptimize(text);
+        }
+        if (ret != ErrorCode::NO_ERROR) {
+            state.SkipWithError("failed to get text");
+            break;
+        }
+    }
+    env.SetEditorText(u"");
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GetTextBeforeCursor)
+    ->Args({ TEXT_ASCII, TRANSCODE_UTF8 })
+    ->Args({ TEXT_ASCII, TRANSCODE_NONE })
+    ->Args({ TEXT_CJK, TRANSCODE_UTF8 })
+    ->Args({ TEXT_CJK, TRANSCODE_NONE })
+    ->Args({ TEXT_EMOJI, TRANSCODE_UTF8 })
+    ->Args({ TEXT_EMOJI, TRANSCODE_NONE })
+    ->Repetitions(REPETITIONS)
+    ->ReportAggregatesOnly(true);
+
+// editor to ime message of state.range(0) bytes, state.range(1) picks the parcel or the shared buffer
+static void BM_SendMessage(benchmark::State &state)
+{
+    auto &env = LoopbackEnv::GetInstance();
+    auto controller = env.GetController();
+    env.ResetAgents(0);
+    auto agent = controller->GetAgent();
+    if (agent == nullptr) {
+        state.SkipWithError("no agent");
+        return;
+    }
+    ArrayBuffer arrayBuffer;
+    arrayBuffer.jsArgc = 2; // msgId and msgParam
+    arrayBuffer.msgId = "benchmark";
+    arrayBuffer.msgParam.assign(static_cast<size_t>(state.range(0)), 'a');
+    bool isShared = state.range(1) == SEND_BY_SHARED_BUFFER;
+    for (auto _ : state) {
+        auto ret = isShared ? controller->SendMessage(arrayBuffer) : agent->SendMessage(arrayBuffer);
+        if (ret != ErrorCode::NO_ERROR) {
+            state.SkipWithError("failed to send message");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+static void SendMessageArgs(benchmark::internal::Benchmark *benchmark)
+{
+    for (int64_t size = MIN_MESSAGE_SIZE; size <= MAX_MESSAGE_SIZE; size *= 2) {
+        benchmark->Args({ size, SEND_BY_PARCEL });
+        benchmark->Args({ size, SEND_BY_SHARED_BUFFER });
+    }
+}
+BENCHMARK(BM_SendMessage)
+    ->Apply(SendMessageArgs)
+    ->Repetitions(REPETITIONS)
+    ->ReportAggregatesOnly(true);
+
+// the config snapshot is reused, only the mtime of the files is checked
+static void BM_ParseSystemConfig(benchmark::State &state)
+{
+    for (auto _ : state) {
+        SystemConfig systemConfig;
+        benchmark::DoNotOptimize(SysCfgParser::ParseSystemConfig(systemConfig));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ParseSystemConfig)->Repetitions(REPETITIONS)->ReportAggregatesOnly(true);
+
+// the cold start case, every config file is read and parsed again
+static void BM_ParseSystemConfigCold(benchmark::State &state)
+{
+    for (auto _ : state) {
+        SysCfgParser::Reload();
+        SystemConfig systemConfig;
+        benchmark::DoNotOptimize(SysCfgParser::ParseSystemConfig(systemConfig));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ParseSystemConfigCold)->Repetitions(REPETITIONS)->ReportAggregatesOnly(true);
+
+static void BM_ParseInputType(benchmark::State &state)
+{
+    for (auto _ : state) {
+        std::vector<InputTypeInfo> inputTypes;
+        benchmark::DoNotOptimize(SysCfgParser::ParseInputType(inputTypes));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ParseInputType)->Repetitions(REPETITIONS)->ReportAggregatesOnly(true);
+} // namespace MiscServices
+} // namespace OHOS
+
+// json is the default output so that the results of two releases can be diffed, --benchmark_format overrides it
+int main(int argc, char **argv)
+{
+    constexpr const char *FORMAT_FLAG = "--benchmark_format";
+    static char defaultFormat[] = "--benchmark_format=json";
+    std::vector<char *> args(argv, argv + argc);
+    bool hasFormat = false;
+    for (int i = 1; i < argc; ++i) {
+        hasFormat = hasFormat || std::strncmp(argv[i], FORMAT_FLAG, std::strlen(FORMAT_FLAG)) == 0;
+    }
+    if (!hasFormat) {
+        args.push_back(defaultFormat);
+    }
+    int count = static_cast<int>(args.size());
+    benchmark::Initialize(&count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(count, args.data())) {
+        return 1;
+    }
+    benchmark::AddCustomContext("imf_benchmark_version", "1");
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+#include "ime_enabled_info_manager.h"
+
+namespace OHOS {
+namespace MiscServices {
+namespace {
+constexpr int32_t REPETITIONS = 5;
+constexpr int64_t MIN_ENTRY_NUM = 10;
+constexpr int64_t MAX_ENTRY_NUM = 1000;
+
+// the array traversal as it was, cJSON_GetArrayItem walks from the head for every index
+struct IndexedEnabledCfg : public Serializable {
+    std::string version;
+    std::vector<ImeEnabledInfo> enabledInfos;
+    bool Unmarshal(cJSON *node) override
+    {
+        auto ret = GetValue(node, GET_NAME(version), version);
+        auto subNode = GetSubNode(node, GET_NAME(inputmethods));
+        if (!cJSON_IsArray(subNode)) {
+            return false;
+        }
+        auto size = cJSON_GetArraySize(subNode);
+        enabledInfos.resize(size);
+        for (int32_t i = 0; i < size; i++) {
+            auto item = cJSON_GetArrayItem(subNode, i);
+            if (item == NULL) {
+                return false;
+            }
+            ret = GetValue(item, "", enabledInfos[i]) && ret;
+        }
+        return ret;
+    }
+};
+
+std::string MakeEnabledCfgContent(int64_t num)
+{
+    ImeEnabledCfg cfg;
+    cfg.version = "benchmark";
+    for (int64_t i = 0; i < num; ++i) {
+        cfg.enabledInfos.emplace_back("com.example.ime" + std::to_string(i), "InputMethodExtAbility",
+            EnabledStatus::BASIC_MODE);
+    }
+    std::string content;
+    cfg.Marshall(content);
+    return content;
+}
+} // namespace
+
+static void BM_UnmarshallEnabledCfg(benchmark::State &state)
+{
+    auto content = MakeEnabledCfgContent(state.range(0));
+    for (auto _ : state) {
+        ImeEnabledCfg cfg;
+        benchmark::DoNotOptimize(cfg.Unmarshall(content));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(content.size()));
+}
+BENCHMARK(BM_UnmarshallEnabledCfg)
+    ->RangeMultiplier(10)
+    ->Range(MIN_ENTRY_NUM, MAX_ENTRY_NUM)
+    ->Repetitions(REPETITIONS)
+    ->ReportAggregatesOnly(true);
+
+static void BM_UnmarshallEnabledCfgIndexed(benchmark::State &state)
+{
+    auto content = MakeEnabledCfgContent(state.range(0));
+    for (auto _ : state) {
+        IndexedEnabledCfg cfg;
+        benchmark::DoNotOptimize(cfg.Unmarshall(content));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(content.size()));
+}
+BENCHMARK(BM_UnmarshallEnabledCfgIndexed)
+    ->RangeMultiplier(10)
+    ->Range(MIN_ENTRY_NUM, MAX_ENTRY_NUM)
+    ->Repetitions(REPETITIONS)
+    ->ReportAggregatesOnly(true);
+
+static void BM_MarshallEnabledCfg(benchmark::State &state)
+{
+    ImeEnabledCfg cfg;
+    cfg.Unmarshall(MakeEnabledCfgContent(state.range(0)));
+    for (auto _ : state) {
+        std::string content;
+        benchmark::DoNotOptimize(cfg.Marshall(content));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MarshallEnabledCfg)
+    ->RangeMultiplier(10)
+    ->Range(MIN_ENTRY_NUM, MAX_ENTRY_NUM)
+    ->Repetitions(REPETITIONS)
+    ->ReportAggregatesOnly(true);
+} // namespace MiscServices
+} // namespace OHOS
@@ -18,8 +18,15 @@
 namespace OHOS {
 namespace DataShare {
 std::shared_ptr<DataShareHelper> DataShareHelper::instance_;
+uint32_t DataShareHelper::creatorNum_ = 0;
+uint32_t DataShareHelper::queryNum_ = 0;
+bool DataShareHelper::isQueryFailed_ = false;
+std::map<std::string, std::string> DataShareHelper::values_;
+constexpr int32_t KEYWORD_COLUMN_INDEX = 0;
+constexpr int32_t VALUE_COLUMN_INDEX = 1;
 DataSharePredicates *DataSharePredicates::EqualTo(const std::string &field, const std::string &value)
 {
+    keyword_ = value;
     return this;
 }
 
@@ -41,19 +48,20 @@ int32_t DataShareResultSet::GoToFirstRow()
 
 int32_t DataShareResultSet::GetColumnIndex(const std::string &columnName, int32_t &columnIndex)
 {
-    columnIndex = 1;
+    columnIndex = columnName == "KEYWORD" ? KEYWORD_COLUMN_INDEX : VALUE_COLUMN_INDEX;
     return 0;
 }
 
 int32_t DataShareResultSet::GetString(int columnIndex, std::string &value) const
 {
-    value = strValue_;
+    value = columnIndex == KEYWORD_COLUMN_INDEX ? keyword_ : value_;
     return 0;
 }
 
 std::shared_ptr<DataShareHelper> DataShareHelper::Creator(
     const sptr<IRemoteObject> &token, const std::string &strUri, const std::string &extUri)
 {
+    ++creatorNum_;
     if (instance_ != nullptr) {
         return instance_;
     }
@@ -64,11 +72,12 @@ std::shared_ptr<DataShareHelper> DataShareHelper::Creator(
 std::shared_ptr<DataShareResultSet> DataShareHelper::Query(Uri &uri, const DataSharePredicates &predicates,
     std::vector<std::string> &columns, DatashareBusinessError *businessError)
 {
-    if (resultSet_ != nullptr) {
-        return resultSet_;
+    ++queryNum_;
+    if (isQueryFailed_) {
+        return nullptr;
     }
-    resultSet_ = std::make_shared<DataShareResultSet>();
-    return resultSet_;
+    auto iter = values_.find(predicates.keyword_);
+    return std::make_shared<DataShareResultSet>(predicates.keyword_, iter == values_.end() ? "" : iter->second);
 }
 
 void DataShareHelper::RegisterObserver(const Uri &uri, const sptr<AAFwk::IDataAbilityObserver> &dataObserver)
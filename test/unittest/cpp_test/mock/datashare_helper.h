@@ -17,7 +17,10 @@
 #define DATASHARE_HELPER_H
 
 #include <cstdint>
+#include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "data_ability_observer_interface.h"
 #include "datashare_value_object.h"
@@ -30,11 +33,13 @@ constexpr int32_t E_OK = 0;
 class DataSharePredicates {
 public:
     DataSharePredicates *EqualTo(const std::string &field, const std::string &value);
+    std::string keyword_;
 };
 class DatashareBusinessError { };
+// one row of keyword and value
 class DataShareResultSet {
 public:
-    DataShareResultSet() = default;
+    DataShareResultSet(const std::string &keyword, const std::string &value) : keyword_(keyword), value_(value) { }
     ~DataShareResultSet() = default;
     static int32_t GetRowCount(int32_t &count);
     static int32_t Close();
@@ -43,7 +48,8 @@ public:
     int32_t GetString(int columnIndex, std::string &value) const;
 
 private:
-    std::string strValue_;
+    std::string keyword_;
+    std::string value_;
 };
 
 class DataShareHelper {
@@ -59,10 +65,15 @@ public:
     static bool Release();
     static int Update(Uri &uri, const DataSharePredicates &predicates, const DataShareValuesBucket &value);
     static int Insert(Uri &uri, const DataShareValuesBucket &value);
+    // counted for the tests of the helper pool
+    static uint32_t creatorNum_;
+    static uint32_t queryNum_;
+    static bool isQueryFailed_;
+    // the stored values by keyword, a keyword not stored reads as an empty value
+    static std::map<std::string, std::string> values_;
 
 private:
     static std::shared_ptr<DataShareHelper> instance_;
-    std::shared_ptr<DataShareResultSet> resultSet_;
 };
 } // namespace DataShare
 } // namespace OHOS
@@ -35,6 +35,8 @@ public:
     static void TearDownTestCase(void);
     void SetUp();
     void TearDown();
+    static void CheckIndexes(int32_t userId);
+    static FullImeInfo MakeInfo(const std::string &bundleName, uint32_t tokenId);
 };
 
 void FullImeInfoManagerTest::SetUpTestCase(void)
@@ -59,6 +61,35 @@ void FullImeInfoManagerTest::TearDown(void)
     IMSA_HILOGI("FullImeInfoManagerTest::TearDown");
 }
 
+void FullImeInfoManagerTest::CheckIndexes(int32_t userId)
+{
+    auto &manager = FullImeInfoManager::GetInstance();
+    auto it = manager.fullImeInfos_.find(userId);
+    ASSERT_NE(it, manager.fullImeInfos_.end());
+    const auto &userInfos = it->second;
+    ASSERT_EQ(userInfos.bundleIndexes.size(), userInfos.infos.size());
+    ASSERT_EQ(userInfos.tokenIndexes.size(), userInfos.infos.size());
+    for (const auto &info : userInfos.infos) {
+        auto bundleIter = userInfos.bundleIndexes.find(info->prop.name);
+        ASSERT_NE(bundleIter, userInfos.bundleIndexes.end());
+        EXPECT_EQ(bundleIter->second, info);
+        auto tokenIter = userInfos.tokenIndexes.find(info->tokenId);
+        ASSERT_NE(tokenIter, userInfos.tokenIndexes.end());
+        EXPECT_EQ(tokenIter->second, info);
+        EXPECT_EQ(manager.Get(userId, info->tokenId), info->prop.name);
+        EXPECT_EQ(manager.Find(userId, info->prop.name), info);
+        EXPECT_TRUE(manager.Has(userId, info->prop.name));
+    }
+}
+
+FullImeInfo FullImeInfoManagerTest::MakeInfo(const std::string &bundleName, uint32_t tokenId)
+{
+    FullImeInfo info;
+    info.prop.name = bundleName;
+    info.tokenId = tokenId;
+    return info;
+}
+
 /**
  * @tc.name: test_Init_001
  * @tc.desc: test Init that QueryFullImeInfo failed.
@@ -99,8 +130,8 @@ HWTEST_F(FullImeInfoManagerTest, test_Init_002, TestSize.Level0)
     EXPECT_EQ(FullImeInfoManager::GetInstance().fullImeInfos_.size(), 1);
     auto it = FullImeInfoManager::GetInstance().fullImeInfos_.find(userId);
     ASSERT_NE(it, FullImeInfoManager::GetInstance().fullImeInfos_.end());
-    ASSERT_EQ(it->second.size(), 1);
-    auto imeInfo = it->second[0];
+    ASSERT_EQ(it->second.infos.size(), 1);
+    auto imeInfo = *it->second.infos[0];
     EXPECT_EQ(imeInfo.isNewIme, isNewIme);
     EXPECT_EQ(imeInfo.tokenId, tokenId);
     EXPECT_EQ(imeInfo.appId, appId);
@@ -118,7 +149,7 @@ HWTEST_F(FullImeInfoManagerTest, test_Switch_001, TestSize.Level0)
     IMSA_HILOGI("test_Switch_001 start");
     int32_t userId = 100;
     std::vector<FullImeInfo> imeInfos;
-    FullImeInfoManager::GetInstance().fullImeInfos_.insert_or_assign(userId, imeInfos);
+    FullImeInfoManager::GetInstance().SetUser(userId, imeInfos);
     auto ret = FullImeInfoManager::GetInstance().Switch(userId);
     EXPECT_EQ(ret, ErrorCode::NO_ERROR);
 }
@@ -150,7 +181,7 @@ HWTEST_F(FullImeInfoManagerTest, test_Switch_003, TestSize.Level0)
     IMSA_HILOGI("test_Switch_003 start");
     int32_t userId = 100;
     std::vector<FullImeInfo> imeInfos;
-    FullImeInfoManager::GetInstance().fullImeInfos_.insert_or_assign(userId, imeInfos);
+    FullImeInfoManager::GetInstance().SetUser(userId, imeInfos);
 
     bool isNewIme = false;
     uint32_t tokenId = 2;
@@ -173,17 +204,17 @@ HWTEST_F(FullImeInfoManagerTest, test_Switch_003, TestSize.Level0)
     EXPECT_EQ(FullImeInfoManager::GetInstance().fullImeInfos_.size(), 2);
     auto it = FullImeInfoManager::GetInstance().fullImeInfos_.find(userId1);
     ASSERT_NE(it, FullImeInfoManager::GetInstance().fullImeInfos_.end());
-    ASSERT_EQ(it->second.size(), 2);
-    EXPECT_EQ(it->second[0].isNewIme, isNewIme);
-    EXPECT_EQ(it->second[0].tokenId, tokenId);
-    EXPECT_EQ(it->second[0].appId, appId);
-    EXPECT_EQ(it->second[0].versionCode, versionCode);
-    EXPECT_EQ(it->second[0].prop.name, prop.name);
-    EXPECT_EQ(it->second[1].isNewIme, isNewIme);
-    EXPECT_EQ(it->second[1].tokenId, tokenId1);
-    EXPECT_EQ(it->second[1].appId, appId1);
-    EXPECT_EQ(it->second[1].versionCode, versionCode);
-    EXPECT_EQ(it->second[1].prop.name, prop1.name);
+    ASSERT_EQ(it->second.infos.size(), 2);
+    EXPECT_EQ(it->second.infos[0]->isNewIme, isNewIme);
+    EXPECT_EQ(it->second.infos[0]->tokenId, tokenId);
+    EXPECT_EQ(it->second.infos[0]->appId, appId);
+    EXPECT_EQ(it->second.infos[0]->versionCode, versionCode);
+    EXPECT_EQ(it->second.infos[0]->prop.name, prop.name);
+    EXPECT_EQ(it->second.infos[1]->isNewIme, isNewIme);
+    EXPECT_EQ(it->second.infos[1]->tokenId, tokenId1);
+    EXPECT_EQ(it->second.infos[1]->appId, appId1);
+    EXPECT_EQ(it->second.infos[1]->versionCode, versionCode);
+    EXPECT_EQ(it->second.infos[1]->prop.name, prop1.name);
 }
 
 /**
@@ -219,7 +250,7 @@ HWTEST_F(FullImeInfoManagerTest, test_Add_002, TestSize.Level0)
     EXPECT_EQ(FullImeInfoManager::GetInstance().fullImeInfos_.size(), 1);
     auto it = FullImeInfoManager::GetInstance().fullImeInfos_.find(userId);
     ASSERT_NE(it, FullImeInfoManager::GetInstance().fullImeInfos_.end());
-    EXPECT_EQ(it->second.size(), 1);
+    EXPECT_EQ(it->second.infos.size(), 1);
 }
 
 /**
@@ -235,7 +266,7 @@ HWTEST_F(FullImeInfoManagerTest, test_Add_003, TestSize.Level0)
     FullImeInfo imeInfo;
     imeInfo.prop.name = "bundleName";
     imeInfos.push_back(imeInfo);
-    FullImeInfoManager::GetInstance().fullImeInfos_.insert_or_assign(userId, imeInfos);
+    FullImeInfoManager::GetInstance().SetUser(userId, imeInfos);
 
     FullImeInfo imeInfo1;
     imeInfo1.prop.name = "bundleName1";
@@ -247,9 +278,9 @@ HWTEST_F(FullImeInfoManagerTest, test_Add_003, TestSize.Level0)
     EXPECT_EQ(FullImeInfoManager::GetInstance().fullImeInfos_.size(), 1);
     auto it = FullImeInfoManager::GetInstance().fullImeInfos_.find(userId);
     ASSERT_NE(it, FullImeInfoManager::GetInstance().fullImeInfos_.end());
-    ASSERT_EQ(it->second.size(), 2);
-    EXPECT_EQ(it->second[0].prop.name, imeInfo.prop.name);
-    EXPECT_EQ(it->second[1].prop.name, imeInfo1.prop.name);
+    ASSERT_EQ(it->second.infos.size(), 2);
+    EXPECT_EQ(it->second.infos[0]->prop.name, imeInfo.prop.name);
+    EXPECT_EQ(it->second.infos[1]->prop.name, imeInfo1.prop.name);
 }
 
 /**
@@ -266,7 +297,7 @@ HWTEST_F(FullImeInfoManagerTest, test_Add_004, TestSize.Level0)
     imeInfo.isNewIme = true;
     imeInfo.prop.name = "bundleName";
     imeInfos.push_back(imeInfo);
-    FullImeInfoManager::GetInstance().fullImeInfos_.insert_or_assign(userId, imeInfos);
+    FullImeInfoManager::GetInstance().SetUser(userId, imeInfos);
 
     FullImeInfo imeInfo1;
     imeInfo1.isNewIme = false;
@@ -279,8 +310,8 @@ HWTEST_F(FullImeInfoManagerTest, test_Add_004, TestSize.Level0)
     EXPECT_EQ(FullImeInfoManager::GetInstance().fullImeInfos_.size(), 1);
     auto it = FullImeInfoManager::GetInstance().fullImeInfos_.find(userId);
     ASSERT_NE(it, FullImeInfoManager::GetInstance().fullImeInfos_.end());
-    ASSERT_EQ(it->second.size(), 1);
-    EXPECT_FALSE(it->second[0].isNewIme);
+    ASSERT_EQ(it->second.infos.size(), 1);
+    EXPECT_FALSE(it->second.infos[0]->isNewIme);
 }
 
 /**
@@ -293,7 +324,7 @@ HWTEST_F(FullImeInfoManagerTest, test_Update_001, TestSize.Level0)
     IMSA_HILOGI("test_Update_001 start");
     int32_t userId = 100;
     std::vector<FullImeInfo> imeInfos;
-    FullImeInfoManager::GetInstance().fullImeInfos_.insert_or_assign(userId, imeInfos);
+    FullImeInfoManager::GetInstance().SetUser(userId, imeInfos);
 
     std::vector<std::pair<int32_t, std::vector<FullImeInfo>>> fullImeInfos;
     ImeInfoInquirer::GetInstance().SetFullImeInfo(false, fullImeInfos);
@@ -312,7 +343,7 @@ HWTEST_F(FullImeInfoManagerTest, test_Update_002, TestSize.Level0)
     IMSA_HILOGI("test_Update_002 start");
     int32_t userId = 100;
     std::vector<FullImeInfo> imeInfos;
-    FullImeInfoManager::GetInstance().fullImeInfos_.insert_or_assign(userId, imeInfos);
+    FullImeInfoManager::GetInstance().SetUser(userId, imeInfos);
 
     int32_t userId1 = 101;
     std::vector<FullImeInfo> imeInfos1;
@@ -344,7 +375,7 @@ HWTEST_F(FullImeInfoManagerTest, test_Delete_001, TestSize.Level0)
     IMSA_HILOGI("test_Delete_001 start");
     int32_t userId = 100;
     std::vector<FullImeInfo> imeInfos;
-    FullImeInfoManager::GetInstance().fullImeInfos_.insert_or_assign(userId, imeInfos);
+    FullImeInfoManager::GetInstance().SetUser(userId, imeInfos);
 
     int32_t userId1 = 101;
     auto ret = FullImeInfoManager::GetInstance().Delete(userId1);
@@ -364,7 +395,7 @@ HWTEST_F(FullImeInfoManagerTest, test_Delete_002, TestSize.Level0)
     IMSA_HILOGI("test_Delete_002 start");
     int32_t userId = 100;
     std::vector<FullImeInfo> imeInfos;
-    FullImeInfoManager::GetInstance().fullImeInfos_.insert_or_assign(userId, imeInfos);
+    FullImeInfoManager::GetInstance().SetUser(userId, imeInfos);
 
     auto ret = FullImeInfoManager::GetInstance().Delete(userId);
     EXPECT_EQ(ret, ErrorCode::NO_ERROR);
@@ -372,10 +403,10 @@ HWTEST_F(FullImeInfoManagerTest, test_Delete_002, TestSize.Level0)
 
     int32_t userId1 = 101;
     std::vector<FullImeInfo> imeInfos1;
-    FullImeInfoManager::GetInstance().fullImeInfos_.insert_or_assign(userId1, imeInfos1);
+    FullImeInfoManager::GetInstance().SetUser(userId1, imeInfos1);
     int32_t userId2 = 102;
     std::vector<FullImeInfo> imeInfos2;
-    FullImeInfoManager::GetInstance().fullImeInfos_.insert_or_assign(userId2, imeInfos2);
+    FullImeInfoManager::GetInstance().SetUser(userId2, imeInfos2);
     ret = FullImeInfoManager::GetInstance().Delete(userId2);
     EXPECT_EQ(ret, ErrorCode::NO_ERROR);
     EXPECT_EQ(FullImeInfoManager::GetInstance().fullImeInfos_.size(), 1);
@@ -393,7 +424,7 @@ HWTEST_F(FullImeInfoManagerTest, test_Delete_003, TestSize.Level0)
     IMSA_HILOGI("test_Delete_003 start");
     int32_t userId = 100;
     std::vector<FullImeInfo> imeInfos;
-    FullImeInfoManager::GetInstance().fullImeInfos_.insert_or_assign(userId, imeInfos);
+    FullImeInfoManager::GetInstance().SetUser(userId, imeInfos);
 
     int32_t userId1 = 101;
     std::string bundleName = "bundleName";
@@ -417,7 +448,7 @@ HWTEST_F(FullImeInfoManagerTest, test_Delete_004, TestSize.Level0)
     FullImeInfo imeInfo;
     imeInfo.prop.name = "bundleName";
     imeInfos.push_back(imeInfo);
-    FullImeInfoManager::GetInstance().fullImeInfos_.insert_or_assign(userId, imeInfos);
+    FullImeInfoManager::GetInstance().SetUser(userId, imeInfos);
 
     std::string bundleName = "bundleName1";
     auto ret = FullImeInfoManager::GetInstance().Delete(userId, bundleName);
@@ -425,8 +456,8 @@ HWTEST_F(FullImeInfoManagerTest, test_Delete_004, TestSize.Level0)
     EXPECT_EQ(FullImeInfoManager::GetInstance().fullImeInfos_.size(), 1);
     auto it = FullImeInfoManager::GetInstance().fullImeInfos_.find(userId);
     ASSERT_NE(it, FullImeInfoManager::GetInstance().fullImeInfos_.end());
-    ASSERT_EQ(it->second.size(), 1);
-    EXPECT_EQ(it->second[0].prop.name, imeInfo.prop.name);
+    ASSERT_EQ(it->second.infos.size(), 1);
+    EXPECT_EQ(it->second.infos[0]->prop.name, imeInfo.prop.name);
 }
 
 /**
@@ -445,7 +476,7 @@ HWTEST_F(FullImeInfoManagerTest, test_Delete_005, TestSize.Level0)
     FullImeInfo imeInfo1;
     imeInfo1.prop.name = "bundleName1";
     imeInfos.push_back(imeInfo1);
-    FullImeInfoManager::GetInstance().fullImeInfos_.insert_or_assign(userId, imeInfos);
+    FullImeInfoManager::GetInstance().SetUser(userId, imeInfos);
 
     std::string bundleName1 = "bundleName1";
     auto ret = FullImeInfoManager::GetInstance().Delete(userId, bundleName1);
@@ -453,8 +484,8 @@ HWTEST_F(FullImeInfoManagerTest, test_Delete_005, TestSize.Level0)
     EXPECT_EQ(FullImeInfoManager::GetInstance().fullImeInfos_.size(), 1);
     auto it = FullImeInfoManager::GetInstance().fullImeInfos_.find(userId);
     ASSERT_NE(it, FullImeInfoManager::GetInstance().fullImeInfos_.end());
-    ASSERT_EQ(it->second.size(), 1);
-    EXPECT_EQ(it->second[0].prop.name, imeInfo.prop.name);
+    ASSERT_EQ(it->second.infos.size(), 1);
+    EXPECT_EQ(it->second.infos[0]->prop.name, imeInfo.prop.name);
 
     std::string bundleName = "bundleName";
     ret = FullImeInfoManager::GetInstance().Delete(userId, bundleName);
@@ -474,7 +505,7 @@ HWTEST_F(FullImeInfoManagerTest, test_Get_001, TestSize.Level0)
     std::vector<FullImeInfo> imeInfos;
     FullImeInfo info;
     imeInfos.push_back(info);
-    FullImeInfoManager::GetInstance().fullImeInfos_.insert_or_assign(userId, imeInfos);
+    FullImeInfoManager::GetInstance().SetUser(userId, imeInfos);
 
     int32_t userId1 = 101;
     std::vector<Property> props;
@@ -495,7 +526,7 @@ HWTEST_F(FullImeInfoManagerTest, test_Get_002, TestSize.Level0)
     std::vector<FullImeInfo> imeInfos;
     FullImeInfo info;
     imeInfos.push_back(info);
-    FullImeInfoManager::GetInstance().fullImeInfos_.insert_or_assign(userId, imeInfos);
+    FullImeInfoManager::GetInstance().SetUser(userId, imeInfos);
     std::vector<Property> props;
     auto ret = FullImeInfoManager::GetInstance().Get(userId, props);
     EXPECT_EQ(ret, ErrorCode::NO_ERROR);
@@ -512,7 +543,7 @@ HWTEST_F(FullImeInfoManagerTest, test_Get_003, TestSize.Level0)
     IMSA_HILOGI("test_Get_003 start");
     int32_t userId = 100;
     std::vector<FullImeInfo> imeInfos;
-    FullImeInfoManager::GetInstance().fullImeInfos_.insert_or_assign(userId, imeInfos);
+    FullImeInfoManager::GetInstance().SetUser(userId, imeInfos);
 
     int32_t userId1 = 101;
     std::string bundleName = "bundleName";
@@ -534,7 +565,7 @@ HWTEST_F(FullImeInfoManagerTest, test_Get_004, TestSize.Level0)
     FullImeInfo info;
     info.prop.name = "bundleName1";
     imeInfos.push_back(info);
-    FullImeInfoManager::GetInstance().fullImeInfos_.insert_or_assign(userId, imeInfos);
+    FullImeInfoManager::GetInstance().SetUser(userId, imeInfos);
 
     int32_t userId1 = 100;
     std::string bundleName = "bundleName";
@@ -556,7 +587,7 @@ HWTEST_F(FullImeInfoManagerTest, test_Get_005, TestSize.Level0)
     FullImeInfo info;
     info.prop.name = "bundleName1";
     imeInfos.push_back(info);
-    FullImeInfoManager::GetInstance().fullImeInfos_.insert_or_assign(userId, imeInfos);
+    FullImeInfoManager::GetInstance().SetUser(userId, imeInfos);
 
     int32_t userId1 = 100;
     std::string bundleName = "bundleName1";
@@ -565,5 +596,45 @@ HWTEST_F(FullImeInfoManagerTest, test_Get_005, TestSize.Level0)
     EXPECT_TRUE(ret);
     EXPECT_EQ(infoRet.prop.name, info.prop.name);
 }
+
+/**
+ * @tc.name: test_Index_001
+ * @tc.desc: the bundleName and tokenId indexes follow the package add, delete and update events
+ * @tc.type: FUNC
+ */
+HWTEST_F(FullImeInfoManagerTest, test_Index_001, TestSize.Level0)
+{
+    IMSA_HILOGI("test_Index_001 start");
+    int32_t userId = 100;
+    int32_t otherUserId = 101;
+    auto &manager = FullImeInfoManager::GetInstance();
+    manager.SetUser(userId, { MakeInfo("bundleName", 1), MakeInfo("bundleName1", 2) });
+    manager.SetUser(otherUserId, { MakeInfo("bundleName", 1) });
+    auto otherInfo = manager.Find(otherUserId, "bundleName");
+    ASSERT_NE(otherInfo, nullptr);
+    CheckIndexes(userId);
+
+    ImeInfoInquirer::GetInstance().SetFullImeInfo(true, MakeInfo("bundleName2", 3));
+    EXPECT_EQ(manager.Add(userId, "bundleName2"), ErrorCode::NO_ERROR);
+    CheckIndexes(userId);
+    EXPECT_EQ(manager.Get(userId, 3), "bundleName2");
+
+    // the token changes when the package is updated
+    ImeInfoInquirer::GetInstance().SetFullImeInfo(true, MakeInfo("bundleName1", 4));
+    EXPECT_EQ(manager.Update(userId, "bundleName1"), ErrorCode::NO_ERROR);
+    CheckIndexes(userId);
+    EXPECT_EQ(manager.Get(userId, 2), "");
+    EXPECT_EQ(manager.Get(userId, 4), "bundleName1");
+
+    EXPECT_EQ(manager.Delete(userId, "bundleName"), ErrorCode::NO_ERROR);
+    CheckIndexes(userId);
+    EXPECT_FALSE(manager.Has(userId, "bundleName"));
+    EXPECT_EQ(manager.Get(userId, 1), "");
+
+    // other users are not touched
+    EXPECT_EQ(manager.Find(otherUserId, "bundleName"), otherInfo);
+    EXPECT_EQ(manager.Get(otherUserId, 1), "bundleName");
+    CheckIndexes(otherUserId);
+}
 } // namespace MiscServices
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
@@ -650,7 +650,7 @@ HWTEST_F(IdentityCheckerTest, testSwitchInputMethod_001, TestSize.Level1)
     ImeEnabledInfo enabledInfo{ CURRENT_BUNDLENAME, CURRENT_EXTNAME, EnabledStatus::BASIC_MODE };
     enabledInfo.extraInfo.isDefaultIme = true;
     cfg.enabledInfos.push_back(enabledInfo);
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.insert_or_assign(MAIN_USER_ID, cfg);
+    ImeEnabledInfoManager::GetInstance().SetEnabledCache(MAIN_USER_ID, cfg);
     service_->identityChecker_ = identityCheckerImpl_;
     int32_t ret = IdentityCheckerTest::service_->SwitchInputMethod(
         CURRENT_BUNDLENAME, CURRENT_SUBNAME, static_cast<uint32_t>(SwitchTrigger::CURRENT_IME));
@@ -671,7 +671,7 @@ HWTEST_F(IdentityCheckerTest, testSwitchInputMethod_003, TestSize.Level1)
     ImeEnabledInfo enabledInfo{ CURRENT_BUNDLENAME, CURRENT_EXTNAME, EnabledStatus::BASIC_MODE };
     enabledInfo.extraInfo.isDefaultIme = true;
     cfg.enabledInfos.push_back(enabledInfo);
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.insert_or_assign(MAIN_USER_ID, cfg);
+    ImeEnabledInfoManager::GetInstance().SetEnabledCache(MAIN_USER_ID, cfg);
     IdentityCheckerTest::IdentityCheckerMock::hasPermission_ = true;
     IdentityCheckerTest::IdentityCheckerMock::isBundleNameValid_ = false;
     int32_t ret = IdentityCheckerTest::service_->SwitchInputMethod(
@@ -693,7 +693,7 @@ HWTEST_F(IdentityCheckerTest, testSwitchInputMethod_004, TestSize.Level1)
     ImeEnabledInfo enabledInfo{ CURRENT_BUNDLENAME, CURRENT_EXTNAME, EnabledStatus::BASIC_MODE };
     enabledInfo.extraInfo.isDefaultIme = true;
     cfg.enabledInfos.push_back(enabledInfo);
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.insert_or_assign(MAIN_USER_ID, cfg);
+    ImeEnabledInfoManager::GetInstance().SetEnabledCache(MAIN_USER_ID, cfg);
     service_->identityChecker_ = identityCheckerImpl_;
     IdentityCheckerTest::IdentityCheckerMock::isFromShell_ = true;
     IdentityCheckerTest::IdentityCheckerMock::isBundleNameValid_ = false;
@@ -20,6 +20,11 @@
 #undef private
 
 #include <gtest/gtest.h>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <random>
+#include <thread>
 
 #include "ability_manager_client.h"
 #include "global.h"
@@ -30,6 +35,7 @@
 #include "input_method_engine_listener_impl.h"
 #include "input_method_types.h"
 #include "keyboard_listener_test_impl.h"
+#include "message_parcel.h"
 #include "scope_utils.h"
 #include "tdd_util.h"
 #include "text_listener.h"
@@ -429,18 +435,18 @@ HWTEST_F(ImaTextEditTest, ImaTextEditTest_SendFunctionKey, TestSize.Level0)
 }
 
 /**
- * @tc.name: ImaTextEditTest_ClearRspHandlers
+ * @tc.name: ImaTextEditTest_CancelAllPending
  * @tc.desc:
  * @tc.type: FUNC
  */
-HWTEST_F(ImaTextEditTest, ImaTextEditTest_ClearRspHandlers, TestSize.Level0)
+HWTEST_F(ImaTextEditTest, ImaTextEditTest_CancelAllPending, TestSize.Level0)
 {
-    IMSA_HILOGI("ImeProxyTest::ImaTextEditTest_ClearRspHandlers");
+    IMSA_HILOGI("ImeProxyTest::ImaTextEditTest_CancelAllPending");
     auto channelProxy = std::make_shared<InputDataChannelProxy>(nullptr);
     auto channelWrap = std::make_shared<InputDataChannelProxyWrap>(channelProxy, nullptr);
     auto delayTask = [&channelWrap]() {
         usleep(100000);
-        channelWrap->ClearRspHandlers();
+        channelWrap->CancelAllPending();
     };
     std::thread delayThread(delayTask);
 
@@ -517,8 +523,8 @@ HWTEST_F(ImaTextEditTest, ImaTextEditTest_HandleMsg, TestSize.Level0)
     std::shared_ptr<ResponseHandler> handler = nullptr;
     handler = channelWrap->AddRspHandler(nullptr, false, 0);
     ASSERT_NE(handler, nullptr);
-    std::lock_guard<std::mutex> lock(channelWrap->rspMutex_);
     EXPECT_EQ(channelWrap->HandleMsg(handler->msgId, rspInfo), ErrorCode::NO_ERROR);
+    EXPECT_FALSE(channelWrap->rspHandlers_.Contains(handler->msgId));
 }
 
 /**
@@ -537,5 +543,470 @@ HWTEST_F(ImaTextEditTest, ImaTextEditTest_Report, TestSize.Level0)
     channelWrap->ReportBaseTextOperation(1, ErrorCode::ERROR_NULL_POINTER, 1);
     channelWrap->ReportBaseTextOperation(1, ErrorCode::NO_ERROR, REPORT_TIMEOUT);
 }
+
+/**
+ * @tc.name: ImaTextEditTest_CommitEdit_Order
+ * @tc.desc: operations between BeginEdit and CommitEdit are applied in order
+ * @tc.type: FUNC
+ */
+HWTEST_F(ImaTextEditTest, ImaTextEditTest_CommitEdit_Order, TestSize.Level0)
+{
+    IMSA_HILOGI("ImeProxyTest::ImaTextEditTest_CommitEdit_Order");
+    const std::string replaceText = "XYZ";
+    EXPECT_EQ(InputMethodAbility::GetInstance().BeginEdit(), ErrorCode::NO_ERROR);
+    EXPECT_EQ(InputMethodAbility::GetInstance().InsertText(INSERT_TEXT), ErrorCode::NO_ERROR);
+    EXPECT_EQ(InputMethodAbility::GetInstance().DeleteForward(GET_LENGTH), ErrorCode::NO_ERROR);
+    EXPECT_EQ(InputMethodAbility::GetInstance().InsertText(replaceText, CommonRsp), ErrorCode::NO_ERROR);
+    // nothing is sent before commit
+    EXPECT_FALSE(KeyboardListenerTestImpl::WaitTextChange(INSERT_TEXT));
+
+    auto ret = InputMethodAbility::GetInstance().CommitEdit();
+    EXPECT_EQ(ret, ErrorCode::NO_ERROR);
+    EXPECT_TRUE(WaitCommonRsp());
+    finalText_ = INSERT_TEXT.substr(0, INSERT_TEXT.size() - GET_LENGTH) + replaceText;
+    EXPECT_TRUE(KeyboardListenerTestImpl::WaitTextChange(finalText_));
+
+    std::u16string text;
+    ret = InputMethodAbility::GetInstance().GetTextBeforeCursor(replaceText.size(), text);
+    EXPECT_EQ(ret, ErrorCode::NO_ERROR);
+    EXPECT_EQ(Str16ToStr8(text), replaceText);
+}
+
+/**
+ * @tc.name: ImaTextEditTest_CommitEdit_Atomic
+ * @tc.desc: an edit batch with an invalid operation is rejected as a whole
+ * @tc.type: FUNC
+ */
+HWTEST_F(ImaTextEditTest, ImaTextEditTest_CommitEdit_Atomic, TestSize.Level0)
+{
+    IMSA_HILOGI("ImeProxyTest::ImaTextEditTest_CommitEdit_Atomic");
+    EXPECT_EQ(InputMethodAbility::GetInstance().BeginEdit(), ErrorCode::NO_ERROR);
+    EXPECT_EQ(InputMethodAbility::GetInstance().InsertText(INSERT_TEXT), ErrorCode::NO_ERROR);
+    EXPECT_EQ(InputMethodAbility::GetInstance().DeleteBackward(-1), ErrorCode::NO_ERROR);
+    auto ret = InputMethodAbility::GetInstance().CommitEdit();
+    EXPECT_EQ(ret, ErrorCode::ERROR_PARAMETER_CHECK_FAILED);
+    EXPECT_FALSE(KeyboardListenerTestImpl::WaitTextChange(INSERT_TEXT));
+
+    int32_t index = -1;
+    ret = InputMethodAbility::GetInstance().GetTextIndexAtCursor(index);
+    EXPECT_EQ(ret, ErrorCode::NO_ERROR);
+    EXPECT_EQ(index, 0);
+}
+
+/**
+ * @tc.name: ImaTextEditTest_CommitEdit_State
+ * @tc.desc: BeginEdit/CommitEdit/AbortEdit state check
+ * @tc.type: FUNC
+ */
+HWTEST_F(ImaTextEditTest, ImaTextEditTest_CommitEdit_State, TestSize.Level0)
+{
+    IMSA_HILOGI("ImeProxyTest::ImaTextEditTest_CommitEdit_State");
+    EXPECT_EQ(InputMethodAbility::GetInstance().CommitEdit(), ErrorCode::ERROR_IMA_PRECONDITION_REQUIRED);
+    EXPECT_EQ(InputMethodAbility::GetInstance().BeginEdit(), ErrorCode::NO_ERROR);
+    EXPECT_EQ(InputMethodAbility::GetInstance().BeginEdit(), ErrorCode::ERROR_IMA_PRECONDITION_REQUIRED);
+    // empty batch
+    EXPECT_EQ(InputMethodAbility::GetInstance().CommitEdit(CommonRsp), ErrorCode::NO_ERROR);
+    EXPECT_TRUE(WaitCommonRsp());
+
+    ResetParams();
+    EXPECT_EQ(InputMethodAbility::GetInstance().BeginEdit(), ErrorCode::NO_ERROR);
+    EXPECT_EQ(InputMethodAbility::GetInstance().InsertText(INSERT_TEXT, CommonRsp), ErrorCode::NO_ERROR);
+    EXPECT_EQ(InputMethodAbility::GetInstance().AbortEdit(), ErrorCode::NO_ERROR);
+    EXPECT_FALSE(WaitCommonRsp());
+    EXPECT_EQ(dealRet_, ErrorCode::ERROR_IMA_DATA_CHANNEL_ABNORMAL);
+    EXPECT_EQ(InputMethodAbility::GetInstance().CommitEdit(), ErrorCode::ERROR_IMA_PRECONDITION_REQUIRED);
+
+    EXPECT_EQ(InputMethodAbility::GetInstance().BeginEdit(), ErrorCode::NO_ERROR);
+    for (size_t i = 0; i < MAX_EDIT_BATCH_OPERATION_COUNT; ++i) {
+        EXPECT_EQ(InputMethodAbility::GetInstance().MoveCursor(DIRECTION), ErrorCode::NO_ERROR);
+    }
+    EXPECT_EQ(InputMethodAbility::GetInstance().MoveCursor(DIRECTION), ErrorCode::ERROR_PARAMETER_CHECK_FAILED);
+    EXPECT_EQ(InputMethodAbility::GetInstance().AbortEdit(), ErrorCode::NO_ERROR);
+}
+
+/**
+ * @tc.name: ImaTextEditTest_EditBatchInner
+ * @tc.desc: EditBatchInner keeps the order of operations through parcel
+ * @tc.type: FUNC
+ */
+HWTEST_F(ImaTextEditTest, ImaTextEditTest_EditBatchInner, TestSize.Level0)
+{
+    IMSA_HILOGI("ImeProxyTest::ImaTextEditTest_EditBatchInner");
+    EditBatchInner batch;
+    EditOperation deleteOperation;
+    deleteOperation.type = EditOperationType::DELETE_FORWARD;
+    deleteOperation.length = DEL_LENGTH;
+    EditOperation insertOperation;
+    insertOperation.type = EditOperationType::INSERT_TEXT;
+    insertOperation.text = INSERT_TEXT;
+    EditOperation moveOperation;
+    moveOperation.type = EditOperationType::MOVE_CURSOR;
+    moveOperation.direction = DIRECTION;
+    EditOperation selectOperation;
+    selectOperation.type = EditOperationType::SELECT_BY_RANGE;
+    selectOperation.range = { LEFT_INDEX, RIGHT_INDEX };
+    batch.operations = { deleteOperation, insertOperation, moveOperation, selectOperation };
+    EXPECT_TRUE(EditBatchInner::IsValid(batch.operations));
+
+    MessageParcel parcel;
+    EXPECT_TRUE(batch.Marshalling(parcel));
+    std::unique_ptr<EditBatchInner> result(EditBatchInner::Unmarshalling(parcel));
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(result->operations, batch.operations);
+
+    EXPECT_FALSE(EditBatchInner::IsValid({}));
+    selectOperation.range = { -1, RIGHT_INDEX };
+    EXPECT_FALSE(EditBatchInner::IsValid({ insertOperation, selectOperation }));
+    EditOperation invalidOperation;
+    EXPECT_FALSE(EditBatchInner::IsValid({ invalidOperation }));
+}
+
+/**
+ * @tc.name: ImaTextEditTest_EditBatch_Report
+ * @tc.desc: the response of a batch is reported with the event code of every batched operation
+ * @tc.type: FUNC
+ */
+HWTEST_F(ImaTextEditTest, ImaTextEditTest_EditBatch_Report, TestSize.Level0)
+{
+    IMSA_HILOGI("ImeProxyTest::ImaTextEditTest_EditBatch_Report");
+    EditBatchInner batch;
+    EditOperation insertOperation;
+    insertOperation.type = EditOperationType::INSERT_TEXT;
+    insertOperation.text = INSERT_TEXT;
+    EditOperation deleteOperation;
+    deleteOperation.type = EditOperationType::DELETE_BACKWARD;
+    deleteOperation.length = DEL_LENGTH;
+    EditOperation selectOperation;
+    selectOperation.type = EditOperationType::SELECT_BY_RANGE;
+    selectOperation.range = { LEFT_INDEX, RIGHT_INDEX };
+    batch.operations = { insertOperation, deleteOperation, insertOperation, selectOperation };
+    std::vector<int32_t> eventCodes = { static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_INSERT_TEXT),
+        static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_DELETE_BACKWARD),
+        static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_INSERT_TEXT),
+        static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_SELECT_BY_RANGE) };
+    EXPECT_EQ(InputDataChannelProxyWrap::GetBatchEventCodes(batch), eventCodes);
+
+    auto channelProxy = std::make_shared<InputDataChannelProxy>(nullptr);
+    auto channelWrap = std::make_shared<InputDataChannelProxyWrap>(channelProxy, nullptr);
+    int32_t resultCode = ErrorCode::ERROR_NULL_POINTER;
+    auto handler = channelWrap->AddRspHandler([&resultCode](int32_t code, const ResponseData &data) {
+        resultCode = code;
+    }, false, static_cast<int32_t>(IInputDataChannelIpcCode::COMMAND_COMMIT_EDIT_BATCH));
+    ASSERT_NE(handler, nullptr);
+    handler->batchEventCodes = eventCodes;
+    ResponseInfo rspInfo = { ErrorCode::NO_ERROR, std::monostate{} };
+    EXPECT_EQ(channelWrap->HandleResponse(handler->msgId, rspInfo), ErrorCode::NO_ERROR);
+    EXPECT_EQ(resultCode, ErrorCode::NO_ERROR);
+    EXPECT_FALSE(channelWrap->rspHandlers_.Contains(handler->msgId));
+}
+
+/**
+ * @tc.name: ImaTextEditTest_TextDelta_Random
+ * @tc.desc: random edits applied as text deltas through parcel keep the mirror equal to the editor text
+ * @tc.type: FUNC
+ */
+HWTEST_F(ImaTextEditTest, ImaTextEditTest_TextDelta_Random, TestSize.Level0)
+{
+    IMSA_HILOGI("ImeProxyTest::ImaTextEditTest_TextDelta_Random");
+    constexpr int32_t editCount = 500;
+    constexpr size_t maxInsertLength = 5;
+    const std::u16string alphabet = u"ab\u4f60\U0001F600 ";
+    std::mt19937 gen(0);
+    std::u16string text;
+    uint64_t version = 1;
+    TextMirror mirror;
+    std::u16string mirrorText;
+    EXPECT_TRUE(mirror.Apply(TextDeltaInner::FullText(text, version), mirrorText));
+    for (int32_t i = 0; i < editCount; ++i) {
+        std::u16string newText = text;
+        size_t pos = newText.empty() ? 0 : gen() % (newText.size() + 1);
+        size_t removeLength = newText.empty() ? 0 : gen() % (newText.size() - pos + 1);
+        std::u16string insert;
+        size_t insertLength = gen() % maxInsertLength;
+        for (size_t j = 0; j < insertLength; ++j) {
+            insert.push_back(alphabet[gen() % alphabet.size()]);
+        }
+        newText.replace(pos, removeLength, insert);
+        auto delta = TextDeltaInner::Diff(text, newText);
+        delta.baseVersion = version;
+        delta.version = ++version;
+
+        MessageParcel parcel;
+        ASSERT_TRUE(delta.Marshalling(parcel));
+        std::unique_ptr<TextDeltaInner> result(TextDeltaInner::Unmarshalling(parcel));
+        ASSERT_NE(result, nullptr);
+        ASSERT_TRUE(mirror.Apply(*result, mirrorText));
+        ASSERT_EQ(mirrorText, newText);
+        text = newText;
+    }
+    EXPECT_EQ(mirror.GetVersion(), version);
+}
+
+/**
+ * @tc.name: ImaTextEditTest_TextDelta_VersionMismatch
+ * @tc.desc: delta with unexpected base version is rejected and a full text recovers the mirror
+ * @tc.type: FUNC
+ */
+HWTEST_F(ImaTextEditTest, ImaTextEditTest_TextDelta_VersionMismatch, TestSize.Level0)
+{
+    IMSA_HILOGI("ImeProxyTest::ImaTextEditTest_TextDelta_VersionMismatch");
+    TextMirror mirror;
+    std::u16string text;
+    EXPECT_TRUE(mirror.Apply(TextDeltaInner::FullText(u"hello", 1), text));
+    auto delta = TextDeltaInner::Diff(u"hello world", u"hello there");
+    delta.baseVersion = 2;
+    delta.version = 3;
+    EXPECT_FALSE(mirror.Apply(delta, text));
+    EXPECT_EQ(mirror.GetText(), u"hello");
+
+    TextDeltaInner outOfRange;
+    outOfRange.baseVersion = 1;
+    outOfRange.version = 2;
+    outOfRange.offset = 10;
+    EXPECT_FALSE(mirror.Apply(outOfRange, text));
+    EXPECT_EQ(mirror.GetVersion(), 0u);
+
+    EXPECT_TRUE(mirror.Apply(TextDeltaInner::FullText(u"hello there", 3), text));
+    EXPECT_EQ(text, u"hello there");
+    EXPECT_FALSE(mirror.Apply(delta, text));
+}
+
+/**
+ * @tc.name: ImaTextEditTest_ResponseTimeout
+ * @tc.desc: sync request without response times out, its handler is removed and the late response is dropped
+ * @tc.type: FUNC
+ */
+HWTEST_F(ImaTextEditTest, ImaTextEditTest_ResponseTimeout, TestSize.Level0)
+{
+    constexpr uint32_t SHORT_TIMEOUT = 100; // unit ms
+    IMSA_HILOGI("ImeProxyTest::ImaTextEditTest_ResponseTimeout");
+    auto channelProxy = std::make_shared<InputDataChannelProxy>(nullptr);
+    auto channelWrap = std::make_shared<InputDataChannelProxyWrap>(channelProxy, nullptr);
+    auto handler = channelWrap->AddRspHandler(nullptr, true, 0, SHORT_TIMEOUT);
+    ASSERT_NE(handler, nullptr);
+    auto start = std::chrono::steady_clock::now();
+    auto ret = channelWrap->WaitResponse(handler, nullptr);
+    auto cost = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    EXPECT_EQ(ret, ErrorCode::ERROR_IMA_RESPONSE_TIMEOUT);
+    EXPECT_GE(cost.count(), static_cast<int64_t>(SHORT_TIMEOUT));
+    EXPECT_FALSE(channelWrap->rspHandlers_.Contains(handler->msgId));
+
+    ResponseInfo rspInfo = { ErrorCode::NO_ERROR, std::monostate{} };
+    EXPECT_EQ(channelWrap->HandleResponse(handler->msgId, rspInfo), ErrorCode::NO_ERROR);
+    EXPECT_EQ(channelWrap->rspHandlers_.Size(), 0u);
+}
+
+
+/**
+ * @tc.name: ImaTextEditTest_ResponseSlot_Generation
+ * @tc.desc: a slot reused by a newer request does not match the msgId of the evicted one
+ * @tc.type: FUNC
+ */
+HWTEST_F(ImaTextEditTest, ImaTextEditTest_ResponseSlot_Generation, TestSize.Level0)
+{
+    IMSA_HILOGI("ImeProxyTest::ImaTextEditTest_ResponseSlot_Generation");
+    ResponseSlotTable table;
+    std::shared_ptr<ResponseHandler> evicted = nullptr;
+    auto first = std::make_shared<ResponseHandler>(1, false, nullptr, 0);
+    table.Insert(first, evicted);
+    EXPECT_EQ(evicted, nullptr);
+    auto second = std::make_shared<ResponseHandler>(1 + ResponseSlotTable::CAPACITY, false, nullptr, 0);
+    table.Insert(second, evicted);
+    EXPECT_EQ(evicted, first);
+    EXPECT_EQ(table.Take(first->msgId), nullptr);
+    EXPECT_TRUE(table.Contains(second->msgId));
+    EXPECT_EQ(table.Take(second->msgId), second);
+    EXPECT_EQ(table.Take(second->msgId), nullptr);
+    EXPECT_EQ(table.Size(), 0u);
+}
+
+/**
+ * @tc.name: ImaTextEditTest_ResponseSlot_Contention
+ * @tc.desc: requester threads add handlers while responder threads answer them, compare the slot table with a
+ *           mutex guarded map, every request completes once with its own response
+ * @tc.type: PERF
+ */
+HWTEST_F(ImaTextEditTest, ImaTextEditTest_ResponseSlot_Contention, TestSize.Level1)
+{
+    constexpr int32_t THREAD_NUM = 4;
+    constexpr int32_t ROUNDS = 20000;
+    constexpr int32_t WINDOW = 64; // unanswered requests of one requester
+    constexpr int32_t TOTAL = THREAD_NUM * ROUNDS;
+    IMSA_HILOGI("ImeProxyTest::ImaTextEditTest_ResponseSlot_Contention");
+    using Request = std::function<uint64_t(const AsyncIpcCallBack &)>;
+    using Respond = std::function<void(uint64_t, const ResponseInfo &)>;
+    struct Result {
+        int64_t cost = 0;
+        int32_t answered = 0;
+        int32_t evicted = 0;
+        int32_t mismatched = 0;
+        int32_t lost = 0;
+        int32_t repeated = 0;
+    };
+    auto run = [](const Request &request, const Respond &respond) {
+        std::vector<std::atomic<uint64_t>> issued(TOTAL);
+        std::vector<std::atomic<int32_t>> completed(TOTAL);
+        std::vector<std::atomic<int32_t>> outstanding(THREAD_NUM);
+        std::atomic<int32_t> answered{ 0 };
+        std::atomic<int32_t> evicted{ 0 };
+        std::atomic<int32_t> mismatched{ 0 };
+        std::mutex queueMutex;
+        std::condition_variable queueCv;
+        std::deque<uint64_t> queue;
+        bool isDone = false;
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> responders;
+        for (int32_t i = 0; i < THREAD_NUM; ++i) {
+            responders.emplace_back([&]() {
+                while (true) {
+                    std::unique_lock<std::mutex> lock(queueMutex);
+                    queueCv.wait(lock, [&]() { return isDone || !queue.empty(); });
+                    if (queue.empty()) {
+                        return;
+                    }
+                    auto msgId = queue.front();
+                    queue.pop_front();
+                    lock.unlock();
+                    respond(msgId, { ErrorCode::NO_ERROR, std::to_string(msgId) });
+                }
+            });
+        }
+        std::vector<std::thread> requesters;
+        for (int32_t i = 0; i < THREAD_NUM; ++i) {
+            requesters.emplace_back([&, i]() {
+                for (int32_t j = 0; j < ROUNDS; ++j) {
+                    while (outstanding[i].load() >= WINDOW) {
+                        std::this_thread::yield();
+                    }
+                    int32_t tag = i * ROUNDS + j;
+                    outstanding[i]++;
+                    auto msgId = request([&, i, tag](int32_t code, const ResponseData &data) {
+                        completed[tag]++;
+                        if (code == ErrorCode::ERROR_IMA_DATA_CHANNEL_ABNORMAL) {
+                            evicted++;
+                        } else if (std::get_if<std::string>(&data) != nullptr &&
+                                   std::get<std::string>(data) == std::to_string(issued[tag].load())) {
+                            answered++;
+                        } else {
+                            mismatched++;
+                        }
+                        outstanding[i]--;
+                    });
+                    issued[tag] = msgId;
+                    {
+                        std::lock_guard<std::mutex> lock(queueMutex);
+                        queue.push_back(msgId);
+                    }
+                    queueCv.notify_one();
+                }
+            });
+        }
+        for (auto &thread : requesters) {
+            thread.join();
+        }
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            isDone = true;
+        }
+        queueCv.notify_all();
+        for (auto &thread : responders) {
+            thread.join();
+        }
+        Result result;
+        result.cost =
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        result.answered = answered.load();
+        result.evicted = evicted.load();
+        result.mismatched = mismatched.load();
+        for (const auto &count : completed) {
+            result.lost += count.load() == 0 ? 1 : 0;
+            result.repeated += count.load() > 1 ? 1 : 0;
+        }
+        return result;
+    };
+
+    std::mutex mapMutex;
+    std::map<uint64_t, std::shared_ptr<ResponseHandler>> map;
+    uint64_t mapMsgId = 0;
+    auto mapResult = run(
+        [&](const AsyncIpcCallBack &callback) {
+            std::lock_guard<std::mutex> lock(mapMutex);
+            auto msgId = ++mapMsgId;
+            map.insert({ msgId, std::make_shared<ResponseHandler>(msgId, false, callback, 0) });
+            return msgId;
+        },
+        [&](uint64_t msgId, const ResponseInfo &rspInfo) {
+            std::shared_ptr<ResponseHandler> handler = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(mapMutex);
+                auto it = map.find(msgId);
+                if (it == map.end()) {
+                    return;
+                }
+                handler = it->second;
+                map.erase(it);
+            }
+            handler->asyncCallback(rspInfo.dealRet_, rspInfo.data_);
+        });
+
+    auto channelWrap = std::make_shared<InputDataChannelProxyWrap>(nullptr, nullptr);
+    auto slotResult = run(
+        [&](const AsyncIpcCallBack &callback) { return channelWrap->AddRspHandler(callback, false, 0)->msgId; },
+        [&](uint64_t msgId, const ResponseInfo &rspInfo) { channelWrap->HandleResponse(msgId, rspInfo); });
+
+    EXPECT_EQ(mapResult.answered, TOTAL);
+    EXPECT_EQ(mapResult.mismatched, 0);
+    EXPECT_EQ(mapResult.lost, 0);
+    EXPECT_EQ(mapResult.repeated, 0);
+    // a request may only be evicted by a newer one using the same slot, it is then completed with an error
+    EXPECT_EQ(slotResult.answered + slotResult.evicted, TOTAL);
+    EXPECT_EQ(slotResult.mismatched, 0);
+    EXPECT_EQ(slotResult.lost, 0);
+    EXPECT_EQ(slotResult.repeated, 0);
+    EXPECT_EQ(channelWrap->rspHandlers_.Size(), 0u);
+    IMSA_HILOGI("map: %{public}lld us, slot table: %{public}lld us, evicted: %{public}d.",
+        static_cast<long long>(mapResult.cost), static_cast<long long>(slotResult.cost), slotResult.evicted);
+}
+
+/**
+ * @tc.name: ImaTextEditTest_ToUtf8Callback
+ * @tc.desc: the callback of the legacy utf-8 variants receives the utf-16 response as utf-8
+ * @tc.type: FUNC
+ */
+HWTEST_F(ImaTextEditTest, ImaTextEditTest_ToUtf8Callback, TestSize.Level0)
+{
+    IMSA_HILOGI("ImeProxyTest::ImaTextEditTest_ToUtf8Callback");
+    EXPECT_EQ(InputDataChannelProxyWrap::ToUtf8Callback(nullptr), nullptr);
+    std::string result;
+    int32_t resultCode = ErrorCode::ERROR_NULL_POINTER;
+    auto callback = InputDataChannelProxyWrap::ToUtf8Callback([&](int32_t code, const ResponseData &data) {
+        resultCode = code;
+        VariantUtil::GetValue(data, result);
+    });
+    ASSERT_NE(callback, nullptr);
+    callback(ErrorCode::NO_ERROR, std::u16string(u"a\u4f60"));
+    EXPECT_EQ(resultCode, ErrorCode::NO_ERROR);
+    EXPECT_EQ(result, "a\xe4\xbd\xa0");
+}
+
+/**
+ * @tc.name: ImaTextEditTest_ResponseDataU16
+ * @tc.desc: utf-16 response data survives the parcel unchanged
+ * @tc.type: FUNC
+ */
+HWTEST_F(ImaTextEditTest, ImaTextEditTest_ResponseDataU16, TestSize.Level0)
+{
+    IMSA_HILOGI("ImeProxyTest::ImaTextEditTest_ResponseDataU16");
+    const std::u16string text = u"a你\U0001F600";
+    MessageParcel parcel;
+    ResponseDataInner rsp;
+    rsp.rspData = text;
+    ASSERT_TRUE(rsp.Marshalling(parcel));
+    std::unique_ptr<ResponseDataInner> received(ResponseDataInner::Unmarshalling(parcel));
+    ASSERT_NE(received, nullptr);
+    ASSERT_TRUE(std::holds_alternative<std::u16string>(received->rspData));
+    EXPECT_EQ(std::get<std::u16string>(received->rspData), text);
+}
+
 } // namespace MiscServices
 } // namespace OHOS
@@ -24,8 +24,10 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <atomic>
 #include <condition_variable>
 #include <map>
+#include <thread>
 
 #include "file_operator.h"
 #include "ime_info_inquirer.h"
@@ -106,6 +108,8 @@ public:
     void SetUp();
     void TearDown();
     static bool WaitDataShareCallback(const std::map<int32_t, ImeEnabledCfg> &enabledCfg);
+    static void SetEnabledCache(const std::map<int32_t, ImeEnabledCfg> &enabledCfg);
+    static std::map<int32_t, ImeEnabledCfg> GetEnabledCache();
     static std::map<int32_t, std::vector<FullImeInfo>> GenerateFullImeInfos(
         const std::map<int32_t, std::vector<std::string>> &easyInfos);
     static std::vector<FullImeInfo> GenerateFullImeInfos(const std::vector<std::string> &imeKeys);
@@ -192,7 +196,7 @@ void ImeEnabledInfoManagerTest::SetUp()
     TddUtil::DeleteUserTable(currentUserId_, ENABLE_IME);
     ModImePersistCfg("");
     enabledCfg_.clear();
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.clear();
+    SetEnabledCache({});
     EnableUpgradeManager::GetInstance().upgradedUserId_.clear();
 }
 
@@ -203,7 +207,7 @@ void ImeEnabledInfoManagerTest::TearDown()
     TddUtil::DeleteUserTable(currentUserId_, ENABLE_IME);
     ModImePersistCfg("");
     enabledCfg_.clear();
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.clear();
+    SetEnabledCache({});
     EnableUpgradeManager::GetInstance().upgradedUserId_.clear();
 }
 
@@ -227,7 +231,7 @@ bool ImeEnabledInfoManagerTest::WaitDataShareCallback(const std::map<int32_t, Im
 {
     std::unique_lock<std::mutex> lock(dataShareCbCvMutex_);
     dataShareCbCv_.wait_for(lock, std::chrono::milliseconds(WAIT_DATA_SHARE_CB_TIMEOUT), [&enabledCfg]() {
-        return enabledCfg == enabledCfg_ && enabledCfg_ == ImeEnabledInfoManager::GetInstance().imeEnabledCfg_;
+        return enabledCfg == enabledCfg_ && enabledCfg_ == GetEnabledCache();
     });
     for (const auto &cfg : enabledCfg) {
         IMSA_HILOGI("enabledCfg base info:[%{public}d, %{public}s].", cfg.first, cfg.second.version.c_str());
@@ -243,7 +247,7 @@ bool ImeEnabledInfoManagerTest::WaitDataShareCallback(const std::map<int32_t, Im
                 info.extensionName.c_str(), info.enabledStatus);
         }
     }
-    for (const auto &cfg : ImeEnabledInfoManager::GetInstance().imeEnabledCfg_) {
+    for (const auto &cfg : GetEnabledCache()) {
         IMSA_HILOGI("cache base info:[%{public}d, %{public}s].", cfg.first, cfg.second.version.c_str());
         for (const auto &info : cfg.second.enabledInfos) {
             IMSA_HILOGI("cache info:[%{public}s,%{public}s,%{public}d].", info.bundleName.c_str(),
@@ -253,10 +257,28 @@ bool ImeEnabledInfoManagerTest::WaitDataShareCallback(const std::map<int32_t, Im
     if (enabledCfg != enabledCfg_) {
         IMSA_HILOGI("enabledCfg not same enabledCfg_.");
     }
-    if (ImeEnabledInfoManager::GetInstance().imeEnabledCfg_ != enabledCfg) {
-        IMSA_HILOGI("enabledCfg not same ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.");
+    if (GetEnabledCache() != enabledCfg) {
+        IMSA_HILOGI("enabledCfg not same cache.");
     }
-    return enabledCfg == enabledCfg_ && enabledCfg_ == ImeEnabledInfoManager::GetInstance().imeEnabledCfg_;
+    return enabledCfg == enabledCfg_ && enabledCfg_ == GetEnabledCache();
+}
+
+void ImeEnabledInfoManagerTest::SetEnabledCache(const std::map<int32_t, ImeEnabledCfg> &enabledCfg)
+{
+    ImeEnabledInfoManager::GetInstance().ClearEnabledCache();
+    for (const auto &cfg : enabledCfg) {
+        ImeEnabledInfoManager::GetInstance().SetEnabledCache(cfg.first, cfg.second);
+    }
+}
+
+std::map<int32_t, ImeEnabledCfg> ImeEnabledInfoManagerTest::GetEnabledCache()
+{
+    std::map<int32_t, ImeEnabledCfg> enabledCfg;
+    auto snapshots = std::atomic_load(&ImeEnabledInfoManager::GetInstance().imeEnabledCfg_);
+    for (const auto &snapshot : *snapshots) {
+        enabledCfg.insert_or_assign(snapshot.first, snapshot.second->cfg);
+    }
+    return enabledCfg;
 }
 
 std::map<int32_t, std::vector<FullImeInfo>> ImeEnabledInfoManagerTest::GenerateFullImeInfos(
@@ -962,8 +984,7 @@ HWTEST_F(ImeEnabledInfoManagerTest, testUserAdd_001, TestSize.Level0)
     easyEnabledInfos.insert({ ImeEnabledInfoManagerTest::currentUserId_,
         { { ImeEnabledInfoManagerTest::SYS_IME_KEY, EnabledStatus::BASIC_MODE, true },
             { ImeEnabledInfoManagerTest::IME_KEY2, EnabledStatus::BASIC_MODE } } });
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_ =
-        ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos);
+    ImeEnabledInfoManagerTest::SetEnabledCache(ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos));
 
     std::vector<std::string> imeKeys = {
         ImeEnabledInfoManagerTest::SYS_IME_KEY,
@@ -972,7 +993,7 @@ HWTEST_F(ImeEnabledInfoManagerTest, testUserAdd_001, TestSize.Level0)
     auto imeInfos = ImeEnabledInfoManagerTest::GenerateFullImeInfos(imeKeys);
     auto ret = ImeEnabledInfoManager::GetInstance().Switch(ImeEnabledInfoManagerTest::currentUserId_, imeInfos);
     EXPECT_EQ(ret, ErrorCode::NO_ERROR);
-    EXPECT_FALSE(ImeEnabledInfoManagerTest::WaitDataShareCallback(ImeEnabledInfoManager::GetInstance().imeEnabledCfg_));
+    EXPECT_FALSE(ImeEnabledInfoManagerTest::WaitDataShareCallback(GetEnabledCache()));
     EXPECT_TRUE(ImeEnabledInfoManagerTest::enabledCfg_.empty());
 }
 
@@ -991,12 +1012,11 @@ HWTEST_F(ImeEnabledInfoManagerTest, testUserDelete_001, TestSize.Level0)
     easyEnabledInfos.insert({ ImeEnabledInfoManagerTest::currentUserId_,
         { { ImeEnabledInfoManagerTest::SYS_IME_KEY, EnabledStatus::BASIC_MODE, true },
             { ImeEnabledInfoManagerTest::IME_KEY2, EnabledStatus::BASIC_MODE } } });
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_ =
-        ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos);
-    EXPECT_FALSE(ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.empty());
+    ImeEnabledInfoManagerTest::SetEnabledCache(ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos));
+    EXPECT_FALSE(ImeEnabledInfoManagerTest::GetEnabledCache().empty());
     auto ret = ImeEnabledInfoManager::GetInstance().Delete(ImeEnabledInfoManagerTest::currentUserId_);
     EXPECT_EQ(ret, ErrorCode::NO_ERROR);
-    EXPECT_TRUE(ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.empty());
+    EXPECT_TRUE(ImeEnabledInfoManagerTest::GetEnabledCache().empty());
 }
 
 /**
@@ -1014,8 +1034,7 @@ HWTEST_F(ImeEnabledInfoManagerTest, testBundleAdd_001, TestSize.Level0)
     std::map<int32_t, std::vector<ImeEasyInfo>> easyEnabledInfos;
     easyEnabledInfos.insert({ ImeEnabledInfoManagerTest::currentUserId_,
         { { ImeEnabledInfoManagerTest::SYS_IME_KEY, EnabledStatus::BASIC_MODE, true } } });
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_ =
-        ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos);
+    ImeEnabledInfoManagerTest::SetEnabledCache(ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos));
     auto imeInfo = ImeEnabledInfoManagerTest::GenerateFullImeInfo(ImeEnabledInfoManagerTest::IME_KEY2);
     auto ret = ImeEnabledInfoManager::GetInstance().Add(ImeEnabledInfoManagerTest::currentUserId_, imeInfo);
     EXPECT_EQ(ret, ErrorCode::NO_ERROR);
@@ -1054,8 +1073,7 @@ HWTEST_F(ImeEnabledInfoManagerTest, testBundleAdd_002, TestSize.Level0)
     easyEnabledInfos.insert({ ImeEnabledInfoManagerTest::currentUserId_,
         { { ImeEnabledInfoManagerTest::SYS_IME_KEY, EnabledStatus::BASIC_MODE, true },
             { ImeEnabledInfoManagerTest::IME_KEY2, EnabledStatus::FULL_EXPERIENCE_MODE } } });
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_ =
-        ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos);
+    ImeEnabledInfoManagerTest::SetEnabledCache(ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos));
     auto imeInfo = ImeEnabledInfoManagerTest::GenerateFullImeInfo(ImeEnabledInfoManagerTest::IME_KEY2);
     auto ret = ImeEnabledInfoManager::GetInstance().Add(ImeEnabledInfoManagerTest::currentUserId_, imeInfo);
     EXPECT_EQ(ret, ErrorCode::NO_ERROR);
@@ -1081,8 +1099,7 @@ HWTEST_F(ImeEnabledInfoManagerTest, testBundleAdd_003, TestSize.Level0)
         { { ImeEnabledInfoManagerTest::SYS_IME_KEY, EnabledStatus::BASIC_MODE, true },
             { std::string(ImeEnabledInfoManagerTest::IME_KEY2) + "/" + "noExtName",
                 EnabledStatus::FULL_EXPERIENCE_MODE } } });
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_ =
-        ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos);
+    ImeEnabledInfoManagerTest::SetEnabledCache(ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos));
     auto imeInfo = ImeEnabledInfoManagerTest::GenerateFullImeInfo(ImeEnabledInfoManagerTest::IME_KEY2);
     auto ret = ImeEnabledInfoManager::GetInstance().Add(ImeEnabledInfoManagerTest::currentUserId_, imeInfo);
     EXPECT_EQ(ret, ErrorCode::NO_ERROR);
@@ -1109,8 +1126,7 @@ HWTEST_F(ImeEnabledInfoManagerTest, testBundleDelete_001, TestSize.Level0)
     easyEnabledInfos.insert({ ImeEnabledInfoManagerTest::currentUserId_,
         { { ImeEnabledInfoManagerTest::SYS_IME_KEY, EnabledStatus::BASIC_MODE },
             { ImeEnabledInfoManagerTest::IME_KEY2, EnabledStatus::BASIC_MODE, true } } });
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_ =
-        ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos);
+    ImeEnabledInfoManagerTest::SetEnabledCache(ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos));
 
     auto ret = ImeEnabledInfoManager::GetInstance().Delete(
         ImeEnabledInfoManagerTest::currentUserId_, ImeEnabledInfoManagerTest::BUNDLE_NAME2);
@@ -1138,8 +1154,7 @@ HWTEST_F(ImeEnabledInfoManagerTest, testBundleDelete_002, TestSize.Level0)
     easyEnabledInfos.insert({ ImeEnabledInfoManagerTest::currentUserId_,
         { { ImeEnabledInfoManagerTest::SYS_IME_KEY, EnabledStatus::BASIC_MODE, true },
             { ImeEnabledInfoManagerTest::IME_KEY2, EnabledStatus::BASIC_MODE } } });
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_ =
-        ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos);
+    ImeEnabledInfoManagerTest::SetEnabledCache(ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos));
 
     auto ret = ImeEnabledInfoManager::GetInstance().Delete(
         ImeEnabledInfoManagerTest::currentUserId_, ImeEnabledInfoManagerTest::BUNDLE_NAME2);
@@ -1162,8 +1177,7 @@ HWTEST_F(ImeEnabledInfoManagerTest, testBundleEnabledStatusUpdate_001, TestSize.
     std::map<int32_t, std::vector<ImeEasyInfo>> easyEnabledInfos;
     easyEnabledInfos.insert({ ImeEnabledInfoManagerTest::currentUserId_,
         { { ImeEnabledInfoManagerTest::IME_KEY3, EnabledStatus::BASIC_MODE } } });
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_ =
-        ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos);
+    ImeEnabledInfoManagerTest::SetEnabledCache(ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos));
 
     auto ret = ImeEnabledInfoManager::GetInstance().Update(ImeEnabledInfoManagerTest::currentUserId_,
         BUNDLE_NAME3, EXT_NAME3, EnabledStatus::FULL_EXPERIENCE_MODE);
@@ -1206,8 +1220,7 @@ HWTEST_F(ImeEnabledInfoManagerTest, testBundleEnabledStatusUpdate_003, TestSize.
     std::map<int32_t, std::vector<ImeEasyInfo>> easyEnabledInfos;
     easyEnabledInfos.insert({ ImeEnabledInfoManagerTest::currentUserId_,
         { { ImeEnabledInfoManagerTest::IME_KEY3, EnabledStatus::BASIC_MODE } } });
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_ =
-        ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos);
+    ImeEnabledInfoManagerTest::SetEnabledCache(ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos));
 
     auto ret = ImeEnabledInfoManager::GetInstance().Update(ImeEnabledInfoManagerTest::currentUserId_,
         BUNDLE_NAME3, EXT_NAME3, EnabledStatus::BASIC_MODE);
@@ -1235,8 +1248,7 @@ HWTEST_F(ImeEnabledInfoManagerTest, testBundleEnabledStatusUpdate_004, TestSize.
     std::map<int32_t, std::vector<ImeEasyInfo>> easyEnabledInfos;
     easyEnabledInfos.insert({ ImeEnabledInfoManagerTest::currentUserId_,
         { { ImeEnabledInfoManagerTest::SYS_IME_KEY, EnabledStatus::BASIC_MODE } } });
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_ =
-        ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos);
+    ImeEnabledInfoManagerTest::SetEnabledCache(ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos));
 
     auto ret = ImeEnabledInfoManager::GetInstance().Update(ImeEnabledInfoManagerTest::currentUserId_,
         ImeEnabledInfoManagerTest::sysImeProp_.bundleName, "error", EnabledStatus::BASIC_MODE);
@@ -1257,8 +1269,7 @@ HWTEST_F(ImeEnabledInfoManagerTest, testSetCurrentIme_001, TestSize.Level0)
     easyEnabledInfos.insert({ ImeEnabledInfoManagerTest::currentUserId_,
         { { ImeEnabledInfoManagerTest::SYS_IME_KEY, EnabledStatus::BASIC_MODE, true },
             { ImeEnabledInfoManagerTest::IME_KEY2, EnabledStatus::BASIC_MODE } } });
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_ =
-        ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos);
+    ImeEnabledInfoManagerTest::SetEnabledCache(ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos));
 
     auto ret = ImeEnabledInfoManager::GetInstance().SetCurrentIme(ImeEnabledInfoManagerTest::currentUserId_,
         std::string(ImeEnabledInfoManagerTest::BUNDLE_NAME2) + "/" + ImeEnabledInfoManagerTest::EXT_NAME2,
@@ -1288,8 +1299,7 @@ HWTEST_F(ImeEnabledInfoManagerTest, testSetCurrentIme_002, TestSize.Level0)
         { { ImeEnabledInfoManagerTest::SYS_IME_KEY, EnabledStatus::BASIC_MODE, false, false, true },
             { ImeEnabledInfoManagerTest::IME_KEY2, EnabledStatus::BASIC_MODE, true, true, false,
                 ImeEnabledInfoManagerTest::CUR_SUBNAME2 } } });
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_ =
-        ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos);
+    ImeEnabledInfoManagerTest::SetEnabledCache(ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos));
 
     auto ret = ImeEnabledInfoManager::GetInstance().SetCurrentIme(ImeEnabledInfoManagerTest::currentUserId_,
         std::string(ImeEnabledInfoManagerTest::BUNDLE_NAME2) + "/" + ImeEnabledInfoManagerTest::EXT_NAME2,
@@ -1320,8 +1330,7 @@ HWTEST_F(ImeEnabledInfoManagerTest, testSetTmpIme_001, TestSize.Level0)
         { { ImeEnabledInfoManagerTest::SYS_IME_KEY, EnabledStatus::BASIC_MODE, false, false, true },
             { ImeEnabledInfoManagerTest::IME_KEY2, EnabledStatus::BASIC_MODE, true, true, false,
                 ImeEnabledInfoManagerTest::CUR_SUBNAME2 } } });
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_ =
-        ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos);
+    ImeEnabledInfoManagerTest::SetEnabledCache(ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos));
 
     auto ret = ImeEnabledInfoManager::GetInstance().SetTmpIme(
         ImeEnabledInfoManagerTest::currentUserId_, std::string(ImeEnabledInfoManagerTest::sysImeProp_.bundleName) + "/"
@@ -1347,8 +1356,7 @@ HWTEST_F(ImeEnabledInfoManagerTest, testSetTmpIme_002, TestSize.Level0)
         { { ImeEnabledInfoManagerTest::SYS_IME_KEY, EnabledStatus::BASIC_MODE },
             { ImeEnabledInfoManagerTest::IME_KEY2, EnabledStatus::BASIC_MODE, true, true, false,
                 ImeEnabledInfoManagerTest::CUR_SUBNAME2 } } });
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_ =
-        ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos);
+    ImeEnabledInfoManagerTest::SetEnabledCache(ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos));
 
     auto ret = ImeEnabledInfoManager::GetInstance().SetTmpIme(ImeEnabledInfoManagerTest::currentUserId_, "");
     EXPECT_EQ(ret, ErrorCode::NO_ERROR);
@@ -1371,8 +1379,7 @@ HWTEST_F(ImeEnabledInfoManagerTest, testSetTmpIme_003, TestSize.Level0)
         { { ImeEnabledInfoManagerTest::SYS_IME_KEY, EnabledStatus::BASIC_MODE, false, false, true },
             { ImeEnabledInfoManagerTest::IME_KEY2, EnabledStatus::BASIC_MODE, true, true, false,
                 ImeEnabledInfoManagerTest::CUR_SUBNAME2 } } });
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_ =
-        ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos);
+    ImeEnabledInfoManagerTest::SetEnabledCache(ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos));
 
     auto ret = ImeEnabledInfoManager::GetInstance().SetTmpIme(ImeEnabledInfoManagerTest::currentUserId_, "");
     EXPECT_EQ(ret, ErrorCode::NO_ERROR);
@@ -1399,8 +1406,7 @@ HWTEST_F(ImeEnabledInfoManagerTest, testSetTmpIme_004, TestSize.Level0)
         { { ImeEnabledInfoManagerTest::SYS_IME_KEY, EnabledStatus::BASIC_MODE },
             { ImeEnabledInfoManagerTest::IME_KEY2, EnabledStatus::BASIC_MODE, true, true, false,
                 ImeEnabledInfoManagerTest::CUR_SUBNAME2 } } });
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_ =
-        ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos);
+    ImeEnabledInfoManagerTest::SetEnabledCache(ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos));
 
     auto ret = ImeEnabledInfoManager::GetInstance().SetTmpIme(
         ImeEnabledInfoManagerTest::currentUserId_, std::string(ImeEnabledInfoManagerTest::sysImeProp_.bundleName) + "/"
@@ -1429,8 +1435,7 @@ HWTEST_F(ImeEnabledInfoManagerTest, testGetCurrentImeCfg_001, TestSize.Level0)
         { { ImeEnabledInfoManagerTest::SYS_IME_KEY, EnabledStatus::BASIC_MODE, false, false, true },
             { ImeEnabledInfoManagerTest::IME_KEY2, EnabledStatus::BASIC_MODE, true, true, false,
                 ImeEnabledInfoManagerTest::CUR_SUBNAME2 } } });
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_ =
-        ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos);
+    ImeEnabledInfoManagerTest::SetEnabledCache(ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos));
     auto currentIme = ImeEnabledInfoManager::GetInstance().GetCurrentImeCfg(ImeEnabledInfoManagerTest::currentUserId_);
     ASSERT_NE(currentIme, nullptr);
     EXPECT_EQ(currentIme->bundleName, ImeEnabledInfoManagerTest::sysImeProp_.bundleName);
@@ -1452,8 +1457,7 @@ HWTEST_F(ImeEnabledInfoManagerTest, testGetCurrentImeCfg_002, TestSize.Level0)
         { { ImeEnabledInfoManagerTest::SYS_IME_KEY, EnabledStatus::BASIC_MODE },
             { ImeEnabledInfoManagerTest::IME_KEY2, EnabledStatus::BASIC_MODE, true, true, false,
                 ImeEnabledInfoManagerTest::CUR_SUBNAME2 } } });
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_ =
-        ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos);
+    ImeEnabledInfoManagerTest::SetEnabledCache(ImeEnabledInfoManagerTest::GenerateAllEnabledCfg(easyEnabledInfos));
     auto currentIme = ImeEnabledInfoManager::GetInstance().GetCurrentImeCfg(ImeEnabledInfoManagerTest::currentUserId_);
     ASSERT_NE(currentIme, nullptr);
     EXPECT_EQ(currentIme->bundleName, ImeEnabledInfoManagerTest::BUNDLE_NAME2);
@@ -1462,5 +1466,84 @@ HWTEST_F(ImeEnabledInfoManagerTest, testGetCurrentImeCfg_002, TestSize.Level0)
     EXPECT_EQ(currentIme->imeId,
         std::string(ImeEnabledInfoManagerTest::BUNDLE_NAME2) + "/" + ImeEnabledInfoManagerTest::EXT_NAME2);
 }
+
+/**
+ * @tc.name: testSnapshot_001
+ * @tc.desc: test:snapshot indexes and current ime match the linear search of the cfg
+ * @tc.require:
+ */
+HWTEST_F(ImeEnabledInfoManagerTest, testSnapshot_001, TestSize.Level0)
+{
+    IMSA_HILOGI("ImeEnabledInfoManagerTest testSnapshot_001 START");
+    ImeEnabledCfg cfg;
+    cfg.enabledInfos.emplace_back(BUNDLE_NAME1, EXT_NAME1, EnabledStatus::BASIC_MODE);
+    cfg.enabledInfos.emplace_back(BUNDLE_NAME2, EXT_NAME2, EnabledStatus::FULL_EXPERIENCE_MODE);
+    cfg.enabledInfos.back().extraInfo.isDefaultIme = true;
+    cfg.enabledInfos.back().extraInfo.isDefaultImeSet = true;
+    cfg.enabledInfos.back().extraInfo.currentSubName = CUR_SUBNAME2;
+    auto snapshot = ImeEnabledSnapshot::Create(cfg);
+    ASSERT_NE(snapshot, nullptr);
+    auto info = snapshot->FindByBundleName(BUNDLE_NAME2);
+    ASSERT_NE(info, nullptr);
+    EXPECT_EQ(info->enabledStatus, EnabledStatus::FULL_EXPERIENCE_MODE);
+    EXPECT_NE(snapshot->FindByImeId(std::string(BUNDLE_NAME1) + "/" + EXT_NAME1), nullptr);
+    EXPECT_EQ(snapshot->FindByImeId(std::string(BUNDLE_NAME1) + "/" + EXT_NAME2), nullptr);
+    EXPECT_EQ(snapshot->FindByBundleName(BUNDLE_NAME3), nullptr);
+    EXPECT_EQ(snapshot->currentIme.imeId, std::string(BUNDLE_NAME2) + "/" + EXT_NAME2);
+    EXPECT_EQ(snapshot->currentIme.subName, CUR_SUBNAME2);
+    EXPECT_TRUE(snapshot->isDefaultImeSet);
+
+    cfg.enabledInfos.front().extraInfo.isTmpIme = true;
+    snapshot = ImeEnabledSnapshot::Create(cfg);
+    ASSERT_NE(snapshot, nullptr);
+    EXPECT_EQ(snapshot->currentIme.bundleName, BUNDLE_NAME1);
+    EXPECT_TRUE(snapshot->currentIme.subName.empty());
+}
+
+/**
+ * @tc.name: testConcurrentRead_001
+ * @tc.desc: test:readers always see a whole snapshot while the cache is being replaced
+ * @tc.require:
+ */
+HWTEST_F(ImeEnabledInfoManagerTest, testConcurrentRead_001, TestSize.Level0)
+{
+    IMSA_HILOGI("ImeEnabledInfoManagerTest testConcurrentRead_001 START");
+    constexpr int32_t readerNum = 8;
+    constexpr int32_t writeNum = 1000;
+    ImeEnabledCfg basicCfg;
+    basicCfg.enabledInfos.emplace_back(BUNDLE_NAME1, EXT_NAME1, EnabledStatus::BASIC_MODE);
+    basicCfg.enabledInfos.back().extraInfo.isDefaultIme = true;
+    ImeEnabledCfg fullCfg;
+    fullCfg.enabledInfos.emplace_back(BUNDLE_NAME1, EXT_NAME1, EnabledStatus::FULL_EXPERIENCE_MODE);
+    fullCfg.enabledInfos.back().extraInfo.isDefaultIme = true;
+    fullCfg.enabledInfos.back().extraInfo.isDefaultImeSet = true;
+    auto &manager = ImeEnabledInfoManager::GetInstance();
+    manager.SetEnabledCache(currentUserId_, basicCfg);
+
+    std::atomic<bool> isDone{ false };
+    std::atomic<int32_t> errorNum{ 0 };
+    std::vector<std::thread> readers;
+    for (int32_t i = 0; i < readerNum; ++i) {
+        readers.emplace_back([&manager, &isDone, &errorNum]() {
+            while (!isDone.load()) {
+                auto snapshot = manager.GetSnapshot(currentUserId_);
+                auto info = snapshot == nullptr ? nullptr : snapshot->FindByBundleName(BUNDLE_NAME1);
+                // status and default flag are written together, a reader never sees half of an update
+                if (info == nullptr ||
+                    (info->enabledStatus == EnabledStatus::FULL_EXPERIENCE_MODE) != snapshot->isDefaultImeSet) {
+                    errorNum++;
+                }
+            }
+        });
+    }
+    for (int32_t i = 0; i < writeNum; ++i) {
+        manager.SetEnabledCache(currentUserId_, i % 2 == 0 ? fullCfg : basicCfg);
+    }
+    isDone.store(true);
+    for (auto &reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(errorNum.load(), 0);
+}
 } // namespace MiscServices
 } // namespace OHOS
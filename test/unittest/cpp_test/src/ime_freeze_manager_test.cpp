@@ -29,6 +29,7 @@ namespace OHOS {
 namespace MiscServices {
 constexpr int32_t TASK_NUM = 100;
 constexpr int32_t IPC_COST_TIME = 5000;
+constexpr int32_t FREEZE_DELAY_TIME = 3500000; // longer than the 3s freeze delay
 class ImeFreezeManagerTest : public testing::Test {
 public:
     static void SetUpTestCase(void)
@@ -322,5 +323,39 @@ HWTEST_F(ImeFreezeManagerTest, TemporaryActiveImeTest_001, TestSize.Level1)
     ImeFreezeManagerTest::freezeManager_->TemporaryActiveIme();
     EXPECT_TRUE(ImeFreezeManagerTest::freezeManager_->isFrozen_);
 }
+
+/**
+ * @tc.name: KeepWarm_001
+ * @tc.desc: a warm ime stays thawed and is only frozen by the delayed freeze
+ * @tc.type: FUNC
+ */
+HWTEST_F(ImeFreezeManagerTest, KeepWarm_001, TestSize.Level1)
+{
+    IMSA_HILOGI("ImeFreezeManagerTest::KeepWarm_001");
+    ASSERT_NE(ImeFreezeManagerTest::freezeManager_, nullptr);
+    ClearState();
+    ImeFreezeManagerTest::freezeManager_->KeepWarm();
+    EXPECT_FALSE(ImeFreezeManagerTest::freezeManager_->isFrozen_);
+    usleep(FREEZE_DELAY_TIME);
+    EXPECT_TRUE(ImeFreezeManagerTest::freezeManager_->isFrozen_);
+}
+
+/**
+ * @tc.name: KeepWarm_002
+ * @tc.desc: the delayed freeze of a warm ime gives up once an editor uses the ime
+ * @tc.type: FUNC
+ */
+HWTEST_F(ImeFreezeManagerTest, KeepWarm_002, TestSize.Level1)
+{
+    IMSA_HILOGI("ImeFreezeManagerTest::KeepWarm_002");
+    ASSERT_NE(ImeFreezeManagerTest::freezeManager_, nullptr);
+    ClearState();
+    ImeFreezeManagerTest::freezeManager_->KeepWarm();
+    ImeFreezeManagerTest::freezeManager_->BeforeIpc(RequestType::START_INPUT);
+    ImeFreezeManagerTest::freezeManager_->AfterIpc(RequestType::START_INPUT, true);
+    usleep(FREEZE_DELAY_TIME);
+    EXPECT_TRUE(ImeFreezeManagerTest::freezeManager_->isImeInUse_);
+    EXPECT_FALSE(ImeFreezeManagerTest::freezeManager_->isFrozen_);
+}
 } // namespace MiscServices
 } // namespace OHOS
\ No newline at end of file
@@ -17,6 +17,7 @@
 #define protected public
 #include "ima_hisysevent_reporter.h"
 #include "imc_hisysevent_reporter.h"
+#include "imf_hisysevent_histogram.h"
 #include "imf_hisysevent_info.h"
 #include "imf_hisysevent_reporter.h"
 #include "imf_hisysevent_util.h"
@@ -30,8 +31,10 @@
 
 #include <condition_variable>
 #include <cstdint>
+#include <map>
 #include <sstream>
 #include <string>
+#include <thread>
 
 #include "global.h"
 #include "hisysevent_base_manager.h"
@@ -240,6 +243,17 @@ private:
     };
 };
 
+// drops the ima statistics recorded so far, returns whether there were any
+static bool ClearImaStatistics()
+{
+    ImeStartInputAllInfo imeStartInputInfo(ImfHiSysEventReporter::COUNT_STATISTICS_INTERVAL_NUM,
+        ImfHiSysEventReporter::COUNT_STATISTICS_INTERVAL_NUM, ImaHiSysEventReporter::IME_CB_TIME_INTERVAL.size());
+    BaseTextOperationAllInfo baseTextOperationInfo(ImaHiSysEventReporter::BASE_TEXT_OPERATION_TIME_INTERVAL.size(),
+        ImfHiSysEventReporter::COUNT_STATISTICS_INTERVAL_NUM);
+    ImaHiSysEventReporter::GetInstance().CollectStatistics(imeStartInputInfo, baseTextOperationInfo);
+    return !imeStartInputInfo.appNames.empty() || !baseTextOperationInfo.appNames.empty();
+}
+
 void ImfHiSysEventReporterTest::SetUpTestCase(void)
 {
     IMSA_HILOGI("ImfHiSysEventReporterTest::SetUpTestCase");
@@ -264,12 +278,7 @@ void ImfHiSysEventReporterTest::SetUp(void)
         ImfHiSysEventReporter::COUNT_STATISTICS_INTERVAL_NUM, ImfHiSysEventReporter::COUNT_STATISTICS_INTERVAL_NUM);
     ImsaHiSysEventReporter::GetInstance().clientShowInfo_ = ClientShowAllInfo(
         ImfHiSysEventReporter::COUNT_STATISTICS_INTERVAL_NUM, ImfHiSysEventReporter::COUNT_STATISTICS_INTERVAL_NUM);
-    ImaHiSysEventReporter::GetInstance().imeStartInputAllInfo_ =
-        ImeStartInputAllInfo(ImfHiSysEventReporter::COUNT_STATISTICS_INTERVAL_NUM,
-            ImfHiSysEventReporter::COUNT_STATISTICS_INTERVAL_NUM, ImaHiSysEventReporter::IME_CB_TIME_INTERVAL.size());
-    ImaHiSysEventReporter::GetInstance().baseTextOperationAllInfo_ =
-        BaseTextOperationAllInfo(ImaHiSysEventReporter::BASE_TEXT_OPERATION_TIME_INTERVAL.size(),
-            ImfHiSysEventReporter::COUNT_STATISTICS_INTERVAL_NUM);
+    ClearImaStatistics();
 }
 
 void ImfHiSysEventReporterTest::TearDown(void)
@@ -936,7 +945,7 @@ HWTEST_F(ImfHiSysEventReporterTest, ImeStartInputStatistic_011, TestSize.Level1)
     statistics.cbTimeConsume.timeConsumeStatistics = "0/1/0/0/0/0";
     ImaHiSysEventReporter::GetInstance().TimerCallback();
     EXPECT_TRUE(ImfHiSysEventReporterTest::WaitImeStartInputStatistic(statistics));
-    EXPECT_TRUE(ImaHiSysEventReporter::GetInstance().imeStartInputAllInfo_.appNames.empty());
+    EXPECT_FALSE(ClearImaStatistics());
 }
 
 /**
@@ -991,7 +1000,7 @@ HWTEST_F(ImfHiSysEventReporterTest, BaseTextOperationStatistic_012, TestSize.Lev
     statistics.failedInfo.info[failedIndex] = { failedStr };
     ImaHiSysEventReporter::GetInstance().TimerCallback();
     EXPECT_TRUE(ImfHiSysEventReporterTest::WaitBaseTextOperatorStatistic(statistics));
-    EXPECT_TRUE(ImaHiSysEventReporter::GetInstance().baseTextOperationAllInfo_.appNames.empty());
+    EXPECT_FALSE(ClearImaStatistics());
 }
 
 /**
@@ -1008,5 +1017,77 @@ HWTEST_F(ImfHiSysEventReporterTest, StatisticsEventConcurrentTest_013, TestSize.
     GTEST_RUN_TASK(TestStatisticsEventConcurrent);
     EXPECT_EQ(multiThreadExecTotalNum_, THREAD_NUM * EACH_THREAD_CIRCULATION_TIME);
 }
+/**
+ * @tc.name: HistogramRecord_014
+ * @tc.desc: the records of many threads are all counted, in the right key and bucket
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(ImfHiSysEventReporterTest, HistogramRecord_014, TestSize.Level1)
+{
+    IMSA_HILOGI("HistogramRecord_014");
+    constexpr uint32_t bucketNum = 4;
+    constexpr uint32_t keyNum = 8;
+    constexpr uint32_t threadNum = 4;
+    constexpr uint32_t recordNum = 10000;
+    ImfHiSysEventHistogram histogram(bucketNum);
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < threadNum; ++i) {
+        threads.emplace_back([&histogram]() {
+            for (uint32_t j = 0; j < recordNum; ++j) {
+                histogram.Record(j % keyNum, j % (bucketNum + 1));
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_FALSE(histogram.Record(ImfHiSysEventHistogram::MAX_KEY + 1, 0));
+
+    std::map<std::pair<uint64_t, uint32_t>, uint32_t> counts;
+    uint64_t total = 0;
+    auto droppedNum = histogram.Collect([&counts, &total](uint64_t key, uint32_t bucket, uint32_t count) {
+        counts[{ key, bucket }] += count;
+        total += count;
+    });
+    EXPECT_EQ(droppedNum, 1);
+    EXPECT_EQ(total, threadNum * recordNum);
+    // every key gets the same number of records in each of the buckets 0 to 4, bucket 4 is counted in the last one
+    auto firstNum = counts[std::make_pair(0, 0)];
+    auto lastNum = counts[std::make_pair(0, bucketNum - 1)];
+    EXPECT_EQ(firstNum, threadNum * recordNum / keyNum / (bucketNum + 1));
+    EXPECT_EQ(lastNum, 2 * firstNum);
+    EXPECT_EQ(counts.count(std::make_pair(0, bucketNum)), 0);
+
+    total = 0;
+    droppedNum = histogram.Collect([&total](uint64_t, uint32_t, uint32_t count) { total += count; });
+    EXPECT_EQ(total, 0);
+    EXPECT_EQ(droppedNum, 0);
+}
+
+/**
+ * @tc.name: HistogramRecord_015
+ * @tc.desc: a key beyond the capacity of the table is dropped, the keys in it are still counted
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(ImfHiSysEventReporterTest, HistogramRecord_015, TestSize.Level1)
+{
+    IMSA_HILOGI("HistogramRecord_015");
+    constexpr uint32_t slotNum = 4;
+    ImfHiSysEventHistogram histogram(1, slotNum);
+    for (uint32_t i = 0; i < slotNum; ++i) {
+        EXPECT_TRUE(histogram.Record(i, 0));
+    }
+    EXPECT_FALSE(histogram.Record(slotNum, 0));
+    EXPECT_TRUE(histogram.Record(0, 0));
+    uint32_t keyNum = 0;
+    auto droppedNum = histogram.Collect([&keyNum](uint64_t, uint32_t, uint32_t) { ++keyNum; });
+    EXPECT_EQ(keyNum, slotNum);
+    EXPECT_EQ(droppedNum, 1);
+    EXPECT_EQ(ImfHiSysEventHistogram::GetIntervalIndex(ImaHiSysEventReporter::IME_CB_TIME_INTERVAL, 40), 1);
+    EXPECT_EQ(ImfHiSysEventHistogram::GetIntervalIndex(ImaHiSysEventReporter::IME_CB_TIME_INTERVAL, 5000),
+        ImaHiSysEventReporter::IME_CB_TIME_INTERVAL.size() - 1);
+}
 } // namespace MiscServices
 } // namespace OHOS
@@ -30,6 +30,7 @@
 #include <string_ex.h>
 #include <sys/time.h>
 
+#include <algorithm>
 #include <condition_variable>
 #include <csignal>
 #include <cstdint>
@@ -53,6 +54,8 @@
 #include "input_death_recipient.h"
 #include "input_event_callback.h"
 #include "input_method_ability.h"
+#include "input_method_agent_service_impl.h"
+#include "input_method_agent_stub.h"
 #include "input_method_engine_listener_impl.h"
 #include "input_data_channel_service_impl.h"
 #include "input_method_system_ability_proxy.h"
@@ -62,6 +65,7 @@
 #include "keyboard_listener.h"
 #include "message_parcel.h"
 #include "scope_utils.h"
+#include "shared_message_buffer.h"
 #include "system_ability.h"
 #include "system_ability_definition.h"
 #include "tdd_util.h"
@@ -114,6 +118,171 @@ void SelectListenerMock::WaitSelectListenerCallback()
     selectListenerCv_.wait_for(lock, std::chrono::milliseconds(WAIT_INTERVAL));
 }
 
+class CoalesceAgentFake : public InputMethodAgentStub {
+public:
+    ErrCode DispatchKeyEvent(const KeyEventValue &keyEvent, uint64_t cbId,
+        const sptr<IRemoteObject> &channelObject) override
+    {
+        return ERR_OK;
+    }
+    ErrCode DispatchKeyEventAsync(const KeyEventValue &keyEvent, uint64_t cbId,
+        const sptr<IRemoteObject> &channelObject) override
+    {
+        return ERR_OK;
+    }
+    ErrCode OnCursorUpdate(int32_t positionX, int32_t positionY, int height) override
+    {
+        cursorCount_++;
+        lastPositionX_ = positionX;
+        return ERR_OK;
+    }
+    ErrCode OnSelectionChange(
+        const std::string &text, int32_t oldBegin, int32_t oldEnd, int32_t newBegin, int32_t newEnd) override
+    {
+        return ERR_OK;
+    }
+    ErrCode SetCallingWindow(uint32_t windowId) override
+    {
+        return ERR_OK;
+    }
+    ErrCode OnAttributeChange(const InputAttributeInner &attributeInner) override
+    {
+        attributeCount_++;
+        lastEnterKeyType_ = attributeInner.enterKeyType;
+        return ERR_OK;
+    }
+    ErrCode SendPrivateCommand(const Value &value) override
+    {
+        return ERR_OK;
+    }
+    ErrCode SendMessage(const ArrayBuffer &arraybuffer) override
+    {
+        return ERR_OK;
+    }
+    ErrCode SetMessageBuffer(const SharedMessageBufferInner &buffer) override
+    {
+        return ERR_OK;
+    }
+    ErrCode SendSharedMessage(const SharedMessageInner &msg) override
+    {
+        return ERR_OK;
+    }
+    ErrCode DiscardTypingText() override
+    {
+        return ERR_OK;
+    }
+    ErrCode ResponseDataChannel(uint64_t msgId, int code, const ResponseDataInner &msg) override
+    {
+        return ERR_OK;
+    }
+    ErrCode ResponseDataChannelAsync(uint64_t msgId, int code, const ResponseDataInner &msg) override
+    {
+        return ERR_OK;
+    }
+    ErrCode OnFunctionKey(int32_t funcKey) override
+    {
+        return ERR_OK;
+    }
+    ErrCode OnTextDeltaChange(
+        const TextDeltaInner &delta, int32_t oldBegin, int32_t oldEnd, int32_t newBegin, int32_t newEnd) override
+    {
+        textCount_++;
+        lastDelta_ = delta;
+        lastNewBegin_ = newBegin;
+        return ERR_OK;
+    }
+    std::atomic<int32_t> cursorCount_{ 0 };
+    std::atomic<int32_t> textCount_{ 0 };
+    std::atomic<int32_t> attributeCount_{ 0 };
+    int32_t lastPositionX_ = 0;
+    int32_t lastNewBegin_ = 0;
+    int32_t lastEnterKeyType_ = 0;
+    TextDeltaInner lastDelta_;
+};
+
+// receives messages like the input method does, and can drop its shared buffer as a rebind does
+class MessageAgentFake : public CoalesceAgentFake {
+public:
+    ErrCode SetMessageBuffer(const SharedMessageBufferInner &buffer) override
+    {
+        recvBuffer_ = SharedMessageBuffer::Attach(buffer.ashmem);
+        setBufferCount_++;
+        return recvBuffer_ == nullptr ? ErrorCode::ERROR_CLIENT_NULL_POINTER : ErrorCode::NO_ERROR;
+    }
+    ErrCode SendSharedMessage(const SharedMessageInner &msg) override
+    {
+        if (recvBuffer_ == nullptr) {
+            return ErrorCode::ERROR_CLIENT_NULL_POINTER;
+        }
+        if (!recvBuffer_->Read(msg.offset, msg.length, lastMsgParam_)) {
+            return ErrorCode::ERROR_INVALID_ARRAY_BUFFER_SIZE;
+        }
+        sharedCount_++;
+        return ErrorCode::NO_ERROR;
+    }
+    ErrCode SendMessage(const ArrayBuffer &arraybuffer) override
+    {
+        lastMsgParam_ = arraybuffer.msgParam;
+        parcelCount_++;
+        return ErrorCode::NO_ERROR;
+    }
+    void ClearBuffer()
+    {
+        recvBuffer_ = nullptr;
+    }
+    std::shared_ptr<SharedMessageBuffer> recvBuffer_ = nullptr;
+    std::vector<uint8_t> lastMsgParam_;
+    int32_t setBufferCount_ = 0;
+    int32_t sharedCount_ = 0;
+    int32_t parcelCount_ = 0;
+};
+
+// replies to every key event after the input method has consumed it and the result has travelled back
+class KeyDelayAgentFake : public CoalesceAgentFake {
+public:
+    static constexpr auto CONSUME_TIME = std::chrono::milliseconds(1);
+    static constexpr auto TRANSIT_TIME = std::chrono::milliseconds(5);
+    ErrCode DispatchKeyEvent(const KeyEventValue &keyEvent, uint64_t cbId,
+        const sptr<IRemoteObject> &channelObject) override
+    {
+        // the synchronous call returns once the result is back
+        Reply(cbId).join();
+        return ERR_OK;
+    }
+    ErrCode DispatchKeyEventAsync(const KeyEventValue &keyEvent, uint64_t cbId,
+        const sptr<IRemoteObject> &channelObject) override
+    {
+        std::lock_guard<std::mutex> lock(threadsMutex_);
+        threads_.push_back(Reply(cbId));
+        return ERR_OK;
+    }
+    void WaitReplies()
+    {
+        std::lock_guard<std::mutex> lock(threadsMutex_);
+        for (auto &thread : threads_) {
+            thread.join();
+        }
+        threads_.clear();
+    }
+
+private:
+    std::thread Reply(uint64_t cbId)
+    {
+        return std::thread([this, cbId]() {
+            {
+                // the input method handles one key at a time
+                std::lock_guard<std::mutex> lock(consumeMutex_);
+                std::this_thread::sleep_for(CONSUME_TIME);
+            }
+            std::this_thread::sleep_for(TRANSIT_TIME);
+            InputMethodController::GetInstance()->HandleKeyEventResult(cbId, true);
+        });
+    }
+    std::mutex consumeMutex_;
+    std::mutex threadsMutex_;
+    std::vector<std::thread> threads_;
+};
+
 class InputMethodControllerTest : public testing::Test {
 public:
     static void SetUpTestCase(void);
@@ -1784,7 +1953,7 @@ HWTEST_F(InputMethodControllerTest, testIMCReset, TestSize.Level0)
 HWTEST_F(InputMethodControllerTest, testGetInputMethodState_001, TestSize.Level0)
 {
     IMSA_HILOGI("InputMethodControllerTest GetInputMethodState_001 Test START");
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.clear();
+    ImeEnabledInfoManager::GetInstance().ClearEnabledCache();
     ImeInfoInquirer::GetInstance().systemConfig_.enableFullExperienceFeature = true;
     ImeInfoInquirer::GetInstance().systemConfig_.enableInputMethodFeature = true;
     ImeEnabledInfo info;
@@ -1792,7 +1961,7 @@ HWTEST_F(InputMethodControllerTest, testGetInputMethodState_001, TestSize.Level0
     info.enabledStatus = EnabledStatus::FULL_EXPERIENCE_MODE;
     ImeEnabledCfg cfg;
     cfg.enabledInfos.push_back(info);
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.insert({ imsa_->userId_, cfg });
+    ImeEnabledInfoManager::GetInstance().SetEnabledCache(imsa_->userId_, cfg);
     EnabledStatus status = EnabledStatus::DISABLED;
     auto ret = inputMethodController_->GetInputMethodState(status);
     EXPECT_EQ(ret, ErrorCode::NO_ERROR);
@@ -1808,7 +1977,7 @@ HWTEST_F(InputMethodControllerTest, testGetInputMethodState_001, TestSize.Level0
 HWTEST_F(InputMethodControllerTest, testGetInputMethodState_002, TestSize.Level0)
 {
     IMSA_HILOGI("InputMethodControllerTest GetInputMethodState_002 Test START");
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.clear();
+    ImeEnabledInfoManager::GetInstance().ClearEnabledCache();
     ImeInfoInquirer::GetInstance().systemConfig_.enableFullExperienceFeature = false;
     ImeInfoInquirer::GetInstance().systemConfig_.enableInputMethodFeature = false;
     ImeEnabledInfo info;
@@ -1816,7 +1985,7 @@ HWTEST_F(InputMethodControllerTest, testGetInputMethodState_002, TestSize.Level0
     info.enabledStatus = EnabledStatus::BASIC_MODE;
     ImeEnabledCfg cfg;
     cfg.enabledInfos.push_back(info);
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.insert({ imsa_->userId_, cfg });
+    ImeEnabledInfoManager::GetInstance().SetEnabledCache(imsa_->userId_, cfg);
     EnabledStatus status = EnabledStatus::DISABLED;
     auto ret = inputMethodController_->GetInputMethodState(status);
     EXPECT_EQ(ret, ErrorCode::NO_ERROR);
@@ -1832,7 +2001,7 @@ HWTEST_F(InputMethodControllerTest, testGetInputMethodState_002, TestSize.Level0
 HWTEST_F(InputMethodControllerTest, testGetInputMethodState_003, TestSize.Level0)
 {
     IMSA_HILOGI("InputMethodControllerTest GetInputMethodState_003 Test START");
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.clear();
+    ImeEnabledInfoManager::GetInstance().ClearEnabledCache();
     ImeInfoInquirer::GetInstance().systemConfig_.enableFullExperienceFeature = true;
     ImeInfoInquirer::GetInstance().systemConfig_.enableInputMethodFeature = false;
     ImeEnabledInfo info;
@@ -1840,7 +2009,7 @@ HWTEST_F(InputMethodControllerTest, testGetInputMethodState_003, TestSize.Level0
     info.enabledStatus = EnabledStatus::BASIC_MODE;
     ImeEnabledCfg cfg;
     cfg.enabledInfos.push_back(info);
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.insert({ imsa_->userId_, cfg });
+    ImeEnabledInfoManager::GetInstance().SetEnabledCache(imsa_->userId_, cfg);
     EnabledStatus status = EnabledStatus::DISABLED;
     auto ret = inputMethodController_->GetInputMethodState(status);
     EXPECT_EQ(ret, ErrorCode::NO_ERROR);
@@ -1856,7 +2025,7 @@ HWTEST_F(InputMethodControllerTest, testGetInputMethodState_003, TestSize.Level0
 HWTEST_F(InputMethodControllerTest, testGetInputMethodState_004, TestSize.Level0)
 {
     IMSA_HILOGI("InputMethodControllerTest GetInputMethodState_004 Test START");
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.clear();
+    ImeEnabledInfoManager::GetInstance().ClearEnabledCache();
     ImeInfoInquirer::GetInstance().systemConfig_.enableFullExperienceFeature = false;
     ImeInfoInquirer::GetInstance().systemConfig_.enableInputMethodFeature = true;
     ImeEnabledInfo info;
@@ -1864,7 +2033,7 @@ HWTEST_F(InputMethodControllerTest, testGetInputMethodState_004, TestSize.Level0
     info.enabledStatus = EnabledStatus::BASIC_MODE;
     ImeEnabledCfg cfg;
     cfg.enabledInfos.push_back(info);
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.insert({ imsa_->userId_, cfg });
+    ImeEnabledInfoManager::GetInstance().SetEnabledCache(imsa_->userId_, cfg);
     EnabledStatus status = EnabledStatus::DISABLED;
     auto ret = inputMethodController_->GetInputMethodState(status);
     EXPECT_EQ(ret, ErrorCode::NO_ERROR);
@@ -2190,6 +2359,49 @@ HWTEST_F(InputMethodControllerTest, TestResponseDataChannel, TestSize.Level0)
     EXPECT_NE(ret, ErrorCode::NO_ERROR);
 }
 
+/**
+ * @tc.name: TestResponseAgentCache
+ * @tc.desc: Test ResponseDataChannel replies through the proxy of each bound agent, main and mirror ime in turn,
+ *           and only caches the proxy of an agent which is not bound
+ * @tc.type: FUNC
+ */
+HWTEST_F(InputMethodControllerTest, TestResponseAgentCache, TestSize.Level0)
+{
+    IMSA_HILOGI("TestResponseAgentCache START");
+    sptr<IRemoteObject> agentObject = new (std::nothrow) InputMethodAgentServiceImpl();
+    ASSERT_NE(agentObject, nullptr);
+    sptr<IRemoteObject> mirrorObject = new (std::nothrow) InputMethodAgentServiceImpl();
+    ASSERT_NE(mirrorObject, nullptr);
+    inputMethodController_->ClearAgentInfo();
+    inputMethodController_->SetAgent(agentObject, "");
+    inputMethodController_->SetAgent(mirrorObject, "proxyIme_IME_MIRROR");
+    auto agent = inputMethodController_->GetResponseAgent(agentObject);
+    ASSERT_NE(agent, nullptr);
+    EXPECT_EQ(agent, inputMethodController_->GetAgent());
+    auto mirror = inputMethodController_->GetResponseAgent(mirrorObject);
+    ASSERT_NE(mirror, nullptr);
+    EXPECT_NE(mirror, agent);
+    ResponseData data = std::monostate{};
+    for (uint64_t msgId = 1; msgId < 5; ++msgId) {
+        inputMethodController_->ResponseDataChannel(msgId % 2 ? agentObject : mirrorObject, msgId,
+            ErrorCode::NO_ERROR, data);
+        EXPECT_EQ(inputMethodController_->GetResponseAgent(agentObject), agent);
+        EXPECT_EQ(inputMethodController_->GetResponseAgent(mirrorObject), mirror);
+    }
+    EXPECT_EQ(inputMethodController_->rspAgent_, nullptr);
+
+    inputMethodController_->OnImeMirrorStop(mirrorObject);
+    auto unbound = inputMethodController_->GetResponseAgent(mirrorObject);
+    ASSERT_NE(unbound, nullptr);
+    EXPECT_NE(unbound, mirror);
+    EXPECT_EQ(inputMethodController_->GetResponseAgent(mirrorObject), unbound);
+    EXPECT_EQ(inputMethodController_->GetResponseAgent(agentObject), agent);
+
+    inputMethodController_->ClearAgentInfo();
+    EXPECT_EQ(inputMethodController_->rspAgent_, nullptr);
+    EXPECT_EQ(inputMethodController_->rspAgentObject_, nullptr);
+}
+
 /**
  * @tc.name: TestEditorContentLock
  * @tc.desc: Test editorContentLock_
@@ -2344,5 +2556,310 @@ HWTEST_F(InputMethodControllerTest, TestClearKeyEventCbInfo, TestSize.Level0)
     keyEventRetHandler.ClearKeyEventCbInfo();
     EXPECT_TRUE(keyEventRetHandler.keyEventCbHandlers_.empty());
 }
+
+/**
+ * @tc.name: TestKeyEventResultOrder
+ * @tc.desc: results of pipelined key events are delivered in dispatch order
+ * @tc.type: FUNC
+ */
+HWTEST_F(InputMethodControllerTest, TestKeyEventResultOrder, TestSize.Level0)
+{
+    IMSA_HILOGI("TestKeyEventResultOrder START");
+    constexpr int32_t keyCount = 64;
+    constexpr int32_t threadCount = 4;
+    KeyEventResultHandler keyEventRetHandler;
+    std::mutex orderMutex;
+    std::vector<int32_t> order;
+    std::vector<uint64_t> cbIds;
+    for (int32_t i = 0; i < keyCount; ++i) {
+        auto keyEvent = KeyEventUtil::CreateKeyEvent(MMI::KeyEvent::KEYCODE_A, MMI::KeyEvent::KEY_ACTION_DOWN);
+        keyEvent->SetId(i);
+        KeyEventCbInfo cbInfo = { keyEvent, [&orderMutex, &order](std::shared_ptr<MMI::KeyEvent> &event, bool) {
+            std::lock_guard<std::mutex> lock(orderMutex);
+            order.push_back(event->GetId());
+        } };
+        cbInfo.isOrdered = true;
+        cbIds.push_back(keyEventRetHandler.AddKeyEventCbInfo(cbInfo));
+    }
+    EXPECT_EQ(keyEventRetHandler.GetInflightCount(), keyCount);
+    std::reverse(cbIds.begin(), cbIds.end());
+    std::vector<std::thread> threads;
+    for (int32_t t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&keyEventRetHandler, &cbIds, t]() {
+            for (size_t i = t; i < cbIds.size(); i += threadCount) {
+                keyEventRetHandler.HandleKeyEventResult(cbIds[i], true);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(order.size(), keyCount);
+    for (int32_t i = 0; i < keyCount; ++i) {
+        EXPECT_EQ(order[i], i);
+    }
+    EXPECT_EQ(keyEventRetHandler.GetInflightCount(), 0);
+}
+
+/**
+ * @tc.name: TestKeyEventLateResult
+ * @tc.desc: a key event whose result comes after the window timeout is delivered once with its real result
+ * @tc.type: FUNC
+ */
+HWTEST_F(InputMethodControllerTest, TestKeyEventLateResult, TestSize.Level0)
+{
+    IMSA_HILOGI("TestKeyEventLateResult START");
+    constexpr uint32_t window = 1;
+    constexpr uint32_t waitTime = 10;
+    KeyEventResultHandler keyEventRetHandler;
+    std::vector<std::pair<int32_t, bool>> results;
+    auto callback = [&results](std::shared_ptr<MMI::KeyEvent> &event, bool isConsumed) {
+        results.emplace_back(event->GetId(), isConsumed);
+    };
+    auto addKeyEvent = [&keyEventRetHandler, &callback](int32_t id) {
+        auto keyEvent = KeyEventUtil::CreateKeyEvent(MMI::KeyEvent::KEYCODE_A, MMI::KeyEvent::KEY_ACTION_DOWN);
+        keyEvent->SetId(id);
+        KeyEventCbInfo cbInfo = { keyEvent, callback };
+        cbInfo.isOrdered = true;
+        return keyEventRetHandler.AddKeyEventCbInfo(cbInfo);
+    };
+    auto slowId = addKeyEvent(0);
+    // the window stays full, the slow key stops holding it but gets no made up result
+    keyEventRetHandler.WaitForWindow(window, waitTime);
+    EXPECT_EQ(keyEventRetHandler.GetInflightCount(), 0);
+    EXPECT_TRUE(results.empty());
+
+    // the keys behind it are not held back
+    auto nextId = addKeyEvent(1);
+    keyEventRetHandler.HandleKeyEventResult(nextId, false);
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_EQ(results[0], std::make_pair(1, false));
+
+    // the ime consumed the slow key after all
+    keyEventRetHandler.HandleKeyEventResult(slowId, true);
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(results[1], std::make_pair(0, true));
+    keyEventRetHandler.HandleKeyEventResult(slowId, false);
+    EXPECT_EQ(results.size(), 2);
+    EXPECT_EQ(keyEventRetHandler.GetInflightCount(), 0);
+}
+
+/**
+ * @tc.name: TestKeyEventPipelineThroughput
+ * @tc.desc: with a slow input method, DispatchKeyEvent with a window greater than 1 overlaps the round trips
+ * @tc.type: FUNC
+ */
+HWTEST_F(InputMethodControllerTest, TestKeyEventPipelineThroughput, TestSize.Level1)
+{
+    IMSA_HILOGI("TestKeyEventPipelineThroughput START");
+    constexpr int32_t keyCount = 40;
+    constexpr uint32_t pipelineWindow = 8;
+    auto agent = std::make_shared<KeyDelayAgentFake>();
+    sptr<InputDataChannelStub> channel = new (std::nothrow) InputDataChannelServiceImpl();
+    ASSERT_NE(channel, nullptr);
+    bool isEditable = inputMethodController_->isEditable_.load();
+    sptr<IRemoteObject> oldChannel = nullptr;
+    ClientState oldState = ClientState::INACTIVE;
+    {
+        std::lock_guard<std::recursive_mutex> lock(inputMethodController_->clientInfoLock_);
+        oldChannel = inputMethodController_->clientInfo_.channel;
+        oldState = inputMethodController_->clientInfo_.state;
+        inputMethodController_->clientInfo_.channel = channel->AsObject();
+        inputMethodController_->clientInfo_.state = ClientState::ACTIVE;
+    }
+    inputMethodController_->isEditable_.store(true);
+    inputMethodController_->ClearAgentInfo();
+    {
+        InputMethodController::AgentInfo agentInfo;
+        agentInfo.agent = agent;
+        std::lock_guard<std::mutex> agentLock(inputMethodController_->agentLock_);
+        inputMethodController_->agentInfoList_.push_back(agentInfo);
+    }
+    auto dispatch = [&agent](uint32_t window) {
+        EXPECT_EQ(inputMethodController_->SetKeyEventPipelineWindow(window), ErrorCode::NO_ERROR);
+        std::mutex orderMutex;
+        std::vector<int32_t> order;
+        auto callback = [&orderMutex, &order](std::shared_ptr<MMI::KeyEvent> &event, bool isConsumed) {
+            EXPECT_TRUE(isConsumed);
+            std::lock_guard<std::mutex> lock(orderMutex);
+            order.push_back(event->GetId());
+        };
+        auto start = std::chrono::steady_clock::now();
+        for (int32_t i = 0; i < keyCount; ++i) {
+            auto keyEvent = KeyEventUtil::CreateKeyEvent(MMI::KeyEvent::KEYCODE_A, MMI::KeyEvent::KEY_ACTION_DOWN);
+            keyEvent->SetId(i);
+            EXPECT_EQ(inputMethodController_->DispatchKeyEvent(keyEvent, callback), ErrorCode::NO_ERROR);
+        }
+        agent->WaitReplies();
+        auto cost = std::chrono::steady_clock::now() - start;
+        std::lock_guard<std::mutex> lock(orderMutex);
+        EXPECT_EQ(order.size(), static_cast<size_t>(keyCount));
+        for (size_t i = 0; i < order.size(); ++i) {
+            EXPECT_EQ(order[i], static_cast<int32_t>(i));
+        }
+        return std::chrono::duration_cast<std::chrono::milliseconds>(cost).count();
+    };
+    auto syncCost = dispatch(0);
+    auto pipelineCost = dispatch(pipelineWindow);
+    IMSA_HILOGI("sync: %{public}lld ms, pipeline: %{public}lld ms.", static_cast<long long>(syncCost),
+        static_cast<long long>(pipelineCost));
+    EXPECT_LT(pipelineCost, syncCost);
+    EXPECT_EQ(inputMethodController_->keyEventRetHandler_.GetInflightCount(), 0);
+
+    EXPECT_EQ(inputMethodController_->SetKeyEventPipelineWindow(0), ErrorCode::NO_ERROR);
+    inputMethodController_->ClearAgentInfo();
+    inputMethodController_->isEditable_.store(isEditable);
+    std::lock_guard<std::recursive_mutex> lock(inputMethodController_->clientInfoLock_);
+    inputMethodController_->clientInfo_.channel = oldChannel;
+    inputMethodController_->clientInfo_.state = oldState;
+}
+
+/**
+ * @tc.name: TestSetKeyEventPipelineWindow
+ * @tc.desc: window beyond the limit is rejected
+ * @tc.type: FUNC
+ */
+HWTEST_F(InputMethodControllerTest, TestSetKeyEventPipelineWindow, TestSize.Level0)
+{
+    IMSA_HILOGI("TestSetKeyEventPipelineWindow START");
+    constexpr uint32_t invalidWindow = 33;
+    constexpr uint32_t validWindow = 4;
+    EXPECT_EQ(inputMethodController_->SetKeyEventPipelineWindow(invalidWindow),
+        ErrorCode::ERROR_PARAMETER_CHECK_FAILED);
+    EXPECT_EQ(inputMethodController_->SetKeyEventPipelineWindow(validWindow), ErrorCode::NO_ERROR);
+    EXPECT_EQ(inputMethodController_->keyEventWindow_.load(), validWindow);
+    EXPECT_EQ(inputMethodController_->SetKeyEventPipelineWindow(0), ErrorCode::NO_ERROR);
+}
+
+/**
+ * @tc.name: TestUpdateCoalesce
+ * @tc.desc: buffered cursor, selection and attribute updates are sent once with the latest value before an edit
+ * @tc.type: FUNC
+ */
+HWTEST_F(InputMethodControllerTest, TestUpdateCoalesce, TestSize.Level0)
+{
+    IMSA_HILOGI("TestUpdateCoalesce START");
+    constexpr int32_t updateNum = 10;
+    constexpr uint32_t invalidInterval = 101;
+    constexpr uint32_t validInterval = 100;
+    auto agent = std::make_shared<CoalesceAgentFake>();
+    bool isBound = inputMethodController_->isBound_.load();
+    bool isEditable = inputMethodController_->isEditable_.load();
+    inputMethodController_->isBound_.store(true);
+    inputMethodController_->isEditable_.store(true);
+    inputMethodController_->ClearAgentInfo();
+    std::u16string baseText;
+    {
+        std::lock_guard<std::mutex> lock(inputMethodController_->editorContentLock_);
+        baseText = inputMethodController_->textString_;
+        InputMethodController::AgentInfo agentInfo;
+        agentInfo.agent = agent;
+        agentInfo.textVersion = inputMethodController_->textVersion_;
+        std::lock_guard<std::mutex> agentLock(inputMethodController_->agentLock_);
+        inputMethodController_->agentInfoList_.push_back(agentInfo);
+    }
+    EXPECT_EQ(inputMethodController_->SetUpdateCoalesceInterval(invalidInterval),
+        ErrorCode::ERROR_PARAMETER_CHECK_FAILED);
+    ASSERT_EQ(inputMethodController_->SetUpdateCoalesceInterval(validInterval), ErrorCode::NO_ERROR);
+    uint64_t coalesced = 0;
+    uint64_t sent = 0;
+    inputMethodController_->GetUpdateCoalesceStats(coalesced, sent);
+
+    std::u16string text = baseText;
+    for (int32_t i = 1; i <= updateNum; ++i) {
+        CursorInfo cursorInfo = { static_cast<double>(i), static_cast<double>(i), 1, 1 };
+        inputMethodController_->OnCursorUpdate(cursorInfo);
+        text += u"a";
+        inputMethodController_->OnSelectionChange(text, i, i);
+        Configuration info;
+        info.SetEnterKeyType(i % 2 == 0 ? EnterKeyType::GO : EnterKeyType::SEARCH);
+        info.SetTextInputType(TextInputType::TEXT);
+        inputMethodController_->OnConfigurationChange(info);
+    }
+    EXPECT_EQ(agent->cursorCount_.load(), 0);
+    EXPECT_EQ(agent->textCount_.load(), 0);
+    EXPECT_EQ(agent->attributeCount_.load(), 0);
+
+    // an edit from the input method sends the buffered updates first
+    inputMethodController_->DeleteForward(0);
+    EXPECT_EQ(agent->cursorCount_.load(), 1);
+    EXPECT_EQ(agent->lastPositionX_, updateNum);
+    EXPECT_EQ(agent->textCount_.load(), 1);
+    EXPECT_EQ(agent->lastNewBegin_, updateNum);
+    EXPECT_TRUE(agent->lastDelta_.ApplyTo(baseText));
+    EXPECT_EQ(baseText, text);
+    EXPECT_EQ(agent->attributeCount_.load(), 1);
+    EXPECT_EQ(agent->lastEnterKeyType_, static_cast<int32_t>(EnterKeyType::GO));
+
+    uint64_t coalescedNow = 0;
+    uint64_t sentNow = 0;
+    inputMethodController_->GetUpdateCoalesceStats(coalescedNow, sentNow);
+    EXPECT_EQ(sentNow - sent, 3u);
+    EXPECT_EQ(coalescedNow - coalesced, static_cast<uint64_t>(3 * (updateNum - 1)));
+
+    EXPECT_EQ(inputMethodController_->SetUpdateCoalesceInterval(0), ErrorCode::NO_ERROR);
+    CursorInfo cursorInfo = { 0, 0, 1, 1 };
+    inputMethodController_->OnCursorUpdate(cursorInfo);
+    EXPECT_EQ(agent->cursorCount_.load(), 2);
+    inputMethodController_->ClearAgentInfo();
+    inputMethodController_->isBound_.store(isBound);
+    inputMethodController_->isEditable_.store(isEditable);
+}
+
+/**
+ * @tc.name: TestSendSharedMessageAfterRebind
+ * @tc.desc: a large message is resent by parcel when the input method dropped the shared buffer, the next one
+ *           shares the buffer again
+ * @tc.type: FUNC
+ */
+HWTEST_F(InputMethodControllerTest, TestSendSharedMessageAfterRebind, TestSize.Level0)
+{
+    IMSA_HILOGI("TestSendSharedMessageAfterRebind START");
+    auto agent = std::make_shared<MessageAgentFake>();
+    bool isBound = inputMethodController_->isBound_.load();
+    bool isEditable = inputMethodController_->isEditable_.load();
+    ClientState oldState = ClientState::INACTIVE;
+    {
+        std::lock_guard<std::recursive_mutex> lock(inputMethodController_->clientInfoLock_);
+        oldState = inputMethodController_->clientInfo_.state;
+        inputMethodController_->clientInfo_.state = ClientState::ACTIVE;
+    }
+    inputMethodController_->isBound_.store(true);
+    inputMethodController_->isEditable_.store(true);
+    inputMethodController_->ClearAgentInfo();
+    {
+        InputMethodController::AgentInfo agentInfo;
+        agentInfo.agent = agent;
+        std::lock_guard<std::mutex> agentLock(inputMethodController_->agentLock_);
+        inputMethodController_->agentInfoList_.push_back(agentInfo);
+    }
+    ArrayBuffer arrayBuffer;
+    arrayBuffer.msgId = "shared";
+    arrayBuffer.msgParam.assign(SHARED_MESSAGE_MIN_SIZE, 'a');
+    EXPECT_EQ(inputMethodController_->SendMessage(arrayBuffer), ErrorCode::NO_ERROR);
+    EXPECT_EQ(agent->setBufferCount_, 1);
+    EXPECT_EQ(agent->sharedCount_, 1);
+    EXPECT_EQ(agent->lastMsgParam_, arrayBuffer.msgParam);
+
+    // the receiver drops its buffer, as ClearBindInfo does on rebind
+    agent->ClearBuffer();
+    arrayBuffer.msgParam.assign(SHARED_MESSAGE_MIN_SIZE, 'b');
+    EXPECT_EQ(inputMethodController_->SendMessage(arrayBuffer), ErrorCode::NO_ERROR);
+    EXPECT_EQ(agent->parcelCount_, 1);
+    EXPECT_EQ(agent->lastMsgParam_, arrayBuffer.msgParam);
+
+    arrayBuffer.msgParam.assign(SHARED_MESSAGE_MIN_SIZE, 'c');
+    EXPECT_EQ(inputMethodController_->SendMessage(arrayBuffer), ErrorCode::NO_ERROR);
+    EXPECT_EQ(agent->setBufferCount_, 2);
+    EXPECT_EQ(agent->sharedCount_, 2);
+    EXPECT_EQ(agent->parcelCount_, 1);
+    EXPECT_EQ(agent->lastMsgParam_, arrayBuffer.msgParam);
+
+    inputMethodController_->ClearAgentInfo();
+    inputMethodController_->isBound_.store(isBound);
+    inputMethodController_->isEditable_.store(isEditable);
+    std::lock_guard<std::recursive_mutex> lock(inputMethodController_->clientInfoLock_);
+    inputMethodController_->clientInfo_.state = oldState;
+}
 } // namespace MiscServices
 } // namespace OHOS
@@ -522,6 +522,28 @@ HWTEST_F(InputMethodDfxTest, InputMethodDfxTest_Dump_ALL, TestSize.Level1)
     EXPECT_FALSE(!InputmethodDump::GetInstance().Dump(fd, args));
 }
 
+/**
+ * @tc.name: InputMethodDfxTest_Dump_Command
+ * @tc.desc: a registered dump command is run by its name
+ * @tc.type: FUNC
+ */
+HWTEST_F(InputMethodDfxTest, InputMethodDfxTest_Dump_Command, TestSize.Level1)
+{
+    IMSA_HILOGI("InputMethodDump::InputMethodDfxTest_Dump_Command");
+    auto count = std::make_shared<int32_t>(0);
+    InputmethodDump::GetInstance().AddDumpCommand("--test-cmd", "test command", [count](int fd) { ++(*count); });
+    int fd = 1;
+    std::vector<std::string> args = { "--test-cmd" };
+    EXPECT_TRUE(InputmethodDump::GetInstance().Dump(fd, args));
+    EXPECT_EQ(*count, 1);
+    args = { "--unknown-cmd" };
+    EXPECT_TRUE(InputmethodDump::GetInstance().Dump(fd, args));
+    EXPECT_EQ(*count, 1);
+    args = { "-h" };
+    EXPECT_TRUE(InputmethodDump::GetInstance().Dump(fd, args));
+    EXPECT_EQ(*count, 1);
+}
+
 /**
  * @tc.name: InputMethodDfxTest_Hisysevent_GetOperateAction
  * @tc.desc: Hisysevent GetOperateAction.
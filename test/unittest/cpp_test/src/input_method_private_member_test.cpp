@@ -14,9 +14,13 @@
  */
 #define private public
 #define protected public
+#include "client_broadcaster.h"
+#include "file_operator.h"
 #include "full_ime_info_manager.h"
 #include "ime_cfg_manager.h"
 #include "ime_info_inquirer.h"
+#include "ime_prestart_policy.h"
+#include "ime_request_dispatcher.h"
 #include "input_method_agent_service_impl.h"
 #include "input_method_core_service_impl.h"
 #include "input_method_controller.h"
@@ -24,6 +28,7 @@
 #include "peruser_session.h"
 #include "wms_connection_observer.h"
 #include "settings_data_utils.h"
+#include "sys_cfg_parser.h"
 #include "input_type_manager.h"
 #include "user_session_manager.h"
 #include "system_param_adapter.h"
@@ -32,10 +37,15 @@
 #undef private
 #include <gtest/gtest.h>
 #include <gtest/hwext/gtest-multithread.h>
+#include <sys/stat.h>
 #include <sys/time.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <map>
+#include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "application_info.h"
@@ -83,6 +93,9 @@ constexpr int32_t MS_TO_US = 1000;
 constexpr int32_t WAIT_FOR_THREAD_SCHEDULE = 10;
 constexpr int32_t WAIT_ATTACH_FINISH_DELAY = 50;
 constexpr uint32_t MAX_ATTACH_COUNT = 100000;
+constexpr const char *IME_CFG_FILE_PATH = "/data/service/el1/public/imf/ime_cfg.json";
+constexpr const char *ATOMIC_WRITE_TEST_PATH = "/data/service/el1/public/imf/atomic_write_test.json";
+constexpr const char *SYS_CFG_TEST_PATH = "/data/service/el1/public/imf/sys_cfg_test.json";
 constexpr const char *COMMON_EVENT_PARAM_USER_ID = "userId";
 constexpr const char *COMMON_EVENT_PARAM_BUNDLE_RES_CHANGE_TYPE = "bundleResourceChangeType";
 std::atomic<int32_t> InputMethodPrivateMemberTest::tryLockFailCount_ = 0;
@@ -123,7 +136,7 @@ void InputMethodPrivateMemberTest::SetUp(void)
     IMSA_HILOGI("InputMethodPrivateMemberTest::SetUp");
     ImeCfgManager::GetInstance().imeConfigs_.clear();
     FullImeInfoManager::GetInstance().fullImeInfos_.clear();
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.clear();
+    ImeEnabledInfoManager::GetInstance().ClearEnabledCache();
     service_->userId_ = MAIN_USER_ID;
 }
 
@@ -132,7 +145,7 @@ void InputMethodPrivateMemberTest::TearDown(void)
     IMSA_HILOGI("InputMethodPrivateMemberTest::TearDown");
     ImeCfgManager::GetInstance().imeConfigs_.clear();
     FullImeInfoManager::GetInstance().fullImeInfos_.clear();
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.clear();
+    ImeEnabledInfoManager::GetInstance().ClearEnabledCache();
 }
 sptr<InputMethodSystemAbility> InputMethodPrivateMemberTest::service_;
 
@@ -413,7 +426,7 @@ HWTEST_F(InputMethodPrivateMemberTest, SA_SwitchByCombinationKey_002, TestSize.L
     imeInfo.extraInfo.isDefaultIme = true;
     imeInfo.extraInfo.currentSubName = "subName";
     cfg.enabledInfos.emplace_back(imeInfo);
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.insert({ MAIN_USER_ID, cfg });
+    ImeEnabledInfoManager::GetInstance().SetEnabledCache(MAIN_USER_ID, cfg);
     auto ret = service_->SwitchByCombinationKey(KeyboardEvent::SHIFT_RIGHT_MASK);
     EXPECT_EQ(ret, ErrorCode::ERROR_BAD_PARAMETERS);
     ret = service_->SwitchByCombinationKey(KeyboardEvent::CAPS_MASK);
@@ -437,7 +450,7 @@ HWTEST_F(InputMethodPrivateMemberTest, SA_SwitchByCombinationKey_003, TestSize.L
     SubProperty sub;
     sub.id = "testSubName";
     info.subProps.push_back(sub);
-    FullImeInfoManager::GetInstance().fullImeInfos_.insert({ MAIN_USER_ID, { info } });
+    FullImeInfoManager::GetInstance().SetUser(MAIN_USER_ID, { info });
     ImeEnabledCfg cfg;
     ImeEnabledInfo imeInfo;
     imeInfo.bundleName = "testBundleName";
@@ -445,7 +458,7 @@ HWTEST_F(InputMethodPrivateMemberTest, SA_SwitchByCombinationKey_003, TestSize.L
     imeInfo.extraInfo.isDefaultIme = true;
     imeInfo.extraInfo.currentSubName = "testSubName";
     cfg.enabledInfos.emplace_back(imeInfo);
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.insert({ MAIN_USER_ID, cfg });
+    ImeEnabledInfoManager::GetInstance().SetEnabledCache(MAIN_USER_ID, cfg);
     auto ret = service_->SwitchByCombinationKey(KeyboardEvent::SHIFT_RIGHT_MASK);
     EXPECT_EQ(ret, ErrorCode::NO_ERROR);
     ret = service_->SwitchByCombinationKey(KeyboardEvent::CAPS_MASK);
@@ -470,7 +483,7 @@ HWTEST_F(InputMethodPrivateMemberTest, SA_SwitchByCombinationKey_004, TestSize.L
     sub.id = "testSubName";
     sub.language = "French";
     info.subProps.push_back(sub);
-    FullImeInfoManager::GetInstance().fullImeInfos_.insert({ MAIN_USER_ID, { info } });
+    FullImeInfoManager::GetInstance().SetUser(MAIN_USER_ID, { info });
     ImeEnabledCfg cfg;
     ImeEnabledInfo imeInfo;
     imeInfo.bundleName = "testBundleName";
@@ -478,7 +491,7 @@ HWTEST_F(InputMethodPrivateMemberTest, SA_SwitchByCombinationKey_004, TestSize.L
     imeInfo.extraInfo.isDefaultIme = true;
     imeInfo.extraInfo.currentSubName = "testSubName";
     cfg.enabledInfos.emplace_back(imeInfo);
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.insert({ MAIN_USER_ID, cfg });
+    ImeEnabledInfoManager::GetInstance().SetEnabledCache(MAIN_USER_ID, cfg);
     auto ret = service_->SwitchByCombinationKey(KeyboardEvent::SHIFT_RIGHT_MASK);
     EXPECT_EQ(ret, ErrorCode::NO_ERROR);
 }
@@ -502,7 +515,7 @@ HWTEST_F(InputMethodPrivateMemberTest, SA_SwitchByCombinationKey_005, TestSize.L
     sub.mode = "upper";
     sub.language = "english";
     info.subProps.push_back(sub);
-    FullImeInfoManager::GetInstance().fullImeInfos_.insert({ MAIN_USER_ID, { info } });
+    FullImeInfoManager::GetInstance().SetUser(MAIN_USER_ID, { info });
     ImeEnabledCfg cfg;
     ImeEnabledInfo imeInfo;
     imeInfo.bundleName = "testBundleName";
@@ -510,7 +523,7 @@ HWTEST_F(InputMethodPrivateMemberTest, SA_SwitchByCombinationKey_005, TestSize.L
     imeInfo.extraInfo.isDefaultIme = true;
     imeInfo.extraInfo.currentSubName = "testSubName";
     cfg.enabledInfos.emplace_back(imeInfo);
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.insert({ MAIN_USER_ID, cfg });
+    ImeEnabledInfoManager::GetInstance().SetEnabledCache(MAIN_USER_ID, cfg);
     auto ret = service_->SwitchByCombinationKey(KeyboardEvent::SHIFT_RIGHT_MASK);
     EXPECT_EQ(ret, ErrorCode::ERROR_BAD_PARAMETERS);
     ret = service_->SwitchByCombinationKey(KeyboardEvent::CAPS_MASK);
@@ -542,7 +555,7 @@ HWTEST_F(InputMethodPrivateMemberTest, SA_SwitchByCombinationKey_006, TestSize.L
     sub1.mode = "lower";
     sub1.language = "chinese";
     info.subProps.push_back(sub1);
-    FullImeInfoManager::GetInstance().fullImeInfos_.insert({ MAIN_USER_ID, { info } });
+    FullImeInfoManager::GetInstance().SetUser(MAIN_USER_ID, { info });
 
     ImeEnabledCfg cfg;
     ImeEnabledInfo imeInfo;
@@ -551,7 +564,7 @@ HWTEST_F(InputMethodPrivateMemberTest, SA_SwitchByCombinationKey_006, TestSize.L
     imeInfo.extraInfo.isDefaultIme = true;
     imeInfo.extraInfo.currentSubName = "testSubName";
     cfg.enabledInfos.emplace_back(imeInfo);
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.insert({ MAIN_USER_ID, cfg });
+    ImeEnabledInfoManager::GetInstance().SetEnabledCache(MAIN_USER_ID, cfg);
     // english->chinese
     auto ret = service_->SwitchByCombinationKey(KeyboardEvent::SHIFT_RIGHT_MASK);
     EXPECT_EQ(ret, ErrorCode::ERROR_IMSA_REBOOT_OLD_IME_NOT_STOP);
@@ -601,7 +614,7 @@ HWTEST_F(InputMethodPrivateMemberTest, SA_SwitchByCombinationKey_008, TestSize.L
     imeInfo.extraInfo.isDefaultIme = true;
     imeInfo.extraInfo.currentSubName = subProp->id;
     cfg.enabledInfos.emplace_back(imeInfo);
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.insert({ userId, cfg });
+    ImeEnabledInfoManager::GetInstance().SetEnabledCache(userId, cfg);
     std::vector<Property> props;
     InputMethodController::GetInstance()->ListInputMethod(props);
     if (props.size() == 1) {
@@ -698,13 +711,13 @@ HWTEST_F(InputMethodPrivateMemberTest, III_TestGetCurrentSubtype_001, TestSize.L
     ImeEnabledCfg cfg;
     ImeEnabledInfo imeInfo;
     cfg.enabledInfos.push_back(imeInfo);
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.insert({ currentUserId, cfg });
+    ImeEnabledInfoManager::GetInstance().SetEnabledCache(currentUserId, cfg);
     auto subProp = ImeInfoInquirer::GetInstance().GetCurrentSubtype(currentUserId);
     EXPECT_TRUE(subProp == nullptr);
 
     // subName is not find
     auto currentProp = InputMethodController::GetInstance()->GetCurrentInputMethod();
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.clear();
+    ImeEnabledInfoManager::GetInstance().ClearEnabledCache();
     ImeEnabledInfo imeInfo1;
     imeInfo1.bundleName = currentProp->name;
     imeInfo1.extensionName = currentProp->id;
@@ -712,14 +725,14 @@ HWTEST_F(InputMethodPrivateMemberTest, III_TestGetCurrentSubtype_001, TestSize.L
     imeInfo1.extraInfo.currentSubName = "tt";
     ImeEnabledCfg cfg1;
     cfg1.enabledInfos.emplace_back(imeInfo1);
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.insert({ currentUserId, cfg1 });
+    ImeEnabledInfoManager::GetInstance().SetEnabledCache(currentUserId, cfg1);
     subProp = ImeInfoInquirer::GetInstance().GetCurrentSubtype(currentUserId);
     ASSERT_TRUE(subProp != nullptr);
     EXPECT_TRUE(subProp->name == currentProp->name);
 
     // get correct subProp
     auto currentSubProp = InputMethodController::GetInstance()->GetCurrentInputMethodSubtype();
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.clear();
+    ImeEnabledInfoManager::GetInstance().ClearEnabledCache();
     ImeEnabledInfo imeInfo2;
     imeInfo2.bundleName = currentProp->name;
     imeInfo2.extensionName = currentProp->id;
@@ -727,7 +740,7 @@ HWTEST_F(InputMethodPrivateMemberTest, III_TestGetCurrentSubtype_001, TestSize.L
     imeInfo2.extraInfo.currentSubName = currentSubProp->id;
     ImeEnabledCfg cfg2;
     cfg2.enabledInfos.emplace_back(imeInfo2);
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.insert({ currentUserId, cfg2 });
+    ImeEnabledInfoManager::GetInstance().SetEnabledCache(currentUserId, cfg2);
     subProp = ImeInfoInquirer::GetInstance().GetCurrentSubtype(currentUserId);
     ASSERT_TRUE(subProp != nullptr);
     EXPECT_TRUE(subProp->id == currentSubProp->id);
@@ -748,19 +761,19 @@ HWTEST_F(InputMethodPrivateMemberTest, III_TestGetCurrentIme_001, TestSize.Level
     ImeEnabledCfg cfg;
     ImeEnabledInfo imeInfo;
     cfg.enabledInfos.push_back(imeInfo);
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.insert({ currentUserId, cfg });
+    ImeEnabledInfoManager::GetInstance().SetEnabledCache(currentUserId, cfg);
     auto prop = ImeInfoInquirer::GetInstance().GetCurrentInputMethod(currentUserId);
     EXPECT_TRUE(prop == nullptr);
 
     // get correct prop
     auto currentProp = InputMethodController::GetInstance()->GetCurrentInputMethod();
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.clear();
+    ImeEnabledInfoManager::GetInstance().ClearEnabledCache();
     imeInfo.bundleName = currentProp->name;
     imeInfo.extensionName = currentProp->id;
     imeInfo.extraInfo.isDefaultIme = true;
     imeInfo.extraInfo.currentSubName = currentProp->id;
     cfg.enabledInfos.emplace_back(imeInfo);
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.insert({ currentUserId, cfg });
+    ImeEnabledInfoManager::GetInstance().SetEnabledCache(currentUserId, cfg);
     prop = ImeInfoInquirer::GetInstance().GetCurrentInputMethod(currentUserId);
     ASSERT_TRUE(prop != nullptr);
     EXPECT_TRUE(prop->id == currentProp->id);
@@ -799,7 +812,7 @@ HWTEST_F(InputMethodPrivateMemberTest, III_TestListCurrentInputMethodSubtype_001
     ImeEnabledCfg cfg;
     ImeEnabledInfo imeInfo;
     cfg.enabledInfos.push_back(imeInfo);
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.insert({ currentUserId, cfg });
+    ImeEnabledInfoManager::GetInstance().SetEnabledCache(currentUserId, cfg);
     auto ret = ImeInfoInquirer::GetInstance().ListCurrentInputMethodSubtype(currentUserId, subProps);
     EXPECT_EQ(ret, ErrorCode::ERROR_BAD_PARAMETERS);
 }
@@ -1271,7 +1284,7 @@ HWTEST_F(InputMethodPrivateMemberTest, TestFullImeInfoManager_Get, TestSize.Leve
     SubProperty sub;
     sub.id = "testSubName";
     info.subProps.push_back(sub);
-    FullImeInfoManager::GetInstance().fullImeInfos_.insert({ MAIN_USER_ID, { info } });
+    FullImeInfoManager::GetInstance().SetUser(MAIN_USER_ID, { info });
     uint32_t invalidTokenId = 4294967295;
     auto ret = FullImeInfoManager::GetInstance().Get(MAIN_USER_ID, invalidTokenId);
     EXPECT_EQ(ret, "");
@@ -1669,22 +1682,24 @@ HWTEST_F(InputMethodPrivateMemberTest, Test_ClientGroup_UpdateClientInfo, TestSi
 {
     IMSA_HILOGI("InputMethodPrivateMemberTest Test_ClientGroup_UpdateClientInfo TEST START");
     auto clientGroup = std::make_shared<ClientGroup>(DEFAULT_DISPLAY_ID, nullptr);
-    clientGroup->mapClients_.clear();
+    clientGroup->ModifyClients([](auto &clients) { clients.clear(); });
     bool isShowKeyboard = true;
     sptr<IInputClient> client = new (std::nothrow) InputClientServiceImpl();
     ASSERT_NE(client, nullptr);
     // not find client
     clientGroup->UpdateClientInfo(client->AsObject(), { { UpdateFlag::ISSHOWKEYBOARD, isShowKeyboard } });
-    clientGroup->mapClients_.insert({ client->AsObject(), nullptr });
+    clientGroup->ModifyClients([&client](auto &clients) { clients.insert({ client->AsObject(), nullptr }); });
     // client info is nullptr
     clientGroup->UpdateClientInfo(client->AsObject(), { { UpdateFlag::ISSHOWKEYBOARD, isShowKeyboard } });
  
     auto info = std::make_shared<InputClientInfo>();
-    clientGroup->mapClients_.insert_or_assign(client->AsObject(), info);
+    clientGroup->ModifyClients(
+        [&client, &info](auto &clients) { clients.insert_or_assign(client->AsObject(), info); });
     // update abnormal
     clientGroup->UpdateClientInfo(client->AsObject(), { { UpdateFlag::CLIENT_TYPE, isShowKeyboard } });
-    auto it = clientGroup->mapClients_.find(client->AsObject());
-    ASSERT_NE(it, clientGroup->mapClients_.end());
+    auto clients = clientGroup->GetClientMap();
+    auto it = clients->find(client->AsObject());
+    ASSERT_NE(it, clients->end());
     ASSERT_NE(it->second, nullptr);
     EXPECT_EQ(it->second->type, ClientType::INNER_KIT);
     // update correctly
@@ -1699,8 +1714,9 @@ HWTEST_F(InputMethodPrivateMemberTest, Test_ClientGroup_UpdateClientInfo, TestSi
         { { UpdateFlag::BINDIMETYPE, bindImeType }, { UpdateFlag::ISSHOWKEYBOARD, isShowKeyboard },
             { UpdateFlag::EVENTFLAG, eventFlag }, { UpdateFlag::TEXT_CONFIG, config }, { UpdateFlag::STATE, state },
             { UpdateFlag::UIEXTENSION_TOKENID, uiExtensionTokenId }, { UpdateFlag::CLIENT_TYPE, type } });
-    it = clientGroup->mapClients_.find(client->AsObject());
-    ASSERT_NE(it, clientGroup->mapClients_.end());
+    clients = clientGroup->GetClientMap();
+    it = clients->find(client->AsObject());
+    ASSERT_NE(it, clients->end());
     ASSERT_NE(it->second, nullptr);
     EXPECT_EQ(it->second->isShowKeyboard, isShowKeyboard);
     EXPECT_EQ(it->second->eventFlag, eventFlag);
@@ -1782,7 +1798,7 @@ HWTEST_F(InputMethodPrivateMemberTest, SA_AllowSwitchImeByCombinationKey, TestSi
     group->currentClient_ = client;
     auto info = std::make_shared<InputClientInfo>();
     info->config.isSimpleKeyboardEnabled = true;
-    group->mapClients_.insert_or_assign(client->AsObject(), info);
+    group->ModifyClients([&client, &info](auto &clients) { clients.insert_or_assign(client->AsObject(), info); });
     session.clientGroupMap_.insert_or_assign(DEFAULT_DISPLAY_ID, group);
     ret = session.IsImeSwitchForbidden();
     EXPECT_TRUE(ret);
@@ -1804,25 +1820,25 @@ HWTEST_F(InputMethodPrivateMemberTest, SA_SpecialScenarioCheck, TestSize.Level0)
     group->currentClient_ = client;
     auto info = std::make_shared<InputClientInfo>();
     info->config.isSimpleKeyboardEnabled = true;
-    group->mapClients_.insert_or_assign(client->AsObject(), info);
+    group->ModifyClients([&client, &info](auto &clients) { clients.insert_or_assign(client->AsObject(), info); });
     session.clientGroupMap_.insert_or_assign(DEFAULT_DISPLAY_ID, group);
     auto allow = session.SpecialScenarioCheck();
     EXPECT_FALSE(allow);
 
     info->config.isSimpleKeyboardEnabled = false;
-    group->mapClients_.insert_or_assign(client->AsObject(), info);
+    group->ModifyClients([&client, &info](auto &clients) { clients.insert_or_assign(client->AsObject(), info); });
     session.clientGroupMap_.insert_or_assign(DEFAULT_DISPLAY_ID, group);
     allow = session.SpecialScenarioCheck();
     EXPECT_TRUE(allow);
 
     info->config.inputAttribute.inputPattern = InputAttribute::PATTERN_ONE_TIME_CODE;
-    group->mapClients_.insert_or_assign(client->AsObject(), info);
+    group->ModifyClients([&client, &info](auto &clients) { clients.insert_or_assign(client->AsObject(), info); });
     session.clientGroupMap_.insert_or_assign(DEFAULT_DISPLAY_ID, group);
     allow = session.SpecialScenarioCheck();
     EXPECT_FALSE(allow);
 
     info->config.inputAttribute.inputPattern = InputAttribute::PATTERN_PASSWORD;
-    group->mapClients_.insert_or_assign(client->AsObject(), info);
+    group->ModifyClients([&client, &info](auto &clients) { clients.insert_or_assign(client->AsObject(), info); });
     session.clientGroupMap_.insert_or_assign(DEFAULT_DISPLAY_ID, group);
     allow = session.SpecialScenarioCheck();
     EXPECT_FALSE(allow);
@@ -1844,27 +1860,27 @@ HWTEST_F(InputMethodPrivateMemberTest, SA_IsScreenLockOrSecurityFlag, TestSize.L
     group->currentClient_ = client;
     auto info = std::make_shared<InputClientInfo>();
     info->config.inputAttribute.inputPattern = InputAttribute::PATTERN_TEXT;
-    group->mapClients_.insert_or_assign(client->AsObject(), info);
+    group->ModifyClients([&client, &info](auto &clients) { clients.insert_or_assign(client->AsObject(), info); });
     session.clientGroupMap_.insert_or_assign(DEFAULT_DISPLAY_ID, group);
     auto ret = session.IsImeSwitchForbidden();
     EXPECT_FALSE(ret);
 
 
     info->config.inputAttribute.inputPattern = InputAttribute::PATTERN_ONE_TIME_CODE;
-    group->mapClients_.insert_or_assign(client->AsObject(), info);
+    group->ModifyClients([&client, &info](auto &clients) { clients.insert_or_assign(client->AsObject(), info); });
     session.clientGroupMap_.insert_or_assign(DEFAULT_DISPLAY_ID, group);
     ret = session.IsImeSwitchForbidden();
     EXPECT_FALSE(ret);
 
     info->config.inputAttribute.inputPattern = InputAttribute::PATTERN_PASSWORD;
-    group->mapClients_.insert_or_assign(client->AsObject(), info);
+    group->ModifyClients([&client, &info](auto &clients) { clients.insert_or_assign(client->AsObject(), info); });
     session.clientGroupMap_.insert_or_assign(DEFAULT_DISPLAY_ID, group);
     ret = session.IsImeSwitchForbidden();
     EXPECT_TRUE(ret);
 
     info->config.inputAttribute.inputPattern = InputAttribute::PATTERN_TEXT;
     info->config.isSimpleKeyboardEnabled = true;
-    group->mapClients_.insert_or_assign(client->AsObject(), info);
+    group->ModifyClients([&client, &info](auto &clients) { clients.insert_or_assign(client->AsObject(), info); });
     session.clientGroupMap_.insert_or_assign(DEFAULT_DISPLAY_ID, group);
     ret = session.IsImeSwitchForbidden();
     EXPECT_TRUE(ret);
@@ -1937,7 +1953,7 @@ HWTEST_F(InputMethodPrivateMemberTest, SA_CheckInputTypeOption, TestSize.Level0)
     ImeEnabledInfo enabledInfo{ bundleName2, extName2, EnabledStatus::BASIC_MODE };
     enabledInfo.extraInfo.isDefaultIme = true;
     cfg.enabledInfos.push_back(enabledInfo);
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.insert_or_assign(MAIN_USER_ID, cfg);
+    ImeEnabledInfoManager::GetInstance().SetEnabledCache(MAIN_USER_ID, cfg);
 
     info.isNotifyInputStart = true;
     InputTypeManager::GetInstance().isStarted_ = true;
@@ -1977,7 +1993,7 @@ HWTEST_F(InputMethodPrivateMemberTest, SA_GetRealCurrentIme_001, TestSize.Level0
     ImeEnabledInfo enabledInfo1{ realPreIme->name, realPreIme->id, EnabledStatus::BASIC_MODE };
     cfg.enabledInfos.push_back(enabledInfo);
     cfg.enabledInfos.push_back(enabledInfo1);
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.insert_or_assign(MAIN_USER_ID, cfg);
+    ImeEnabledInfoManager::GetInstance().SetEnabledCache(MAIN_USER_ID, cfg);
 
     std::string bundleName2 = "bundleName2";
     std::string extName2 = "extName2";
@@ -2026,7 +2042,7 @@ HWTEST_F(InputMethodPrivateMemberTest, SA_GetRealCurrentIme_002, TestSize.Level0
     ImeEnabledInfo enabledInfo{ bundleName1, extName1, EnabledStatus::BASIC_MODE };
     enabledInfo.extraInfo.isDefaultIme = true;
     cfg.enabledInfos.push_back(enabledInfo);
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.insert_or_assign(MAIN_USER_ID, cfg);
+    ImeEnabledInfoManager::GetInstance().SetEnabledCache(MAIN_USER_ID, cfg);
 
     std::string bundleName2 = "bundleName2";
     std::string extName2 = "extName2";
@@ -2041,7 +2057,7 @@ HWTEST_F(InputMethodPrivateMemberTest, SA_GetRealCurrentIme_002, TestSize.Level0
     // input type not start, has current client, input type is security, isSimpleKeyboardEnabled is true
     info->config.inputAttribute.inputPattern = InputAttribute::PATTERN_PASSWORD;
     info->config.isSimpleKeyboardEnabled = true;
-    group->mapClients_.insert_or_assign(client->AsObject(), info);
+    group->ModifyClients([&client, &info](auto &clients) { clients.insert_or_assign(client->AsObject(), info); });
     session->clientGroupMap_.insert_or_assign(DEFAULT_DISPLAY_ID, group);
     auto ime = session->GetRealCurrentIme(true);
     ASSERT_NE(ime, nullptr);
@@ -2067,7 +2083,7 @@ HWTEST_F(InputMethodPrivateMemberTest, SA_GetRealCurrentIme_003, TestSize.Level0
     enabledInfo.extraInfo.isDefaultIme = true;
     enabledInfo.extraInfo.currentSubName = subName1;
     cfg.enabledInfos.push_back(enabledInfo);
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.insert_or_assign(MAIN_USER_ID, cfg);
+    ImeEnabledInfoManager::GetInstance().SetEnabledCache(MAIN_USER_ID, cfg);
 
     auto session = std::make_shared<PerUserSession>(MAIN_USER_ID);
     auto group = std::make_shared<ClientGroup>(DEFAULT_DISPLAY_ID, nullptr);
@@ -2076,7 +2092,7 @@ HWTEST_F(InputMethodPrivateMemberTest, SA_GetRealCurrentIme_003, TestSize.Level0
     auto info = std::make_shared<InputClientInfo>();
     info->config.inputAttribute.inputPattern = 0;
     info->config.isSimpleKeyboardEnabled = true;
-    group->mapClients_.insert_or_assign(client->AsObject(), info);
+    group->ModifyClients([&client, &info](auto &clients) { clients.insert_or_assign(client->AsObject(), info); });
     session->clientGroupMap_.insert_or_assign(DEFAULT_DISPLAY_ID, group);
 
     // preconfigured is nullptr
@@ -2462,7 +2478,7 @@ HWTEST_F(InputMethodPrivateMemberTest, SA_RestoreCurrentImeSubType, TestSize.Lev
     enabledInfo.extraInfo.isDefaultIme = true;
     enabledInfo.extraInfo.currentSubName = subName;
     cfg.enabledInfos.push_back(enabledInfo);
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.insert_or_assign(MAIN_USER_ID, cfg);
+    ImeEnabledInfoManager::GetInstance().SetEnabledCache(MAIN_USER_ID, cfg);
 
     auto session = std::make_shared<PerUserSession>(MAIN_USER_ID);
     // has no ready ime
@@ -2534,7 +2550,7 @@ HWTEST_F(InputMethodPrivateMemberTest, SA_GetRealCurrentIme_004, TestSize.Level0
     enabledInfo.extraInfo.currentSubName = subName1;
     cfg.enabledInfos.push_back(enabledInfo);
     cfg.enabledInfos.push_back(enabledInfo1);
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.insert_or_assign(MAIN_USER_ID, cfg);
+    ImeEnabledInfoManager::GetInstance().SetEnabledCache(MAIN_USER_ID, cfg);
 
     // preconfigured ime nullptr
     ImeInfoInquirer::GetInstance().systemConfig_.defaultInputMethod = "abnormal";
@@ -2611,7 +2627,7 @@ HWTEST_F(InputMethodPrivateMemberTest, SA_TryStartIme_001, TestSize.Level0)
     ImeEnabledInfo enabledInfo{ bundleName1, extName1, EnabledStatus::BASIC_MODE };
     enabledInfo.extraInfo.isDefaultIme = true;
     cfg.enabledInfos.push_back(enabledInfo);
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.insert_or_assign(MAIN_USER_ID, cfg);
+    ImeEnabledInfoManager::GetInstance().SetEnabledCache(MAIN_USER_ID, cfg);
 
     std::string bundleName2 = "bundleName2";
     std::string extName2 = "extName2";
@@ -2658,7 +2674,7 @@ HWTEST_F(InputMethodPrivateMemberTest, SA_TryDisconnectIme_001, TestSize.Level0)
     sptr<IInputClient> client = new (std::nothrow) InputClientServiceImpl();
     group->currentClient_ = client;
     auto info = std::make_shared<InputClientInfo>();
-    group->mapClients_.insert_or_assign(client->AsObject(), info);
+    group->ModifyClients([&client, &info](auto &clients) { clients.insert_or_assign(client->AsObject(), info); });
     userSession->clientGroupMap_.insert_or_assign(DEFAULT_DISPLAY_ID, group);
     ret = userSession->TryDisconnectIme();
     EXPECT_EQ(ret, ErrorCode::ERROR_OPERATION_NOT_ALLOWED);
@@ -2971,7 +2987,7 @@ HWTEST_F(InputMethodPrivateMemberTest, IMSA_IsTmpIme, TestSize.Level0)
     ImeEnabledInfo enabledInfo{ "", "extName1", EnabledStatus::BASIC_MODE };
     enabledInfo.extraInfo.isDefaultIme = true;
     cfg.enabledInfos.push_back(enabledInfo);
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.insert_or_assign(MAIN_USER_ID, cfg);
+    ImeEnabledInfoManager::GetInstance().SetEnabledCache(MAIN_USER_ID, cfg);
     // has no running ime
     userSession->imeData_.clear();
     ret = systemAbility.IsTmpIme(MAIN_USER_ID, tokenId);
@@ -2983,21 +2999,21 @@ HWTEST_F(InputMethodPrivateMemberTest, IMSA_IsTmpIme, TestSize.Level0)
     FullImeInfo info;
     info.tokenId = tokenId;
     info.prop.name = bundleName2;
-    FullImeInfoManager::GetInstance().fullImeInfos_.insert({ MAIN_USER_ID, { info } });
+    FullImeInfoManager::GetInstance().SetUser(MAIN_USER_ID, { info });
     // caller is same with running ime, but the bundleName of default ime is empty
     ret = systemAbility.IsTmpIme(MAIN_USER_ID, tokenId);
     EXPECT_FALSE(ret);
     enabledInfo.bundleName = bundleName2;
     cfg.enabledInfos.clear();
     cfg.enabledInfos.push_back(enabledInfo);
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.insert_or_assign(MAIN_USER_ID, cfg);
+    ImeEnabledInfoManager::GetInstance().SetEnabledCache(MAIN_USER_ID, cfg);
     // caller is same with running ime, the bundleName of default ime is also same with
     ret = systemAbility.IsTmpIme(MAIN_USER_ID, tokenId);
     EXPECT_FALSE(ret);
     enabledInfo.bundleName = "diffBundleName";
     cfg.enabledInfos.clear();
     cfg.enabledInfos.push_back(enabledInfo);
-    ImeEnabledInfoManager::GetInstance().imeEnabledCfg_.insert_or_assign(MAIN_USER_ID, cfg);
+    ImeEnabledInfoManager::GetInstance().SetEnabledCache(MAIN_USER_ID, cfg);
     // caller is same with running ime, but the bundleName of default ime is not same with
     ret = systemAbility.IsTmpIme(MAIN_USER_ID, tokenId);
     EXPECT_TRUE(ret);
@@ -3044,7 +3060,7 @@ HWTEST_F(InputMethodPrivateMemberTest, ImCommonEventManager_OnBundleResChanged,
     auto msgHandler = MessageHandler::Instance();
     ASSERT_NE(msgHandler, nullptr);
     while (!msgHandler->mQueue.empty()) {
-        msgHandler->mQueue.pop();
+        msgHandler->mQueue.pop_front();
     }
     AAFwk::Want want;
     int32_t type = 3;
@@ -3056,5 +3072,832 @@ HWTEST_F(InputMethodPrivateMemberTest, ImCommonEventManager_OnBundleResChanged,
     subscriber->OnBundleResChanged(data);
     EXPECT_TRUE(msgHandler->mQueue.empty());
 }
+
+/**
+ * @tc.name: SysCfgParser_Snapshot_001
+ * @tc.desc: the config files are parsed once for all the Parse* and again after Reload
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(InputMethodPrivateMemberTest, SysCfgParser_Snapshot_001, TestSize.Level0)
+{
+    IMSA_HILOGI("InputMethodPrivateMemberTest::SysCfgParser_Snapshot_001 start.");
+    SysCfgParser::Reload();
+    EXPECT_EQ(std::atomic_load(&SysCfgParser::snapshot_), nullptr);
+    SystemConfig systemConfig;
+    auto ret = SysCfgParser::ParseSystemConfig(systemConfig);
+    auto snapshot = std::atomic_load(&SysCfgParser::snapshot_);
+    ASSERT_NE(snapshot, nullptr);
+    std::vector<InputTypeInfo> inputTypes;
+    SysCfgParser::ParseInputType(inputTypes);
+    std::vector<SysPanelAdjust> panelAdjusts;
+    SysCfgParser::ParsePanelAdjust(panelAdjusts);
+    EXPECT_EQ(std::atomic_load(&SysCfgParser::snapshot_), snapshot);
+
+    SysCfgParser::Reload();
+    SystemConfig systemConfig1;
+    EXPECT_EQ(SysCfgParser::ParseSystemConfig(systemConfig1), ret);
+    EXPECT_NE(std::atomic_load(&SysCfgParser::snapshot_), snapshot);
+    EXPECT_EQ(systemConfig1.systemInputMethodConfigAbility, systemConfig.systemInputMethodConfigAbility);
+    EXPECT_EQ(systemConfig1.defaultInputMethod, systemConfig.defaultInputMethod);
+    EXPECT_EQ(systemConfig1.enableInputMethodFeature, systemConfig.enableInputMethodFeature);
+}
+
+/**
+ * @tc.name: SysCfgParser_Snapshot_002
+ * @tc.desc: a config file whose mtime moves makes the next Parse* reload the snapshot
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(InputMethodPrivateMemberTest, SysCfgParser_Snapshot_002, TestSize.Level0)
+{
+    IMSA_HILOGI("InputMethodPrivateMemberTest::SysCfgParser_Snapshot_002 start.");
+    std::string path = SYS_CFG_TEST_PATH;
+    ASSERT_TRUE(FileOperator::WriteAtomically(path, "{}"));
+    SysCfgFileStamp stamp;
+    ASSERT_TRUE(SysCfgParser::GetFileStamp(path, stamp));
+    // a snapshot read from the test file only
+    auto snapshot = std::make_shared<SysCfgSnapshot>();
+    snapshot->stamps.push_back(stamp);
+    std::atomic_store(&SysCfgParser::snapshot_, std::shared_ptr<const SysCfgSnapshot>(snapshot));
+    SystemConfig systemConfig;
+    EXPECT_FALSE(SysCfgParser::ParseSystemConfig(systemConfig));
+    EXPECT_EQ(std::atomic_load(&SysCfgParser::snapshot_), snapshot);
+
+    // only the mtime moves, the size stays the same
+    constexpr int64_t nsPerSecond = 1000000000;
+    struct timespec times[2] = { { 0, UTIME_OMIT }, { static_cast<time_t>(stamp.mtimeNs / nsPerSecond + 1), 0 } };
+    ASSERT_EQ(utimensat(AT_FDCWD, path.c_str(), times, 0), 0);
+    EXPECT_TRUE(SysCfgParser::IsChanged(*snapshot));
+    SysCfgParser::ParseSystemConfig(systemConfig);
+    auto reloaded = std::atomic_load(&SysCfgParser::snapshot_);
+    EXPECT_NE(reloaded, snapshot);
+    ASSERT_NE(reloaded, nullptr);
+    EXPECT_EQ(std::find_if(reloaded->stamps.begin(), reloaded->stamps.end(),
+                  [&path](const SysCfgFileStamp &item) { return item.path == path; }),
+        reloaded->stamps.end());
+    unlink(path.c_str());
+    SysCfgParser::Reload();
+}
+
+class NoFreezeImeStateManager : public ImeStateManager {
+public:
+    explicit NoFreezeImeStateManager(pid_t pid) : ImeStateManager(pid) { }
+
+private:
+    void ControlIme(bool shouldApply) override { }
+    void ScheduleIdle() override { }
+};
+
+// a ready fake ime, the request method decides how long its ipc takes
+static std::shared_ptr<ImeData> AddDelayedIme(const std::shared_ptr<PerUserSession> &session, ImeType type,
+    const std::string &bundleName, pid_t pid)
+{
+    sptr<InputMethodCoreStub> coreStub = new (std::nothrow) InputMethodCoreServiceImpl();
+    sptr<InputMethodAgentStub> agentStub = new (std::nothrow) InputMethodAgentServiceImpl();
+    if (coreStub == nullptr || agentStub == nullptr) {
+        return nullptr;
+    }
+    auto imeData = std::make_shared<ImeData>(coreStub, agentStub->AsObject(), nullptr, pid);
+    imeData->imeStateManager = std::make_shared<NoFreezeImeStateManager>(pid);
+    imeData->imeStatus = ImeStatus::READY;
+    imeData->ime = { bundleName, "InputMethodExtAbility" };
+    session->imeData_.insert_or_assign(type, std::vector<std::shared_ptr<ImeData>>{ imeData });
+    return imeData;
+}
+
+/**
+ * @tc.name: PerUserSession_RequestAllIme_Parallel_001
+ * @tc.desc: the ime and its mirror are requested at the same time, the cost is the slowest one, not the sum
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(InputMethodPrivateMemberTest, PerUserSession_RequestAllIme_Parallel_001, TestSize.Level0)
+{
+    IMSA_HILOGI("InputMethodPrivateMemberTest::PerUserSession_RequestAllIme_Parallel_001 start.");
+    constexpr int32_t imeDelayMs = 100;
+    constexpr int32_t mirrorDelayMs = 150;
+    auto userSession = std::make_shared<PerUserSession>(MAIN_USER_ID);
+    userSession->imeData_.clear();
+    auto ime = AddDelayedIme(userSession, ImeType::IME, "com.example.ime", 101);
+    auto mirror = AddDelayedIme(userSession, ImeType::IME_MIRROR, IME_MIRROR_NAME, 102);
+    ASSERT_NE(ime, nullptr);
+    ASSERT_NE(mirror, nullptr);
+    std::atomic<int32_t> calledNum{ 0 };
+    auto method = [&ime, &calledNum](int32_t imeRet, int32_t mirrorRet) {
+        return [&ime, &calledNum, imeRet, mirrorRet](const sptr<IInputMethodCore> &core) {
+            bool isIme = core == ime->core;
+            usleep((isIme ? imeDelayMs : mirrorDelayMs) * MS_TO_US);
+            ++calledNum;
+            return isIme ? imeRet : mirrorRet;
+        };
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    auto ret = userSession->RequestAllIme(ime, RequestType::START_INPUT,
+        method(ErrorCode::NO_ERROR, ErrorCode::ERROR_IME_NOT_STARTED));
+    auto costMs =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    EXPECT_EQ(ret, ErrorCode::NO_ERROR);
+    EXPECT_EQ(calledNum.load(), 2);
+    EXPECT_GE(costMs, mirrorDelayMs);
+    EXPECT_LT(costMs, imeDelayMs + mirrorDelayMs);
+    EXPECT_TRUE(ime->imeStateManager->IsImeInUse());
+
+    // the mirror never decides the result
+    ret = userSession->RequestAllIme(ime, RequestType::NORMAL,
+        method(ErrorCode::ERROR_IME_NOT_STARTED, ErrorCode::NO_ERROR));
+    EXPECT_EQ(ret, ErrorCode::ERROR_IME_NOT_STARTED);
+    EXPECT_EQ(calledNum.load(), 4);
+    userSession->imeData_.clear();
+}
+
+/**
+ * @tc.name: ImeRequestDispatcher_Dispatch_001
+ * @tc.desc: every task runs once and keeps its result slot, the tasks beyond the workers run on the caller
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(InputMethodPrivateMemberTest, ImeRequestDispatcher_Dispatch_001, TestSize.Level0)
+{
+    IMSA_HILOGI("InputMethodPrivateMemberTest::ImeRequestDispatcher_Dispatch_001 start.");
+    constexpr int32_t taskNum = 5;
+    constexpr int32_t delayMs = 50;
+    ImeRequestDispatcher dispatcher(2);
+    EXPECT_TRUE(dispatcher.Dispatch({}).empty());
+
+    std::atomic<int32_t> calledNum{ 0 };
+    std::vector<ImeRequestDispatcher::Task> tasks;
+    for (int32_t i = 0; i < taskNum; ++i) {
+        tasks.emplace_back([i, &calledNum]() {
+            usleep(delayMs * MS_TO_US);
+            ++calledNum;
+            return i;
+        });
+    }
+    auto results = dispatcher.Dispatch(tasks);
+    ASSERT_EQ(results.size(), taskNum);
+    for (int32_t i = 0; i < taskNum; ++i) {
+        EXPECT_EQ(results[i], i);
+    }
+    EXPECT_EQ(calledNum.load(), taskNum);
+    EXPECT_LE(dispatcher.workers_.size(), 2);
+
+    tasks[1] = nullptr;
+    results = dispatcher.Dispatch(tasks);
+    ASSERT_EQ(results.size(), taskNum);
+    EXPECT_EQ(results[1], ErrorCode::NO_ERROR);
+    EXPECT_EQ(calledNum.load(), taskNum * 2 - 1);
+}
+
+static std::vector<std::shared_ptr<InputClientInfo>> MakeClientInfos(int32_t num)
+{
+    std::vector<std::shared_ptr<InputClientInfo>> clientInfos;
+    for (int32_t i = 0; i < num; ++i) {
+        auto info = std::make_shared<InputClientInfo>();
+        info->pid = i;
+        info->client = new (std::nothrow) InputClientServiceImpl();
+        clientInfos.push_back(info);
+    }
+    return clientInfos;
+}
+
+/**
+ * @tc.name: ClientBroadcaster_Broadcast_001
+ * @tc.desc: the clients are notified in parallel, a failed or a slow client does not hold back the others
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(InputMethodPrivateMemberTest, ClientBroadcaster_Broadcast_001, TestSize.Level0)
+{
+    IMSA_HILOGI("InputMethodPrivateMemberTest::ClientBroadcaster_Broadcast_001 start.");
+    constexpr int32_t clientNum = 4;
+    constexpr int32_t delayMs = 50;
+    constexpr int32_t slowDelayMs = 400;
+    constexpr int64_t timeoutMs = 150;
+    ClientBroadcaster broadcaster(clientNum, ClientBroadcaster::DEFAULT_MAX_PENDING_NUM);
+    auto clientInfos = MakeClientInfos(clientNum);
+    // owned by the notify, the slow client outlives the broadcast
+    auto calledNum = std::make_shared<std::atomic<int32_t>>(0);
+
+    auto start = std::chrono::steady_clock::now();
+    auto failedNum = broadcaster.Broadcast("test", clientInfos, [calledNum](const auto &clientInfo) {
+        usleep(delayMs * MS_TO_US);
+        ++*calledNum;
+        return ErrorCode::NO_ERROR;
+    }, slowDelayMs * clientNum);
+    auto costMs =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    EXPECT_EQ(failedNum, 0);
+    EXPECT_EQ(calledNum->load(), clientNum);
+    EXPECT_LT(costMs, delayMs * clientNum);
+
+    start = std::chrono::steady_clock::now();
+    failedNum = broadcaster.Broadcast("test", clientInfos, [calledNum](const auto &clientInfo) {
+        usleep((clientInfo->pid == 0 ? slowDelayMs : delayMs) * MS_TO_US);
+        ++*calledNum;
+        return clientInfo->pid == 1 ? ErrorCode::ERROR_CLIENT_NOT_FOUND : ErrorCode::NO_ERROR;
+    }, timeoutMs);
+    costMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    EXPECT_EQ(failedNum, 2);
+    EXPECT_GE(costMs, timeoutMs);
+    EXPECT_LT(costMs, slowDelayMs);
+    EXPECT_EQ(calledNum->load(), clientNum * 2 - 1);
+}
+
+/**
+ * @tc.name: ClientBroadcaster_Broadcast_002
+ * @tc.desc: the notifies of one client keep their order even when the first broadcast times out
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(InputMethodPrivateMemberTest, ClientBroadcaster_Broadcast_002, TestSize.Level0)
+{
+    IMSA_HILOGI("InputMethodPrivateMemberTest::ClientBroadcaster_Broadcast_002 start.");
+    constexpr int32_t delayMs = 100;
+    struct Events {
+        std::mutex lock;
+        std::vector<std::string> names;
+    };
+    auto events = std::make_shared<Events>();
+    auto record = [events](const std::string &name, int32_t delay) {
+        return [events, name, delay](const auto &clientInfo) {
+            usleep(delay * MS_TO_US);
+            std::lock_guard<std::mutex> lock(events->lock);
+            events->names.push_back(name);
+            return ErrorCode::NO_ERROR;
+        };
+    };
+    ClientBroadcaster broadcaster(4, ClientBroadcaster::DEFAULT_MAX_PENDING_NUM);
+    auto clientInfos = MakeClientInfos(1);
+    EXPECT_EQ(broadcaster.Broadcast("start", clientInfos, record("start", delayMs), 0), 1);
+    // a direct notify waits for the queued ones instead of overtaking them
+    EXPECT_EQ(broadcaster.Send("ready", clientInfos[0], record("ready", 0)), ErrorCode::NO_ERROR);
+    EXPECT_EQ(broadcaster.Broadcast("stop", clientInfos, record("stop", 0), delayMs * 2), 0);
+    std::lock_guard<std::mutex> lock(events->lock);
+    EXPECT_EQ(events->names, std::vector<std::string>({ "start", "ready", "stop" }));
+    EXPECT_EQ(broadcaster.Broadcast("empty", {}, record("empty", 0)), 0);
+}
+
+/**
+ * @tc.name: ClientBroadcaster_Broadcast_003
+ * @tc.desc: with more clients than workers, a client which never answers holds one worker and is not waited for later
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(InputMethodPrivateMemberTest, ClientBroadcaster_Broadcast_003, TestSize.Level0)
+{
+    IMSA_HILOGI("InputMethodPrivateMemberTest::ClientBroadcaster_Broadcast_003 start.");
+    constexpr int32_t clientNum = 6;
+    constexpr int32_t delayMs = 10;
+    constexpr int64_t timeoutMs = 150;
+    auto isReleased = std::make_shared<std::atomic<bool>>(false);
+    auto calledNum = std::make_shared<std::atomic<int32_t>>(0);
+    auto notify = [isReleased, calledNum](const auto &clientInfo) {
+        // client 0 hangs until the end of the test
+        while (clientInfo->pid == 0 && !isReleased->load()) {
+            usleep(delayMs * MS_TO_US);
+        }
+        usleep(delayMs * MS_TO_US);
+        ++*calledNum;
+        return ErrorCode::NO_ERROR;
+    };
+    ClientBroadcaster broadcaster(2, ClientBroadcaster::DEFAULT_MAX_PENDING_NUM);
+    auto clientInfos = MakeClientInfos(clientNum);
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(broadcaster.Broadcast("first", clientInfos, notify, timeoutMs), 1);
+    auto costMs =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    EXPECT_GE(costMs, timeoutMs);
+    EXPECT_EQ(calledNum->load(), clientNum - 1);
+
+    // the notify of the hung client is queued, the caller only waits for the others
+    start = std::chrono::steady_clock::now();
+    EXPECT_EQ(broadcaster.Broadcast("second", clientInfos, notify, timeoutMs), 1);
+    costMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    EXPECT_LT(costMs, timeoutMs);
+    EXPECT_EQ(calledNum->load(), (clientNum - 1) * 2);
+    isReleased->store(true);
+    // once it answers again, the hung client gets both notifies
+    for (int32_t i = 0; i < timeoutMs / delayMs && calledNum->load() < clientNum * 2; ++i) {
+        usleep(delayMs * MS_TO_US);
+    }
+    EXPECT_EQ(calledNum->load(), clientNum * 2);
+}
+
+/**
+ * @tc.name: ClientBroadcaster_Broadcast_004
+ * @tc.desc: a full queue of a hung client drops the oldest notify which has a newer one of the same kind
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(InputMethodPrivateMemberTest, ClientBroadcaster_Broadcast_004, TestSize.Level0)
+{
+    IMSA_HILOGI("InputMethodPrivateMemberTest::ClientBroadcaster_Broadcast_004 start.");
+    constexpr size_t maxPendingNum = 4;
+    constexpr int32_t delayMs = 10;
+    constexpr int32_t waitTimes = 50;
+    struct Events {
+        std::mutex lock;
+        std::vector<std::string> names;
+        std::atomic<bool> isReleased{ false };
+    };
+    auto events = std::make_shared<Events>();
+    auto record = [events](const std::string &name) {
+        return [events, name](const auto &clientInfo) {
+            while (!events->isReleased.load()) {
+                usleep(delayMs * MS_TO_US);
+            }
+            std::lock_guard<std::mutex> lock(events->lock);
+            events->names.push_back(name);
+            return ErrorCode::NO_ERROR;
+        };
+    };
+    ClientBroadcaster broadcaster(1, maxPendingNum);
+    auto clientInfos = MakeClientInfos(1);
+    EXPECT_EQ(broadcaster.Broadcast("hold", clientInfos, record("hold"), 0), 1);
+    for (const auto &name : { "a1", "b1", "a2", "b2", "a3", "b3" }) {
+        usleep(delayMs * MS_TO_US);
+        EXPECT_EQ(broadcaster.Broadcast(std::string(name, 1), clientInfos, record(name), 0), 1);
+    }
+    events->isReleased.store(true);
+    std::vector<std::string> expected = { "hold", "a2", "b2", "a3", "b3" };
+    for (int32_t i = 0; i < waitTimes; ++i) {
+        {
+            std::lock_guard<std::mutex> lock(events->lock);
+            if (events->names.size() >= expected.size()) {
+                break;
+            }
+        }
+        usleep(delayMs * MS_TO_US);
+    }
+    std::lock_guard<std::mutex> lock(events->lock);
+    EXPECT_EQ(events->names, expected);
+}
+
+static void CheckClientIndexes(const std::shared_ptr<ClientGroup> &group)
+{
+    auto registry = group->GetRegistry();
+    ASSERT_NE(registry, nullptr);
+    std::set<pid_t> pids;
+    for (const auto &[object, info] : registry->clients) {
+        ASSERT_NE(info, nullptr);
+        pids.insert(info->pid);
+        auto pidIter = registry->pidIndexes.find(info->pid);
+        ASSERT_NE(pidIter, registry->pidIndexes.end());
+        EXPECT_EQ(pidIter->second->pid, info->pid);
+    }
+    EXPECT_EQ(registry->pidIndexes.size(), pids.size());
+}
+
+/**
+ * @tc.name: Test_ClientGroup_Indexes_001
+ * @tc.desc: the pid index follows register, unregister and client info updates
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(InputMethodPrivateMemberTest, Test_ClientGroup_Indexes_001, TestSize.Level0)
+{
+    IMSA_HILOGI("InputMethodPrivateMemberTest::Test_ClientGroup_Indexes_001 start.");
+    auto group = std::make_shared<ClientGroup>(DEFAULT_DISPLAY_ID, nullptr);
+    InputClientInfo clientInfo;
+    clientInfo.pid = 101;
+    clientInfo.config.windowId = 1001;
+    clientInfo.client = new (std::nothrow) InputClientServiceImpl();
+    clientInfo.deathRecipient = new (std::nothrow) InputDeathRecipient();
+    ASSERT_NE(clientInfo.client, nullptr);
+    ASSERT_NE(clientInfo.deathRecipient, nullptr);
+    auto object = clientInfo.client->AsObject();
+    EXPECT_EQ(group->AddClientInfo(object, clientInfo, PREPARE_INPUT), ErrorCode::NO_ERROR);
+    ASSERT_NE(group->GetClientInfo(clientInfo.pid), nullptr);
+    EXPECT_EQ(group->GetClientInfo(clientInfo.pid)->client, clientInfo.client);
+
+    auto config = clientInfo.config;
+    config.windowId = 1002;
+    group->UpdateClientInfo(object, { { UpdateFlag::TEXT_CONFIG, config } });
+    ASSERT_NE(group->GetClientInfo(clientInfo.pid), nullptr);
+    EXPECT_EQ(group->GetClientInfo(clientInfo.pid)->config.windowId, config.windowId);
+    CheckClientIndexes(group);
+
+    group->RemoveClientInfo(object, true);
+    EXPECT_EQ(group->GetClientInfo(clientInfo.pid), nullptr);
+    CheckClientIndexes(group);
+}
+
+/**
+ * @tc.name: Test_ClientGroup_Indexes_002
+ * @tc.desc: concurrent register, unregister and lookup leave indexes that match the client map
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(InputMethodPrivateMemberTest, Test_ClientGroup_Indexes_002, TestSize.Level0)
+{
+    IMSA_HILOGI("InputMethodPrivateMemberTest::Test_ClientGroup_Indexes_002 start.");
+    constexpr int32_t threadNum = 4;
+    constexpr int32_t clientNum = 50;
+    auto group = std::make_shared<ClientGroup>(DEFAULT_DISPLAY_ID, nullptr);
+    std::atomic<bool> isIndexBroken{ false };
+    std::vector<std::thread> threads;
+    for (int32_t t = 0; t < threadNum; ++t) {
+        threads.emplace_back([t, &group, &isIndexBroken]() {
+            for (int32_t i = 0; i < clientNum; ++i) {
+                InputClientInfo clientInfo;
+                clientInfo.pid = t * clientNum + i;
+                clientInfo.client = new (std::nothrow) InputClientServiceImpl();
+                clientInfo.deathRecipient = new (std::nothrow) InputDeathRecipient();
+                if (clientInfo.client == nullptr || clientInfo.deathRecipient == nullptr) {
+                    continue;
+                }
+                auto object = clientInfo.client->AsObject();
+                group->AddClientInfo(object, clientInfo, PREPARE_INPUT);
+                auto byPid = group->GetClientInfo(clientInfo.pid);
+                if (byPid == nullptr || byPid->client != clientInfo.client) {
+                    isIndexBroken = true;
+                }
+                // every other client leaves again
+                if (i % 2 == 0) {
+                    group->RemoveClientInfo(object, true);
+                    isIndexBroken = isIndexBroken || group->GetClientInfo(clientInfo.pid) != nullptr;
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_FALSE(isIndexBroken);
+    EXPECT_EQ(group->GetClientMap()->size(), threadNum * clientNum / 2);
+    CheckClientIndexes(group);
+}
+static Message *MakePackageMessage(int32_t msgId, int32_t userId, const std::string &packageName)
+{
+    auto parcel = new (std::nothrow) MessageParcel();
+    if (parcel == nullptr) {
+        return nullptr;
+    }
+    ITypesUtil::Marshal(*parcel, userId, packageName);
+    return new (std::nothrow) Message(msgId, parcel);
+}
+
+static std::vector<int32_t> DrainMessages(MessageHandler &handler)
+{
+    std::vector<int32_t> msgIds;
+    while (!handler.mQueue.empty()) {
+        auto msg = handler.GetMessage();
+        msgIds.push_back(msg->msgId_);
+        delete msg;
+    }
+    return msgIds;
+}
+
+/**
+ * @tc.name: MessageHandler_Coalesce_001
+ * @tc.desc: a burst of package and language events is folded into one event per package and one full refresh
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(InputMethodPrivateMemberTest, MessageHandler_Coalesce_001, TestSize.Level0)
+{
+    IMSA_HILOGI("InputMethodPrivateMemberTest::MessageHandler_Coalesce_001 start.");
+    MessageHandler handler;
+    handler.SetCoalesceKeyGetter(InputMethodSystemAbility::GetCoalesceKey);
+    constexpr int32_t packageNum = 10;
+    constexpr int32_t burstNum = 20;
+    for (int32_t i = 0; i < burstNum; ++i) {
+        for (int32_t j = 0; j < packageNum; ++j) {
+            handler.SendMessage(MakePackageMessage(MSG_ID_PACKAGE_CHANGED, MAIN_USER_ID, "ime" + std::to_string(j)));
+        }
+        handler.SendMessage(new Message(i % 2 == 0 ? MSG_ID_SYS_LANGUAGE_CHANGED : MSG_ID_BUNDLE_RESOURCES_CHANGED,
+            nullptr));
+    }
+    // not folded: another user, no content, not a foldable message
+    handler.SendMessage(MakePackageMessage(MSG_ID_PACKAGE_CHANGED, INVALID_USER_ID, "ime0"));
+    handler.SendMessage(new Message(MSG_ID_PACKAGE_CHANGED, nullptr));
+    handler.SendMessage(new Message(MSG_ID_SCREEN_LOCK, nullptr));
+    handler.SendMessage(new Message(MSG_ID_SCREEN_LOCK, nullptr));
+
+    auto stats = handler.GetCoalesceStats();
+    EXPECT_EQ(stats[MSG_ID_PACKAGE_CHANGED].receivedNum, burstNum * packageNum + 1);
+    EXPECT_EQ(stats[MSG_ID_PACKAGE_CHANGED].coalescedNum, (burstNum - 1) * packageNum);
+    EXPECT_EQ(stats[MSG_ID_SYS_LANGUAGE_CHANGED].coalescedNum + stats[MSG_ID_BUNDLE_RESOURCES_CHANGED].coalescedNum,
+        burstNum - 1);
+    EXPECT_EQ(stats.count(MSG_ID_SCREEN_LOCK), 0);
+
+    auto msgIds = DrainMessages(handler);
+    ASSERT_EQ(msgIds.size(), packageNum + 1 + 4);
+    EXPECT_EQ(std::count(msgIds.begin(), msgIds.end(), MSG_ID_PACKAGE_CHANGED), packageNum + 2);
+    EXPECT_EQ(msgIds[packageNum], MSG_ID_SYS_LANGUAGE_CHANGED);
+    EXPECT_TRUE(handler.mKeys.empty());
+}
+
+/**
+ * @tc.name: MessageHandler_Coalesce_002
+ * @tc.desc: the events of one package are only folded into the latest queued one, so they keep their order
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(InputMethodPrivateMemberTest, MessageHandler_Coalesce_002, TestSize.Level0)
+{
+    IMSA_HILOGI("InputMethodPrivateMemberTest::MessageHandler_Coalesce_002 start.");
+    MessageHandler handler;
+    handler.SetCoalesceKeyGetter(InputMethodSystemAbility::GetCoalesceKey);
+    std::vector<int32_t> sequence = { MSG_ID_PACKAGE_ADDED, MSG_ID_PACKAGE_ADDED, MSG_ID_PACKAGE_REMOVED,
+        MSG_ID_PACKAGE_ADDED, MSG_ID_PACKAGE_CHANGED, MSG_ID_PACKAGE_CHANGED };
+    for (auto msgId : sequence) {
+        handler.SendMessage(MakePackageMessage(msgId, MAIN_USER_ID, "ime"));
+    }
+    std::vector<int32_t> expected = { MSG_ID_PACKAGE_ADDED, MSG_ID_PACKAGE_REMOVED, MSG_ID_PACKAGE_ADDED,
+        MSG_ID_PACKAGE_CHANGED };
+    EXPECT_EQ(DrainMessages(handler), expected);
+
+    // once handled, the next event of the package is queued again
+    handler.SendMessage(MakePackageMessage(MSG_ID_PACKAGE_CHANGED, MAIN_USER_ID, "ime"));
+    auto msg = handler.GetMessage();
+    ASSERT_NE(msg, nullptr);
+    int32_t userId = 0;
+    std::string packageName;
+    EXPECT_TRUE(ITypesUtil::Unmarshal(*msg->msgContent_, userId, packageName));
+    EXPECT_EQ(userId, MAIN_USER_ID);
+    EXPECT_EQ(packageName, "ime");
+    delete msg;
+}
+
+/**
+ * @tc.name: ImePrestartPolicy_Budget_001
+ * @tc.desc: warm ups stop when the budget is used up, and go on after it is refilled
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(InputMethodPrivateMemberTest, ImePrestartPolicy_Budget_001, TestSize.Level0)
+{
+    IMSA_HILOGI("InputMethodPrivateMemberTest::ImePrestartPolicy_Budget_001 start.");
+    int64_t now = 0;
+    uint32_t warmUpNum = 0;
+    ImePrestartPolicy::ImeConnector connector = { []() { return false; }, [&warmUpNum]() {
+        ++warmUpNum;
+        return ErrorCode::NO_ERROR;
+    } };
+    ImePrestartPolicy policy(connector, [&now]() { return now; });
+    for (uint32_t i = 0; i < ImePrestartPolicy::MAX_BUDGET; ++i) {
+        EXPECT_TRUE(policy.OnSignal(PrestartSignal::SCREEN_UNLOCK));
+        now += ImePrestartPolicy::MIN_WARM_UP_INTERVAL;
+    }
+    EXPECT_FALSE(policy.OnSignal(PrestartSignal::SCREEN_UNLOCK));
+    EXPECT_EQ(warmUpNum, ImePrestartPolicy::MAX_BUDGET);
+
+    now = ImePrestartPolicy::BUDGET_REFILL_TIME;
+    EXPECT_TRUE(policy.OnSignal(PrestartSignal::USER_SWITCHED));
+    EXPECT_FALSE(policy.OnSignal(PrestartSignal::USER_SWITCHED));
+    auto stats = policy.GetStats();
+    EXPECT_EQ(stats.warmUpNum, ImePrestartPolicy::MAX_BUDGET + 1);
+    EXPECT_EQ(stats.skippedNum, 2);
+}
+
+/**
+ * @tc.name: ImePrestartPolicy_Skip_001
+ * @tc.desc: a burst of signals warms the ime up once, and none is done under memory pressure
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(InputMethodPrivateMemberTest, ImePrestartPolicy_Skip_001, TestSize.Level0)
+{
+    IMSA_HILOGI("InputMethodPrivateMemberTest::ImePrestartPolicy_Skip_001 start.");
+    int64_t now = 0;
+    uint32_t warmUpNum = 0;
+    ImePrestartPolicy::ImeConnector connector = { []() { return false; }, [&warmUpNum]() {
+        ++warmUpNum;
+        return ErrorCode::NO_ERROR;
+    } };
+    ImePrestartPolicy policy(connector, [&now]() { return now; });
+    EXPECT_TRUE(policy.OnSignal(PrestartSignal::SCREEN_UNLOCK));
+    now += ImePrestartPolicy::MIN_WARM_UP_INTERVAL - 1;
+    EXPECT_FALSE(policy.OnSignal(PrestartSignal::EDITOR_FOCUSED));
+    EXPECT_EQ(warmUpNum, 1);
+
+    now += ImePrestartPolicy::MIN_WARM_UP_INTERVAL;
+    policy.SetLowMemory(true);
+    EXPECT_FALSE(policy.OnSignal(PrestartSignal::EDITOR_FOCUSED));
+    policy.SetLowMemory(false);
+    EXPECT_TRUE(policy.OnSignal(PrestartSignal::EDITOR_FOCUSED));
+    EXPECT_EQ(warmUpNum, 2);
+}
+
+/**
+ * @tc.name: ImePrestartPolicy_Focus_001
+ * @tc.desc: only the focus on a process which started input recently warms the ime up
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(InputMethodPrivateMemberTest, ImePrestartPolicy_Focus_001, TestSize.Level0)
+{
+    IMSA_HILOGI("InputMethodPrivateMemberTest::ImePrestartPolicy_Focus_001 start.");
+    int64_t now = 0;
+    bool isRunning = false;
+    ImePrestartPolicy::ImeConnector connector = { [&isRunning]() { return isRunning; },
+        []() { return ErrorCode::NO_ERROR; } };
+    ImePrestartPolicy policy(connector, [&now]() { return now; });
+    constexpr int32_t editorPid = 100;
+    EXPECT_FALSE(policy.OnWindowFocused(editorPid));
+    policy.OnImeRequired(editorPid);
+    EXPECT_TRUE(policy.OnWindowFocused(editorPid));
+
+    // the oldest editor is forgotten
+    for (size_t i = 1; i <= ImePrestartPolicy::MAX_EDITOR_PID_NUM; ++i) {
+        policy.OnImeRequired(editorPid + static_cast<int32_t>(i));
+    }
+    now += ImePrestartPolicy::MIN_WARM_UP_INTERVAL;
+    EXPECT_FALSE(policy.OnWindowFocused(editorPid));
+    EXPECT_TRUE(policy.OnWindowFocused(editorPid + 1));
+
+    isRunning = true;
+    policy.OnImeRequired(editorPid);
+    auto stats = policy.GetStats();
+    EXPECT_EQ(stats.coldStartNum, ImePrestartPolicy::MAX_EDITOR_PID_NUM + 1);
+    EXPECT_EQ(stats.warmStartNum, 1);
+    EXPECT_EQ(stats.warmUpNum, 2);
+    EXPECT_EQ(policy.Dump(), "warm up: 2, skipped: 0, warm start: 1, cold start: 9\n");
+}
+
+/**
+ * @tc.name: SettingsDataUtils_HelperPool_001
+ * @tc.desc: reads and writes of an uri share one helper until it is idle
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(InputMethodPrivateMemberTest, SettingsDataUtils_HelperPool_001, TestSize.Level0)
+{
+    IMSA_HILOGI("InputMethodPrivateMemberTest::SettingsDataUtils_HelperPool_001 start.");
+    auto &utils = SettingsDataUtils::GetInstance();
+    sptr<IInputClient> client = new (std::nothrow) InputClientServiceImpl();
+    ASSERT_NE(client, nullptr);
+    utils.remoteObj_ = client->AsObject();
+    utils.ReleaseIdleHelpers(0);
+    DataShare::DataShareHelper::creatorNum_ = 0;
+    constexpr int32_t readNum = 3;
+    std::string value;
+    for (int32_t i = 0; i < readNum; ++i) {
+        EXPECT_EQ(utils.GetStringValue(SETTING_URI_PROXY, SettingsDataUtils::ENABLE_IME, value), ErrorCode::NO_ERROR);
+    }
+    EXPECT_TRUE(utils.SetStringValue(SETTING_URI_PROXY, SettingsDataUtils::ENABLE_IME, value));
+    EXPECT_EQ(DataShare::DataShareHelper::creatorNum_, 1);
+    std::string userUri = SETTINGS_USER_DATA_URI + std::to_string(MAIN_USER_ID) + "?Proxy=true";
+    EXPECT_EQ(utils.GetStringValue(userUri, SettingsDataUtils::ENABLE_IME, value), ErrorCode::NO_ERROR);
+    EXPECT_EQ(DataShare::DataShareHelper::creatorNum_, 2);
+
+    for (auto &pooled : utils.helperPool_) {
+        pooled.second.lastUsedTime -= SettingsDataUtils::HELPER_IDLE_TIME;
+    }
+    utils.ReleaseIdleHelpers(SettingsDataUtils::HELPER_IDLE_TIME);
+    EXPECT_TRUE(utils.helperPool_.empty());
+    EXPECT_EQ(utils.GetStringValue(SETTING_URI_PROXY, SettingsDataUtils::ENABLE_IME, value), ErrorCode::NO_ERROR);
+    EXPECT_EQ(DataShare::DataShareHelper::creatorNum_, 3);
+    utils.ReleaseIdleHelpers(0);
+    utils.remoteObj_ = nullptr;
+}
+
+/**
+ * @tc.name: SettingsDataUtils_HelperPool_002
+ * @tc.desc: the keys read together query one by one on one pooled helper, and a failed query drops the helper
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(InputMethodPrivateMemberTest, SettingsDataUtils_HelperPool_002, TestSize.Level0)
+{
+    IMSA_HILOGI("InputMethodPrivateMemberTest::SettingsDataUtils_HelperPool_002 start.");
+    auto &utils = SettingsDataUtils::GetInstance();
+    sptr<IInputClient> client = new (std::nothrow) InputClientServiceImpl();
+    ASSERT_NE(client, nullptr);
+    utils.remoteObj_ = client->AsObject();
+    utils.ReleaseIdleHelpers(0);
+    DataShare::DataShareHelper::creatorNum_ = 0;
+    DataShare::DataShareHelper::queryNum_ = 0;
+    DataShare::DataShareHelper::values_ = { { SettingsDataUtils::ENABLE_IME, "enableTable" },
+        { SettingsDataUtils::SECURITY_MODE, "fullExperienceTable" } };
+    std::map<std::string, std::string> values;
+    EXPECT_EQ(utils.GetStringValues(SETTING_URI_PROXY, {}, values), ErrorCode::NO_ERROR);
+    EXPECT_EQ(DataShare::DataShareHelper::creatorNum_, 0);
+    EXPECT_EQ(utils.GetStringValues(
+        SETTING_URI_PROXY, { SettingsDataUtils::ENABLE_IME, SettingsDataUtils::SECURITY_MODE }, values),
+        ErrorCode::NO_ERROR);
+    EXPECT_EQ(values, (std::map<std::string, std::string>({ { SettingsDataUtils::ENABLE_IME, "enableTable" },
+        { SettingsDataUtils::SECURITY_MODE, "fullExperienceTable" } })));
+    EXPECT_EQ(DataShare::DataShareHelper::queryNum_, 2);
+    EXPECT_EQ(DataShare::DataShareHelper::creatorNum_, 1);
+    std::string enableTable;
+    EXPECT_EQ(utils.GetStringValue(SETTING_URI_PROXY, SettingsDataUtils::ENABLE_IME, enableTable),
+        ErrorCode::NO_ERROR);
+    EXPECT_EQ(enableTable, "enableTable");
+    EXPECT_EQ(DataShare::DataShareHelper::queryNum_, 3);
+    EXPECT_EQ(DataShare::DataShareHelper::creatorNum_, 1);
+
+    // the keys after a failed query are not read
+    DataShare::DataShareHelper::isQueryFailed_ = true;
+    values.clear();
+    EXPECT_EQ(utils.GetStringValues(
+        SETTING_URI_PROXY, { SettingsDataUtils::ENABLE_IME, SettingsDataUtils::SECURITY_MODE }, values),
+        ErrorCode::ERROR_NULL_POINTER);
+    EXPECT_TRUE(values.empty());
+    EXPECT_EQ(DataShare::DataShareHelper::queryNum_, 4);
+    EXPECT_TRUE(utils.helperPool_.empty());
+    std::string value;
+    DataShare::DataShareHelper::isQueryFailed_ = false;
+    EXPECT_EQ(utils.GetStringValue(SETTING_URI_PROXY, SettingsDataUtils::ENABLE_IME, value), ErrorCode::NO_ERROR);
+    EXPECT_EQ(value, "enableTable");
+    EXPECT_EQ(DataShare::DataShareHelper::creatorNum_, 2);
+    DataShare::DataShareHelper::values_.clear();
+    utils.ReleaseIdleHelpers(0);
+    utils.remoteObj_ = nullptr;
+}
+
+/**
+ * @tc.name: FileOperator_WriteAtomically_001
+ * @tc.desc: a crash at any stage of a write leaves the whole old or new content, never a torn one
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(InputMethodPrivateMemberTest, FileOperator_WriteAtomically_001, TestSize.Level0)
+{
+    IMSA_HILOGI("InputMethodPrivateMemberTest::FileOperator_WriteAtomically_001 start.");
+    std::string path = ATOMIC_WRITE_TEST_PATH;
+    std::string tempPath = path + ".tmp";
+    std::string oldContent = "{\"imeCfgList\":[]}";
+    std::string newContent = "{\"imeCfgList\":[{\"userId\":100,\"currentIme\":\"bundleName/extName\"}]}";
+    std::vector<std::pair<FileOperator::WriteStage, std::string>> crashes = {
+        { FileOperator::WriteStage::TEMP_WRITTEN, oldContent },
+        { FileOperator::WriteStage::TEMP_SYNCED, oldContent },
+        { FileOperator::WriteStage::RENAMED, newContent },
+    };
+    for (const auto &crash : crashes) {
+        ASSERT_TRUE(FileOperator::WriteAtomically(path, oldContent));
+        FileOperator::writeStageHook_ = [&crash, &tempPath](FileOperator::WriteStage stage) {
+            if (stage != crash.first) {
+                return true;
+            }
+            if (stage == FileOperator::WriteStage::TEMP_WRITTEN) {
+                // the crash tore the temp file too
+                truncate(tempPath.c_str(), 1);
+            }
+            return false;
+        };
+        EXPECT_FALSE(FileOperator::WriteAtomically(path, newContent));
+        FileOperator::writeStageHook_ = nullptr;
+        std::string content;
+        EXPECT_TRUE(FileOperator::Read(path, content));
+        EXPECT_EQ(content, crash.second);
+    }
+    // a temp file left by a crash does not block the next write
+    EXPECT_TRUE(FileOperator::WriteAtomically(path, newContent));
+    std::string content;
+    EXPECT_TRUE(FileOperator::Read(path, content));
+    EXPECT_EQ(content, newContent);
+    EXPECT_FALSE(FileOperator::IsExist(tempPath));
+    unlink(tempPath.c_str());
+    unlink(path.c_str());
+}
+
+/**
+ * @tc.name: ImeCfgManager_Flush_001
+ * @tc.desc: changes in a row are written once after a delay, or at once by a flush
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(InputMethodPrivateMemberTest, ImeCfgManager_Flush_001, TestSize.Level0)
+{
+    IMSA_HILOGI("InputMethodPrivateMemberTest::ImeCfgManager_Flush_001 start.");
+    std::string backup;
+    bool hasBackup = FileOperator::IsExist(IME_CFG_FILE_PATH) && FileOperator::Read(IME_CFG_FILE_PATH, backup);
+    auto &cfgManager = ImeCfgManager::GetInstance();
+    auto runner = AppExecFwk::EventRunner::Create("test_ImeCfgFlush");
+    cfgManager.SetEventHandler(std::make_shared<AppExecFwk::EventHandler>(runner));
+    cfgManager.imeConfigs_ = { { 100, "ime0", "subName0", false }, { 101, "ime1", "subName1", false },
+        { 102, "ime2", "subName2", false } };
+    cfgManager.DeleteImeCfg(100);
+    cfgManager.DeleteImeCfg(101);
+    EXPECT_TRUE(cfgManager.isDirty_);
+    EXPECT_TRUE(cfgManager.isWritePosted_);
+    EXPECT_EQ(cfgManager.GetImeCfg(100).userId, ImePersistInfo::INVALID_USERID);
+    EXPECT_EQ(cfgManager.GetImeCfg(102).currentIme, "ime2");
+    // replaced by the tests with the same size and other users
+    cfgManager.imeConfigs_ = { { 103, "ime3", "subName3", false } };
+    EXPECT_EQ(cfgManager.GetImeCfg(102).userId, ImePersistInfo::INVALID_USERID);
+    EXPECT_EQ(cfgManager.GetImeCfg(103).currentIme, "ime3");
+
+    cfgManager.Flush();
+    EXPECT_FALSE(cfgManager.isDirty_);
+    std::string content;
+    EXPECT_TRUE(FileOperator::Read(IME_CFG_FILE_PATH, content));
+    EXPECT_EQ(content, cfgManager.PackageImeCfg());
+    usleep((ImeCfgManager::WRITE_DELAY + WAIT_ATTACH_FINISH_DELAY) * MS_TO_US);
+    EXPECT_FALSE(cfgManager.isWritePosted_);
+
+    cfgManager.SetEventHandler(nullptr);
+    cfgManager.imeConfigs_.clear();
+    if (hasBackup) {
+        FileOperator::WriteAtomically(IME_CFG_FILE_PATH, backup);
+    } else {
+        unlink(IME_CFG_FILE_PATH);
+    }
+}
 } // namespace MiscServices
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
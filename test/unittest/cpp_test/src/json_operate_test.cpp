@@ -715,5 +715,42 @@ HWTEST_F(JsonOperateTest, testParseSystemConfigUidList, TestSize.Level1)
     uid = 5521;
     EXPECT_TRUE(systemConfig.proxyImeUidList.find(uid) != systemConfig.proxyImeUidList.end());
 }
+
+/**
+ * @tc.name: testParseLargeArray001
+ * @tc.desc: arrays are read in order, up to maxNum, and a bad item does not stop the others
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(JsonOperateTest, testParseLargeArray001, TestSize.Level1)
+{
+    IMSA_HILOGI("JsonOperateTest testParseLargeArray001 START");
+    constexpr int32_t entryNum = 1000;
+    constexpr int32_t maxNum = 10;
+    std::string content = "{\"values\":[";
+    for (int32_t i = 0; i < entryNum; ++i) {
+        content += (i == 0 ? "" : ",") + (i == 1 ? std::string("\"bad\"") : std::to_string(i));
+    }
+    content += "]}";
+    auto root = cJSON_Parse(content.c_str());
+    ASSERT_NE(root, nullptr);
+    std::vector<int32_t> values;
+    EXPECT_FALSE(Serializable::GetValue(root, "values", values));
+    ASSERT_EQ(values.size(), entryNum);
+    EXPECT_EQ(values[0], 0);
+    EXPECT_EQ(values[2], 2);
+    EXPECT_EQ(values[entryNum - 1], entryNum - 1);
+
+    std::vector<int32_t> limitedValues;
+    Serializable::GetValue(root, "values", limitedValues, maxNum);
+    ASSERT_EQ(limitedValues.size(), maxNum);
+    EXPECT_EQ(limitedValues[maxNum - 1], maxNum - 1);
+
+    std::unordered_set<int32_t> valueSet;
+    Serializable::GetValue(root, "values", valueSet, maxNum);
+    EXPECT_EQ(valueSet.size(), maxNum - 1);
+    EXPECT_EQ(valueSet.count(1), 0);
+    cJSON_Delete(root);
+}
 } // namespace MiscServices
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
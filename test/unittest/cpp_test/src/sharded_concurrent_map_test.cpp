@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sharded_concurrent_map.h"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace testing::ext;
+namespace OHOS {
+namespace MiscServices {
+constexpr int32_t THREAD_NUM = 8;
+constexpr int32_t ROUNDS = 10000;
+constexpr int32_t KEY_NUM = 100;
+class ShardedConcurrentMapTest : public testing::Test {};
+
+/**
+ * @tc.name: testBasic_001
+ * @tc.desc: the ConcurrentMap api on a sharded map
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(ShardedConcurrentMapTest, testBasic_001, TestSize.Level0)
+{
+    ShardedConcurrentMap<int32_t, std::string> map;
+    EXPECT_TRUE(map.Empty());
+    EXPECT_TRUE(map.Emplace(1, "a"));
+    EXPECT_FALSE(map.Emplace(1, "b"));
+    EXPECT_TRUE(map.InsertOrAssign(2, std::string("b")));
+    EXPECT_TRUE(map.Insert(3, "c"));
+    EXPECT_FALSE(map.Insert(3, "d"));
+    EXPECT_EQ(map.Size(), 3);
+    auto [isFound, value] = map.Find(1);
+    EXPECT_TRUE(isFound);
+    EXPECT_EQ(value, "a");
+    EXPECT_FALSE(map.Find(4).first);
+    EXPECT_TRUE(map.Contains(2));
+    EXPECT_EQ(map.Erase(2), 1);
+    EXPECT_FALSE(map.Contains(2));
+    EXPECT_EQ(map.EraseIf([](const int32_t &key, std::string &value) { return key == 3; }), 1);
+    EXPECT_EQ(map.Size(), 1);
+    map.Clear();
+    EXPECT_TRUE(map.Empty());
+}
+
+/**
+ * @tc.name: testCompute_001
+ * @tc.desc: Compute, ComputeIfPresent and ComputeIfAbsent change the value in place or drop it
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(ShardedConcurrentMapTest, testCompute_001, TestSize.Level0)
+{
+    ShardedConcurrentHashMap<int32_t, std::string> map;
+    EXPECT_TRUE(map.Compute(1, [](const int32_t &key, std::string &value) {
+        value = "a";
+        return true;
+    }));
+    EXPECT_TRUE(map.ComputeIfPresent(1, [](const int32_t &key, std::string &value) {
+        value += "b";
+        return true;
+    }));
+    EXPECT_EQ(map.Find(1).second, "ab");
+    EXPECT_FALSE(map.ComputeIfPresent(2, [](const int32_t &key, std::string &value) { return true; }));
+    EXPECT_TRUE(map.ComputeIfPresent(1, [](const int32_t &key, std::string &value) { return false; }));
+    EXPECT_FALSE(map.Contains(1));
+    EXPECT_TRUE(map.ComputeIfAbsent(3, [](const int32_t &key) { return std::string("c"); }));
+    EXPECT_FALSE(map.ComputeIfAbsent(3, [](const int32_t &key) { return std::string("d"); }));
+    EXPECT_FALSE(map.ComputeIfAbsent(4, [](const int32_t &key, std::string &value) { return false; }));
+    EXPECT_FALSE(map.Contains(4));
+    std::string result;
+    EXPECT_TRUE(map.FindShared(3, [&result](const int32_t &key, const std::string &value) { result = value; }));
+    EXPECT_EQ(result, "c");
+    EXPECT_FALSE(map.FindShared(4, [](const int32_t &key, const std::string &value) {}));
+}
+
+/**
+ * @tc.name: testForEach_001
+ * @tc.desc: every shard is visited and returning true stops the traversal
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(ShardedConcurrentMapTest, testForEach_001, TestSize.Level0)
+{
+    ShardedConcurrentMap<int32_t, int32_t> map;
+    for (int32_t i = 0; i < KEY_NUM; ++i) {
+        map.Insert(i, i);
+    }
+    int32_t sum = 0;
+    map.ForEachShared([&sum](const int32_t &key, const int32_t &value) {
+        sum += value;
+        return false;
+    });
+    EXPECT_EQ(sum, KEY_NUM * (KEY_NUM - 1) / 2);
+    int32_t count = 0;
+    map.ForEach([&count](const int32_t &key, int32_t &value) {
+        value = 0;
+        return ++count == KEY_NUM / 2;
+    });
+    EXPECT_EQ(count, KEY_NUM / 2);
+    ShardedConcurrentMap<int32_t, int32_t> copy(map);
+    EXPECT_EQ(copy.Size(), KEY_NUM);
+    ShardedConcurrentMap<int32_t, int32_t> moved(std::move(copy));
+    EXPECT_EQ(moved.Size(), KEY_NUM);
+}
+
+/**
+ * @tc.name: testConcurrentCompute_001
+ * @tc.desc: no update is lost when readers and writers share the keys
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(ShardedConcurrentMapTest, testConcurrentCompute_001, TestSize.Level1)
+{
+    ShardedConcurrentHashMap<int32_t, int32_t> map;
+    std::vector<std::thread> threads;
+    for (int32_t i = 0; i < THREAD_NUM; ++i) {
+        threads.emplace_back([&map]() {
+            for (int32_t j = 0; j < ROUNDS; ++j) {
+                map.Compute(j % KEY_NUM, [](const int32_t &key, int32_t &value) {
+                    ++value;
+                    return true;
+                });
+                map.Find(j % KEY_NUM);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    int32_t sum = 0;
+    map.ForEachShared([&sum](const int32_t &key, const int32_t &value) {
+        sum += value;
+        return false;
+    });
+    EXPECT_EQ(sum, THREAD_NUM * ROUNDS);
+}
+} // namespace MiscServices
+} // namespace OHOS
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "global.h"
+#include "shared_message_buffer.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace MiscServices {
+constexpr int32_t BUFFER_CAPACITY = 1024 * 1024;
+constexpr uint32_t SMALL_SIZE = 1024;
+class SharedMessageBufferTest : public testing::Test {
+public:
+    void SetUp()
+    {
+        IMSA_HILOGI("SharedMessageBufferTest::SetUp");
+    }
+    void TearDown()
+    {
+        IMSA_HILOGI("SharedMessageBufferTest::TearDown");
+    }
+    static std::vector<uint8_t> MakePayload(size_t size, uint8_t seed)
+    {
+        std::vector<uint8_t> payload(size);
+        for (size_t i = 0; i < size; ++i) {
+            payload[i] = static_cast<uint8_t>(seed + i);
+        }
+        return payload;
+    }
+};
+
+/**
+ * @tc.name: testWriteRead_001
+ * @tc.desc: payload written by the owner can be read by the attached peer
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SharedMessageBufferTest, testWriteRead_001, TestSize.Level0)
+{
+    auto writer = SharedMessageBuffer::Create(BUFFER_CAPACITY);
+    ASSERT_NE(writer, nullptr);
+    auto reader = SharedMessageBuffer::Attach(writer->GetAshmem());
+    ASSERT_NE(reader, nullptr);
+    EXPECT_EQ(reader->GetCapacity(), BUFFER_CAPACITY);
+
+    auto payload = MakePayload(SMALL_SIZE, 1);
+    uint32_t offset = 0;
+    ASSERT_TRUE(writer->Write(payload, offset));
+    std::vector<uint8_t> result;
+    ASSERT_TRUE(reader->Read(offset, SMALL_SIZE, result));
+    EXPECT_EQ(result, payload);
+}
+
+/**
+ * @tc.name: testWrap_001
+ * @tc.desc: a message which does not fit into the tail starts over from the head
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SharedMessageBufferTest, testWrap_001, TestSize.Level0)
+{
+    auto writer = SharedMessageBuffer::Create(BUFFER_CAPACITY);
+    ASSERT_NE(writer, nullptr);
+    auto reader = SharedMessageBuffer::Attach(writer->GetAshmem());
+    ASSERT_NE(reader, nullptr);
+
+    uint32_t offset = 0;
+    auto first = MakePayload(BUFFER_CAPACITY / 2 + 1, 1);
+    ASSERT_TRUE(writer->Write(first, offset));
+    EXPECT_EQ(offset, 0u);
+    auto second = MakePayload(BUFFER_CAPACITY / 2, 2);
+    ASSERT_TRUE(writer->Write(second, offset));
+    EXPECT_EQ(offset, 0u);
+    std::vector<uint8_t> result;
+    ASSERT_TRUE(reader->Read(offset, second.size(), result));
+    EXPECT_EQ(result, second);
+
+    auto third = MakePayload(SMALL_SIZE, 3);
+    ASSERT_TRUE(writer->Write(third, offset));
+    EXPECT_EQ(offset, second.size());
+}
+
+/**
+ * @tc.name: testInvalidRegion_001
+ * @tc.desc: out of range regions and oversized payloads are rejected
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SharedMessageBufferTest, testInvalidRegion_001, TestSize.Level0)
+{
+    EXPECT_EQ(SharedMessageBuffer::Create(0), nullptr);
+    EXPECT_EQ(SharedMessageBuffer::Attach(nullptr), nullptr);
+    auto writer = SharedMessageBuffer::Create(BUFFER_CAPACITY);
+    ASSERT_NE(writer, nullptr);
+    uint32_t offset = 0;
+    EXPECT_FALSE(writer->Write({}, offset));
+    EXPECT_FALSE(writer->Write(MakePayload(BUFFER_CAPACITY + 1, 0), offset));
+
+    std::vector<uint8_t> result;
+    EXPECT_FALSE(writer->Read(0, 0, result));
+    EXPECT_FALSE(writer->Read(BUFFER_CAPACITY, 1, result));
+    EXPECT_FALSE(writer->Read(1, BUFFER_CAPACITY, result));
+    EXPECT_FALSE(writer->Read(UINT32_MAX, UINT32_MAX, result));
+}
+} // namespace MiscServices
+} // namespace OHOS
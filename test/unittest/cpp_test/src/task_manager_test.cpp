@@ -21,11 +21,17 @@
 #include "tasks/task_inner.h"
 #undef private
 #undef protected
+#include "tasks/task_imsa.h"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <gtest/gtest.h>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #include "global.h"
 
@@ -34,6 +40,69 @@ namespace MiscServices {
 
 using namespace testing::ext;
 
+class TraceTask : public Task {
+public:
+    TraceTask(TaskType type, uint32_t execUs, std::function<void(const Task &)> onExecute) : Task(type)
+    {
+        isSupersedable_ = type == TASK_TYPE_IMSA_CURSOR_UPDATE || type == TASK_TYPE_IMSA_SELECTION_CHANGE;
+        auto func = [this, execUs, onExecute]() {
+            if (onExecute != nullptr) {
+                onExecute(*this);
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(execUs));
+        };
+        actions_.push_back(std::make_unique<Action>(func));
+    }
+    ~TraceTask() override = default;
+};
+
+class SelectionListener : public KeyboardListener {
+public:
+    bool OnDealKeyEvent(
+        const std::shared_ptr<MMI::KeyEvent> &keyEvent, uint64_t cbId, const sptr<IRemoteObject> &channelObject) override
+    {
+        return false;
+    }
+    bool OnKeyEvent(int32_t keyCode, int32_t keyStatus, sptr<KeyEventConsumerProxy> &consumer) override
+    {
+        return false;
+    }
+    bool OnKeyEvent(const std::shared_ptr<MMI::KeyEvent> &keyEvent, sptr<KeyEventConsumerProxy> &consumer) override
+    {
+        return false;
+    }
+    void OnCursorUpdate(int32_t positionX, int32_t positionY, int32_t height) override { }
+    void OnSelectionChange(int32_t oldBegin, int32_t oldEnd, int32_t newBegin, int32_t newEnd) override
+    {
+        ranges.push_back({ oldBegin, oldEnd, newBegin, newEnd });
+    }
+    void OnTextChange(const std::string &text) override { }
+    void OnEditorAttributeChange(const InputAttribute &inputAttribute) override { }
+
+    std::vector<std::vector<int32_t>> ranges;
+};
+
+// recorded while typing fast in an edit box: the cursor and selection updates arrive faster than the ime handles them
+struct TraceEvent {
+    uint32_t gapUs;
+    TaskType type;
+    uint32_t repeatNum;
+};
+static const TraceEvent TYPING_TRACE[] = {
+    { 0, TASK_TYPE_IMSA_START_INPUT, 1 },
+    { 500, TASK_TYPE_IMSA_CURSOR_UPDATE, 20 },
+    { 0, TASK_TYPE_IMSA_SHOW_KEYBOARD, 1 },
+    { 500, TASK_TYPE_IMSA_SELECTION_CHANGE, 20 },
+    { 0, TASK_TYPE_IMSA_HIDE_KEYBOARD, 1 },
+    { 300, TASK_TYPE_IMSA_CURSOR_UPDATE, 10 },
+    { 300, TASK_TYPE_IMSA_SELECTION_CHANGE, 10 },
+    { 0, TASK_TYPE_IMSA_SHOW_KEYBOARD, 1 },
+    { 500, TASK_TYPE_IMSA_CURSOR_UPDATE, 20 },
+    { 0, TASK_TYPE_IMSA_SHOW_KEYBOARD, 1 },
+};
+constexpr uint32_t TRACE_TASK_EXEC_US = 2000;
+constexpr uint32_t TRACE_SHOW_NUM = 3;
+
 class TaskManagerTest : public testing::Test {
 public:
     void SetUp() override
@@ -48,6 +117,43 @@ public:
         mgr.reset();
     }
 
+    // replays the trace on a virtual clock, the test thread plays the work thread: a task arrives after its gap
+    // and runs TRACE_TASK_EXEC_US, returns the time from queued to started of every keyboard show
+    std::vector<int64_t> ReplayTrace(SchedulePolicy policy)
+    {
+        auto nowUs = std::make_shared<int64_t>(0);
+        auto latencies = std::make_shared<std::vector<int64_t>>();
+        auto onExecute = [nowUs, latencies](const Task &task) {
+            if (task.GetType() == TASK_TYPE_IMSA_SHOW_KEYBOARD) {
+                latencies->push_back(*nowUs - task.GetQueuedTime());
+            }
+        };
+        mgr->SetSchedulePolicy(policy);
+        int64_t idleUs = 0; // when the work thread is done with its current task
+        auto runUntil = [this, nowUs, &idleUs](int64_t untilUs) {
+            while (!mgr->imsaTasks_.empty() && idleUs <= untilUs) {
+                auto task = mgr->imsaTasks_.front();
+                mgr->imsaTasks_.pop_front();
+                *nowUs = idleUs;
+                task->Execute();
+                idleUs += TRACE_TASK_EXEC_US;
+            }
+        };
+        int64_t arrivalUs = 0;
+        for (const auto &event : TYPING_TRACE) {
+            for (uint32_t i = 0; i < event.repeatNum; ++i) {
+                arrivalUs += event.gapUs;
+                runUntil(arrivalUs);
+                idleUs = std::max(idleUs, arrivalUs);
+                auto task = std::make_shared<TraceTask>(event.type, 0, onExecute);
+                task->MarkQueued(arrivalUs);
+                mgr->Enqueue(task);
+            }
+        }
+        runUntil(std::numeric_limits<int64_t>::max());
+        return *latencies;
+    }
+
 public:
     std::unique_ptr<TaskManager> mgr;
 };
@@ -326,5 +432,109 @@ HWTEST_F(TaskManagerTest, ProcessNextAmsTask_002, TestSize.Level0)
     EXPECT_EQ(mgr->curTask_->GetState(), RUNNING_STATE_PAUSED);
 }
 
+/**
+ * @tc.name: EnqueueImsaTask_001
+ * @tc.desc: a supersedable task replaces the queued one of the same type, a show overtakes the low priority tasks
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(TaskManagerTest, EnqueueImsaTask_001, TestSize.Level0)
+{
+    IMSA_HILOGI("TaskManagerTest EnqueueImsaTask_001 START");
+    auto startInput = std::make_shared<TraceTask>(TASK_TYPE_IMSA_START_INPUT, 0, nullptr);
+    auto cursor1 = std::make_shared<TraceTask>(TASK_TYPE_IMSA_CURSOR_UPDATE, 0, nullptr);
+    auto selection = std::make_shared<TraceTask>(TASK_TYPE_IMSA_SELECTION_CHANGE, 0, nullptr);
+    auto cursor2 = std::make_shared<TraceTask>(TASK_TYPE_IMSA_CURSOR_UPDATE, 0, nullptr);
+    auto show = std::make_shared<TraceTask>(TASK_TYPE_IMSA_SHOW_KEYBOARD, 0, nullptr);
+    for (const auto &task : { startInput, cursor1, selection, cursor2, show }) {
+        mgr->EnqueueImsaTask(task);
+    }
+    std::list<task_ptr_t> expected = { startInput, show, selection, cursor2 };
+    EXPECT_EQ(mgr->imsaTasks_, expected);
+    EXPECT_EQ(mgr->GetTaskStats()[TASK_TYPE_IMSA_CURSOR_UPDATE].coalescedNum, 1);
+
+    mgr->imsaTasks_.clear();
+    mgr->SetSchedulePolicy(SchedulePolicy::FIFO);
+    for (const auto &task : { startInput, cursor1, selection, cursor2, show }) {
+        mgr->EnqueueImsaTask(task);
+    }
+    expected = { startInput, cursor1, selection, cursor2, show };
+    EXPECT_EQ(mgr->imsaTasks_, expected);
+}
+
+/**
+ * @tc.name: EnqueueImsaTask_002
+ * @tc.desc: a coalesced selection change reports the range the ime saw last and the latest range
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(TaskManagerTest, EnqueueImsaTask_002, TestSize.Level0)
+{
+    IMSA_HILOGI("TaskManagerTest EnqueueImsaTask_002 START");
+    auto listener = std::make_shared<SelectionListener>();
+    InputMethodAbility::GetInstance().SetKdListener(listener);
+    mgr->EnqueueImsaTask(std::make_shared<TaskImsaOnSelectionChange>(u"abc", 0, 0, 1, 1));
+    mgr->EnqueueImsaTask(std::make_shared<TaskImsaOnSelectionChange>(u"abc", 1, 1, 2, 2));
+    mgr->EnqueueImsaTask(std::make_shared<TaskImsaOnSelectionChange>(u"abc", 2, 2, 1, 3));
+    ASSERT_EQ(mgr->imsaTasks_.size(), 1);
+    EXPECT_EQ(mgr->imsaTasks_.front()->Execute(), RUNNING_STATE_COMPLETED);
+    EXPECT_EQ(listener->ranges, std::vector<std::vector<int32_t>>({ { 0, 0, 1, 3 } }));
+    InputMethodAbility::GetInstance().SetKdListener(nullptr);
+}
+
+/**
+ * @tc.name: ProcessNextImsaTask_001
+ * @tc.desc: a task not started before its deadline is dropped
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(TaskManagerTest, ProcessNextImsaTask_001, TestSize.Level0)
+{
+    IMSA_HILOGI("TaskManagerTest ProcessNextImsaTask_001 START");
+    auto isExecuted = std::make_shared<std::atomic<bool>>(false);
+    auto task = std::make_shared<TraceTask>(TASK_TYPE_IMSA_SEND_PRIVATE_COMMAND, 0, [isExecuted](const Task &) {
+        isExecuted->store(true);
+    });
+    task->SetDeadline(10);
+    mgr->SetInited(true);
+    mgr->PostTask(std::make_shared<TraceTask>(TASK_TYPE_IMSA_START_INPUT, 50000, nullptr));
+    mgr->PostTask(task);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_FALSE(isExecuted->load());
+    auto stats = mgr->GetTaskStats();
+    EXPECT_EQ(stats[TASK_TYPE_IMSA_SEND_PRIVATE_COMMAND].expiredNum, 1);
+    EXPECT_EQ(stats[TASK_TYPE_IMSA_START_INPUT].executedNum, 1);
+    EXPECT_GE(stats[TASK_TYPE_IMSA_START_INPUT].maxExecUs, 50000);
+}
+
+/**
+ * @tc.name: ReplayTrace_001
+ * @tc.desc: replay a typing trace, the keyboard shows wait less with the priority policy than in arrival order
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(TaskManagerTest, ReplayTrace_001, TestSize.Level0)
+{
+    IMSA_HILOGI("TaskManagerTest ReplayTrace_001 START");
+    auto fifoLatencies = ReplayTrace(SchedulePolicy::FIFO);
+    auto fifoStats = mgr->GetTaskStats();
+    mgr = std::make_unique<TaskManager>();
+    auto priorityLatencies = ReplayTrace(SchedulePolicy::PRIORITY);
+    auto priorityStats = mgr->GetTaskStats();
+    ASSERT_EQ(fifoLatencies.size(), TRACE_SHOW_NUM);
+    ASSERT_EQ(priorityLatencies.size(), TRACE_SHOW_NUM);
+
+    auto fifoMaxUs = *std::max_element(fifoLatencies.begin(), fifoLatencies.end());
+    auto priorityMaxUs = *std::max_element(priorityLatencies.begin(), priorityLatencies.end());
+    IMSA_HILOGI("show keyboard max wait, fifo: %{public}lld us, priority: %{public}lld us.",
+        static_cast<long long>(fifoMaxUs), static_cast<long long>(priorityMaxUs));
+    EXPECT_LT(priorityMaxUs, fifoMaxUs);
+    // a show only waits for the task running when it arrives
+    EXPECT_LE(priorityMaxUs, TRACE_TASK_EXEC_US);
+    EXPECT_EQ(fifoStats[TASK_TYPE_IMSA_CURSOR_UPDATE].coalescedNum, 0);
+    EXPECT_GT(priorityStats[TASK_TYPE_IMSA_CURSOR_UPDATE].coalescedNum, 0);
+    EXPECT_GT(priorityStats[TASK_TYPE_IMSA_SELECTION_CHANGE].coalescedNum, 0);
+}
+
 } // namespace MiscServices
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
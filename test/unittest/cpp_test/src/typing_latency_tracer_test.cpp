@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "global.h"
+#include "typing_latency_tracer.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace MiscServices {
+constexpr uint64_t KEY_ID = 7;
+constexpr uint64_t MSG_ID = 100;
+constexpr uint32_t THREAD_NUM = 4;
+constexpr uint32_t TRACE_NUM = 10000;
+class TypingLatencyTracerTest : public testing::Test {
+public:
+    void SetUp()
+    {
+        IMSA_HILOGI("TypingLatencyTracerTest::SetUp");
+        TypingLatencyTracer::GetInstance().Clear();
+        TypingLatencyTracer::GetInstance().SetLastKeyId(0);
+    }
+    void TearDown()
+    {
+        IMSA_HILOGI("TypingLatencyTracerTest::TearDown");
+        TypingLatencyTracer::SetEnabled(false);
+    }
+    // one key from the editor to the ime, which inserts a text and gets the response
+    static void TypeKey(uint64_t keyId, uint64_t msgId)
+    {
+        TypingTraceScope imcScope(TypingTracePoint::IMC_DISPATCH_KEY, keyId);
+        {
+            TypingTraceScope imaScope(TypingTracePoint::IMA_DISPATCH_KEY, keyId);
+            TypingLatencyTracer::GetInstance().SetLastKeyId(keyId);
+        }
+        TypingTraceScope requestScope(
+            TypingTracePoint::IMA_REQUEST, msgId, TypingLatencyTracer::GetInstance().GetLastKeyId());
+        TypingTraceScope responseScope(TypingTracePoint::IMA_RESPONSE, msgId);
+    }
+    static bool Contains(const std::string &trace, const std::string &event)
+    {
+        return trace.find(event) != std::string::npos;
+    }
+};
+
+/**
+ * @tc.name: Trace_001
+ * @tc.desc: nothing is recorded while tracing is off
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(TypingLatencyTracerTest, Trace_001, TestSize.Level0)
+{
+    TypingLatencyTracer::SetEnabled(false);
+    TypeKey(KEY_ID, MSG_ID);
+    EXPECT_TRUE(TypingLatencyTracer::GetInstance().Snapshot().empty());
+    EXPECT_EQ(TypingLatencyTracer::GetInstance().ExportChromeTrace(), "[\n]\n");
+}
+
+/**
+ * @tc.name: Link_001
+ * @tc.desc: the points of a key and of the text operation it caused are linked by the key id and the msg id
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(TypingLatencyTracerTest, Link_001, TestSize.Level0)
+{
+    TypingLatencyTracer::SetEnabled(true);
+    TypeKey(KEY_ID, MSG_ID);
+    auto records = TypingLatencyTracer::GetInstance().Snapshot();
+    std::vector<std::pair<TypingTracePoint, TypingTracePhase>> expected = {
+        { TypingTracePoint::IMC_DISPATCH_KEY, TypingTracePhase::BEGIN },
+        { TypingTracePoint::IMA_DISPATCH_KEY, TypingTracePhase::BEGIN },
+        { TypingTracePoint::IMA_DISPATCH_KEY, TypingTracePhase::END },
+        { TypingTracePoint::IMA_REQUEST, TypingTracePhase::BEGIN },
+        { TypingTracePoint::IMA_RESPONSE, TypingTracePhase::BEGIN },
+        { TypingTracePoint::IMA_RESPONSE, TypingTracePhase::END },
+        { TypingTracePoint::IMA_REQUEST, TypingTracePhase::END },
+        { TypingTracePoint::IMC_DISPATCH_KEY, TypingTracePhase::END },
+    };
+    ASSERT_EQ(records.size(), expected.size());
+    for (size_t i = 0; i < records.size(); ++i) {
+        EXPECT_EQ(records[i].point, expected[i].first);
+        EXPECT_EQ(records[i].phase, expected[i].second);
+        if (i > 0) {
+            EXPECT_GT(records[i].seq, records[i - 1].seq);
+            EXPECT_GE(records[i].timeNs, records[i - 1].timeNs);
+        }
+    }
+    EXPECT_EQ(records[0].id, KEY_ID);
+    EXPECT_EQ(records[1].id, KEY_ID);
+    EXPECT_EQ(records[3].id, MSG_ID);
+    EXPECT_EQ(records[3].linkId, KEY_ID);
+    EXPECT_EQ(records[4].id, MSG_ID);
+
+    auto trace = TypingLatencyTracer::GetInstance().ExportChromeTrace();
+    EXPECT_TRUE(Contains(trace, "\"cat\":\"imf.key\",\"ph\":\"s\",\"bp\":\"e\",\"id\":7,"));
+    EXPECT_TRUE(Contains(trace, "\"cat\":\"imf.key\",\"ph\":\"t\",\"bp\":\"e\",\"id\":7,"));
+    EXPECT_TRUE(Contains(trace, "\"cat\":\"imf.msg\",\"ph\":\"s\",\"bp\":\"e\",\"id\":100,"));
+    EXPECT_TRUE(Contains(trace, "\"cat\":\"imf.msg\",\"ph\":\"f\",\"bp\":\"e\",\"id\":100,"));
+    EXPECT_TRUE(Contains(trace, "\"name\":\"IMA_REQUEST\",\"cat\":\"imf\",\"ph\":\"B\""));
+    EXPECT_TRUE(Contains(trace, "\"args\":{\"id\":100,\"link\":7}}"));
+}
+
+/**
+ * @tc.name: Link_002
+ * @tc.desc: a text operation without a key before it starts its own flow only
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(TypingLatencyTracerTest, Link_002, TestSize.Level0)
+{
+    TypingLatencyTracer::SetEnabled(true);
+    {
+        TypingTraceScope requestScope(
+            TypingTracePoint::IMA_REQUEST, MSG_ID, TypingLatencyTracer::GetInstance().GetLastKeyId());
+    }
+    auto records = TypingLatencyTracer::GetInstance().Snapshot();
+    ASSERT_EQ(records.size(), 2);
+    EXPECT_EQ(records[0].linkId, 0);
+    auto trace = TypingLatencyTracer::GetInstance().ExportChromeTrace();
+    EXPECT_FALSE(Contains(trace, "imf.key"));
+    EXPECT_TRUE(Contains(trace, "\"cat\":\"imf.msg\",\"ph\":\"s\",\"bp\":\"e\",\"id\":100,"));
+}
+
+/**
+ * @tc.name: Wrap_001
+ * @tc.desc: the ring keeps the latest points once it is full
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(TypingLatencyTracerTest, Wrap_001, TestSize.Level0)
+{
+    TypingLatencyTracer::SetEnabled(true);
+    constexpr uint32_t overflowNum = 10;
+    for (uint32_t i = 0; i < TypingLatencyTracer::CAPACITY + overflowNum; ++i) {
+        TypingLatencyTracer::GetInstance().Trace(TypingTracePoint::IMA_TASK, TypingTracePhase::INSTANT, i);
+    }
+    auto records = TypingLatencyTracer::GetInstance().Snapshot();
+    ASSERT_EQ(records.size(), TypingLatencyTracer::CAPACITY);
+    EXPECT_EQ(records.front().id, overflowNum);
+    EXPECT_EQ(records.back().id, TypingLatencyTracer::CAPACITY + overflowNum - 1);
+}
+
+/**
+ * @tc.name: Concurrent_001
+ * @tc.desc: points traced from several threads are read back whole while they are written
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(TypingLatencyTracerTest, Concurrent_001, TestSize.Level0)
+{
+    TypingLatencyTracer::SetEnabled(true);
+    std::atomic<bool> isDone{ false };
+    std::thread reader([&isDone]() {
+        while (!isDone.load()) {
+            for (const auto &record : TypingLatencyTracer::GetInstance().Snapshot()) {
+                // every writer traces the key id as the msg id, a torn record would break it
+                EXPECT_EQ(record.id, record.linkId);
+                EXPECT_LT(record.point, TypingTracePoint::END);
+            }
+        }
+    });
+    std::vector<std::thread> writers;
+    for (uint32_t i = 0; i < THREAD_NUM; ++i) {
+        writers.emplace_back([i]() {
+            for (uint32_t j = 0; j < TRACE_NUM; ++j) {
+                uint64_t id = i * TRACE_NUM + j;
+                TypingLatencyTracer::GetInstance().Trace(
+                    TypingTracePoint::IMA_REQUEST, TypingTracePhase::INSTANT, id, id);
+            }
+        });
+    }
+    for (auto &writer : writers) {
+        writer.join();
+    }
+    isDone.store(true);
+    reader.join();
+    EXPECT_EQ(TypingLatencyTracer::GetInstance().Snapshot().size(), TypingLatencyTracer::CAPACITY);
+}
+
+/**
+ * @tc.name: Remote_001
+ * @tc.desc: the rings reported by other processes are exported with their pid, the oldest report is dropped
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(TypingLatencyTracerTest, Remote_001, TestSize.Level0)
+{
+    constexpr int32_t remotePid = 12345;
+    TypingLatencyTracer::SetEnabled(true);
+    TypeKey(KEY_ID, MSG_ID);
+    auto ring = TypingLatencyTracer::GetInstance().Pack();
+    auto records = TypingLatencyTracer::GetInstance().Snapshot();
+    TypingLatencyTracer::GetInstance().Clear();
+    EXPECT_TRUE(TypingLatencyTracer::GetInstance().Pack().empty());
+
+    // a broken line is skipped, the others are kept
+    TypingLatencyTracer::GetInstance().AddRemote(remotePid, ring + "1 2 3\n");
+    auto trace = TypingLatencyTracer::GetInstance().ExportChromeTrace();
+    EXPECT_TRUE(Contains(trace, "\"name\":\"IMA_REQUEST\",\"cat\":\"imf\",\"ph\":\"B\""));
+    EXPECT_TRUE(Contains(trace, "\"pid\":" + std::to_string(remotePid) + ","));
+    EXPECT_TRUE(Contains(trace, "\"args\":{\"id\":100,\"link\":7}}"));
+    size_t eventNum = 0;
+    for (size_t pos = trace.find("\"cat\":\"imf\","); pos != std::string::npos;
+         pos = trace.find("\"cat\":\"imf\",", pos + 1)) {
+        ++eventNum;
+    }
+    EXPECT_EQ(eventNum, records.size());
+
+    for (int32_t pid = remotePid + 1; pid <= remotePid + static_cast<int32_t>(TypingLatencyTracer::MAX_REMOTE_NUM);
+         ++pid) {
+        TypingLatencyTracer::GetInstance().AddRemote(pid, ring);
+    }
+    trace = TypingLatencyTracer::GetInstance().ExportChromeTrace();
+    EXPECT_FALSE(Contains(trace, "\"pid\":" + std::to_string(remotePid) + ","));
+    EXPECT_TRUE(Contains(trace, "\"pid\":" + std::to_string(remotePid + 1) + ","));
+}
+} // namespace MiscServices
+} // namespace OHOS
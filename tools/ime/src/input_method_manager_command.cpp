@@ -16,8 +16,11 @@
 #include "input_method_manager_command.h"
 #include <getopt.h>
 #include <iostream>
+#include <unistd.h>
 
 #include "input_method_controller.h"
+#include "iservice_registry.h"
+#include "system_ability_definition.h"
 
 namespace OHOS {
 namespace MiscServices {
@@ -193,10 +196,33 @@ void HandleListIme(int32_t argc)
     }
 }
 
+void HandleExportTypingTrace(int32_t argc)
+{
+    if (optind < argc) {
+        std::cout << "Error: Invalid command!" << std::endl;
+        return;
+    }
+    auto samgr = SystemAbilityManagerClient::GetInstance().GetSystemAbilityManager();
+    if (samgr == nullptr) {
+        std::cout << "Error: system ability manager is null." << std::endl;
+        return;
+    }
+    auto remote = samgr->CheckSystemAbility(INPUT_METHOD_SYSTEM_ABILITY_ID);
+    if (remote == nullptr) {
+        std::cout << "Error: input method service is not running." << std::endl;
+        return;
+    }
+    std::cout.flush();
+    auto ret = remote->Dump(STDOUT_FILENO, { u"--typing-trace" });
+    if (ret != ERR_OK) {
+        std::cout << "Error: export typing trace failed. Error code:" << ret << std::endl;
+    }
+}
+
 int32_t InputMethodManagerCommand::ParseCommand(int32_t argc, char *argv[])
 {
     int32_t optCode = 0;
-    while ((optCode = getopt(argc, argv, "d:e:ghls:")) != -1) {
+    while ((optCode = getopt(argc, argv, "d:e:ghls:t")) != -1) {
         switch (optCode) {
             case 'e':
                 HandleStatusChange(optarg, argc, argv, EnabledStatus::BASIC_MODE, "Succeeded in enabling IME");
@@ -213,6 +239,9 @@ int32_t InputMethodManagerCommand::ParseCommand(int32_t argc, char *argv[])
             case 'l':
                 HandleListIme(argc);
                 return ErrorCode::NO_ERROR;
+            case 't':
+                HandleExportTypingTrace(argc);
+                return ErrorCode::NO_ERROR;
             case 'h':
                 ShowUsage(argc);
                 return ErrorCode::NO_ERROR;
@@ -245,6 +274,9 @@ void InputMethodManagerCommand::ShowUsage(int32_t argc)
               << " switching to other input methods is not allowed.\n"
               << "  -g                    Get current input method.\n"
               << "  -l                    List all input methods.\n"
+              << "  -t                    Export the typing trace of the input method service as chrome trace json.\n"
+              << "                        Tracing is on while the parameter imf.typing_trace.enable is true,"
+              << " editors and input methods report their trace when it is set back to false.\n"
               << "  -h                    Show this help message.\n";
 }
 } // namespace MiscServices